@@ -0,0 +1,299 @@
+//
+//  ccm.c
+//  cctest
+//
+//  AES-CCM known answers from RFC 3610 (packet vectors 1-4) and SP 800-38C
+//  (examples C.1-C.3), streamed in pieces that end mid-block, through every
+//  CTR and CBC-MAC path the build has.
+//
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_runtime_config.h>
+#include <corecrypto/ccaes.h>
+#include <corecrypto/ccmode.h>
+#include <corecrypto/ccmode_factory.h>
+#include <corecrypto/ccsha2.h>
+#include <stdio.h>
+#include <string.h>
+
+struct CCM_VECTOR {
+    const char *name;
+    const char *key;
+    const char *nonce;
+    const char *aad;
+    const char *pt;
+    const char *ct; // ciphertext || tag
+};
+
+#define CCM_RFC3610_KEY "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+#define CCM_SP800_38C_KEY "404142434445464748494a4b4c4d4e4f"
+
+static const struct CCM_VECTOR kCCMVectors[] = {
+    { "RFC 3610 #1", CCM_RFC3610_KEY, "00000003020100a0a1a2a3a4a5", "0001020304050607",
+      "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e",
+      "588c979a61c663d2f066d0c2c0f989806d5f6b61dac38417e8d12cfdf926e0" },
+    { "RFC 3610 #2", CCM_RFC3610_KEY, "00000004030201a0a1a2a3a4a5", "0001020304050607",
+      "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+      "72c91a36e135f8cf291ca894085c87e3cc15c439c9e43a3ba091d56e10400916" },
+    { "RFC 3610 #3", CCM_RFC3610_KEY, "00000005040302a0a1a2a3a4a5", "0001020304050607",
+      "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20",
+      "51b1e5f44a197d1da46b0f8e2d282ae871e838bb64da8596574adaa76fbd9fb0c5" },
+    { "RFC 3610 #4", CCM_RFC3610_KEY, "00000006050403a0a1a2a3a4a5", "000102030405060708090a0b",
+      "0c0d0e0f101112131415161718191a1b1c1d1e",
+      "a28c6865939a9a79faaa5c4c2a9d4a91cdac8c96c861b9c9e61ef1" },
+    { "SP 800-38C C.1", CCM_SP800_38C_KEY, "10111213141516", "0001020304050607", "20212223", "7162015b4dac255d" },
+    { "SP 800-38C C.2", CCM_SP800_38C_KEY, "1011121314151617", "000102030405060708090a0b0c0d0e0f",
+      "202122232425262728292a2b2c2d2e2f", "d2a1f0e051ea5f62081a7792073d593d1fc64fbfaccd" },
+    { "SP 800-38C C.3", CCM_SP800_38C_KEY, "101112131415161718191a1b", "000102030405060708090a0b0c0d0e0f10111213",
+      "202122232425262728292a2b2c2d2e2f3031323334353637",
+      "e3b201a9f5b71a7a9b1ceaeccd97e70b6176aad9a4428aa5484392fbc1b09951" },
+};
+
+#define CCM_TEST_NVECTORS (sizeof(kCCMVectors) / sizeof(kCCMVectors[0]))
+
+/*
+ * A message long enough for the interleaved block loops: AES-256 key 00..1f,
+ * nonce a0..aa, 37 bytes of AAD (3 * i + 2), 517 bytes of text (7 * i + 1)
+ * and a 16-byte tag. The ciphertext is checked through its SHA-256.
+ */
+#define CCM_LONG_AAD_NBYTES 37
+#define CCM_LONG_NBYTES 517
+static const char *kCCMLongTag = "f7ff3bdb2dcfbf851171fca11da45ca0";
+static const char *kCCMLongDigest = "9e7e755c1d47a5bc89d1f42aa1c01960ca849a3bb676c66f8b1dabdd302717a0";
+
+#define CCM_TEST_MAX_NBYTES 64
+#define CCM_TEST_MAX_TAG_NBYTES 16
+
+struct CCM_PATH {
+    const char *name;
+    const struct ccmode_ecb *ecb;
+};
+
+static size_t ccm_unhex(const char *hex, uint8_t *out)
+{
+    size_t n = strlen(hex) / 2;
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        out[i] = (uint8_t)b;
+    }
+    return n;
+}
+
+/* One pass with the AAD and the text each fed in two calls, split at split. Writes the output and the tag. */
+static int ccm_test_pass(const struct ccmode_ccm *mode, size_t key_nbytes, const uint8_t *key, size_t nonce_nbytes,
+                         const uint8_t *nonce, size_t aad_nbytes, const uint8_t *aad, size_t nbytes, const uint8_t *in,
+                         uint8_t *out, size_t tag_nbytes, uint8_t *tag, size_t split)
+{
+    size_t asplit = CC_MIN(split, aad_nbytes);
+    size_t tsplit = CC_MIN(split, nbytes);
+    int rc;
+
+    ccccm_ctx_decl(mode->size, ctx);
+    ccccm_nonce_decl(mode->nonce_size, nonce_ctx);
+    rc = ccccm_init(mode, ctx, key_nbytes, key);
+    rc |= ccccm_set_iv(mode, ctx, nonce_ctx, nonce_nbytes, nonce, tag_nbytes, aad_nbytes, nbytes);
+    rc |= ccccm_cbcmac(mode, ctx, nonce_ctx, asplit, aad);
+    rc |= ccccm_cbcmac(mode, ctx, nonce_ctx, aad_nbytes - asplit, aad + asplit);
+    rc |= ccccm_update(mode, ctx, nonce_ctx, tsplit, in, out);
+    rc |= ccccm_update(mode, ctx, nonce_ctx, nbytes - tsplit, in + tsplit, out + tsplit);
+    rc |= ccccm_finalize(mode, ctx, nonce_ctx, tag);
+    ccccm_ctx_clear(mode->size, ctx);
+    ccccm_nonce_clear(mode->nonce_size, nonce_ctx);
+
+    return rc;
+}
+
+/*
+ * Both directions at one split. A decryptor compares the tag itself, so a
+ * ciphertext with one bit flipped must give a tag other than the one sent.
+ */
+static int ccm_test_split(const struct ccmode_ccm *enc, const struct ccmode_ccm *dec, size_t key_nbytes,
+                          const uint8_t *key, size_t nonce_nbytes, const uint8_t *nonce, size_t aad_nbytes,
+                          const uint8_t *aad, size_t nbytes, const uint8_t *pt, uint8_t *ct, size_t tag_nbytes,
+                          const uint8_t *tag, size_t split)
+{
+    uint8_t back[CCM_LONG_NBYTES], t[CCM_TEST_MAX_TAG_NBYTES];
+    int bad = 0;
+
+    bad |= ccm_test_pass(enc, key_nbytes, key, nonce_nbytes, nonce, aad_nbytes, aad, nbytes, pt, ct, tag_nbytes, t,
+                         split);
+    bad |= cc_cmp_safe(tag_nbytes, t, tag) != 0;
+
+    bad |= ccm_test_pass(dec, key_nbytes, key, nonce_nbytes, nonce, aad_nbytes, aad, nbytes, ct, back, tag_nbytes, t,
+                         split);
+    bad |= cc_cmp_safe(tag_nbytes, t, tag) != 0;
+    bad |= memcmp(back, pt, nbytes);
+
+    ct[split % nbytes] ^= 0x10;
+    bad |= ccm_test_pass(dec, key_nbytes, key, nonce_nbytes, nonce, aad_nbytes, aad, nbytes, ct, back, tag_nbytes, t,
+                         split);
+    bad |= cc_cmp_safe(tag_nbytes, t, tag) == 0;
+    ct[split % nbytes] ^= 0x10;
+
+    return bad;
+}
+
+static int ccm_test_path(const struct CCM_PATH *path)
+{
+    struct ccmode_ccm enc_mode, dec_mode;
+    const struct ccmode_ccm *enc = ccaes_ccm_encrypt_mode(), *dec = ccaes_ccm_decrypt_mode();
+    uint8_t key[32], nonce[13], aad[CCM_LONG_AAD_NBYTES], pt[CCM_LONG_NBYTES], ct[CCM_LONG_NBYTES];
+    uint8_t expected[CCM_TEST_MAX_NBYTES], tag[CCM_TEST_MAX_TAG_NBYTES], digest[CCSHA256_OUTPUT_SIZE];
+    int rv = 0;
+
+    if (path->ecb) {
+        ccmode_factory_ccm_encrypt(&enc_mode, path->ecb);
+        ccmode_factory_ccm_decrypt(&dec_mode, path->ecb);
+        enc = &enc_mode;
+        dec = &dec_mode;
+    }
+
+    for (size_t i = 0; i < CCM_TEST_NVECTORS; i++) {
+        const struct CCM_VECTOR *v = &kCCMVectors[i];
+        size_t key_nbytes = ccm_unhex(v->key, key), nonce_nbytes = ccm_unhex(v->nonce, nonce);
+        size_t aad_nbytes = ccm_unhex(v->aad, aad), nbytes = ccm_unhex(v->pt, pt);
+        size_t tag_nbytes = ccm_unhex(v->ct, expected) - nbytes;
+        int bad = 0;
+
+        for (size_t split = 0; split <= nbytes || split <= aad_nbytes; split++) {
+            bad |= ccm_test_split(enc, dec, key_nbytes, key, nonce_nbytes, nonce, aad_nbytes, aad, nbytes, pt, ct,
+                                  tag_nbytes, expected + nbytes, split);
+            bad |= memcmp(ct, expected, nbytes);
+        }
+
+        if (bad) {
+            printf("CCM MISMATCH!!! (%s, %s)\n", path->name, v->name);
+            rv = -1;
+        } else {
+            printf("CCM MATCH! (%s, %s)\n", path->name, v->name);
+        }
+    }
+
+    /* the long message, with splits on both sides of whole-block runs */
+    {
+        int bad = 0;
+
+        for (size_t i = 0; i < 32; i++) {
+            key[i] = (uint8_t)i;
+        }
+        for (size_t i = 0; i < 11; i++) {
+            nonce[i] = (uint8_t)(0xa0 + i);
+        }
+        for (size_t i = 0; i < CCM_LONG_AAD_NBYTES; i++) {
+            aad[i] = (uint8_t)(3 * i + 2);
+        }
+        for (size_t i = 0; i < CCM_LONG_NBYTES; i++) {
+            pt[i] = (uint8_t)(7 * i + 1);
+        }
+        ccm_unhex(kCCMLongTag, tag);
+        ccm_unhex(kCCMLongDigest, expected);
+
+        for (size_t split = 0; split <= CCM_LONG_NBYTES; split += 47) {
+            bad |= ccm_test_split(enc, dec, 32, key, 11, nonce, CCM_LONG_AAD_NBYTES, aad, CCM_LONG_NBYTES, pt, ct,
+                                  sizeof(tag), tag, split);
+            ccdigest(ccsha256_di(), CCM_LONG_NBYTES, ct, digest);
+            bad |= memcmp(digest, expected, sizeof(digest));
+        }
+
+        if (bad) {
+            printf("CCM MISMATCH!!! (%s, 517 bytes)\n", path->name);
+            rv = -1;
+        } else {
+            printf("CCM MATCH! (%s, 517 bytes)\n", path->name);
+        }
+    }
+
+    return rv;
+}
+
+/* The AAD and text lengths promised to set_iv are enforced by the later calls. */
+static int ccm_test_lengths(void)
+{
+    const struct ccmode_ccm *mode = ccaes_ccm_encrypt_mode();
+    const struct CCM_VECTOR *v = &kCCMVectors[0];
+    uint8_t key[16], nonce[13], aad[CCM_TEST_MAX_NBYTES], pt[CCM_TEST_MAX_NBYTES], ct[CCM_TEST_MAX_NBYTES];
+    uint8_t tag[CCM_TEST_MAX_TAG_NBYTES];
+    size_t key_nbytes = ccm_unhex(v->key, key), nonce_nbytes = ccm_unhex(v->nonce, nonce);
+    size_t aad_nbytes = ccm_unhex(v->aad, aad), nbytes = ccm_unhex(v->pt, pt);
+    int bad = 0;
+
+    ccccm_ctx_decl(mode->size, ctx);
+    ccccm_nonce_decl(mode->nonce_size, nonce_ctx);
+    bad |= ccccm_init(mode, ctx, key_nbytes, key);
+
+    /* more AAD than declared */
+    bad |= ccccm_set_iv(mode, ctx, nonce_ctx, nonce_nbytes, nonce, 8, aad_nbytes, nbytes);
+    bad |= ccccm_cbcmac(mode, ctx, nonce_ctx, aad_nbytes + 1, aad) != CCMODE_INVALID_INPUT;
+
+    /* text before all of the AAD */
+    bad |= ccccm_set_iv(mode, ctx, nonce_ctx, nonce_nbytes, nonce, 8, aad_nbytes, nbytes);
+    bad |= ccccm_cbcmac(mode, ctx, nonce_ctx, aad_nbytes - 1, aad);
+    bad |= ccccm_update(mode, ctx, nonce_ctx, nbytes, pt, ct) != CCMODE_INVALID_CALL_SEQUENCE;
+
+    /* more text than declared, in one call and across two */
+    bad |= ccccm_set_iv(mode, ctx, nonce_ctx, nonce_nbytes, nonce, 8, aad_nbytes, nbytes);
+    bad |= ccccm_cbcmac(mode, ctx, nonce_ctx, aad_nbytes, aad);
+    bad |= ccccm_update(mode, ctx, nonce_ctx, nbytes + 1, pt, ct) != CCMODE_INVALID_INPUT;
+    bad |= ccccm_update(mode, ctx, nonce_ctx, nbytes - 1, pt, ct);
+    bad |= ccccm_update(mode, ctx, nonce_ctx, 2, pt, ct) != CCMODE_INVALID_INPUT;
+
+    /* finalize short of the declared AAD, and of the declared text */
+    bad |= ccccm_set_iv(mode, ctx, nonce_ctx, nonce_nbytes, nonce, 8, aad_nbytes, nbytes);
+    bad |= ccccm_cbcmac(mode, ctx, nonce_ctx, aad_nbytes - 1, aad);
+    bad |= ccccm_finalize(mode, ctx, nonce_ctx, tag) != CCMODE_INVALID_CALL_SEQUENCE;
+    bad |= ccccm_set_iv(mode, ctx, nonce_ctx, nonce_nbytes, nonce, 8, aad_nbytes, nbytes);
+    bad |= ccccm_cbcmac(mode, ctx, nonce_ctx, aad_nbytes, aad);
+    bad |= ccccm_update(mode, ctx, nonce_ctx, nbytes - 1, pt, ct);
+    bad |= ccccm_finalize(mode, ctx, nonce_ctx, tag) != CCMODE_INVALID_CALL_SEQUENCE;
+
+    /* and the rejected calls left the state alone: the last byte still gives the right tag */
+    bad |= ccccm_update(mode, ctx, nonce_ctx, 1, pt + nbytes - 1, ct + nbytes - 1);
+    bad |= ccccm_finalize(mode, ctx, nonce_ctx, tag);
+    ccm_unhex(v->ct, aad);
+    bad |= memcmp(ct, aad, nbytes) || memcmp(tag, aad + nbytes, 8);
+
+    ccccm_ctx_clear(mode->size, ctx);
+    ccccm_nonce_clear(mode->nonce_size, nonce_ctx);
+
+    if (bad) {
+        printf("CCM MISMATCH!!! (lengths)\n");
+        return -1;
+    }
+    printf("CCM MATCH! (lengths)\n");
+    return 0;
+}
+
+int TestCCM(void)
+{
+    const struct CCM_PATH paths[] = {
+        { "default", NULL },
+        { "LTC", &ccaes_ltc_ecb_encrypt_mode },
+        { "bitsliced", &ccaes_bitslice_ecb_encrypt_mode },
+    };
+    int rv = 0;
+
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        rv |= ccm_test_path(&paths[i]);
+    }
+
+#if CCAES_VPERM
+    if (CC_HAS_SupplementalSSE3()) {
+        const struct CCM_PATH vperm = { "vector permute", &ccaes_vperm_ecb_encrypt_mode };
+        rv |= ccm_test_path(&vperm);
+    }
+#endif
+
+#if CCAES_INTEL_ASM && defined(__x86_64__)
+    /* the interleaved AES-NI blocks, picked by the factory for the AES-NI ECB */
+    if (CC_HAS_AESNI()) {
+        const struct CCM_PATH aesni = { "AES-NI", &ccaes_intel_ecb_encrypt_aesni_mode };
+        rv |= ccm_test_path(&aesni);
+    }
+#endif
+
+    rv |= ccm_test_lengths();
+
+    return rv;
+}
@@ -4,67 +4,304 @@
 //
 //  Created by Zormeister on 15/2/2025.
 //
+//  ChaCha20, Poly1305 and the AEAD from RFC 8439 (sections 2.4.2, 2.5.2 and
+//  2.8.2), streamed in pieces, plus a message long enough to cross the
+//  AEAD's 2 KiB cipher-then-MAC chunks, forged tags through the one-shot
+//  decrypt and the batch decrypt.
+//
 
 #include <corecrypto/cc.h>
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccchacha20poly1305.h>
 #include <corecrypto/ccchacha20poly1305_priv.h>
+#include <corecrypto/ccsha2.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char kSunscreen[] = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the "
+                                 "future, sunscreen would be it.";
+
+#define CHACHA20_SUNSCREEN_NBYTES (sizeof(kSunscreen) - 1)
+
+/* 2.4.2: key 00..1f, counter 1 */
+static const char *kChaCha20Nonce = "000000000000004a00000000";
+static const char *kChaCha20Out =
+    "6e2e359a2568f98041ba0728dd0d6981e97e7aec1d4360c20a27afccfd9fae0bf91b65c5524733ab8f593dabcd62b3571639d624e65152ab8f"
+    "530c359f0861d807ca0dbf500d6a6156a38e088a22b65e52bc514d16ccf806818ce91ab77937365af90bbf74a35be6b40b8eedf2785e42874d";
 
-uint8_t key[32] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
-uint32_t nonce[3] = { 0, 0, 0 };
+/* 2.5.2 */
+static const char *kPoly1305Key = "85d6be7857556d337f4452fe42d506a80103808afb0db2fd4abff6af4149f51b";
+static const char kPoly1305Msg[] = "Cryptographic Forum Research Group";
+static const char *kPoly1305Tag = "a8061dc1305136c6c22b8baf0c0127a9";
 
-uint64_t data[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+/* 2.8.2: key 80..9f */
+static const char *kAEADNonce = "070000004041424344454647";
+static const char *kAEADAAD = "50515253c0c1c2c3c4c5c6c7";
+static const char *kAEADOut =
+    "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d63dbea45e8ca9671282fafb69da92728b1a71de0a9e060b29"
+    "05d6a5b67ecd3b3692ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc3ff4def08e4b7a9de576d26586cec64b"
+    "6116";
+static const char *kAEADTag = "1ae10b594f09e26a7e902ecbd0600691";
 
-uint64_t out[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
 /*
- * 000  76 b8 e0 ad a0 f1 3d 90 40 5d 6a e5 53 86 bd 28  v.....=.@]j.S..(
- * 016  bd d2 19 b8 a0 8d ed 1a a8 36 ef cc 8b 77 0d c7  .........6...w..
- * 032  da 41 59 7c 51 57 48 8d 77 24 e0 3f b8 d8 4a 37  .AY|QWH.w$.?..J7
- * 048  6a 43 b8 f4 15 18 a1 1c c3 87 b6 69 b2 ee 65 86  jC.........i..e.
+ * Key 00..1f, nonce a0..ab, 37 bytes of AAD (3 * i + 2) and 5000 bytes of
+ * text (7 * i + 1), computed with an independent model. The ciphertext is
+ * checked through its SHA-256.
  */
-uint8_t expected[CCCHACHA20_BLOCK_NBYTES] = {
-    0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90, 0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28,
-    0xbd, 0xd2, 0x19, 0xb8, 0xa0, 0x8d, 0xed, 0x1a, 0xa8, 0x36, 0xef, 0xcc, 0x8b, 0x77, 0x0d, 0xc7,
-    0xda, 0x41, 0x59, 0x7c, 0x51, 0x57, 0x48, 0x8d, 0x77, 0x24, 0xe0, 0x3f, 0xb8, 0xd8, 0x4a, 0x37,
-    0x6a, 0x43, 0xb8, 0xf4, 0x15, 0x18, 0xa1, 0x1c, 0xc3, 0x87, 0xb6, 0x69, 0xb2, 0xee, 0x65, 0x86
-};
+#define CHACHA20_LONG_AAD_NBYTES 37
+#define CHACHA20_LONG_NBYTES 5000
+static const char *kAEADLongTag = "db1b9328c1d7238f213524094cf28129";
+static const char *kAEADLongDigest = "71678899c44461d576da56a984f7bf7f80d93807a08bc6306630110f7e1adf93";
 
-/* TODO: find an ACTUAL test vector. My code is fine. */
+/* split points on both sides of 64-byte blocks and of the 2 KiB chunks */
+static const size_t kAEADLongSplits[] = { 0, 1, 63, 64, 65, 2047, 2048, 2049, 3001, 4095, 4096, 4097, 4999, 5000 };
 
-/*
-void TestChaCha20(void) {
-    ccchacha20_ctx ctx;
-    if (ccchacha20_init(&ctx, key)
-        != CCERR_OK) {
-        printf("ccchacha20_init failed");
-        return;
-    } else if (ccchacha20_setnonce(&ctx, nonce) != CCERR_OK) {
-        printf("ccchacha20_setnonce failed");
-        return;
-    } else if (ccchacha20_setcounter(&ctx, 1) != CCERR_OK) {
-        printf("ccchacha20_setcounter failed");
-        return;
+#define CHACHA20_BATCH_NPACKETS 6
+
+static size_t chacha20_unhex(const char *hex, uint8_t *out)
+{
+    size_t n = strlen(hex) / 2;
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        out[i] = (uint8_t)b;
     }
+    return n;
+}
 
-    printf("current state:\n");
-    for (int i = 0; i < 16; i++) {
-        printf("%04X ", ctx.state[i]);
-        printf("\n");
+static void chacha20_report(const char *name, int bad, int *rv)
+{
+    if (bad) {
+        printf("ChaCha20-Poly1305 MISMATCH!!! (%s)\n", name);
+        *rv = -1;
+    } else {
+        printf("ChaCha20-Poly1305 MATCH! (%s)\n", name);
     }
+}
 
-    if (ccchacha20_update(&ctx, CCCHACHA20_BLOCK_NBYTES, data, out) != CCERR_OK) {
-        printf("ccchacha20_update failed");
-        return;
+/* 2.4.2 and 2.5.2, the two primitives alone, in two pieces split at every offset */
+static void chacha20_test_primitives(int *rv)
+{
+    uint8_t key[32], nonce[12], out[CHACHA20_SUNSCREEN_NBYTES], expected[CHACHA20_SUNSCREEN_NBYTES], tag[16];
+    size_t msg_nbytes = sizeof(kPoly1305Msg) - 1;
+    int bad = 0;
+
+    for (size_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)i;
     }
+    chacha20_unhex(kChaCha20Nonce, nonce);
+    chacha20_unhex(kChaCha20Out, expected);
+    for (size_t split = 0; split <= CHACHA20_SUNSCREEN_NBYTES; split++) {
+        ccchacha20_ctx ctx;
 
-    if (memcmp(out, expected, sizeof(out)) == 0) {
-        printf("omg it worked\n");
+        cc_clear(sizeof(ctx), &ctx);
+        bad |= ccchacha20_init(&ctx, key);
+        bad |= ccchacha20_setnonce(&ctx, nonce);
+        bad |= ccchacha20_setcounter(&ctx, 1);
+        bad |= ccchacha20_update(&ctx, split, kSunscreen, out);
+        bad |= ccchacha20_update(&ctx, CHACHA20_SUNSCREEN_NBYTES - split, kSunscreen + split, out + split);
+        bad |= ccchacha20_final(&ctx);
+        bad |= memcmp(out, expected, sizeof(out)) != 0;
+    }
+    chacha20_report("RFC 8439 2.4.2", bad, rv);
+
+    bad = 0;
+    chacha20_unhex(kPoly1305Key, key);
+    chacha20_unhex(kPoly1305Tag, expected);
+    for (size_t split = 0; split <= msg_nbytes; split++) {
+        ccpoly1305_ctx ctx;
+
+        bad |= ccpoly1305_init(&ctx, key);
+        bad |= ccpoly1305_update(&ctx, split, kPoly1305Msg);
+        bad |= ccpoly1305_update(&ctx, msg_nbytes - split, kPoly1305Msg + split);
+        bad |= ccpoly1305_final(&ctx, tag);
+        bad |= memcmp(tag, expected, sizeof(tag)) != 0;
+    }
+    chacha20_report("RFC 8439 2.5.2", bad, rv);
+}
+
+/*
+ * One AEAD pass with the AAD split at asplit and the text at tsplit. Encrypting writes the tag, decrypting checks it
+ * with ccchacha20poly1305_verify() and returns its result.
+ */
+static int chacha20_test_pass(int decrypt, const uint8_t *key, const uint8_t *nonce, size_t aad_nbytes,
+                              const uint8_t *aad, size_t nbytes, const uint8_t *in, uint8_t *out, uint8_t *tag,
+                              size_t asplit, size_t tsplit)
+{
+    const struct ccchacha20poly1305_info *info = ccchacha20poly1305_info();
+    int (*crypt)(const struct ccchacha20poly1305_info *, ccchacha20poly1305_ctx *, size_t, const void *, void *) =
+        decrypt ? ccchacha20poly1305_decrypt : ccchacha20poly1305_encrypt;
+    ccchacha20poly1305_ctx ctx;
+    int rc;
+
+    rc = ccchacha20poly1305_init(info, &ctx, key);
+    rc |= ccchacha20poly1305_setnonce(info, &ctx, nonce);
+    rc |= ccchacha20poly1305_aad(info, &ctx, asplit, aad);
+    rc |= ccchacha20poly1305_aad(info, &ctx, aad_nbytes - asplit, aad + asplit);
+    rc |= crypt(info, &ctx, tsplit, in, out);
+    rc |= crypt(info, &ctx, nbytes - tsplit, in + tsplit, out + tsplit);
+    if (decrypt) {
+        rc |= ccchacha20poly1305_verify(info, &ctx, tag);
     } else {
-        printf("recieved:\n");
-        for (int i = 0; i < 8; i++) {
-            printf("%08llX\n", out[i]);
+        rc |= ccchacha20poly1305_finalize(info, &ctx, tag);
+    }
+    cc_clear(sizeof(ctx), &ctx);
+
+    return rc;
+}
+
+/* 2.8.2, streamed at every split, then the one-shot calls, and a flipped bit in the text, the AAD or the tag */
+static void chacha20_test_aead(int *rv)
+{
+    const struct ccchacha20poly1305_info *info = ccchacha20poly1305_info();
+    uint8_t key[32], nonce[12], aad[12], tag[16], expected_tag[16];
+    uint8_t ct[CHACHA20_SUNSCREEN_NBYTES], back[CHACHA20_SUNSCREEN_NBYTES], expected[CHACHA20_SUNSCREEN_NBYTES];
+    const uint8_t *pt = (const uint8_t *)kSunscreen;
+    size_t aad_nbytes = chacha20_unhex(kAEADAAD, aad);
+    int bad = 0;
+
+    for (size_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)(0x80 + i);
+    }
+    chacha20_unhex(kAEADNonce, nonce);
+    chacha20_unhex(kAEADOut, expected);
+    chacha20_unhex(kAEADTag, expected_tag);
+
+    for (size_t split = 0; split <= CHACHA20_SUNSCREEN_NBYTES; split++) {
+        bad |= chacha20_test_pass(0, key, nonce, aad_nbytes, aad, sizeof(ct), pt, ct, tag, split % (aad_nbytes + 1),
+                                  split);
+        bad |= memcmp(ct, expected, sizeof(ct)) != 0 || memcmp(tag, expected_tag, sizeof(tag)) != 0;
+        bad |= chacha20_test_pass(1, key, nonce, aad_nbytes, aad, sizeof(ct), ct, back, expected_tag,
+                                  split % (aad_nbytes + 1), split);
+        bad |= memcmp(back, pt, sizeof(back)) != 0;
+    }
+    chacha20_report("RFC 8439 2.8.2", bad, rv);
+
+    bad = ccchacha20poly1305_encrypt_oneshot(info, key, nonce, aad_nbytes, aad, sizeof(ct), pt, ct, tag);
+    bad |= memcmp(ct, expected, sizeof(ct)) != 0 || memcmp(tag, expected_tag, sizeof(tag)) != 0;
+    bad |= ccchacha20poly1305_decrypt_oneshot(info, key, nonce, aad_nbytes, aad, sizeof(ct), ct, back, tag);
+    bad |= memcmp(back, pt, sizeof(back)) != 0;
+    chacha20_report("RFC 8439 2.8.2, one-shot", bad, rv);
+
+    bad = 0;
+    ct[17] ^= 0x01;
+    bad |= ccchacha20poly1305_decrypt_oneshot(info, key, nonce, aad_nbytes, aad, sizeof(ct), ct, back, tag) == 0;
+    ct[17] ^= 0x01;
+    aad[3] ^= 0x80;
+    bad |= ccchacha20poly1305_decrypt_oneshot(info, key, nonce, aad_nbytes, aad, sizeof(ct), ct, back, tag) == 0;
+    aad[3] ^= 0x80;
+    tag[15] ^= 0x40;
+    bad |= ccchacha20poly1305_decrypt_oneshot(info, key, nonce, aad_nbytes, aad, sizeof(ct), ct, back, tag) == 0;
+    tag[15] ^= 0x40;
+    bad |= chacha20_test_pass(1, key, nonce, aad_nbytes, aad, sizeof(ct) - 1, ct, back, tag, 0, 0) == 0;
+    chacha20_report("forgeries, one-shot", bad, rv);
+}
+
+/* the long message, with the text split on both sides of the 2 KiB chunks */
+static void chacha20_test_long(int *rv)
+{
+    static uint8_t pt[CHACHA20_LONG_NBYTES], ct[CHACHA20_LONG_NBYTES], back[CHACHA20_LONG_NBYTES];
+    uint8_t key[32], nonce[12], aad[CHACHA20_LONG_AAD_NBYTES], tag[16], expected_tag[16];
+    uint8_t digest[CCSHA256_OUTPUT_SIZE], expected[CCSHA256_OUTPUT_SIZE];
+    int bad = 0;
+
+    for (size_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)i;
+    }
+    for (size_t i = 0; i < sizeof(nonce); i++) {
+        nonce[i] = (uint8_t)(0xa0 + i);
+    }
+    for (size_t i = 0; i < sizeof(aad); i++) {
+        aad[i] = (uint8_t)(3 * i + 2);
+    }
+    for (size_t i = 0; i < sizeof(pt); i++) {
+        pt[i] = (uint8_t)(7 * i + 1);
+    }
+    chacha20_unhex(kAEADLongTag, expected_tag);
+    chacha20_unhex(kAEADLongDigest, expected);
+
+    for (size_t i = 0; i < sizeof(kAEADLongSplits) / sizeof(kAEADLongSplits[0]); i++) {
+        size_t split = kAEADLongSplits[i];
+
+        bad |= chacha20_test_pass(0, key, nonce, sizeof(aad), aad, sizeof(pt), pt, ct, tag, split % sizeof(aad),
+                                  split);
+        ccdigest(ccsha256_di(), sizeof(ct), ct, digest);
+        bad |= memcmp(digest, expected, sizeof(digest)) != 0 || memcmp(tag, expected_tag, sizeof(tag)) != 0;
+        bad |= chacha20_test_pass(1, key, nonce, sizeof(aad), aad, sizeof(ct), ct, back, expected_tag,
+                                  split % sizeof(aad), split);
+        bad |= memcmp(back, pt, sizeof(back)) != 0;
+    }
+    chacha20_report("5000 bytes", bad, rv);
+}
+
+/*
+ * A batch of messages around the block and chunk sizes under one key: every one must match its one-shot encryption,
+ * and a decrypt batch with one forged tag must fail that message alone.
+ */
+static void chacha20_test_batch(int *rv)
+{
+    static const size_t lengths[CHACHA20_BATCH_NPACKETS] = { 0, 1, 63, 114, 300, 2049 };
+    static uint8_t pt[CHACHA20_BATCH_NPACKETS][2049], ct[CHACHA20_BATCH_NPACKETS][2049];
+    static uint8_t back[CHACHA20_BATCH_NPACKETS][2049], one[2049];
+    const struct ccchacha20poly1305_info *info = ccchacha20poly1305_info();
+    struct ccchacha20poly1305_packet packets[CHACHA20_BATCH_NPACKETS];
+    uint8_t key[32], nonces[CHACHA20_BATCH_NPACKETS][12], aad[CHACHA20_BATCH_NPACKETS][9];
+    uint8_t tags[CHACHA20_BATCH_NPACKETS][16], tag[16];
+    int results[CHACHA20_BATCH_NPACKETS];
+    int bad = 0;
+
+    for (size_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)(0x80 + i);
+    }
+    for (size_t p = 0; p < CHACHA20_BATCH_NPACKETS; p++) {
+        for (size_t i = 0; i < sizeof(nonces[p]); i++) {
+            nonces[p][i] = (uint8_t)(p * 16 + i);
+        }
+        for (size_t i = 0; i < sizeof(aad[p]); i++) {
+            aad[p][i] = (uint8_t)(p + i);
+        }
+        for (size_t i = 0; i < lengths[p]; i++) {
+            pt[p][i] = (uint8_t)(11 * i + p);
         }
-        printf("\n");
+        packets[p] = (struct ccchacha20poly1305_packet){ nonces[p], p % 2 ? sizeof(aad[p]) : 0, aad[p],
+                                                          lengths[p], pt[p], ct[p], tags[p] };
+    }
+
+    bad |= ccchacha20poly1305_encrypt_batch(info, key, CHACHA20_BATCH_NPACKETS, packets);
+    for (size_t p = 0; p < CHACHA20_BATCH_NPACKETS; p++) {
+        bad |= ccchacha20poly1305_encrypt_oneshot(info, key, nonces[p], packets[p].aad_nbytes, aad[p], lengths[p],
+                                                  pt[p], one, tag);
+        bad |= memcmp(one, ct[p], lengths[p]) != 0 || memcmp(tag, tags[p], sizeof(tag)) != 0;
+
+        packets[p].in = ct[p];
+        packets[p].out = back[p];
     }
 
-    ccchacha20_final(&ctx);
+    bad |= ccchacha20poly1305_decrypt_batch(info, key, CHACHA20_BATCH_NPACKETS, packets, results);
+    for (size_t p = 0; p < CHACHA20_BATCH_NPACKETS; p++) {
+        bad |= results[p] != 0 || memcmp(back[p], pt[p], lengths[p]) != 0;
+    }
+    chacha20_report("batch", bad, rv);
+
+    bad = 0;
+    tags[3][0] ^= 0x02;
+    bad |= ccchacha20poly1305_decrypt_batch(info, key, CHACHA20_BATCH_NPACKETS, packets, results) == 0;
+    for (size_t p = 0; p < CHACHA20_BATCH_NPACKETS; p++) {
+        bad |= (results[p] != 0) != (p == 3);
+    }
+    tags[3][0] ^= 0x02;
+    chacha20_report("forgeries, batch", bad, rv);
+}
+
+int TestChaCha20(void)
+{
+    int rv = 0;
+
+    chacha20_test_primitives(&rv);
+    chacha20_test_aead(&rv);
+    chacha20_test_long(&rv);
+    chacha20_test_batch(&rv);
+
+    return rv;
 }
-*/
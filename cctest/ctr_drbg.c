@@ -0,0 +1,165 @@
+//
+//  ctr_drbg.c
+//  cctest
+//
+//  NIST CAVP CTR_DRBG known answers (drbgvectors_no_reseed, AES with and
+//  without the derivation function), plus the keystream buffer of
+//  ccdrbg_nistctr_custom.buffer_nbytes.
+//
+
+#include <corecrypto/ccaes.h>
+#include <corecrypto/ccdrbg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Each vector is instantiated, then asked for 64 bytes twice, the first time
+ * with add1 and the second with add2. Only the second output is checked.
+ */
+struct CTR_DRBG_VECTOR {
+    const char *name;
+    size_t keylen;
+    int use_df;
+    const char *entropy;
+    const char *nonce;
+    const char *ps;
+    const char *add1;
+    const char *add2;
+    const char *out;
+};
+
+static const struct CTR_DRBG_VECTOR kCTRDRBGVectors[] = {
+    { "AES-128 df", 16, 1,
+      "890eb067acf7382eff80b0c73bc872c6", "aad471ef3ef1d203", "", "", "",
+      "a5514ed7095f64f3d0d3a5760394ab42062f373a25072a6ea6bcfd8489e94af6"
+      "cf18659fea22ed1ca0a9e33f718b115ee536b12809c31b72b08ddd8be1910fa3" },
+    { "AES-192 df", 24, 1,
+      "c35c2fa2a89d52a11fa32aa96c95b8f1c9a8f9cb245a8b40f3a6e5a7fbd9d3c68e277ba9ac9bbb00", "", "", "", "",
+      "8c2e72abfd9bb8284db79e17a43a3146cd7694e35249fc3383914a7117f41368"
+      "e6d4f148ff49bf29076b5015c59f457945662e3d3503843f4aa5a3df9a9df10d" },
+    { "AES-256 df", 32, 1,
+      "36401940fa8b1fba91a1661f211d78a0b9389a74e5bccfece8d766af1a6d3b14", "496f25b0f1301b4f501be30380a137eb", "", "", "",
+      "5862eb38bd558dd978a696e6df164782ddd887e7e9a6c9f3f1fbafb78941b535"
+      "a64912dfd224c6dc7454e5250b3d97165e16260c2faf1cc7735cb75fb4f07e1d" },
+    { "AES-128 no df", 16, 0,
+      "ce50f33da5d4c1d3d4004eb35244b7f2cd7f2e5076fbf6780a7ff634b249a5fc", "", "", "", "",
+      "6545c0529d372443b392ceb3ae3a99a30f963eaf313280f1d1a1e87f9db373d3"
+      "61e75d18018266499cccd64d9bbb8de0185f213383080faddec46bae1f784e5a" },
+    { "AES-192 no df", 24, 0,
+      "f1ef7eb311c850e189be229df7e6d68f1795aa8e21d93504e75abe78f041395873540386812a9a2a", "", "", "", "",
+      "6bb0aa5b4b97ee83765736ad0e9068dfef0ccfc93b71c1d3425302ef7ba4635f"
+      "fc09981d262177e208a7ec90a557b6d76112d56c40893892c3034835036d7a69" },
+    { "AES-256 no df", 32, 0,
+      "df5d73faa468649edda33b5cca79b0b05600419ccb7a879ddfec9db32ee494e5531b51de16a30f769262474c73bec010", "", "", "", "",
+      "d1c07cd95af8a7f11012c84ce48bb8cb87189e99d40fccb1771c619bdf82ab22"
+      "80b1dc2f2581f39164f7ac0c510494b3a43c41b7db17514c87b107ae793e01c5" },
+    { "AES-128 df, ps and additional input", 16, 1,
+      "c0701f9250758fcdf2be739880db66eb1468b4a5879c2da6", "", "8008aee8e96940c50873c79f8ecfe002",
+      "f901f8167a1dffde8e3c83e24485e7fe", "171c0938c2389f97876055b48216627f",
+      "97c0c0e5a0ccf24f3363488adb130a3589bf806562ee13957c33d37df407777a"
+      "2b650b5f455c13f190777fc5043fcc1a38f8cd1bbbd557d14a4c2e8a2b491e5c" },
+};
+
+/*
+ * The first 128 bytes out of the "AES-128 df" instantiation, as a single
+ * generate. With a 128-byte buffer, smaller requests are served from exactly
+ * that keystream.
+ */
+static const char *kCTRDRBGBufferedOut =
+    "957c314cc96cd004c6a77d8e162c0b61b373c82106e725394e7f9c7a9334ae43"
+    "4ef01227fadf3de68ab2e41f485e0a239832c11bff578c3602c4608acd93dd71"
+    "5b5d086eef9f67a8b6fa0ba5f1898d97556c8d59d8d0c1d9407f39d6940c97c1"
+    "345261841ef45bdd328dfa63b5c3aace472e10ebda46d0b3b17fedf79f3d11df";
+
+#define CTR_DRBG_MAX_INPUT_NBYTES 64
+
+static size_t ctr_drbg_unhex(const char *hex, uint8_t *out)
+{
+    size_t n = strlen(hex) / 2;
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        out[i] = (uint8_t)b;
+    }
+    return n;
+}
+
+static int ctr_drbg_instantiate(struct ccdrbg_info *info, struct ccdrbg_nistctr_custom *custom,
+                                struct ccdrbg_state **drbg, const struct CTR_DRBG_VECTOR *v,
+                                size_t buffer_nbytes)
+{
+    uint8_t entropy[CTR_DRBG_MAX_INPUT_NBYTES], nonce[CTR_DRBG_MAX_INPUT_NBYTES], ps[CTR_DRBG_MAX_INPUT_NBYTES];
+    size_t entropy_nbytes = ctr_drbg_unhex(v->entropy, entropy);
+    size_t nonce_nbytes = ctr_drbg_unhex(v->nonce, nonce);
+    size_t ps_nbytes = ctr_drbg_unhex(v->ps, ps);
+
+    custom->ctr_info = ccaes_ctr_crypt_mode();
+    custom->keylen = v->keylen;
+    custom->strictFIPS = 0;
+    custom->use_df = v->use_df;
+    custom->buffer_nbytes = buffer_nbytes;
+    ccdrbg_factory_nistctr(info, custom);
+
+    *drbg = malloc(ccdrbg_context_size(info));
+    if (*drbg == NULL) {
+        return -1;
+    }
+    return ccdrbg_init(info, *drbg, entropy_nbytes, entropy, nonce_nbytes, nonce, ps_nbytes, ps);
+}
+
+int TestCTRDRBG(void)
+{
+    struct ccdrbg_nistctr_custom custom;
+    struct ccdrbg_info info;
+    struct ccdrbg_state *drbg;
+    uint8_t add[CTR_DRBG_MAX_INPUT_NBYTES], expected[128], out[128];
+    int rv = 0;
+
+    for (size_t i = 0; i < sizeof(kCTRDRBGVectors) / sizeof(kCTRDRBGVectors[0]); i++) {
+        const struct CTR_DRBG_VECTOR *v = &kCTRDRBGVectors[i];
+        size_t out_nbytes = ctr_drbg_unhex(v->out, expected);
+        int bad = ctr_drbg_instantiate(&info, &custom, &drbg, v, 0);
+
+        if (drbg) {
+            bad |= ccdrbg_generate(&info, drbg, out_nbytes, out, ctr_drbg_unhex(v->add1, add), add);
+            bad |= ccdrbg_generate(&info, drbg, out_nbytes, out, ctr_drbg_unhex(v->add2, add), add);
+            bad |= memcmp(out, expected, out_nbytes);
+            ccdrbg_done(&info, drbg);
+            free(drbg);
+        }
+
+        if (bad) {
+            printf("CTR_DRBG MISMATCH!!! (%s)\n", v->name);
+            rv = -1;
+        } else {
+            printf("CTR_DRBG MATCH! (%s)\n", v->name);
+        }
+    }
+
+    /* 1, 2, 3, ... byte requests, the last one trimmed, out of a 128-byte buffer */
+    {
+        size_t out_nbytes = ctr_drbg_unhex(kCTRDRBGBufferedOut, expected);
+        int bad = ctr_drbg_instantiate(&info, &custom, &drbg, &kCTRDRBGVectors[0], sizeof(out));
+
+        if (drbg) {
+            for (size_t n = 1, off = 0; off < out_nbytes; off += n, n++) {
+                n = n < out_nbytes - off ? n : out_nbytes - off;
+                bad |= ccdrbg_generate(&info, drbg, n, out + off, 0, NULL);
+            }
+            bad |= memcmp(out, expected, out_nbytes);
+            ccdrbg_done(&info, drbg);
+            free(drbg);
+        }
+
+        if (bad) {
+            printf("CTR_DRBG MISMATCH!!! (buffered)\n");
+            rv = -1;
+        } else {
+            printf("CTR_DRBG MATCH! (buffered)\n");
+        }
+    }
+
+    return rv;
+}
@@ -0,0 +1,302 @@
+//
+//  gcm.c
+//  cctest
+//
+//  AES-GCM known answers from the GCM specification (McGrew and Viega,
+//  test cases 1-6 and 16), run through every GHASH and CTR path the build has.
+//
+
+#include <corecrypto/cc_runtime_config.h>
+#include <corecrypto/ccaes.h>
+#include <corecrypto/ccmode.h>
+#include <corecrypto/ccmode_factory.h>
+#include <corecrypto/ccmode_internal.h>
+#include <stdio.h>
+#include <string.h>
+
+struct GCM_VECTOR {
+    const char *name;
+    const char *key;
+    const char *iv;
+    const char *aad;
+    const char *pt;
+    const char *ct;
+    const char *tag;
+};
+
+#define GCM_TEST_KEY "feffe9928665731c6d6a8f9467308308"
+#define GCM_TEST_AAD "feedfacedeadbeeffeedfacedeadbeefabaddad2"
+#define GCM_TEST_PT60                                                    \
+    "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72" \
+    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39"
+
+static const struct GCM_VECTOR kGCMVectors[] = {
+    { "TC1, empty", "00000000000000000000000000000000", "000000000000000000000000", "", "", "",
+      "58e2fccefa7e3061367f1d57a4e7455a" },
+    { "TC2, one block", "00000000000000000000000000000000", "000000000000000000000000", "",
+      "00000000000000000000000000000000", "0388dace60b6a392f328c2b971b2fe78", "ab6e47d42cec13bdf53a67b21257bddf" },
+    { "TC3, four blocks", GCM_TEST_KEY, "cafebabefacedbaddecaf888", "", GCM_TEST_PT60 "1aafd255",
+      "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+      "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+      "4d5c2af327cd64a62cf35abd2ba6fab4" },
+    { "TC4, partial blocks", GCM_TEST_KEY, "cafebabefacedbaddecaf888", GCM_TEST_AAD, GCM_TEST_PT60,
+      "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+      "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+      "5bc94fbc3221a5db94fae95ae7121a47" },
+    { "TC5, 64-bit IV", GCM_TEST_KEY, "cafebabefacedbad", GCM_TEST_AAD, GCM_TEST_PT60,
+      "61353b4c2806934a777ff51fa22a4755699b2a714fcdc6f83766e5f97b6c7423"
+      "73806900e49f24b22b097544d4896b424989b5e1ebac0f07c23f4598",
+      "3612d2e79e3b0785561be14aaca2fccb" },
+    { "TC6, 480-bit IV", GCM_TEST_KEY,
+      "9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728"
+      "c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b",
+      GCM_TEST_AAD, GCM_TEST_PT60,
+      "8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca7"
+      "01e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5",
+      "619cc5aefffe0bfa462af43c1699d050" },
+    { "TC16, AES-256", GCM_TEST_KEY GCM_TEST_KEY, "cafebabefacedbaddecaf888", GCM_TEST_AAD, GCM_TEST_PT60,
+      "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+      "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+      "76fc6ece0f4e1768cddf8853bb2d551b" },
+};
+
+/*
+ * A message long enough for the 8-block GHASH aggregation and the stitched
+ * loop: key 00..0f, IV a0..ab, 37 bytes of AAD (3 * i + 2) and 517 bytes of
+ * text (7 * i + 1). Only the tag is stored, it covers the ciphertext.
+ */
+#define GCM_LONG_AAD_NBYTES 37
+#define GCM_LONG_NBYTES 517
+static const char *kGCMLongTag = "5fb71a19e04852c23f3f49a30f49d395";
+
+#define GCM_TEST_MAX_NBYTES 64
+#define GCM_TEST_NVECTORS (sizeof(kGCMVectors) / sizeof(kGCMVectors[0]))
+
+static uint8_t gcm_batch_iv[GCM_TEST_NVECTORS][GCM_TEST_MAX_NBYTES];
+static uint8_t gcm_batch_aad[GCM_TEST_NVECTORS][GCM_TEST_MAX_NBYTES];
+static uint8_t gcm_batch_in[GCM_TEST_NVECTORS][GCM_TEST_MAX_NBYTES];
+static uint8_t gcm_batch_out[GCM_TEST_NVECTORS][GCM_TEST_MAX_NBYTES];
+static uint8_t gcm_batch_tag[GCM_TEST_NVECTORS][CCGCM_BLOCK_NBYTES];
+
+struct GCM_PATH {
+    const char *name;
+    const struct ccmode_ecb *ecb;
+    int table; // replace the GHASH the init picked with the 4-bit table
+};
+
+static size_t gcm_unhex(const char *hex, uint8_t *out)
+{
+    size_t n = strlen(hex) / 2;
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        out[i] = (uint8_t)b;
+    }
+    return n;
+}
+
+static int gcm_test_init(const struct GCM_PATH *path, const struct ccmode_gcm *mode, ccgcm_ctx *ctx,
+                         size_t key_nbytes, const uint8_t *key)
+{
+    int rc = ccgcm_init(mode, ctx, key_nbytes, key);
+
+    if (rc == CCERR_OK && path->table) {
+        struct _ccmode_gcm_key *k = _CCMODE_GCM_KEY(ctx);
+
+        ccmode_gcm_gen_table(k);
+        k->ghash = ccmode_gcm_ghash_table;
+    }
+    return rc;
+}
+
+/* Streaming encryption with the AAD and the text each split at split, then decryption of the result. */
+static int gcm_test_split(const struct GCM_PATH *path, const struct ccmode_gcm *enc, const struct ccmode_gcm *dec,
+                          size_t key_nbytes, const uint8_t *key, size_t iv_nbytes, const uint8_t *iv,
+                          size_t aad_nbytes, const uint8_t *aad, size_t nbytes, const uint8_t *pt,
+                          const uint8_t *ct, const uint8_t *tag, size_t split)
+{
+    uint8_t out[GCM_LONG_NBYTES], back[GCM_LONG_NBYTES], t[CCGCM_BLOCK_NBYTES];
+    size_t asplit = split < aad_nbytes ? split : aad_nbytes;
+    size_t tsplit = split < nbytes ? split : nbytes;
+    int bad = 0;
+
+    ccgcm_ctx_decl(enc->size, ectx);
+    bad |= gcm_test_init(path, enc, ectx, key_nbytes, key);
+    bad |= ccgcm_set_iv(enc, ectx, iv_nbytes, iv);
+    bad |= ccgcm_aad(enc, ectx, asplit, aad);
+    bad |= ccgcm_aad(enc, ectx, aad_nbytes - asplit, aad + asplit);
+    bad |= ccgcm_update(enc, ectx, tsplit, pt, out);
+    bad |= ccgcm_update(enc, ectx, nbytes - tsplit, pt + tsplit, out + tsplit);
+    bad |= ccgcm_finalize(enc, ectx, sizeof(t), t);
+    ccgcm_ctx_clear(enc->size, ectx);
+    bad |= (ct && memcmp(out, ct, nbytes)) || memcmp(t, tag, sizeof(t));
+
+    ccgcm_ctx_decl(dec->size, dctx);
+    bad |= gcm_test_init(path, dec, dctx, key_nbytes, key);
+    bad |= ccgcm_set_iv(dec, dctx, iv_nbytes, iv);
+    bad |= ccgcm_aad(dec, dctx, aad_nbytes, aad);
+    bad |= ccgcm_update(dec, dctx, tsplit, out, back);
+    bad |= ccgcm_update(dec, dctx, nbytes - tsplit, out + tsplit, back + tsplit);
+    bad |= ccgcm_finalize(dec, dctx, sizeof(t), t);
+    ccgcm_ctx_clear(dec->size, dctx);
+    bad |= memcmp(back, pt, nbytes);
+
+    return bad;
+}
+
+static int gcm_test_path(const struct GCM_PATH *path)
+{
+    struct ccmode_gcm enc_mode, dec_mode;
+    const struct ccmode_gcm *enc = ccaes_gcm_encrypt_mode(), *dec = ccaes_gcm_decrypt_mode();
+    uint8_t key[32], iv[GCM_TEST_MAX_NBYTES], aad[GCM_LONG_AAD_NBYTES], pt[GCM_LONG_NBYTES];
+    uint8_t ct[GCM_LONG_NBYTES], out[GCM_LONG_NBYTES], tag[CCGCM_BLOCK_NBYTES], t[CCGCM_BLOCK_NBYTES];
+    struct ccgcm_packet packets[GCM_TEST_NVECTORS];
+    int results[GCM_TEST_NVECTORS];
+    size_t nbatch = 0;
+    int rv = 0;
+
+    if (path->ecb) {
+        ccmode_factory_gcm_encrypt(&enc_mode, path->ecb);
+        ccmode_factory_gcm_decrypt(&dec_mode, path->ecb);
+        enc = &enc_mode;
+        dec = &dec_mode;
+    }
+
+    for (size_t i = 0; i < GCM_TEST_NVECTORS; i++) {
+        const struct GCM_VECTOR *v = &kGCMVectors[i];
+        size_t key_nbytes = gcm_unhex(v->key, key), iv_nbytes = gcm_unhex(v->iv, iv);
+        size_t aad_nbytes = gcm_unhex(v->aad, aad), nbytes = gcm_unhex(v->pt, pt);
+        int bad = 0;
+
+        gcm_unhex(v->ct, ct);
+        gcm_unhex(v->tag, tag);
+
+        for (size_t split = 0; split <= nbytes || split <= aad_nbytes; split++) {
+            bad |= gcm_test_split(path, enc, dec, key_nbytes, key, iv_nbytes, iv, aad_nbytes, aad, nbytes, pt, ct, tag,
+                                  split);
+        }
+
+        /* the one-shot decryption takes the tag and must refuse it with a bit flipped */
+        memcpy(t, tag, sizeof(t));
+        bad |= ccgcm_one_shot(dec, key_nbytes, key, iv_nbytes, iv, aad_nbytes, aad, nbytes, ct, out, sizeof(t), t);
+        bad |= memcmp(out, pt, nbytes);
+        memcpy(t, tag, sizeof(t));
+        t[sizeof(t) - 1] ^= 0x80;
+        bad |= ccgcm_one_shot(dec, key_nbytes, key, iv_nbytes, iv, aad_nbytes, aad, nbytes, ct, out, sizeof(t), t) !=
+               CCMODE_INTEGRITY_FAILURE;
+
+        if (bad) {
+            printf("GCM MISMATCH!!! (%s, %s)\n", path->name, v->name);
+            rv = -1;
+        } else {
+            printf("GCM MATCH! (%s, %s)\n", path->name, v->name);
+        }
+    }
+
+    /* one batch over the test cases that share GCM_TEST_KEY, the last one with a forged tag */
+    for (size_t i = 0; i < GCM_TEST_NVECTORS; i++) {
+        const struct GCM_VECTOR *v = &kGCMVectors[i];
+        struct ccgcm_packet *p = &packets[nbatch];
+
+        if (strcmp(v->key, GCM_TEST_KEY)) {
+            continue;
+        }
+        p->iv_nbytes = gcm_unhex(v->iv, gcm_batch_iv[nbatch]);
+        p->iv = gcm_batch_iv[nbatch];
+        p->adata_nbytes = gcm_unhex(v->aad, gcm_batch_aad[nbatch]);
+        p->adata = gcm_batch_aad[nbatch];
+        p->nbytes = gcm_unhex(v->ct, gcm_batch_in[nbatch]);
+        p->in = gcm_batch_in[nbatch];
+        p->out = gcm_batch_out[nbatch];
+        p->tag = gcm_batch_tag[nbatch];
+        gcm_unhex(v->tag, gcm_batch_tag[nbatch]);
+        nbatch++;
+    }
+    gcm_batch_tag[nbatch - 1][0] ^= 1;
+    {
+        /* every plaintext under GCM_TEST_KEY is a prefix of TC3's */
+        size_t key_nbytes = gcm_unhex(GCM_TEST_KEY, key);
+        int bad = ccgcm_one_shot_batch(dec, key_nbytes, key, CCGCM_BLOCK_NBYTES, nbatch, packets, results) == 0;
+
+        gcm_unhex(kGCMVectors[2].pt, pt);
+        for (size_t i = 0; i < nbatch; i++) {
+            bad |= (i == nbatch - 1) ? results[i] != CCMODE_INTEGRITY_FAILURE : results[i] != CCERR_OK;
+            bad |= memcmp(gcm_batch_out[i], pt, packets[i].nbytes);
+        }
+
+        if (bad) {
+            printf("GCM MISMATCH!!! (%s, batch)\n", path->name);
+            rv = -1;
+        } else {
+            printf("GCM MATCH! (%s, batch)\n", path->name);
+        }
+    }
+
+    /* the long message, split so that both halves run whole 8-block batches and leave partial ones */
+    {
+        int bad = 0;
+
+        for (size_t i = 0; i < 16; i++) {
+            key[i] = (uint8_t)i;
+        }
+        for (size_t i = 0; i < 12; i++) {
+            iv[i] = (uint8_t)(0xa0 + i);
+        }
+        for (size_t i = 0; i < GCM_LONG_AAD_NBYTES; i++) {
+            aad[i] = (uint8_t)(3 * i + 2);
+        }
+        for (size_t i = 0; i < GCM_LONG_NBYTES; i++) {
+            pt[i] = (uint8_t)(7 * i + 1);
+        }
+        gcm_unhex(kGCMLongTag, tag);
+
+        for (size_t split = 0; split <= GCM_LONG_NBYTES; split += 47) {
+            bad |= gcm_test_split(path, enc, dec, 16, key, 12, iv, GCM_LONG_AAD_NBYTES, aad, GCM_LONG_NBYTES, pt,
+                                  NULL, tag, split);
+        }
+
+        if (bad) {
+            printf("GCM MISMATCH!!! (%s, 517 bytes)\n", path->name);
+            rv = -1;
+        } else {
+            printf("GCM MATCH! (%s, 517 bytes)\n", path->name);
+        }
+    }
+
+    return rv;
+}
+
+int TestGCM(void)
+{
+    const struct GCM_PATH paths[] = {
+        { "default", NULL, 0 },
+        { "LTC", &ccaes_ltc_ecb_encrypt_mode, 0 },
+        { "bitsliced", &ccaes_bitslice_ecb_encrypt_mode, 0 },
+#if CCMODE_GCM_VNG_SPEEDUP
+        { "LTC, 4-bit table", &ccaes_ltc_ecb_encrypt_mode, 1 },
+#endif
+    };
+    int rv = 0;
+
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        rv |= gcm_test_path(&paths[i]);
+    }
+
+#if CCAES_VPERM
+    if (CC_HAS_SupplementalSSE3()) {
+        const struct GCM_PATH vperm = { "vector permute", &ccaes_vperm_ecb_encrypt_mode, 0 };
+        rv |= gcm_test_path(&vperm);
+    }
+#endif
+
+#if CCMODE_GCM_VNG_SPEEDUP
+    /* the stitched AES-NI + PCLMULQDQ loop, picked by the factory for the AES-NI ECB */
+    if (CC_HAS_AESNI() && CC_HAS_PCLMULQDQ()) {
+        const struct GCM_PATH stitched = { "AES-NI stitched", &ccaes_intel_ecb_encrypt_aesni_mode, 0 };
+        rv |= gcm_test_path(&stitched);
+    }
+#endif
+
+    return rv;
+}
@@ -0,0 +1,160 @@
+//
+//  kprng.c
+//  cctest
+//
+//  Known answers for the Fortuna-style cckprng: output for a fixed seed and
+//  nonce, generators that do not disturb each other, and the scheduled
+//  reseed once pool 0 has CCKPRNG_RESEED_NSAMPLES samples.
+//
+
+#include <corecrypto/cckprng.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/kprng/cckprng_internal.h"
+
+#define KPRNG_TEST_NGENS 2
+
+/*
+ * Computed with an independent model (Python hashlib/hmac, AES-256-CTR from
+ * openssl) for seed 00..1f and nonce 80..87, with two generators:
+ * gen 0 asks for 7, then 256 bytes, gen 1 for 32, gen 0 for 33. Then a
+ * scheduled reseed, after which each generator asks for 32 bytes.
+ */
+static const char *kKPRNGOut[] = {
+    "8b43909c0bb1c5",
+    "e74f21c22e5ec1c6e1cce0b7763d1c10fc9c5e60046ea6052b887d6cdead6fc5"
+    "cfe8b8acd2aacb264c2146df134e4c49eb375acdc02cf03276819e19d1bbde69"
+    "d638ff7f85aa2252ecf0c6a2157a5a0a91e0aa8149b03645091175a2c423a746"
+    "f5c42d5391ab2109c99b585f3328fce31909792ea410a89738596feb6e23f8dd"
+    "af47ceed3cc93d5250fb32ee359a972e0b9308c0299a375bffc9cadae514ad83"
+    "d1e4535984b0bc830a75857d0b30ec21d60ade27c05f55d07b09b28d0588d461"
+    "47826c62a7782446d3c9f1530f3765f9cc40162a3bc9b7370804cb5b35c11c69"
+    "003d0ab14863a96821cbd432e088a5f0377748a7f4ce9829168a3373563c908c",
+    "8c8149b48a820f93cd8b3b87360da06ff4f39e6706489a1e47caea2796314e9c",
+    "14694931fd40946a0f0c476d21b3ec8fba18a8418b668962e33361d7db8bd04239",
+    "2fcdb61ab450f01b331c008a121a82bdbc4b49857606de32cbf1114398331869",
+    "06ad9e1fc4346ab5b16630a4c5a05a822afae52adebc9b8dbf258cb3f5caca6f",
+};
+
+static uint8_t kprng_test_seed[32];
+static uint8_t kprng_test_nonce[8];
+static uint8_t kprng_test_entropy[64];
+static uint32_t kprng_test_nsamples;
+
+static void kprng_test_init(struct cckprng_ctx *ctx, uint8_t nonce_xor)
+{
+    uint8_t nonce[sizeof(kprng_test_nonce)];
+
+    for (size_t i = 0; i < sizeof(kprng_test_seed); i++) {
+        kprng_test_seed[i] = (uint8_t)i;
+    }
+    for (size_t i = 0; i < sizeof(nonce); i++) {
+        nonce[i] = (uint8_t)(0x80 + i) ^ nonce_xor;
+    }
+    memset(kprng_test_entropy, 0, sizeof(kprng_test_entropy));
+    kprng_test_nsamples = 0;
+
+    cckprng_init(ctx, KPRNG_TEST_NGENS, sizeof(kprng_test_entropy), kprng_test_entropy, &kprng_test_nsamples,
+                 sizeof(kprng_test_seed), kprng_test_seed, sizeof(nonce), nonce);
+    for (unsigned i = 0; i < KPRNG_TEST_NGENS; i++) {
+        cckprng_initgen(ctx, i);
+    }
+}
+
+/* Generate nbytes from gen_idx and compare them with the hex string expected. */
+static int kprng_test_expect(struct cckprng_ctx *ctx, unsigned gen_idx, const char *expected)
+{
+    uint8_t out[CCKPRNG_GENERATE_MAX_NBYTES];
+    size_t nbytes = strlen(expected) / 2;
+
+    cckprng_generate(ctx, gen_idx, nbytes, out);
+    for (size_t i = 0; i < nbytes; i++) {
+        unsigned int b;
+        sscanf(expected + 2 * i, "%2x", &b);
+        if (out[i] != b) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void kprng_test_report(const char *name, int bad, int *rv)
+{
+    if (bad) {
+        printf("cckprng MISMATCH!!! (%s)\n", name);
+        *rv = -1;
+    } else {
+        printf("cckprng MATCH! (%s)\n", name);
+    }
+}
+
+int TestKPRNG(void)
+{
+    struct cckprng_ctx ctx, twin;
+    uint8_t a[32], b[32];
+    int rv = 0, bad;
+
+    /* the fixed seed and nonce give the model's output, generator requests interleaved */
+    kprng_test_init(&ctx, 0);
+    bad = kprng_test_expect(&ctx, 0, kKPRNGOut[0]);
+    bad |= kprng_test_expect(&ctx, 0, kKPRNGOut[1]);
+    bad |= kprng_test_expect(&ctx, 1, kKPRNGOut[2]);
+    bad |= kprng_test_expect(&ctx, 0, kKPRNGOut[3]);
+    kprng_test_report("fixed seed", bad, &rv);
+
+    /* generator 0 alone gives the same bytes: generator 1's requests did not touch it */
+    kprng_test_init(&twin, 0);
+    bad = kprng_test_expect(&twin, 0, kKPRNGOut[0]);
+    bad |= kprng_test_expect(&twin, 0, kKPRNGOut[1]);
+    bad |= kprng_test_expect(&twin, 0, kKPRNGOut[3]);
+    cckprng_done(&twin);
+
+    /* and another nonce gives other bytes */
+    kprng_test_init(&twin, 1);
+    cckprng_generate(&twin, 0, sizeof(a), a);
+    cckprng_generate(&twin, 1, sizeof(b), b);
+    bad |= memcmp(a, b, sizeof(a)) == 0;
+    cckprng_done(&twin);
+    kprng_test_init(&twin, 0);
+    cckprng_generate(&twin, 0, sizeof(b), b);
+    bad |= memcmp(a, b, sizeof(a)) == 0;
+    cckprng_done(&twin);
+    kprng_test_report("independent generators", bad, &rv);
+
+    /*
+     * 63 samples land in pool 0, then one more sample in each pool in turn.
+     * Only the 32nd of those, into pool 0 again, reaches the threshold.
+     */
+    for (size_t i = 0; i < sizeof(kprng_test_entropy); i++) {
+        kprng_test_entropy[i] = (uint8_t)i;
+    }
+    kprng_test_nsamples = CCKPRNG_RESEED_NSAMPLES - 1;
+    cckprng_refresh(&ctx);
+    bad = ctx.diag.pools[0].nsamples != CCKPRNG_RESEED_NSAMPLES - 1;
+
+    cckprng_refresh(&ctx);
+    bad |= ctx.sched.pool_idx != 1;
+
+    for (unsigned i = 1; i <= CCKPRNG_NPOOLS; i++) {
+        bad |= ctx.diag.schedreseed_nreseeds != 0;
+        kprng_test_entropy[0] = (uint8_t)i;
+        kprng_test_nsamples++;
+        cckprng_refresh(&ctx);
+    }
+
+    bad |= ctx.diag.schedreseed_nreseeds != 1;
+    bad |= ctx.diag.pools[0].ndrains != 1 || ctx.diag.pools[0].nsamples != 0;
+    bad |= ctx.diag.pools[1].ndrains != 0 || ctx.diag.pools[1].nsamples != 1;
+    for (unsigned i = 0; i < KPRNG_TEST_NGENS; i++) {
+        bad |= ctx.diag.gens[i].nrekeys != 1;
+    }
+    bad |= kprng_test_expect(&ctx, 0, kKPRNGOut[4]);
+    bad |= kprng_test_expect(&ctx, 1, kKPRNGOut[5]);
+    kprng_test_report("scheduled reseed", bad, &rv);
+
+    cckprng_done(&ctx);
+    kprng_test_report("done", ctx.gens != NULL || ctx.diag.gens != NULL, &rv);
+
+    return rv;
+}
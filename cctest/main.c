@@ -11,6 +11,18 @@
 #define CCTEST_MD2    0
 #define CCTEST_MD4    0
 #define CCTEST_RMD160 0
+#define CCTEST_SHA512 1
+#define CCTEST_SHA3   1
+#define CCTEST_CMAC   1
+#define CCTEST_MERKLE 1
+#define CCTEST_CTR_DRBG 1
+#define CCTEST_KPRNG  1
+#define CCTEST_CCZP   1
+#define CCTEST_GCM    1
+#define CCTEST_CCM    1
+#define CCTEST_XTS    1
+#define CCTEST_CHACHA20 1
+#define CCTEST_BENCH_HMAC_DRBG 1
 
 // fr gotta make more test cases
 #if CCTEST_MD2
@@ -22,19 +34,93 @@ extern int TestMD4(void);
 #if CCTEST_RMD160
 extern int TestRMD160(void);
 #endif
-
-extern void TestChaCha20(void);
+#if CCTEST_SHA512
+extern int TestSHA512(void);
+#endif
+#if CCTEST_SHA3
+extern int TestSHA3(void);
+#endif
+#if CCTEST_CMAC
+extern int TestCMAC(void);
+#endif
+#if CCTEST_MERKLE
+extern int TestMerkle(void);
+#endif
+#if CCTEST_CTR_DRBG
+extern int TestCTRDRBG(void);
+#endif
+#if CCTEST_KPRNG
+extern int TestKPRNG(void);
+#endif
+#if CCTEST_CCZP
+extern int TestCCZP(void);
+#endif
+#if CCTEST_GCM
+extern int TestGCM(void);
+#endif
+#if CCTEST_CCM
+extern int TestCCM(void);
+#endif
+#if CCTEST_XTS
+extern int TestXTS(void);
+#endif
+#if CCTEST_CHACHA20
+extern int TestChaCha20(void);
+#endif
+#if CCTEST_BENCH_HMAC_DRBG
+extern void BenchHMACDRBG(void);
+#endif
 
 int main(int argc, const char *argv[])
 {
+    int rv = 0;
     const struct cctest_info *ti = ccmd2_ti();
     cctest_ctx_decl(ti->size, md2);
 
     ti->init(ti, md2);
 
     if (ti->run(md2) == 0) {
-        printf("lmao it worked");
+        printf("lmao it worked\n");
+    } else {
+        rv = -1;
     }
 
-    return 0;
+#if CCTEST_SHA512
+    rv |= TestSHA512();
+#endif
+#if CCTEST_SHA3
+    rv |= TestSHA3();
+#endif
+#if CCTEST_CMAC
+    rv |= TestCMAC();
+#endif
+#if CCTEST_MERKLE
+    rv |= TestMerkle();
+#endif
+#if CCTEST_CTR_DRBG
+    rv |= TestCTRDRBG();
+#endif
+#if CCTEST_KPRNG
+    rv |= TestKPRNG();
+#endif
+#if CCTEST_CCZP
+    rv |= TestCCZP();
+#endif
+#if CCTEST_GCM
+    rv |= TestGCM();
+#endif
+#if CCTEST_CCM
+    rv |= TestCCM();
+#endif
+#if CCTEST_XTS
+    rv |= TestXTS();
+#endif
+#if CCTEST_CHACHA20
+    rv |= TestChaCha20();
+#endif
+#if CCTEST_BENCH_HMAC_DRBG
+    BenchHMACDRBG();
+#endif
+
+    return rv ? 1 : 0;
 }
@@ -0,0 +1,158 @@
+//
+//  merkle.c
+//  cctest
+//
+//  RFC 6962 Merkle Tree Hash known answers for ccmerkle over SHA-256, with
+//  audit paths checked for every leaf.
+//
+
+#include <corecrypto/cc_error.h>
+#include <corecrypto/ccmerkle.h>
+#include <corecrypto/ccsha2.h>
+#include <stdio.h>
+#include <string.h>
+
+/* The leaves of the certificate-transparency reference tests, taken in prefixes of 1 to 8. */
+static const struct {
+    size_t nbytes;
+    const uint8_t data[16];
+} kMerkleTestLeaves[8] = {
+    { 0, { 0 } },
+    { 1, { 0x00 } },
+    { 1, { 0x10 } },
+    { 2, { 0x20, 0x21 } },
+    { 2, { 0x30, 0x31 } },
+    { 4, { 0x40, 0x41, 0x42, 0x43 } },
+    { 8, { 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57 } },
+    { 16, { 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f } },
+};
+
+static const uint8_t kMerkleTestRoots[8][32] = {
+    { 0x6e, 0x34, 0x0b, 0x9c, 0xff, 0xb3, 0x7a, 0x98, 0x9c, 0xa5, 0x44, 0xe6, 0xbb, 0x78, 0x0a, 0x2c,
+      0x78, 0x90, 0x1d, 0x3f, 0xb3, 0x37, 0x38, 0x76, 0x85, 0x11, 0xa3, 0x06, 0x17, 0xaf, 0xa0, 0x1d },
+    { 0xfa, 0xc5, 0x42, 0x03, 0xe7, 0xcc, 0x69, 0x6c, 0xf0, 0xdf, 0xcb, 0x42, 0xc9, 0x2a, 0x1d, 0x9d,
+      0xba, 0xf7, 0x0a, 0xd9, 0xe6, 0x21, 0xf4, 0xbd, 0x8d, 0x98, 0x66, 0x2f, 0x00, 0xe3, 0xc1, 0x25 },
+    { 0xae, 0xb6, 0xbc, 0xfe, 0x27, 0x4b, 0x70, 0xa1, 0x4f, 0xb0, 0x67, 0xa5, 0xe5, 0x57, 0x82, 0x64,
+      0xdb, 0x0f, 0xa9, 0xb5, 0x1a, 0xf5, 0xe0, 0xba, 0x15, 0x91, 0x58, 0xf3, 0x29, 0xe0, 0x6e, 0x77 },
+    { 0xd3, 0x7e, 0xe4, 0x18, 0x97, 0x6d, 0xd9, 0x57, 0x53, 0xc1, 0xc7, 0x38, 0x62, 0xb9, 0x39, 0x8f,
+      0xa2, 0xa2, 0xcf, 0x9b, 0x4f, 0xf0, 0xfd, 0xfe, 0x8b, 0x30, 0xcd, 0x95, 0x20, 0x96, 0x14, 0xb7 },
+    { 0x4e, 0x3b, 0xbb, 0x1f, 0x7b, 0x47, 0x8d, 0xcf, 0xe7, 0x1f, 0xb6, 0x31, 0x63, 0x15, 0x19, 0xa3,
+      0xbc, 0xa1, 0x2c, 0x9a, 0xef, 0xca, 0x16, 0x12, 0xbf, 0xce, 0x4c, 0x13, 0xa8, 0x62, 0x64, 0xd4 },
+    { 0x76, 0xe6, 0x7d, 0xad, 0xbc, 0xdf, 0x1e, 0x10, 0xe1, 0xb7, 0x4d, 0xdc, 0x60, 0x8a, 0xbd, 0x2f,
+      0x98, 0xdf, 0xb1, 0x6f, 0xbc, 0xe7, 0x52, 0x77, 0xb5, 0x23, 0x2a, 0x12, 0x7f, 0x20, 0x87, 0xef },
+    { 0xdd, 0xb8, 0x9b, 0xe4, 0x03, 0x80, 0x9e, 0x32, 0x57, 0x50, 0xd3, 0xd2, 0x63, 0xcd, 0x78, 0x92,
+      0x9c, 0x29, 0x42, 0xb7, 0x94, 0x2a, 0x34, 0xb7, 0x7e, 0x12, 0x2c, 0x95, 0x94, 0xa7, 0x4c, 0x8c },
+    { 0x5d, 0xc9, 0xda, 0x79, 0xa7, 0x06, 0x59, 0xa9, 0xad, 0x55, 0x9c, 0xb7, 0x01, 0xde, 0xd9, 0xa2,
+      0xab, 0x9d, 0x82, 0x3a, 0xad, 0x2f, 0x49, 0x60, 0xcf, 0xe3, 0x70, 0xef, 0xf4, 0x60, 0x43, 0x28 },
+};
+
+/*
+ * 181 bytes of (13 * i + 5) cut into 5-byte leaves, so 37 leaves with a short
+ * last one: enough for more than one batch of ccdigest_multi_update() lanes.
+ * The second root is the same object with leaf 17 zeroed.
+ */
+#define MERKLE_OBJECT_NBYTES 181
+#define MERKLE_OBJECT_LEAF_NBYTES 5
+
+static const uint8_t kMerkleObjectRoot[32] = {
+    0x8c, 0xb1, 0x0a, 0xd9, 0xd8, 0x90, 0x6f, 0xba, 0xb1, 0xe3, 0xc7, 0x6a, 0x79, 0xf5, 0x00, 0x2c,
+    0x42, 0x71, 0xf6, 0xcd, 0xa2, 0x40, 0xe8, 0xbc, 0xc2, 0xcb, 0x9c, 0x45, 0x03, 0x21, 0x8d, 0x49
+};
+static const uint8_t kMerkleObjectUpdatedRoot[32] = {
+    0x90, 0xd4, 0x33, 0x44, 0x0a, 0xc1, 0x80, 0xe5, 0xc2, 0x7d, 0xce, 0x8f, 0x26, 0x19, 0xda, 0x17,
+    0xb4, 0xa4, 0x71, 0xcd, 0xbe, 0x7a, 0xbd, 0x8d, 0xff, 0xcd, 0xfa, 0xba, 0x33, 0x13, 0xd4, 0x8a
+};
+
+static uint8_t merkle_nodes[128 * 32];
+
+/* Every leaf's audit path must lead to the root, and a path with one bit flipped must not. */
+static int merkle_check_proofs(const struct ccmerkle_tree *tree)
+{
+    const struct ccdigest_info *di = tree->di;
+    uint8_t proof[16 * 32];
+
+    for (size_t leaf = 0; leaf < tree->nleaves; leaf++) {
+        const uint8_t *leaf_digest = ccmerkle_node(tree, 0, leaf);
+        size_t proof_nbytes = sizeof(proof);
+
+        if (ccmerkle_proof(tree, leaf, &proof_nbytes, proof) ||
+            ccmerkle_verify_proof(di, tree->nleaves, leaf, leaf_digest, proof_nbytes, proof, ccmerkle_root(tree))) {
+            return -1;
+        }
+        if (proof_nbytes) {
+            proof[proof_nbytes - 1] ^= 1;
+            if (ccmerkle_verify_proof(di, tree->nleaves, leaf, leaf_digest, proof_nbytes, proof,
+                                      ccmerkle_root(tree)) != CCERR_INTEGRITY) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int TestMerkle(void)
+{
+    const struct ccdigest_info *di = ccsha256_di();
+    struct ccmerkle_tree tree;
+    uint8_t object[MERKLE_OBJECT_NBYTES];
+    size_t split = 20 * MERKLE_OBJECT_LEAF_NBYTES;
+    int rv = 0;
+
+    /* the reference leaves differ in size, so their digests go straight into level 0 */
+    for (size_t n = 1; n <= 8; n++) {
+        int bad = 0;
+
+        if (ccmerkle_nodes_nbytes(di, n) > sizeof(merkle_nodes) ||
+            ccmerkle_init(&tree, di, sizeof(kMerkleTestLeaves[0].data), n, merkle_nodes)) {
+            bad = 1;
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                ccmerkle_hash_leaf(di, kMerkleTestLeaves[i].nbytes, kMerkleTestLeaves[i].data,
+                                   (uint8_t *)ccmerkle_node(&tree, 0, i));
+            }
+            if (ccmerkle_build(&tree) ||
+                memcmp(ccmerkle_root(&tree), kMerkleTestRoots[n - 1], sizeof(kMerkleTestRoots[0])) ||
+                merkle_check_proofs(&tree)) {
+                bad = 1;
+            }
+        }
+
+        if (bad) {
+            printf("Merkle MISMATCH!!! (%zu)\n", n);
+            rv = -1;
+        } else {
+            printf("Merkle MATCH! (%zu)\n", n);
+        }
+    }
+
+    /* a whole object through the batched leaf hashing, in two ranges, then a single leaf update */
+    for (size_t i = 0; i < sizeof(object); i++) {
+        object[i] = (uint8_t)(13 * i + 5);
+    }
+
+    if (ccmerkle_init(&tree, di, MERKLE_OBJECT_LEAF_NBYTES,
+                      ccmerkle_nleaves(MERKLE_OBJECT_LEAF_NBYTES, sizeof(object)), merkle_nodes) ||
+        ccmerkle_nodes_nbytes(di, tree.nleaves) > sizeof(merkle_nodes) ||
+        ccmerkle_hash_leaves(&tree, split / MERKLE_OBJECT_LEAF_NBYTES, sizeof(object) - split, object + split) ||
+        ccmerkle_hash_leaves(&tree, 0, split, object) ||
+        ccmerkle_build(&tree) ||
+        memcmp(ccmerkle_root(&tree), kMerkleObjectRoot, sizeof(kMerkleObjectRoot)) ||
+        merkle_check_proofs(&tree)) {
+        printf("Merkle MISMATCH!!! (object)\n");
+        rv = -1;
+    } else {
+        printf("Merkle MATCH! (object)\n");
+    }
+
+    memset(object + 17 * MERKLE_OBJECT_LEAF_NBYTES, 0, MERKLE_OBJECT_LEAF_NBYTES);
+    if (ccmerkle_update_leaf(&tree, 17, MERKLE_OBJECT_LEAF_NBYTES, object + 17 * MERKLE_OBJECT_LEAF_NBYTES) ||
+        memcmp(ccmerkle_root(&tree), kMerkleObjectUpdatedRoot, sizeof(kMerkleObjectUpdatedRoot)) ||
+        merkle_check_proofs(&tree)) {
+        printf("Merkle MISMATCH!!! (update)\n");
+        rv = -1;
+    } else {
+        printf("Merkle MATCH! (update)\n");
+    }
+
+    return rv;
+}
@@ -0,0 +1,288 @@
+//
+//  sha3.c
+//  cctest
+//
+//  FIPS 202 known answers for SHA3-224/256/384/512 and SHAKE128/256 on the
+//  empty message, "abc" and the 200-byte 0xa3 message from the NIST examples
+//  (more than one block at every rate), streamed through ccdigest/ccxof at odd
+//  splits. ccshake128_x4/ccshake256_x4 are checked against the scalar
+//  one-shots lane by lane.
+//
+
+#include <corecrypto/ccdigest.h>
+#include <corecrypto/ccsha2.h>
+#include <corecrypto/ccsha3.h>
+#include <corecrypto/ccxof.h>
+#include <stdio.h>
+#include <string.h>
+
+struct SHA3_VECTOR {
+    const char *name;
+    const struct ccdigest_info *(*di)(void);
+    const struct ccxof_info *(*xi)(void);
+    size_t msg;          /* index into kSHA3Messages */
+    const char *md;      /* SHAKE: the first 32 or 64 bytes of output */
+};
+
+struct SHA3_MESSAGE {
+    const char *name;
+    size_t len;
+};
+
+/* 0: empty, 1: "abc", 2: 200 bytes of 0xa3 */
+static const struct SHA3_MESSAGE kSHA3Messages[] = {
+    { "empty", 0 },
+    { "abc", 3 },
+    { "200 bytes", 200 },
+};
+
+static const struct SHA3_VECTOR kSHA3Vectors[] = {
+    { "SHA3-224", ccsha3_224_di, NULL, 0, "6b4e03423667dbb73b6e15454f0eb1abd4597f9a1b078e3f5b5a6bc7" },
+    { "SHA3-224", ccsha3_224_di, NULL, 1, "e642824c3f8cf24ad09234ee7d3c766fc9a3a5168d0c94ad73b46fdf" },
+    { "SHA3-224", ccsha3_224_di, NULL, 2, "9376816aba503f72f96ce7eb65ac095deee3be4bf9bbc2a1cb7e11e0" },
+    { "SHA3-256", ccsha3_256_di, NULL, 0, "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a" },
+    { "SHA3-256", ccsha3_256_di, NULL, 1, "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532" },
+    { "SHA3-256", ccsha3_256_di, NULL, 2, "79f38adec5c20307a98ef76e8324afbfd46cfd81b22e3973c65fa1bd9de31787" },
+    { "SHA3-384", ccsha3_384_di, NULL, 0,
+      "0c63a75b845e4f7d01107d852e4c2485c51a50aaaa94fc61995e71bbee983a2ac3713831264adb47fb6bd1e058d5f004" },
+    { "SHA3-384", ccsha3_384_di, NULL, 1,
+      "ec01498288516fc926459f58e2c6ad8df9b473cb0fc08c2596da7cf0e49be4b298d88cea927ac7f539f1edf228376d25" },
+    { "SHA3-384", ccsha3_384_di, NULL, 2,
+      "1881de2ca7e41ef95dc4732b8f5f002b189cc1e42b74168ed1732649ce1dbcdd76197a31fd55ee989f2d7050dd473e8f" },
+    { "SHA3-512", ccsha3_512_di, NULL, 0,
+      "a69f73cca23a9ac5c8b567dc185a756e97c982164fe25859e0d1dcc1475c80a6"
+      "15b2123af1f5f94c11e3e9402c3ac558f500199d95b6d3e301758586281dcd26" },
+    { "SHA3-512", ccsha3_512_di, NULL, 1,
+      "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e"
+      "10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0" },
+    { "SHA3-512", ccsha3_512_di, NULL, 2,
+      "e76dfad22084a8b1467fcf2ffa58361bec7628edf5f3fdc0e4805dc48caeeca8"
+      "1b7c13c30adf52a3659584739a2df46be589c51ca1a4a8416df6545a1ce8ba00" },
+    { "SHAKE128", NULL, ccshake128_xi, 0, "7f9c2ba4e88f827d616045507605853ed73b8093f6efbc88eb1a6eacfa66ef26" },
+    { "SHAKE128", NULL, ccshake128_xi, 1, "5881092dd818bf5cf8a3ddb793fbcba74097d5c526a6d35f97b83351940f2cc8" },
+    { "SHAKE128", NULL, ccshake128_xi, 2, "131ab8d2b594946b9c81333f9bb6e0ce75c3b93104fa3469d3917457385da037" },
+    { "SHAKE256", NULL, ccshake256_xi, 0,
+      "46b9dd2b0ba88d13233b3feb743eeb243fcd52ea62b81b82b50c27646ed5762f"
+      "d75dc4ddd8c0f200cb05019d67b592f6fc821c49479ab48640292eacb3b7c4be" },
+    { "SHAKE256", NULL, ccshake256_xi, 1,
+      "483366601360a8771c6863080cc4114d8db44530f8f1e1ee4f94ea37e78b5739"
+      "d5a15bef186a5386c75744c0527e1faa9f8726e462a12a4feb06bd8801e751e4" },
+    { "SHAKE256", NULL, ccshake256_xi, 2,
+      "cd8a920ed141aa0407a22d59288652e9d9f1a7ee0c1e7c1ca699424da84a904d"
+      "2d700caae7396ece96604440577da4f3aa22aeb8857f961c4cd8e06f0ae6610b" },
+};
+
+#define SHA3_TEST_NVECTORS (sizeof(kSHA3Vectors) / sizeof(kSHA3Vectors[0]))
+
+/* SHA-256 of the first 512 bytes of SHAKE128/SHAKE256 on the 200-byte message, several rate blocks of output */
+static const char kSHA3TestSHAKE128Long[] = "c1134ff48c4e5e770824f32bdcc5b4f80376fa3d2a957297ce5728780bb8551c";
+static const char kSHA3TestSHAKE256Long[] = "5324d170930075b539d5b2752dfe21dca1a2172f5fc7f48ab6f468162ab458ea";
+
+#define SHA3_TEST_LONG_NBYTES 512
+
+static size_t sha3_unhex(const char *hex, uint8_t *out)
+{
+    size_t n = strlen(hex) / 2;
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        out[i] = (uint8_t)b;
+    }
+
+    return n;
+}
+
+static const uint8_t *sha3_message(size_t msg)
+{
+    static uint8_t a3[200];
+
+    if (msg == 0) {
+        return (const uint8_t *)"";
+    } else if (msg == 1) {
+        return (const uint8_t *)"abc";
+    }
+
+    memset(a3, 0xa3, sizeof(a3));
+    return a3;
+}
+
+/* absorb in two updates split at split, then squeeze out_nbytes in pieces of step bytes */
+static void sha3_shake(const struct ccxof_info *xi, size_t len, const uint8_t *in, size_t split,
+                       size_t out_nbytes, uint8_t *out, size_t step)
+{
+    struct ccxof_ctx ctx;
+
+    ccxof_init(xi, &ctx);
+    ccxof_absorb(xi, &ctx, split, in);
+    ccxof_absorb(xi, &ctx, len - split, in + split);
+    for (size_t i = 0; i < out_nbytes; i += step) {
+        ccxof_squeeze(xi, &ctx, step < out_nbytes - i ? step : out_nbytes - i, out + i);
+    }
+}
+
+static int sha3_test_vectors(void)
+{
+    int rv = 0;
+
+    for (size_t i = 0; i < SHA3_TEST_NVECTORS; i++) {
+        const struct SHA3_VECTOR *v = &kSHA3Vectors[i];
+        const struct SHA3_MESSAGE *m = &kSHA3Messages[v->msg];
+        const uint8_t *in = sha3_message(v->msg);
+        uint8_t expected[64], md[64];
+        size_t md_len = sha3_unhex(v->md, expected);
+        size_t splits[] = { 0, 1, 71, 72, 73, 137, 168, 169, m->len };
+        int ok = 1;
+
+        for (size_t j = 0; j < sizeof(splits) / sizeof(splits[0]); j++) {
+            size_t split = splits[j] < m->len ? splits[j] : m->len;
+
+            memset(md, 0, sizeof(md));
+            if (v->di) {
+                const struct ccdigest_info *di = v->di();
+                ccdigest_di_decl(di, ctx);
+
+                ccdigest_init(di, ctx);
+                ccdigest_update(di, ctx, split, in);
+                ccdigest_update(di, ctx, m->len - split, in + split);
+                ccdigest_final(di, ctx, md);
+                ccdigest_di_clear(di, ctx);
+            } else {
+                sha3_shake(v->xi(), m->len, in, split, md_len, md, 1 + j);
+            }
+
+            if (memcmp(md, expected, md_len)) {
+                printf("%s MISMATCH!!! (%s, split %zu)\n", v->name, m->name, split);
+                ok = 0;
+            }
+        }
+
+        if (v->di) {
+            memset(md, 0, sizeof(md));
+            ccdigest(v->di(), m->len, in, md);
+            if (memcmp(md, expected, md_len)) {
+                printf("%s MISMATCH!!! (%s, one-shot)\n", v->name, m->name);
+                ok = 0;
+            }
+        } else {
+            memset(md, 0, sizeof(md));
+            if (v->xi == ccshake128_xi) {
+                ccshake128(m->len, in, md_len, md);
+            } else {
+                ccshake256(m->len, in, md_len, md);
+            }
+            if (memcmp(md, expected, md_len)) {
+                printf("%s MISMATCH!!! (%s, one-shot)\n", v->name, m->name);
+                ok = 0;
+            }
+        }
+
+        if (ok) {
+            printf("%s MATCH! (%s)\n", v->name, m->name);
+        } else {
+            rv = -1;
+        }
+    }
+
+    return rv;
+}
+
+/* output longer than a rate block, squeezed whole and in pieces that straddle the block boundaries */
+static int sha3_test_long_squeeze(void)
+{
+    static const size_t steps[] = { SHA3_TEST_LONG_NBYTES, 1, 7, 100, 136, 167, 168, 169 };
+    const uint8_t *in = sha3_message(2);
+    uint8_t out[SHA3_TEST_LONG_NBYTES], md[CCSHA256_OUTPUT_SIZE], expected[CCSHA256_OUTPUT_SIZE];
+    int rv = 0;
+
+    for (int shake = 0; shake < 2; shake++) {
+        const struct ccxof_info *xi = shake ? ccshake256_xi() : ccshake128_xi();
+        const char *name = shake ? "SHAKE256" : "SHAKE128";
+        int ok = 1;
+
+        sha3_unhex(shake ? kSHA3TestSHAKE256Long : kSHA3TestSHAKE128Long, expected);
+
+        for (size_t j = 0; j < sizeof(steps) / sizeof(steps[0]); j++) {
+            memset(out, 0, sizeof(out));
+            sha3_shake(xi, 200, in, 100, sizeof(out), out, steps[j]);
+            ccdigest(ccsha256_di(), sizeof(out), out, md);
+            if (memcmp(md, expected, sizeof(md))) {
+                printf("%s MISMATCH!!! (512 byte output, step %zu)\n", name, steps[j]);
+                ok = 0;
+            }
+        }
+
+        if (ok) {
+            printf("%s MATCH! (512 byte output)\n", name);
+        } else {
+            rv = -1;
+        }
+    }
+
+    return rv;
+}
+
+/* each lane of the 4-way SHAKE has to equal a scalar SHAKE of the same input */
+static int sha3_test_x4(void)
+{
+    static const size_t in_lens[] = { 0, 1, 135, 136, 137, 167, 168, 169, 400 };
+    static const size_t out_lens[] = { 1, 32, 136, 168, 300 };
+    static uint8_t in[4][400], out[4][300], ref[300];
+    int rv = 0;
+
+    for (size_t l = 0; l < 4; l++) {
+        for (size_t i = 0; i < sizeof(in[l]); i++) {
+            in[l][i] = (uint8_t)(i * 7 + l * 61 + 1);
+        }
+    }
+
+    for (int shake = 0; shake < 2; shake++) {
+        const char *name = shake ? "SHAKE256" : "SHAKE128";
+        int ok = 1;
+
+        for (size_t a = 0; a < sizeof(in_lens) / sizeof(in_lens[0]); a++) {
+            for (size_t b = 0; b < sizeof(out_lens) / sizeof(out_lens[0]); b++) {
+                const void *const ins[4] = { in[0], in[1], in[2], in[3] };
+                void *const outs[4] = { out[0], out[1], out[2], out[3] };
+
+                memset(out, 0, sizeof(out));
+                if (shake) {
+                    ccshake256_x4(in_lens[a], ins, out_lens[b], outs);
+                } else {
+                    ccshake128_x4(in_lens[a], ins, out_lens[b], outs);
+                }
+
+                for (size_t l = 0; l < 4; l++) {
+                    if (shake) {
+                        ccshake256(in_lens[a], in[l], out_lens[b], ref);
+                    } else {
+                        ccshake128(in_lens[a], in[l], out_lens[b], ref);
+                    }
+                    if (memcmp(out[l], ref, out_lens[b])) {
+                        printf("%s MISMATCH!!! (x4, lane %zu, in %zu, out %zu)\n", name, l, in_lens[a], out_lens[b]);
+                        ok = 0;
+                    }
+                }
+            }
+        }
+
+        if (ok) {
+            printf("%s MATCH! (x4)\n", name);
+        } else {
+            rv = -1;
+        }
+    }
+
+    return rv;
+}
+
+int TestSHA3(void)
+{
+    int rv = 0;
+
+    rv |= sha3_test_vectors();
+    rv |= sha3_test_long_squeeze();
+    rv |= sha3_test_x4();
+
+    return rv;
+}
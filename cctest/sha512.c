@@ -0,0 +1,135 @@
+//
+//  sha512.c
+//  cctest
+//
+//  Known answers for the LTC SHA-384, SHA-512 and SHA-512/224. These catch the
+//  SHA-256 IV in ccsha512_ltc_di, a compress that only ran the first of
+//  nblocks, and the 4-byte output stride in ccsha512_final.
+//
+
+#include <corecrypto/ccdigest.h>
+#include <corecrypto/ccsha2.h>
+#include <stdio.h>
+#include <string.h>
+
+struct SHA512_VECTOR {
+    const char *name;
+    const struct ccdigest_info *di;
+    const char *msg;      /* NULL: a message of msg_len 'a' bytes */
+    size_t msg_len;
+    const uint8_t *md;
+};
+
+/* 112 bytes: the length no longer fits in the first block, so final() compresses two. */
+static const char kSHA512TestTwoBlockMsg[] = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+static const uint8_t kSHA512TestSHA384Abc[] = {
+    0xcb, 0x00, 0x75, 0x3f, 0x45, 0xa3, 0x5e, 0x8b, 0xb5, 0xa0, 0x3d, 0x69, 0x9a, 0xc6, 0x50, 0x07,
+    0x27, 0x2c, 0x32, 0xab, 0x0e, 0xde, 0xd1, 0x63, 0x1a, 0x8b, 0x60, 0x5a, 0x43, 0xff, 0x5b, 0xed,
+    0x80, 0x86, 0x07, 0x2b, 0xa1, 0xe7, 0xcc, 0x23, 0x58, 0xba, 0xec, 0xa1, 0x34, 0xc8, 0x25, 0xa7
+};
+
+static const uint8_t kSHA512TestSHA384TwoBlock[] = {
+    0x09, 0x33, 0x0c, 0x33, 0xf7, 0x11, 0x47, 0xe8, 0x3d, 0x19, 0x2f, 0xc7, 0x82, 0xcd, 0x1b, 0x47,
+    0x53, 0x11, 0x1b, 0x17, 0x3b, 0x3b, 0x05, 0xd2, 0x2f, 0xa0, 0x80, 0x86, 0xe3, 0xb0, 0xf7, 0x12,
+    0xfc, 0xc7, 0xc7, 0x1a, 0x55, 0x7e, 0x2d, 0xb9, 0x66, 0xc3, 0xe9, 0xfa, 0x91, 0x74, 0x60, 0x39
+};
+
+static const uint8_t kSHA512TestSHA384Thousand[] = {
+    0xf5, 0x44, 0x80, 0x68, 0x9c, 0x6b, 0x0b, 0x11, 0xd0, 0x30, 0x32, 0x85, 0xd9, 0xa8, 0x1b, 0x21,
+    0xa9, 0x3b, 0xca, 0x6b, 0xa5, 0xa1, 0xb4, 0x47, 0x27, 0x65, 0xdc, 0xa4, 0xda, 0x45, 0xee, 0x32,
+    0x80, 0x82, 0xd4, 0x69, 0xc6, 0x50, 0xcd, 0x3b, 0x61, 0xb1, 0x6d, 0x32, 0x66, 0xab, 0x8c, 0xed
+};
+
+static const uint8_t kSHA512TestSHA512Abc[] = {
+    0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba, 0xcc, 0x41, 0x73, 0x49, 0xae, 0x20, 0x41, 0x31,
+    0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2, 0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a,
+    0x21, 0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8, 0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+    0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e, 0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f
+};
+
+static const uint8_t kSHA512TestSHA512TwoBlock[] = {
+    0x8e, 0x95, 0x9b, 0x75, 0xda, 0xe3, 0x13, 0xda, 0x8c, 0xf4, 0xf7, 0x28, 0x14, 0xfc, 0x14, 0x3f,
+    0x8f, 0x77, 0x79, 0xc6, 0xeb, 0x9f, 0x7f, 0xa1, 0x72, 0x99, 0xae, 0xad, 0xb6, 0x88, 0x90, 0x18,
+    0x50, 0x1d, 0x28, 0x9e, 0x49, 0x00, 0xf7, 0xe4, 0x33, 0x1b, 0x99, 0xde, 0xc4, 0xb5, 0x43, 0x3a,
+    0xc7, 0xd3, 0x29, 0xee, 0xb6, 0xdd, 0x26, 0x54, 0x5e, 0x96, 0xe5, 0x5b, 0x87, 0x4b, 0xe9, 0x09
+};
+
+static const uint8_t kSHA512TestSHA512Thousand[] = {
+    0x67, 0xba, 0x55, 0x35, 0xa4, 0x6e, 0x3f, 0x86, 0xdb, 0xfb, 0xed, 0x8c, 0xbb, 0xaf, 0x01, 0x25,
+    0xc7, 0x6e, 0xd5, 0x49, 0xff, 0x8b, 0x0b, 0x9e, 0x03, 0xe0, 0xc8, 0x8c, 0xf9, 0x0f, 0xa6, 0x34,
+    0xfa, 0x7b, 0x12, 0xb4, 0x7d, 0x77, 0xb6, 0x94, 0xde, 0x48, 0x8a, 0xce, 0x8d, 0x9a, 0x65, 0x96,
+    0x7d, 0xc9, 0x6d, 0xf5, 0x99, 0x72, 0x7d, 0x32, 0x92, 0xa8, 0xd9, 0xd4, 0x47, 0x70, 0x9c, 0x97
+};
+
+static const uint8_t kSHA512TestSHA512_224Abc[] = {
+    0x46, 0x34, 0x27, 0x0f, 0x70, 0x7b, 0x6a, 0x54, 0xda, 0xae, 0x75, 0x30, 0x46, 0x08, 0x42, 0xe2,
+    0x0e, 0x37, 0xed, 0x26, 0x5c, 0xee, 0xe9, 0xa4, 0x3e, 0x89, 0x24, 0xaa
+};
+
+static const uint8_t kSHA512TestSHA512_224TwoBlock[] = {
+    0x23, 0xfe, 0xc5, 0xbb, 0x94, 0xd6, 0x0b, 0x23, 0x30, 0x81, 0x92, 0x64, 0x0b, 0x0c, 0x45, 0x33,
+    0x35, 0xd6, 0x64, 0x73, 0x4f, 0xe4, 0x0e, 0x72, 0x68, 0x67, 0x4a, 0xf9
+};
+
+static const uint8_t kSHA512TestSHA512_224Thousand[] = {
+    0xff, 0xdf, 0xa2, 0x84, 0xae, 0x9e, 0x56, 0x22, 0x22, 0xe2, 0xa3, 0x7c, 0xd6, 0x83, 0x82, 0x3f,
+    0x7e, 0x66, 0x9f, 0x36, 0x36, 0x47, 0x77, 0x01, 0xf4, 0xce, 0x9a, 0xbe
+};
+
+static const struct SHA512_VECTOR kSHA512Vectors[] = {
+    { "SHA-384", &ccsha384_ltc_di, "abc", 3, kSHA512TestSHA384Abc },
+    { "SHA-384", &ccsha384_ltc_di, kSHA512TestTwoBlockMsg, 112, kSHA512TestSHA384TwoBlock },
+    { "SHA-384", &ccsha384_ltc_di, NULL, 1000, kSHA512TestSHA384Thousand },
+    { "SHA-512", &ccsha512_ltc_di, "abc", 3, kSHA512TestSHA512Abc },
+    { "SHA-512", &ccsha512_ltc_di, kSHA512TestTwoBlockMsg, 112, kSHA512TestSHA512TwoBlock },
+    { "SHA-512", &ccsha512_ltc_di, NULL, 1000, kSHA512TestSHA512Thousand },
+    { "SHA-512/224", &ccsha512_224_ltc_di, "abc", 3, kSHA512TestSHA512_224Abc },
+    { "SHA-512/224", &ccsha512_224_ltc_di, kSHA512TestTwoBlockMsg, 112, kSHA512TestSHA512_224TwoBlock },
+    { "SHA-512/224", &ccsha512_224_ltc_di, NULL, 1000, kSHA512TestSHA512_224Thousand },
+};
+
+/*
+ * Each message is hashed in one update, so the 1000-byte one hands the
+ * compress seven whole blocks at once, and again split at odd offsets.
+ */
+int TestSHA512(void)
+{
+    static uint8_t msg[1000];
+    int rv = 0;
+
+    for (size_t i = 0; i < sizeof(kSHA512Vectors) / sizeof(kSHA512Vectors[0]); i++) {
+        const struct SHA512_VECTOR *v = &kSHA512Vectors[i];
+        const struct ccdigest_info *di = v->di;
+        const uint8_t *in = (const uint8_t *)v->msg;
+        uint8_t md[CCSHA512_OUTPUT_SIZE];
+        size_t splits[] = { v->msg_len, 1, 129, 300 };
+
+        if (in == NULL) {
+            memset(msg, 'a', v->msg_len);
+            in = msg;
+        }
+
+        for (size_t j = 0; j < sizeof(splits) / sizeof(splits[0]); j++) {
+            size_t split = splits[j] < v->msg_len ? splits[j] : v->msg_len;
+            ccdigest_di_decl(di, ctx);
+
+            ccdigest_init(di, ctx);
+            ccdigest_update(di, ctx, split, in);
+            ccdigest_update(di, ctx, v->msg_len - split, in + split);
+            ccdigest_final(di, ctx, md);
+            ccdigest_di_clear(di, ctx);
+
+            if (memcmp(md, v->md, di->output_size)) {
+                printf("%s MISMATCH!!! (%zu, split %zu)\n", v->name, i, split);
+                rv = -1;
+            }
+        }
+
+        if (rv == 0) {
+            printf("%s MATCH! (%zu)\n", v->name, i);
+        }
+    }
+
+    return rv;
+}
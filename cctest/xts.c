@@ -0,0 +1,304 @@
+//
+//  xts.c
+//  cctest
+//
+//  XTS-AES known answers from IEEE 1619-2007 (vectors 1-4 and 10, and the
+//  partial last blocks of vectors 15-18 through ccpad_xts), through every
+//  ECB path the build has, and ccxts_update_sectors() against one
+//  ccxts_set_tweak()/ccxts_update() pair per sector.
+//
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_runtime_config.h>
+#include <corecrypto/ccaes.h>
+#include <corecrypto/ccmode.h>
+#include <corecrypto/ccmode_factory.h>
+#include <corecrypto/ccpad.h>
+#include <corecrypto/ccsha2.h>
+#include <stdio.h>
+#include <string.h>
+
+struct XTS_VECTOR {
+    const char *name;
+    const char *key1; // data key
+    const char *key2; // tweak key
+    uint64_t data_unit;
+    const char *pt;
+    const char *ct;
+};
+
+#define XTS_V15_KEY1 "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"
+#define XTS_V15_KEY2 "bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0"
+
+static const struct XTS_VECTOR kXTSVectors[] = {
+    { "vector 1", "00000000000000000000000000000000", "00000000000000000000000000000000", 0,
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      "917cf69ebd68b2ec9b9fe9a3eadda692cd43d2f59598ed858c02c2652fbf922e" },
+    { "vector 2", "11111111111111111111111111111111", "22222222222222222222222222222222", 0x3333333333,
+      "4444444444444444444444444444444444444444444444444444444444444444",
+      "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0" },
+    { "vector 3", "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0", "22222222222222222222222222222222", 0x3333333333,
+      "4444444444444444444444444444444444444444444444444444444444444444",
+      "af85336b597afc1a900b2eb21ec949d292df4c047e0b21532186a5971a227a89" },
+    { "vector 15", XTS_V15_KEY1, XTS_V15_KEY2, 0x123456789a, "000102030405060708090a0b0c0d0e0f10",
+      "6c1625db4671522d3d7599601de7ca09ed" },
+    { "vector 16", XTS_V15_KEY1, XTS_V15_KEY2, 0x123456789a, "000102030405060708090a0b0c0d0e0f1011",
+      "d069444b7a7e0cab09e24447d24deb1fedbf" },
+    { "vector 17", XTS_V15_KEY1, XTS_V15_KEY2, 0x123456789a, "000102030405060708090a0b0c0d0e0f101112",
+      "e5df1351c0544ba1350b3363cd8ef4beedbf9d" },
+    { "vector 18", XTS_V15_KEY1, XTS_V15_KEY2, 0x123456789a, "000102030405060708090a0b0c0d0e0f10111213",
+      "9d84c813f719aa2c7be3f66171c7c5c2edbf9dac" },
+};
+
+#define XTS_TEST_NVECTORS (sizeof(kXTSVectors) / sizeof(kXTSVectors[0]))
+
+/* The 512-byte vectors, plaintext 00..ff twice, checked through the SHA-256 of the ciphertext. */
+static const struct XTS_VECTOR kXTSLongVectors[] = {
+    { "vector 4", "27182818284590452353602874713526", "31415926535897932384626433832795", 0, NULL,
+      "ebee4d64dd2395bb2d6a2d37a0a48ecb2bf4913cfc99d27c2214f2f4144715ea" },
+    { "vector 10", "2718281828459045235360287471352662497757247093699959574966967627",
+      "3141592653589793238462643383279502884197169399375105820974944592", 0xff, NULL,
+      "e97e974fa393af794f7a4684395814cf820de60a01eaec677d87b452e316b364" },
+};
+
+#define XTS_TEST_NLONG (sizeof(kXTSLongVectors) / sizeof(kXTSLongVectors[0]))
+
+#define XTS_TEST_MAX_NBYTES 32
+#define XTS_LONG_NBYTES 512
+#define XTS_SECTORS_NBYTES 8192
+
+struct XTS_PATH {
+    const char *name;
+    const struct ccmode_xts *enc;
+    const struct ccmode_xts *dec;
+};
+
+static size_t xts_unhex(const char *hex, uint8_t *out)
+{
+    size_t n = strlen(hex) / 2;
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        out[i] = (uint8_t)b;
+    }
+    return n;
+}
+
+/* the IEEE 1619 tweak input: the data unit number, little-endian */
+static void xts_data_unit_iv(uint64_t data_unit, uint8_t *iv)
+{
+    memset(iv, 0, 16);
+    for (size_t i = 0; i < 8; i++) {
+        iv[i] = (uint8_t)(data_unit >> (8 * i));
+    }
+}
+
+/*
+ * One data unit through ccpad_xts, or for whole blocks through two ccxts_update() calls split after split blocks,
+ * which must pick up the tweak where the first one left it.
+ */
+static int xts_test_pass(const struct ccmode_xts *mode, int decrypt, size_t key_nbytes, const uint8_t *key1,
+                         const uint8_t *key2, uint64_t data_unit, size_t nbytes, const uint8_t *in, uint8_t *out,
+                         size_t split)
+{
+    uint8_t iv[16];
+    int rc;
+
+    ccxts_ctx_decl(mode->size, ctx);
+    ccxts_tweak_decl(mode->tweak_size, tweak);
+    xts_data_unit_iv(data_unit, iv);
+    rc = ccxts_init(mode, ctx, key_nbytes, key1, key2);
+    rc |= ccxts_set_tweak(mode, ctx, tweak, iv);
+    if (nbytes % 16) {
+        if (decrypt) {
+            rc |= ccpad_xts_decrypt(mode, ctx, tweak, nbytes, in, out) != nbytes;
+        } else {
+            ccpad_xts_encrypt(mode, ctx, tweak, nbytes, in, out);
+        }
+    } else {
+        if (split) {
+            rc |= ccxts_update(mode, ctx, tweak, split, in, out) == NULL;
+        }
+        if (split < nbytes / 16) {
+            rc |= ccxts_update(mode, ctx, tweak, nbytes / 16 - split, in + 16 * split, out + 16 * split) == NULL;
+        }
+    }
+    ccxts_ctx_clear(mode->size, ctx);
+    ccxts_tweak_clear(mode->tweak_size, tweak);
+
+    return rc;
+}
+
+static void xts_test_report(const char *path, const char *name, int bad, int *rv)
+{
+    if (bad) {
+        printf("XTS MISMATCH!!! (%s, %s)\n", path, name);
+        *rv = -1;
+    } else {
+        printf("XTS MATCH! (%s, %s)\n", path, name);
+    }
+}
+
+/* Anything shorter than a block has nothing to steal from: ccpad_xts leaves the output alone. */
+static int xts_test_short(const struct XTS_PATH *path)
+{
+    uint8_t key[16] = { 0 }, iv[16] = { 0 }, in[15] = { 0 }, out[15];
+    int bad = 0;
+
+    ccxts_ctx_decl(path->enc->size, ctx);
+    ccxts_tweak_decl(path->enc->tweak_size, tweak);
+    bad |= ccxts_init(path->enc, ctx, sizeof(key), key, key);
+    bad |= ccxts_set_tweak(path->enc, ctx, tweak, iv);
+    memset(out, 0xa5, sizeof(out));
+    ccpad_xts_encrypt(path->enc, ctx, tweak, sizeof(in), in, out);
+    for (size_t i = 0; i < sizeof(out); i++) {
+        bad |= out[i] != 0xa5;
+    }
+    ccxts_ctx_clear(path->enc->size, ctx);
+
+    bad |= ccxts_init(path->dec, ctx, sizeof(key), key, key);
+    bad |= ccxts_set_tweak(path->dec, ctx, tweak, iv);
+    bad |= ccpad_xts_decrypt(path->dec, ctx, tweak, sizeof(in), in, out) != 0;
+    for (size_t i = 0; i < sizeof(out); i++) {
+        bad |= out[i] != 0xa5;
+    }
+    ccxts_ctx_clear(path->dec->size, ctx);
+    ccxts_tweak_clear(path->enc->tweak_size, tweak);
+
+    return bad;
+}
+
+/* Whole sectors of several sizes, from a data unit just short of 2^32 so the tweak input carries. */
+static int xts_test_sectors(const struct ccmode_xts *mode, const uint8_t *key1, const uint8_t *key2)
+{
+    static const size_t sector_sizes[] = { 16, 48, 512, 4096 };
+    static uint8_t in[XTS_SECTORS_NBYTES], batched[XTS_SECTORS_NBYTES], single[XTS_SECTORS_NBYTES];
+    const uint64_t first = 0xfffffffe;
+    uint8_t iv[16];
+    int bad = 0;
+
+    for (size_t i = 0; i < sizeof(in); i++) {
+        in[i] = (uint8_t)(5 * i + 3);
+    }
+
+    ccxts_ctx_decl(mode->size, ctx);
+    ccxts_tweak_decl(mode->tweak_size, tweak);
+    bad |= ccxts_init(mode, ctx, 16, key1, key2);
+
+    for (size_t s = 0; s < sizeof(sector_sizes) / sizeof(sector_sizes[0]); s++) {
+        size_t sector_nbytes = sector_sizes[s];
+        size_t nbytes = sector_nbytes * (sizeof(in) / sector_nbytes);
+
+        bad |= ccxts_update_sectors(mode, ctx, first, sector_nbytes, nbytes, in, batched);
+        for (size_t off = 0; off < nbytes; off += sector_nbytes) {
+            xts_data_unit_iv(first + off / sector_nbytes, iv);
+            bad |= ccxts_set_tweak(mode, ctx, tweak, iv);
+            bad |= ccxts_update(mode, ctx, tweak, sector_nbytes / 16, in + off, single + off) == NULL;
+        }
+        bad |= memcmp(batched, single, nbytes) != 0;
+    }
+
+    ccxts_ctx_clear(mode->size, ctx);
+    ccxts_tweak_clear(mode->tweak_size, tweak);
+
+    return bad;
+}
+
+static int xts_test_path(const struct XTS_PATH *path)
+{
+    uint8_t key1[32], key2[32], pt[XTS_LONG_NBYTES], ct[XTS_LONG_NBYTES], back[XTS_LONG_NBYTES];
+    uint8_t expected[XTS_TEST_MAX_NBYTES], digest[CCSHA256_OUTPUT_SIZE];
+    int rv = 0;
+
+    for (size_t i = 0; i < XTS_TEST_NVECTORS; i++) {
+        const struct XTS_VECTOR *v = &kXTSVectors[i];
+        size_t key_nbytes = xts_unhex(v->key1, key1);
+        size_t nbytes = xts_unhex(v->pt, pt);
+        size_t nsplits = nbytes % 16 ? 0 : nbytes / 16;
+        int bad = 0;
+
+        xts_unhex(v->key2, key2);
+        xts_unhex(v->ct, expected);
+        for (size_t split = 0; split <= nsplits; split++) {
+            bad |= xts_test_pass(path->enc, 0, key_nbytes, key1, key2, v->data_unit, nbytes, pt, ct, split);
+            bad |= memcmp(ct, expected, nbytes) != 0;
+            bad |= xts_test_pass(path->dec, 1, key_nbytes, key1, key2, v->data_unit, nbytes, ct, back, split);
+            bad |= memcmp(back, pt, nbytes) != 0;
+        }
+        xts_test_report(path->name, v->name, bad, &rv);
+    }
+
+    for (size_t i = 0; i < XTS_TEST_NLONG; i++) {
+        const struct XTS_VECTOR *v = &kXTSLongVectors[i];
+        size_t key_nbytes = xts_unhex(v->key1, key1);
+        int bad = 0;
+
+        xts_unhex(v->key2, key2);
+        for (size_t j = 0; j < XTS_LONG_NBYTES; j++) {
+            pt[j] = (uint8_t)j;
+        }
+        for (size_t split = 0; split <= XTS_LONG_NBYTES / 16; split += 3) {
+            bad |= xts_test_pass(path->enc, 0, key_nbytes, key1, key2, v->data_unit, XTS_LONG_NBYTES, pt, ct, split);
+            ccdigest(ccsha256_di(), XTS_LONG_NBYTES, ct, digest);
+            xts_unhex(v->ct, expected);
+            bad |= memcmp(digest, expected, sizeof(digest)) != 0;
+            bad |= xts_test_pass(path->dec, 1, key_nbytes, key1, key2, v->data_unit, XTS_LONG_NBYTES, ct, back, split);
+            bad |= memcmp(back, pt, XTS_LONG_NBYTES) != 0;
+        }
+        xts_test_report(path->name, v->name, bad, &rv);
+    }
+
+    xts_test_report(path->name, "short input", xts_test_short(path), &rv);
+
+    xts_unhex(kXTSLongVectors[0].key1, key1);
+    xts_unhex(kXTSLongVectors[0].key2, key2);
+    xts_test_report(path->name, "sectors",
+                    xts_test_sectors(path->enc, key1, key2) | xts_test_sectors(path->dec, key1, key2), &rv);
+
+    return rv;
+}
+
+int TestXTS(void)
+{
+    static struct ccmode_xts ltc_enc, ltc_dec, bs_enc, bs_dec;
+    int rv = 0;
+
+    ccmode_factory_xts_encrypt(&ltc_enc, &ccaes_ltc_ecb_encrypt_mode, &ccaes_ltc_ecb_encrypt_mode);
+    ccmode_factory_xts_decrypt(&ltc_dec, &ccaes_ltc_ecb_decrypt_mode, &ccaes_ltc_ecb_encrypt_mode);
+    ccmode_factory_xts_encrypt(&bs_enc, &ccaes_bitslice_ecb_encrypt_mode, &ccaes_bitslice_ecb_encrypt_mode);
+    ccmode_factory_xts_decrypt(&bs_dec, &ccaes_bitslice_ecb_decrypt_mode, &ccaes_bitslice_ecb_encrypt_mode);
+
+    {
+        const struct XTS_PATH paths[] = {
+            { "default", ccaes_xts_encrypt_mode(), ccaes_xts_decrypt_mode() },
+            { "LTC", &ltc_enc, &ltc_dec },
+            { "bitsliced", &bs_enc, &bs_dec },
+        };
+
+        for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+            rv |= xts_test_path(&paths[i]);
+        }
+    }
+
+#if CCAES_VPERM
+    if (CC_HAS_SupplementalSSE3()) {
+        static struct ccmode_xts vp_enc, vp_dec;
+
+        ccmode_factory_xts_encrypt(&vp_enc, &ccaes_vperm_ecb_encrypt_mode, &ccaes_vperm_ecb_encrypt_mode);
+        ccmode_factory_xts_decrypt(&vp_dec, &ccaes_vperm_ecb_decrypt_mode, &ccaes_vperm_ecb_encrypt_mode);
+        const struct XTS_PATH vperm = { "vector permute", &vp_enc, &vp_dec };
+        rv |= xts_test_path(&vperm);
+    }
+#endif
+
+#if CCAES_INTEL_ASM && defined(__x86_64__)
+    if (CC_HAS_AESNI()) {
+        const struct XTS_PATH aesni = { "AES-NI", &ccaes_intel_xts_encrypt_aesni_mode,
+                                        &ccaes_intel_xts_decrypt_aesni_mode };
+        rv |= xts_test_path(&aesni);
+    }
+#endif
+
+    return rv;
+}
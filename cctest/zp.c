@@ -0,0 +1,344 @@
+//
+//  zp.c
+//  cctest
+//
+//  Known answers for cczp_power and ccn_mul from 64 to 4096 bits, computed
+//  with Python's pow() and integer multiply.
+//
+
+#include <corecrypto/ccn.h>
+#include <corecrypto/cczp.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CCZP_TEST_MAX_BITS 4096
+#define CCZP_TEST_MAX_N ccn_nof(CCZP_TEST_MAX_BITS)
+#define CCZP_TEST_MAX_NBYTES (CCZP_TEST_MAX_BITS / 8)
+
+enum {
+    CCZP_TEST_RANDOM, // random p, m and e
+    CCZP_TEST_F4,     // random p and m, e = 65537
+    CCZP_TEST_ONES,   // p = 2^bits - 1, random m and e
+};
+
+/*
+ * The inputs are not stored. p, m and e are each bits bits long, filled in
+ * that order, big-endian, from the bytes of an xorshift64 (13, 7, 17) stream
+ * started at seed, each 64-bit output contributing its bytes least
+ * significant first. p then gets its top and bottom bits set; m and e are
+ * left as drawn, so m is often not reduced mod p. The ccn_mul vector is m * e.
+ */
+struct CCZP_VECTOR {
+    size_t bits;
+    uint64_t seed;
+    int kind;
+    const char *r;
+    const char *mul;
+};
+
+static const struct CCZP_VECTOR kCCZPVectors[] = {
+    { 64, 1, CCZP_TEST_RANDOM,
+      "83bbd37ae9715e90",
+      "0a75ff4f90025762c6eb9a6a5f9ce9b0" },
+    { 256, 2, CCZP_TEST_RANDOM,
+      "1e8e0fe8df3c8c2573d814644b2aea9a3e867b9f5e9c7a778e33990b73a7e569",
+      "6d6a1c6f10784e1dc5b22b7731e0cfd8f4f5eebaa779c204eb439458d80ff978"
+      "882c9cf6388cb076201eaa5010ebe466db73f3e72226499a850dd9a1cbfee338" },
+    { 256, 3, CCZP_TEST_F4,
+      "63f01df4c81ab799502b62e945282fed52d4e8083cea64a4b00f6df65ed1761b",
+      "c78384612396e2e17ed3802303546695b74ae28c38e03ef0873f3ea8c8a569ae"
+      "6a7e" },
+    { 521, 4, CCZP_TEST_RANDOM,
+      "13b43f11eed612663a503f63e0c7cb40233be5f95f84771a5a808d4d4822368d"
+      "a9cd30b92dbc274da7d18a8a469c3e7bc8e7b4c94a8adab056def9cec9291255"
+      "05",
+      "3aede764a6c1edb3acb27ddeab39294c0fa66e28623bd94a447c2639a2ce1c86"
+      "57a9a02a34c3bbbe0d15e74a4db5b49329521e214b7c743a2160670227113580"
+      "c0cb6f6242d742fcdefa06037b0e3d8aca9156c08f53546479339821252dc578"
+      "d76f1e72ff4812b46f02188652fb9306f597393c03c04fc01de13da33b13b7e5"
+      "e5a4be6c" },
+    { 1024, 5, CCZP_TEST_RANDOM,
+      "9670e9b4af1e06c19ea9511d875ebb011f746d35ee9ba0e252a84dfe072fe71a"
+      "89298af14f1c024d2ce1508f0e4962d4a2e77611296d400d129f871c49dad31f"
+      "318b0591bdb6a3aa4388f09803449aac42980c6edcd8e448573a798a5d5218f0"
+      "77c8371de69bfbd480ab4dcbf3a0b3fb2aed6597e0b82f4334e502c9985e0db5",
+      "6a5700ec75334669fdd003542dd8c883ceceafb487a432f10b0b5eca8bf8fbb9"
+      "ff502e08df71c5a27e5a471af80a16c291e10f30bf3c145ad9429950f87da8a9"
+      "a11afe7f15c8ffb1173e39b5f119bc4fd27df28a9d29aee4c94c7f46b37b13c2"
+      "2f488eec89bd30003b2fc47822b2f2d14c78d44607cab6043d629d6f73c7d44a"
+      "6169c8fefb6b603d8b1a4653f4b90628901eac7e717231dcd9c20033e976123f"
+      "ede695d2bf407825b53b09a16c64c022bc5dabc2080b805cbe8e60d4534c2466"
+      "89ddee9117deab15807928786d773e43f14ca191093fd2e4ec9d0bcb67a7be26"
+      "804fa9157c1e9e560c5b752d8667a15dc325b5168ec4dbae66e68f1ed1c7b090" },
+    { 1088, 6, CCZP_TEST_ONES,
+      "edc04f07c77085a9201745df4cb20e00a7482960fa282c2ad5adcc7299aeab4c"
+      "c69611940cc6a91b1d303b678ffdf03a8bb1838f9440301cf3b336a2183c520c"
+      "9dd6799b78d611b429aedcd568c8524ea493e9488eba1cce3f61c0ff32d5f648"
+      "b7d924d8ee548d45be0d5de330ba6ab496bf6bd5185dd5d3ce340a9ce4ce23e7"
+      "a9c26d7c274b06a6",
+      "4923bb3e43324196d1f58d21479ca3118a051797260f56a844121db1bd3c2145"
+      "603dfa7addd609ffee81b43164674d1b1e761d4acb7f39999354bde905ffc3ba"
+      "8a1d985555da2b9d8e1046ea4148130bcd6c9d5dba775fc15f8663652182d8f2"
+      "354264c0f65ce3f14b5cbb792a3b9fcdb852810780859e4b05033b132f65893a"
+      "207b527c09bd006e86b1f6d719acb3cdf1e7526382ecbef9ddca2bc74d6f7419"
+      "b37e56c3bb2389f564fbb9c30e77fa622b06aedcb99b294b22c5fc5245176d4c"
+      "07d662334ae4f5ba0d7e36f5b1105e1582c4fa4e2426088a0d4cf403db96b5f9"
+      "cdd23574a0ebc4b03f5f61324f9588af4bce1d648ccfaadbdce3fc07df5eea89"
+      "e8e63a5970736b5d1b54573bac14642c" },
+    { 2048, 7, CCZP_TEST_RANDOM,
+      "81873f44ddfc91e6ab7ffc574f7c250e35adc24d9455631b14ca62c99cf9c718"
+      "83b836b8d10792a3c1073ee57cbe5bd56360fe9c85348a8babf9110bd3485df7"
+      "01f538601774352a3e4eb192ea66d0c7b19dd51b13c953cf1b6a03477e175ad6"
+      "2effc7c5bc84617ba4da019db6c978462f1b3758ede710bf3af63d805fddba9d"
+      "37a67fddff66cb623742b3307c0cbe9120a4991d6821fc3320bf5af0cecb13cd"
+      "29541a58fdbd89c569ee96cd1436a1b10e134d0a2aca28bdc68cd1c1e67c4abe"
+      "790b45daa1e7879d2785376df24aa71b7251f8a12fa0a566071596973e663d53"
+      "0fc9a8415f0b01c5554ad6820230ca7f19525313ff35efdb6fee05dd1fb9c9b0",
+      "1fe9dc5e455c55e8be6cc6e6bda288d62cb193e0f39aa82cde081fe72ba747a5"
+      "87040a6efe7db59d8bcce11e28d91c23e2a78d73f200671902eb655c0df64da2"
+      "bee5bddddc68384c66ec167f69f2bab33b8be0f75dab6a23947aa2332b93d088"
+      "fba8ca2eb0f09d67c2eb2b926c1e49bf52ed8dbfe66a76aac199727f27c83942"
+      "4656b7ec12648cf4d77b2e9cf89901df1d57ae4540b268457b0615f838678250"
+      "29260a3d32d975eacbf2d46c2a0dc67b3e0840840763ea967bc6c8e9a33f256e"
+      "52ca75d2b980ede6628dc88d22e0f382df44ae915b6ca811c828e5eb9217534e"
+      "8a095165e14d0c5d00f182604475e95f2c8a80332c1b26a8e975370d7a3b420d"
+      "9b87dd41db880707f9814f4843ffb8bdab6a24333c81a7db34de12d22131af0f"
+      "8de823c2cbbef780879ed878b3dde2d60198e7e9e55e4f748bedd12ee44d6675"
+      "97ea01c9db2e3c1b4844a5d9db5fc1e0e4ca98da40cd8ef1956551d6ec3c364c"
+      "82920ae30a000708ddb73ecfb3c08bdeaac79f8299047467d571fca0e0aa755f"
+      "1f31c0acf69f9e4cabcbc7480c2683b32f7cd1ba08ca3b8615efee2a321d960d"
+      "eb097e3fcbeda8cc7231996c856b8def2e338f95343d271a944b079a516fca18"
+      "003486b6cc878b5d6045d81caf795635d3a984d7aa208baf9b49c6b6b4d7be42"
+      "1c293db85fe34159e2f0deba083990115e67e54f6f4258c70486a66d4dbb8742" },
+    { 3072, 8, CCZP_TEST_RANDOM,
+      "84c141296498700556eb0a92c8a3edb3d157cbfad8de00c13247fe0128ad1cfe"
+      "ea14047c94b28183d1bf3b7e0957e833a0fff402d632dda525476e0c00714740"
+      "8f51ee155a0c5e918207be399066a479866e25ff2b87dfbdf67b7733c60e0b96"
+      "1872dac38fbd66157faf378cd42b60fc544171850a9b5dcb7cc57cbf73107387"
+      "5160bba92b5cf719f5d46012481beb9d7a4fd2c37cfb38a79f564a65bb1c4123"
+      "e24d3fa1e1b4246789fed1e50154ba9aa78d0f8bdc2274b14bbc96ce8495f61b"
+      "347d70944be42a18d700756b77e2cb2c6b178a16d357cdf29eb871ec37b74e11"
+      "93b221f341f8212371bac880024c0b33ca3977b56f45f6c5cebc88ae8f6319e8"
+      "8b24f94749c847c12fca2a84b8542b63513301459cf66249575d705c9864cd81"
+      "c5e1495b7d3bb68cc38d479e204ec6dbf8630203ec340add3052386bc2e06c48"
+      "fa9c689349719ebbd621d900eb33ccf9e024f5cf6328acf04fa506ce5cc86c73"
+      "cfcbfb26737a0177dc9c0044cf6bc3888d5299df1b513c38b658a8999cacca05",
+      "756482d2d7cf02adf6c95a6b8ab7e5000ea5ae8fc841677c158a94bbdc66c8d4"
+      "76d0961ee1fbda03afbab3997066a8dfbdcfbf716aae6c86aa681b600d33d7b3"
+      "dc8edeb44a21c256347d4db56df5c9e18649825d0695b50983feffec6ddd6fd4"
+      "b7364d0fbc895b166ca820f832a66dab1a5975d2a03c4f1bb98e49777ac1d8b9"
+      "96cbc901f391280e82c0a2dd57a60f9e5f06d7c6ca6fcdc65822f8f474f26b2d"
+      "65a59a0b6a3865ba2ba9fca8b8f35674f603e81cb3d13ca34d28d35f4fbf6491"
+      "b15ea26989ea64f5115e67cc88dbd1e30c0c112c9040933f399cba6d99b02377"
+      "ebfb914912e933118a85fb6c037a789be5a1cbba19ecc9230afc5e475622f6c9"
+      "7abf33a3141b271d03d91fced21c3ab85c8bcb959544231bab67ca63cb9099cb"
+      "43218ef855942ebf8e892ddfefc02763c03b9d3948bceb3582263fd66f75d538"
+      "96d80bbe2aafe20aa91f24477f75812304c21b8caa585051b882fdb7b37b7cca"
+      "a587389b93f69c8e3e97564690567edb7dcf44d3eae0a5cc3ac5dec9de3323d9"
+      "e5d2fa8be5f3c2f02657bb64fc17b359d5f6e00c0a7510df405e4288303f597d"
+      "70cf33d43301968cf7a6d8dfd5f2cc2a8d93a8ca4bae10372d41336d0f6e582c"
+      "8a61f91ff24bd70da230880596dcd627c8c0e9cf7d7b02f6883b7483cf8b2095"
+      "f0ddc41006104b109fc424c0daf169e939851011fd5ad1c9676e726251ee8202"
+      "dcc3a96ac65fe6b4c3e29592ac4e2a346443c0f263e05b154aca46d1f44d126c"
+      "fcf6a6ca4d0e7413fd13bec524c29a891c11dca4100dff18c6d68a4e43aa292e"
+      "1e0c2869e3ac2832f5811b2809776ce6ebd4f440ef954ae05f9f85cc8dacb1a3"
+      "76a465cf172bb6ac6444c553e2f9a94923642d8d2e68ac9492c2cab3e29061d7"
+      "aeb1968c136ca1e906a233fbd97597edd5ae8b6ddf97e557aac877a6f3df0857"
+      "1c2f9015f035e3065439bb3aece04fef2f1cddbfaaa8ae902dc049811bc803b6"
+      "9dab7ed098814b49a5feb398c0d0f12337fd2854680cb8830107c6196dd811c0"
+      "784cefe7920657d29670aa19c2fd9ca6df9cceb3ee682de025ea0a3ba42cd460" },
+    { 4096, 9, CCZP_TEST_RANDOM,
+      "2608197874dee8eaa1fe7667498d21846fb9519a9d8919e8cbba1e10dce3e416"
+      "22240dfcc059e2d7d480f4e33536afb42a79931eafc88cb6ec5425a8433681c0"
+      "a1ceb5b08d96781b6a8f8018177f0a52a02e6842b341466ef58439e05d89eaa3"
+      "b3dfe695d83b527da2aa77f5d2b44e2ecb27e2273e378fb10158b5cd80825f0d"
+      "e303e3ec20c61df409c698b46cf806016d6b42d130d72f59f8d09d39accfd0ea"
+      "9ea7b6b8b7cb1897a34c550d7743d9fc0f0f0076c0d31fd5fefe2e679d8221b3"
+      "3fb0d42f39b34e03a75393282984099377aa45b0c5498487e5878e3b6440675e"
+      "0859b3fa48dd37f752527e06c2d57fcdb8a674cc84a203ea2a1ff34c68d412d5"
+      "fd845413815e68ff2bffb10ed2d792f2a8302b5dbf803ec64efa6f6f5b6668e0"
+      "de91a953e4c3a3e5c36e6fbbf335b445a5fe273668016ca0a8a6c19c5073f65b"
+      "231b72c3bde759bcf3615f446a030744193bafedd785cd4fd14fcb68076113f1"
+      "c9040fb3b734dd0e04d754a60efb364b9d0ec3c628a147917fc31315f558b4b1"
+      "a44e43e6c60cf414eede899e95d4fb3c0c7cf724d9cb94e9755112a8193b54b0"
+      "a5156ab892dca614fb2f389cbeed0bf0c52d69ba3f1ade7b3678fa023df16860"
+      "09d3cb42551b566348a883f4b72313d0e8c9b2568c0107b494f6c202b8487d75"
+      "5ca29cf286f75c32ae3221a5157971e0519fb3e67bc26cac16135682d909c432",
+      "6b14bd9f6e99ba6af45693d2b1f27b1f51433740da5ee9d0feb562718f00c52e"
+      "1c3af1bdcf295453fb9a8c2b1e2d9d9bdeb5063d141df97234a13a44397eeedc"
+      "98d0d54f4ece590620f51cb79a174e47641150276e1a82497063659498c4a60f"
+      "851e2c4b79a13b0643078523e1c112ec4ae1c3abb5b0a4fa153ec79738acc621"
+      "2f44fc550d7a3d756ac816f6a675f027f0ec5c10a97e3ffe78b6fe769bda98eb"
+      "44d3ac793a03d853cf6a67f2ca200e9ac15e1ce6fae9defe036722c3d4c8df19"
+      "ff1fa127fccb41677e43266c1ca93a5b5bebefb39cf02d20d39fb56b3a2305d4"
+      "bbb6532a0cec1095b42375fe9ddfaeef2bfc83d63b8b4003bbf8e921ea469cb9"
+      "a414720fdccfb03446b5faa9d730eb4f1d18eb773b19b2719955dab2770aa73b"
+      "489e24a2bca6cc030e67f2defe91fadf93a6dca7b60c25c06d340116e3c4e460"
+      "9bb4d695d95489d520d0a8b1e194af12292e490014b97ae199c6788912fb1c82"
+      "2de29868e53287241daaab2611034d709746bfe38379fb1fbec6094747d017ac"
+      "fbd6bcc9708ab9cbf167a62977a6a80e7fe2b8a827c3d547ac636e2f23b2d679"
+      "b2c5b85da32c3dcde40f081b78b7ea9084c92f9b4126366a1c91856ab5077557"
+      "fad8ca499e57248e9419ac36a5fb5a7337efd42468d2aa9a904a3191c125c248"
+      "4669d61ada268aa37ae2fdfa49df5806a8343266f24f9e975b51f642e7bb6ab3"
+      "fba707e17cd6ec62ee8ac109cfa357b61cd7b92629e9945aba40a07963ddde0d"
+      "526fbb07cb19f05928fe26250a89d2f09ca19b27479ae842170c126d8c9d2370"
+      "528f1f8c7aadf140f8cdaba314bec3aecc7f7998689cb5fbddcdad63b6f212da"
+      "cff677ebc8fd7c73b7b38a389f34bb388661c1200ffcb32e326e04c3bceb97a3"
+      "de3f6b6beaceecef70f47463a5a8f23e9d80ae0fe45db96c19059d57aa12e66b"
+      "01c4709de4d8a19d2732f952a8b8872d6c13726795ced4a78ce17ee1157b0af6"
+      "ec72a489a0ed9ea3b8ae36e3c8f260ae832046cae8b78014629b35eb67069a60"
+      "8ca9364fa3993c5ca8888b6bb800504bdfb9686bbc3b669ab08cac946c2cd4b3"
+      "855e75a01129e417c4fba856ce286b727c32806dab2fa2f4ac65850e476c5653"
+      "1d8b7aa7c8d9a9125a63bcb17168894f7bb3d8d90e5c4554de10d9e56c1ca2c8"
+      "4f58eee7f1ac14879e50651e42410e22d0e27aba73520f464de450d885a2208c"
+      "49cef047c370d953d28828a6e36e319f4882491d0e240da6983be1ee98a0e004"
+      "32df87b452f32607b33f7871431bf337535dab3df241b84000a1716fbf9aaabf"
+      "e1dec6e5cfaef85f274de657a218d987c201993b339e2e0828afd94c849a79c2"
+      "fa66052215f7efda529ec9a4a8b5c1561790677d17791c5523f611ac09f10ad2"
+      "46d7da0d6b8090f3dcf3dd2e8322d0bbd2646471e84a08a93d082a3d89a550ee" },
+    { 4096, 10, CCZP_TEST_F4,
+      "51f923dc5ef16c88a115e1549f0ac04d811a6b31004fbcfa07b89c2ed10d3268"
+      "5554506f6e6d6bf4ea19308e61f7cdbab68fb5e2f02ec0d441ea91ebdcdbf6ab"
+      "40be70e776110aad458ffd71769bd0ad6ad77978feaffda776e139403bae0cc2"
+      "26e4b70a8faf58ba77a59ec05794f166dccc2ee25256c81dbbf718ac36892342"
+      "df68a673814683bb4e2c39eb36ae8dedcc8dc3acc7923bee2ccdd81fc7c1b415"
+      "f893f990e6a65813919fc8dca374343ee0f87797553628c133c4ac50ec8263d6"
+      "d8a753565678b7be55ed43609f54e91754cea5a468d68c885b0a8a7c3ad8693a"
+      "edf4f6f0887aef7872779d07ebe9389e4e956781438a84898538ecb1d4f86551"
+      "e64a57ffe034faa78a8b6ce3d8eb3195cf293f592e3f1774a8f4d1f515e75299"
+      "8a9963b0bb22737e88295a891e29a6b37579057d7dcdd176e85e742a53f0ce80"
+      "a557b0074e505ce66af1c517751639019656b900d489e8d61e765c21ef9bc28a"
+      "30d7a1f3f333c3a01367f923a9a2180b7a35b5432b7cd7215e40f8fb0294db0d"
+      "6cc719e489e834837de2f6a53cb4c692e14658d4d618cd9f3c032aa2a45394cc"
+      "a6bb96bbacf4ad88f575f86b7e8eabc5d199d4951934e8ea176ea19fa84ade7c"
+      "7efae07a4edc29b1e3d15972d7909cfbd9c478c5feb57421bcfb98ea2b4fbd0f"
+      "d06ddc2b6202914de85dd175d89192ed2fb5c7fc14ce5db96c78e473db6bf8bf",
+      "433a41f2a5f88fc0da76bdda46d3bb539aa34f5ffb775af6faa324f4f74870b2"
+      "1bf32c0944cff5fb86cc84f639a2474595be5abf71bd3894c8f6d51ee5e7ea23"
+      "32dbfca63e15f64fdde2444de9f0bb6630a953e34d16f9f75b2ab9244112b9e9"
+      "6a637d3800e8ffe692d78fd7b40598b1d937d550adc385c3f1dd1b11d1446c28"
+      "89f7b91b6b114489b2088784755190fb5914dbe3e2acaf4c9eb364b20c3ff7de"
+      "bab59776d26b98109d1307689913c0f41c622f44a949e5978bd7df6da2482543"
+      "f56d4ac76230b4da2c5430f5f4f4c1cd37ebe5845d325471b110f2151b88c9b1"
+      "af8d22b5be489f6716ed017bdf7ec69aa6bc0793c67b995af0c787694d7be9b3"
+      "354b38919b5c191f8ed16ee9d20a19ccf5e423dfc9464d3c19dc30466a097131"
+      "50714b2150d4ce45a999141c5671a28ab9b60e91c4d05d29b691fc783fe93ef6"
+      "722ff3ee69eea5315d35d47b04810ed029d51d88ec84b865fcce2c8fd40ca08b"
+      "edff38456c66a23b98daacf8acebf2ab885260ddd742e7ee26c7baec580601d3"
+      "f0b7d47a3fa6be72ce220b363e7c4e65698b96ab542d93831e546728d4675cfa"
+      "ceaa9123f565e02bc0f711d0186f9be0a20bf37c2c66739403cc20e4b938efd2"
+      "e895624810007afdd95539ed7b38f7814912badc8cdd1bf6bcb805888d6e249f"
+      "27cbbacacd406a3ba9a65c3301992e9a77155127487f8b741421108327fd4a03"
+      "5ae3" },
+};
+
+static void cczp_test_fill(uint64_t *x, size_t nbytes, uint8_t *out)
+{
+    for (size_t i = 0; i < nbytes; i++) {
+        if (i % 8 == 0) {
+            *x ^= *x << 13;
+            *x ^= *x >> 7;
+            *x ^= *x << 17;
+        }
+        out[i] = (uint8_t)(*x >> (8 * (i % 8)));
+    }
+}
+
+/* big-endian bytes to units; ccn_read_uint is not implemented yet */
+static int cczp_test_read(cc_size n, cc_unit *r, size_t nbytes, const uint8_t *data)
+{
+    if (nbytes > ccn_sizeof_n(n)) {
+        return -1;
+    }
+
+    ccn_zero(n, r);
+    for (size_t i = 0; i < nbytes; i++) {
+        size_t bit = 8 * (nbytes - 1 - i);
+        r[bit / CCN_UNIT_BITS] |= (cc_unit)data[i] << (bit % CCN_UNIT_BITS);
+    }
+    return 0;
+}
+
+static int cczp_test_read_hex(cc_size n, cc_unit *r, const char *hex)
+{
+    uint8_t buf[2 * CCZP_TEST_MAX_NBYTES];
+    size_t nbytes = strlen(hex) / 2;
+
+    for (size_t i = 0; i < nbytes; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        buf[i] = (uint8_t)b;
+    }
+    return cczp_test_read(n, r, nbytes, buf);
+}
+
+/*
+ * Each vector checks cczp_power out of place and in place (r == m), the same
+ * through a second zp set up with cczp_init_with_recip from the first one's
+ * reciprocal, and ccn_mul.
+ */
+int TestCCZP(void)
+{
+    int rv = 0;
+
+    for (size_t i = 0; i < sizeof(kCCZPVectors) / sizeof(kCCZPVectors[0]); i++) {
+        const struct CCZP_VECTOR *v = &kCCZPVectors[i];
+        size_t nbytes = (v->bits + 7) / 8;
+        cc_size n = ccn_nof(v->bits);
+        uint8_t p_bytes[CCZP_TEST_MAX_NBYTES], m_bytes[CCZP_TEST_MAX_NBYTES], e_bytes[CCZP_TEST_MAX_NBYTES];
+        cc_unit m[CCZP_TEST_MAX_N], e[CCZP_TEST_MAX_N], r[CCZP_TEST_MAX_N], expected[2 * CCZP_TEST_MAX_N];
+        cc_unit mul[2 * CCZP_TEST_MAX_N];
+        uint64_t x = v->seed;
+        int bad = 0;
+
+        cczp_test_fill(&x, nbytes, p_bytes);
+        cczp_test_fill(&x, nbytes, m_bytes);
+        cczp_test_fill(&x, nbytes, e_bytes);
+        p_bytes[0] &= (uint8_t)((2u << ((v->bits - 1) % 8)) - 1);
+        p_bytes[0] |= (uint8_t)(1u << ((v->bits - 1) % 8));
+        p_bytes[nbytes - 1] |= 1;
+        if (v->kind == CCZP_TEST_ONES) {
+            memset(p_bytes + 1, 0xff, nbytes - 1);
+            p_bytes[0] = (uint8_t)((2u << ((v->bits - 1) % 8)) - 1);
+        }
+
+        cczp_decl_n(CCZP_TEST_MAX_N, zp);
+        cczp_decl_n(CCZP_TEST_MAX_N, zp_recip);
+        CCZP_N(zp) = n;
+        CCZP_N(zp_recip) = n;
+        bad |= cczp_test_read(n, CCZP_PRIME(zp), nbytes, p_bytes);
+        bad |= cczp_test_read(n, CCZP_PRIME(zp_recip), nbytes, p_bytes);
+        bad |= cczp_test_read(n, m, nbytes, m_bytes);
+        if (v->kind == CCZP_TEST_F4) {
+            ccn_seti(n, e, 65537);
+        } else {
+            bad |= cczp_test_read(n, e, nbytes, e_bytes);
+        }
+        bad |= cczp_init(zp);
+        cczp_init_with_recip(zp_recip, cczp_recip(zp));
+
+        bad |= cczp_test_read_hex(n, expected, v->r);
+        bad |= cczp_power(zp, r, m, e);
+        bad |= ccn_cmp(n, r, expected) != 0;
+
+        ccn_set(n, r, m);
+        bad |= cczp_power(zp, r, r, e);
+        bad |= ccn_cmp(n, r, expected) != 0;
+
+        bad |= cczp_power(zp_recip, r, m, e);
+        bad |= ccn_cmp(n, r, expected) != 0;
+
+        bad |= cczp_test_read_hex(2 * n, expected, v->mul);
+        ccn_mul(n, mul, m, e);
+        bad |= ccn_cmp(2 * n, mul, expected) != 0;
+
+        if (bad) {
+            printf("CCZP MISMATCH!!! (%zu bits, %zu)\n", v->bits, i);
+            rv = -1;
+        } else {
+            printf("CCZP MATCH! (%zu bits, %zu)\n", v->bits, i);
+        }
+    }
+
+    return rv;
+}
@@ -357,6 +357,8 @@
  #define CCN_MULMOD_256_ASM     1
  #define CCAES_ARM_ASM          1
  #define CCAES_INTEL_ASM        0
+ #define CCAES_VPERM            0
+ #define CCMODE_GCM_VNG_SPEEDUP 0
  #if CC_KERNEL || CC_USE_L4 || CC_IBOOT || CC_RTKIT || CC_RTKITROM || CC_USE_SEPROM || CC_USE_S3
   #define CCAES_MUX             0
  #else
@@ -397,6 +399,8 @@
  #define CCN_MULMOD_256_ASM     1
  #define CCAES_ARM_ASM          1
  #define CCAES_INTEL_ASM        0
+ #define CCAES_VPERM            0
+ #define CCMODE_GCM_VNG_SPEEDUP 0
  #define CCAES_MUX              0        // On 64bit SoC, asm is much faster than HW
  #define CCN_USE_BUILTIN_CLZ    1
  #define CCSHA1_VNG_INTEL       0
@@ -443,6 +447,12 @@
  #define CCN_SET_ASM            0
  #define CCAES_ARM_ASM          0
  #define CCAES_INTEL_ASM        1
+ #define CCAES_VPERM            0
+ #if defined(__x86_64__)
+  #define CCMODE_GCM_VNG_SPEEDUP 1
+ #else
+  #define CCMODE_GCM_VNG_SPEEDUP 0
+ #endif
  #define CCAES_MUX              0
  #define CCN_USE_BUILTIN_CLZ    0
  #define CCSHA1_VNG_INTEL       1
@@ -477,6 +487,13 @@
  #define CCN_MULMOD_256_ASM     0
  #define CCAES_ARM_ASM          0
  #define CCAES_INTEL_ASM        0
+ /* SSSE3 vector permute AES in C, picked at runtime by ccaes_modes.c */
+ #if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !CC_KERNEL
+  #define CCAES_VPERM           1
+ #else
+  #define CCAES_VPERM           0
+ #endif
+ #define CCMODE_GCM_VNG_SPEEDUP 0
  #define CCAES_MUX              0
  #define CCN_USE_BUILTIN_CLZ    0
  #define CCSHA1_VNG_INTEL       0
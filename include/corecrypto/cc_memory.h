@@ -25,11 +25,11 @@
 /* Workspace related macros go here. */
 
 #define CC_WORKSPACE_STACK_DECL_N(ws, n) \
-            cc_unit ws##_buf[ccn_sizeof_n(n)]; \
+            cc_unit ws##_buf[n]; \
             cc_ws ws##_ctx; \
             cc_ws_t ws = &ws##_ctx; \
             ws->start = (cc_unit *)&ws##_buf; \
-            ws->end = ws->start + ccn_sizeof_n(n); \
+            ws->end = ws->start + (n); \
 
 #define CC_WORKSPACE_STACK_FREE_N(ws, n) \
             ccn_clear(n, ws->start); \
@@ -60,9 +60,10 @@
             cc_ws ws##_ctx; \
             cc_ws_t ws = &ws##_ctx; \
             ws->start = IOMalloc(ccn_sizeof_n(n)); \
-            ws->end = ws->start + ccn_sizeof_n(n); \
+            ws->end = ws->start + (n); \
 
 #define CC_WORKSPACE_FREE_N(ws, n) \
+            ccn_clear(n, ws->start); \
             IOFree(ws->start, ccn_sizeof_n(n)); \
             ws->end = NULL; \
 
@@ -86,9 +87,10 @@
             cc_ws ws##_ctx; \
             cc_ws_t ws = &ws##_ctx; \
             ws->start = malloc(ccn_sizeof_n(n)); \
-            ws->end = ws->start + ccn_sizeof_n(n); \
+            ws->end = ws->start + (n); \
 
 #define CC_WORKSPACE_FREE_N(ws, n) \
+            ccn_clear(n, ws->start); \
             free(ws->start); \
             ws->start = NULL; \
             ws->end = NULL; \
@@ -151,13 +151,13 @@ x = (((uint64_t)(((const unsigned char *)(y))[7] & 255))<<56) |           \
     "bswapl %0     \n\t"        \
     "movl   %0,(%1)\n\t"        \
     "bswapl %0     \n\t"        \
-    ::"r"(x), "r"(y))
+    ::"r"(x), "r"(y) : "memory")
 
 #define CC_LOAD32_BE(x, y)      \
     __asm__ __volatile__ (      \
     "movl (%1),%0\n\t"          \
     "bswapl %0\n\t"             \
-    :"=r"(x): "r"(y))
+    :"=r"(x): "r"(y) : "memory")
 
 #else
 // MARK: --- default version
@@ -188,13 +188,13 @@ __asm__ __volatile__ (        \
 "bswapq %0     \n\t"          \
 "movq   %0,(%1)\n\t"          \
 "bswapq %0     \n\t"          \
-::"r"(x), "r"(y))
+::"r"(x), "r"(y) : "memory")
 
 #define	CC_LOAD64_BE(x, y)    \
 __asm__ __volatile__ (        \
 "movq (%1),%0\n\t"            \
 "bswapq %0\n\t"               \
-:"=r"(x): "r"(y))
+:"=r"(x): "r"(y) : "memory")
 
 #else
 
@@ -29,11 +29,12 @@
     #define CC_HAS_RDRAND() 0
 #endif
 
-#if (CCSHA1_VNG_INTEL || CCSHA2_VNG_INTEL || CCAES_INTEL_ASM)
+#if (CCSHA1_VNG_INTEL || CCSHA2_VNG_INTEL || CCAES_INTEL_ASM || CCAES_VPERM)
 
 #if CC_KERNEL
     #include <i386/cpuid.h>
     #define CC_HAS_AESNI() ((cpuid_features() & CPUID_FEATURE_AES) != 0)
+    #define CC_HAS_PCLMULQDQ() ((cpuid_features() & CPUID_FEATURE_PCLMULQDQ) != 0)
     #define CC_HAS_SupplementalSSE3() ((cpuid_features() & CPUID_FEATURE_SSSE3) != 0)
     #define CC_HAS_AVX1() ((cpuid_features() & CPUID_FEATURE_AVX1_0) != 0)
     #define CC_HAS_AVX2() ((cpuid_info()->cpuid_leaf7_features & CPUID_LEAF7_FEATURE_AVX2) != 0)
@@ -51,6 +52,7 @@
 
     extern int _cpu_capabilities;
     #define CC_HAS_AESNI() (_cpu_capabilities & kHasAES)
+    #define CC_HAS_PCLMULQDQ() (_cpu_capabilities & kHasPCLMULQDQ)
     #define CC_HAS_SupplementalSSE3() (_cpu_capabilities & kHasSupplementalSSE3)
     #define CC_HAS_AVX1() (_cpu_capabilities & kHasAVX1_0)
     #define CC_HAS_AVX2() (_cpu_capabilities & kHasAVX2_0)
@@ -76,15 +78,25 @@
     //
 
     #define CC_HAS_AESNI() __builtin_cpu_supports("aes")
+    #define CC_HAS_PCLMULQDQ() __builtin_cpu_supports("pclmul")
     #define CC_HAS_SupplementalSSE3() __builtin_cpu_supports("ssse3")
     #define CC_HAS_AVX1() __builtin_cpu_supports("avx")
     #define CC_HAS_AVX2() __builtin_cpu_supports("avx2")
-    #define CC_HAS_AVX512_AND_IN_KERNEL() 0
-    #define CC_HAS_SHA() 0
+    // userspace is free to use the AVX-512 state here
+    #define CC_HAS_AVX512_AND_IN_KERNEL() __builtin_cpu_supports("avx512f")
+
+    // older compilers don't know "sha" for __builtin_cpu_supports, so ask cpuid leaf 7 directly
+    CC_INLINE int cc_linux_has_sha(void)
+    {
+        unsigned int eax, ebx, ecx, edx;
+        return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_SHA) != 0;
+    }
+    #define CC_HAS_SHA() cc_linux_has_sha()
 
 #elif __has_include(<immintrin.h>)
     #include <immintrin.h>
     #define CC_HAS_AESNI() _may_i_use_cpu_feature(_FEATURE_AES)
+    #define CC_HAS_PCLMULQDQ() _may_i_use_cpu_feature(_FEATURE_PCLMULQDQ)
     #define CC_HAS_SupplementalSSE3() _may_i_use_cpu_feature(_FEATURE_SSSE3)
     #define CC_HAS_AVX1() _may_i_use_cpu_feature(_FEATURE_AVX)
     #define CC_HAS_AVX2() _may_i_use_cpu_feature(_FEATURE_AVX2)
@@ -95,6 +107,7 @@
 
 #else
     #define CC_HAS_AESNI() 0
+    #define CC_HAS_PCLMULQDQ() 0
     #define CC_HAS_SupplementalSSE3() 0
     #define CC_HAS_AVX1() 0
     #define CC_HAS_AVX2() 0
@@ -103,7 +116,7 @@
 
 #endif
 
-#endif  // (CCSHA1_VNG_INTEL || CCSHA2_VNG_INTEL || CCAES_INTEL_ASM)
+#endif  // (CCSHA1_VNG_INTEL || CCSHA2_VNG_INTEL || CCAES_INTEL_ASM || CCAES_VPERM)
 
 #endif  // defined(__x86_64__) || defined(__i386__)
 
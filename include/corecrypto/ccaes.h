@@ -24,6 +24,16 @@
 extern const struct ccmode_ecb ccaes_ltc_ecb_decrypt_mode;
 extern const struct ccmode_ecb ccaes_ltc_ecb_encrypt_mode;
 
+/* Constant-time bitsliced AES, several blocks per pass; used by the parallel modes when there is no AES assembly. */
+extern const struct ccmode_ecb ccaes_bitslice_ecb_decrypt_mode;
+extern const struct ccmode_ecb ccaes_bitslice_ecb_encrypt_mode;
+
+#if CCAES_VPERM
+/* Constant-time SSSE3 vector permute AES, one or two blocks at a time; only usable if CC_HAS_SupplementalSSE3(). */
+extern const struct ccmode_ecb ccaes_vperm_ecb_decrypt_mode;
+extern const struct ccmode_ecb ccaes_vperm_ecb_encrypt_mode;
+#endif
+
 /*
  * SAMUEL: This isn't actually a mode in Apple CC, this is my own doing.
  *
@@ -135,6 +145,21 @@ extern const struct ccmode_xts ccaes_intel_xts_encrypt_aesni_mode;
 
 extern const struct ccmode_xts ccaes_intel_xts_decrypt_opt_mode;
 extern const struct ccmode_xts ccaes_intel_xts_decrypt_aesni_mode;
+
+#if defined(__x86_64__)
+/* CTR on top of ccaes_intel_ecb_encrypt_aesni_mode, picked by ccmode_factory_ctr_crypt(). */
+int ccaes_intel_ctr_crypt_aesni(ccctr_ctx *ctx, size_t nbytes, const void *in, void *out);
+
+/* CCM with interleaved CBC-MAC and CTR blocks, picked by ccmode_factory_ccm_* for ccaes_intel_ecb_encrypt_aesni_mode. */
+int ccaes_vng_ccm_encrypt(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out);
+int ccaes_vng_ccm_decrypt(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out);
+#endif
+
+#if CCMODE_GCM_VNG_SPEEDUP
+/* Stitched AES-NI + PCLMULQDQ GCM, picked by ccmode_factory_gcm_* for ccaes_intel_ecb_encrypt_aesni_mode. */
+int ccaes_vng_gcm_encrypt(ccgcm_ctx *ctx, size_t nbytes, const void *in, void *out);
+int ccaes_vng_gcm_decrypt(ccgcm_ctx *ctx, size_t nbytes, const void *in, void *out);
+#endif
 #endif
 
 #if CC_USE_L4
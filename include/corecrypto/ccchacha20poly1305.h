@@ -25,10 +25,24 @@ typedef struct {
 
 #define CCPOLY1305_TAG_NBYTES 16
 
+/*
+ * r and the accumulator h are kept in the radix the scalar code runs in: five
+ * 26-bit limbs, or three 44-bit limbs (l44) where the compiler has a 128-bit
+ * type. Both views share the same 56 bytes, so the size and the offsets of
+ * buf, buf_used and key are unchanged.
+ */
 typedef struct {
-	uint32_t r0, r1, r2, r3, r4;
-	uint32_t s1, s2, s3, s4;
-	uint32_t h0, h1, h2, h3, h4;
+	union {
+		struct {
+			uint32_t r0, r1, r2, r3, r4;
+			uint32_t s1, s2, s3, s4;
+			uint32_t h0, h1, h2, h3, h4;
+		};
+		struct {
+			uint64_t r[3];
+			uint64_t h[3];
+		} l44;
+	};
 	uint8_t	buf[16];
 	size_t buf_used;
 	uint8_t	key[16];
@@ -290,4 +304,63 @@ int ccchacha20poly1305_encrypt_oneshot(const struct ccchacha20poly1305_info *inf
  */
 int ccchacha20poly1305_decrypt_oneshot(const struct ccchacha20poly1305_info *info, const uint8_t *key, const uint8_t *nonce, size_t aad_nbytes, const void *aad, size_t ctext_nbytes, const void *ctext, void *ptext, const uint8_t *tag);
 
+/*!
+ @struct        ccchacha20poly1305_packet
+ @abstract      One message of a batch.
+
+ @field      nonce          Unique nonce for this message
+ @field      aad_nbytes     Length of the additional data in bytes
+ @field      aad            Additional data to authenticate
+ @field      text_nbytes    Length of the text in bytes
+ @field      in             Input plaintext (encrypt) or ciphertext (decrypt)
+ @field      out            Output ciphertext (encrypt) or plaintext (decrypt)
+ @field      tag            Generated (encrypt) or expected (decrypt) authentication tag
+ */
+struct ccchacha20poly1305_packet {
+	const uint8_t *nonce;
+	size_t aad_nbytes;
+	const void *aad;
+	size_t text_nbytes;
+	const void *in;
+	void *out;
+	uint8_t *tag;
+};
+
+/*!
+ @function      ccchacha20poly1305_encrypt_batch
+ @abstract      Encrypt many messages under one key.
+
+ @param      info           Descriptor for the mode
+ @param      key            Secret chacha20 key
+ @param      npackets       Number of messages
+ @param      packets        Message descriptors
+
+ @discussion Equivalent to calling @p ccchacha20poly1305_encrypt_oneshot on every packet, but the key is set up once and
+ the per-message keystream work (the Poly1305 key block and the short tail) is shared across SIMD lanes. Meant for
+ many small messages, e.g. a packet data plane.
+
+ In-place processing is supported.
+
+ @warning The key-nonce pair must be unique per encryption.
+ */
+int ccchacha20poly1305_encrypt_batch(const struct ccchacha20poly1305_info *info, const uint8_t *key, size_t npackets, const struct ccchacha20poly1305_packet *packets);
+
+/*!
+ @function      ccchacha20poly1305_decrypt_batch
+ @abstract      Decrypt and verify many messages under one key.
+
+ @param      info           Descriptor for the mode
+ @param      key            Secret chacha20 key
+ @param      npackets       Number of messages
+ @param      packets        Message descriptors
+ @param      results        Optional, receives the @p ccchacha20poly1305_decrypt_oneshot result of each message
+
+ @result     Zero iff every message verified.
+
+ @discussion The plaintext of a message that fails verification is still written and must be discarded.
+
+ In-place processing is supported.
+ */
+int ccchacha20poly1305_decrypt_batch(const struct ccchacha20poly1305_info *info, const uint8_t *key, size_t npackets, const struct ccchacha20poly1305_packet *packets, int *results);
+
 #endif
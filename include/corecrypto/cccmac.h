@@ -23,8 +23,8 @@ struct cccmac_ctx {
     size_t  block_nbytes; // Number of byte occupied in block
     size_t  cumulated_nbytes;  // Total size processed
     const struct ccmode_cbc *cbc;
-    uint8_t ctx[1];
-} CC_ALIGNED(8);// cccmac_ctx_hdr;
+    uint8_t ctx[1] CC_ALIGNED(16); // cccbc_ctx, then cccbc_iv, both 16-byte aligned
+} CC_ALIGNED(16);// cccmac_ctx_hdr;
 
 typedef struct cccmac_ctx* cccmac_ctx_t;
 
@@ -32,7 +32,8 @@ typedef struct cccmac_ctx* cccmac_ctx_t;
 
 
 #define cccmac_iv_size(_mode_)  ((_mode_)->block_size)
-#define cccmac_cbc_size(_mode_) ((_mode_)->size)
+/* rounded up so the cccbc_iv that follows the cbc context keeps its alignment */
+#define cccmac_cbc_size(_mode_) (((_mode_)->size + sizeof(cccbc_iv) - 1) & ~(sizeof(cccbc_iv) - 1))
 
 #define cccmac_ctx_size(_mode_) (cccmac_hdr_size + cccmac_iv_size(_mode_) + cccmac_cbc_size(_mode_))
 #define cccmac_ctx_n(_mode_)  ccn_nof_size(cccmac_ctx_size(_mode_))
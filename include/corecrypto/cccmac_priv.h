@@ -20,7 +20,14 @@
 #define _CORECRYPTO_CCCMAC_PRIV_H_
 
 #include <corecrypto/cccmac.h>
+#include <corecrypto/ccmode.h>
 
 int cccmac_generate_subkeys(const struct ccmode_cbc *cbc, size_t key_nbytes, const void *key, uint8_t *key1, uint8_t *key2);
 
+/* K1 = L.x and K2 = L.x^2 from L = E_K(0^128) */
+void cccmac_derive_subkeys(const uint8_t *L, uint8_t *key1, uint8_t *key2);
+
+/* blocks per cbc call in cccmac_update, the ciphertext lands in a stack buffer of this size */
+#define CCCMAC_UPDATE_NBLOCKS 32
+
 #endif /* _CORECRYPTO_CCCMAC_PRIV_H_ */
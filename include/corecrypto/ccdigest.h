@@ -98,6 +98,19 @@ void ccdigest_final(const struct ccdigest_info *di, ccdigest_ctx_t ctx, void *di
 void ccdigest(const struct ccdigest_info *di, size_t len,
               const void *data, void *digest);
 
+/* One message for ccdigest_multi_update(): len bytes at data go into ctx. */
+struct ccdigest_multi_job {
+    ccdigest_ctx_t ctx;
+    size_t len;
+    const void *data;
+};
+
+/* Same result as ccdigest_update() on each job in turn, but the whole blocks of
+   independent messages are compressed side by side when di has a multi-buffer
+   kernel (SHA-1, SHA-224/256, SHA-384/512). All contexts must belong to di. */
+void ccdigest_multi_update(const struct ccdigest_info *di, size_t njobs,
+                           const struct ccdigest_multi_job *jobs);
+
 #define OID_DEF(_VALUE_)  ((const unsigned char *)_VALUE_)
 
 #define CC_DIGEST_OID_MD2           OID_DEF("\x06\x08\x2A\x86\x48\x86\xF7\x0D\x02\x02")
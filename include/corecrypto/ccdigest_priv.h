@@ -35,6 +35,66 @@ void ccdigest_final_64le(const struct ccdigest_info *di, ccdigest_ctx_t ctx, voi
 
 void ccdigest_final_64be(const struct ccdigest_info *di, ccdigest_ctx_t ctx, void *digest);
 
+void ccsha512_final(const struct ccdigest_info *di, ccdigest_ctx_t ctx, void *digest);
+
 void ccdigest_final_fn(const struct ccdigest_info *di, ccdigest_ctx_t ctx, void *digest);
 
+/* How the Merkle-Damgard digests of this library pad their last block and store their digest,
+   for the HMAC loops that keep pre-padded blocks and skip the generic update/final. */
+struct ccdigest_md_format {
+    size_t word_nbytes;
+    size_t length_nbytes;
+    bool le;
+};
+
+/* false if di is not one of them (or its digest is longer than its state) */
+bool ccdigest_md_format(const struct ccdigest_info *di, struct ccdigest_md_format *fmt);
+
+/* the last block of a message of one whole block plus the nbytes at the start of block */
+void ccdigest_md_pad_block(const struct ccdigest_info *di, const struct ccdigest_md_format *fmt,
+                           size_t nbytes, uint8_t *block);
+
+/* the first nbytes of the digest of a finished state */
+void ccdigest_md_store(const struct ccdigest_md_format *fmt, size_t nbytes, const void *state, uint8_t *out);
+
+/* Multi-buffer kernels behind ccdigest_multi_update(). Each one runs nblocks blocks of data[i] through
+   states[i] for all of its lanes at once, using GCC/clang vector extensions for the lane arithmetic. */
+#if defined(__GNUC__) || defined(__clang__)
+#define CCDIGEST_MULTI_SIMD 1
+#else
+#define CCDIGEST_MULTI_SIMD 0
+#endif
+
+/* the AVX2 and AVX-512 widths are only built where cc_runtime_config.h can probe for them */
+#if CCDIGEST_MULTI_SIMD && defined(__x86_64__) && (CCSHA1_VNG_INTEL || CCSHA2_VNG_INTEL || CCAES_INTEL_ASM)
+#define CCDIGEST_MULTI_X86 1
+#else
+#define CCDIGEST_MULTI_X86 0
+#endif
+
+#define CCDIGEST_MULTI_MAX_LANES 16
+
+#define CCDIGEST_MULTI_CPU_ANY    0
+#define CCDIGEST_MULTI_CPU_AVX2   1
+#define CCDIGEST_MULTI_CPU_AVX512 2
+
+typedef void (*ccdigest_multi_compress_f)(ccdigest_state_t *states, size_t nblocks, const uint8_t *const *data);
+
+struct ccdigest_multi_compress {
+    size_t nlanes;
+    int cpu;
+    ccdigest_multi_compress_f compress;
+};
+
+/* widest first, terminated by an entry with nlanes == 0 */
+extern const struct ccdigest_multi_compress ccsha1_multi_compress[];
+extern const struct ccdigest_multi_compress ccsha256_multi_compress[];
+extern const struct ccdigest_multi_compress ccsha512_multi_compress[];
+
+/* kernel table for di, NULL if it has none or the build has no vector extensions */
+const struct ccdigest_multi_compress *ccdigest_multi_kernels(const struct ccdigest_info *di);
+
+/* usable kernel for nactive lanes: the widest that fits, else the narrowest (to be padded with dummy lanes) */
+const struct ccdigest_multi_compress *ccdigest_multi_select(const struct ccdigest_multi_compress *kernels, size_t nactive);
+
 #endif /* _CORECRYPTO_CCDIGEST_PRIV_H_ */
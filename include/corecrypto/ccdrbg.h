@@ -92,8 +92,14 @@ struct ccdrbg_nistctr_custom {
     size_t keylen;
     int strictFIPS;
     int use_df;
+    /* Optional. Requests shorter than this without additional input are served from
+       a keystream buffer of that many bytes (at most CCDRBG_NISTCTR_MAX_BUFFER_SIZE),
+       refilled by one generate. Ignored with strictFIPS. */
+    size_t buffer_nbytes;
 };
 
+#define CCDRBG_NISTCTR_MAX_BUFFER_SIZE 4096
+
 void ccdrbg_factory_nistctr(struct ccdrbg_info *info, const struct ccdrbg_nistctr_custom *custom);
 
 /*
@@ -63,4 +63,34 @@ void cchmac(const struct ccdigest_info *di, size_t key_len,
             const void *key, size_t data_len, const void *data,
             unsigned char *mac);
 
+/* A prepared HMAC key: the inner and outer midstates after compressing
+   key ^ ipad and key ^ opad. Preparing it costs what cchmac_init() does,
+   starting an HMAC from it is two state copies. */
+struct cchmac_key {
+    uint8_t b[1];
+} CC_ALIGNED(8);
+
+typedef struct cchmac_key* cchmac_key_t;
+
+#define cchmac_key_size(STATE_SIZE) (2 * cc_pad_align(STATE_SIZE))
+#define cchmac_key_di_size(_di_)    (cchmac_key_size((_di_)->state_size))
+
+#define cchmac_key_decl(_di_, _name_)  cc_ctx_decl(struct cchmac_key, cchmac_key_di_size(_di_), _name_)
+#define cchmac_key_clear(_di_, _name_) cc_clear(cchmac_key_di_size(_di_), _name_)
+
+#define cchmac_key_istate(_di_, HK) ((struct ccdigest_state *)(((cchmac_key_t)(HK))->b))
+#define cchmac_key_ostate(_di_, HK) ((struct ccdigest_state *)(((cchmac_key_t)(HK))->b + cc_pad_align((_di_)->state_size)))
+
+/* Prepare hk from key, which may be any length. */
+void cchmac_key_init(const struct ccdigest_info *di, cchmac_key_t hk,
+                     size_t key_len, const void *key);
+
+/* Same as cchmac_init() with the key hk was prepared from. */
+void cchmac_init_with_key(const struct ccdigest_info *di, cchmac_ctx_t ctx,
+                          const cchmac_key_t hk);
+
+/* Same as cchmac() with the key hk was prepared from. */
+void cchmac_with_key(const struct ccdigest_info *di, const cchmac_key_t hk,
+                     size_t data_len, const void *data, unsigned char *mac);
+
 #endif /* _CORECRYPTO_CCHMAC_H_ */
@@ -22,8 +22,6 @@
 #include <corecrypto/cc.h>
 #include <corecrypto/cc_config.h>
 
-/* Grasping at straws here. */
-
 /* 5 * 5 * 64 == 1600 */
 struct cckeccak_state {
     uint64_t state[25];
@@ -31,9 +29,40 @@ struct cckeccak_state {
 
 typedef struct cckeccak_state *cckeccak_state_t;
 
+#define CCKECCAK_STATE_NBYTES 200
+
+/* sponge padding bytes: domain separation bits followed by the first pad10*1 bit */
+#define CCKECCAK_SHA3_PADDING  0x06
+#define CCKECCAK_SHAKE_PADDING 0x1f
+
+typedef void (*cckeccak_permutation)(cckeccak_state_t state);
+
 int cckeccak_init_state(cckeccak_state_t state);
 
-typedef int (*cckeccak_permutation)(cckeccak_state_t state, size_t length, const void *data);
+/* Keccak-f[1600], portable C */
+void cckeccak_f1600_c(cckeccak_state_t state);
+
+/* best permutation for this cpu */
+cckeccak_permutation cckeccak_get_permutation(void);
+
+/* xor rate-byte blocks into the state, permuting after each one */
+void cckeccak_absorb_blocks(cckeccak_state_t state, size_t rate, size_t nblocks, const void *data, cckeccak_permutation permutation);
+
+/* xor the final nbytes (< rate) and pad them, the permutation runs on the first squeeze */
+void cckeccak_absorb_and_pad(cckeccak_state_t state, size_t rate, size_t nbytes, const void *data, uint8_t padding);
+
+/* permute and read out up to rate bytes at a time */
+void cckeccak_squeeze(cckeccak_state_t state, size_t rate, size_t nbytes, void *out, cckeccak_permutation permutation);
+
+/*
+ * Four independent states, interleaved lane by lane so the 4-way permutation
+ * can load each lane of all four with one vector load.
+ */
+struct cckeccak_state_x4 {
+    uint64_t state[25][4];
+} CC_ALIGNED(32);
+
+void cckeccak_f1600_x4(struct cckeccak_state_x4 *states);
 
 /*
  000000000001e870 T _cckeccak_absorb_and_pad
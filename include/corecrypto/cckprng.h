@@ -15,7 +15,15 @@
 
 #include <corecrypto/cc.h>
 
+// The kernel extension still registers the Yarrow-based PRNG; every
+// other build gets the portable Fortuna-style implementation below.
+#ifndef CCKPRNG_YARROW
+#if CC_KERNEL
 #define CCKPRNG_YARROW 1
+#else
+#define CCKPRNG_YARROW 0
+#endif
+#endif
 
 #if CCKPRNG_YARROW
 
@@ -156,7 +164,7 @@ struct cckprng_lock_ctx {
     cckprng_lock_mutex mutex;
 };
 
-#else
+#elif defined(__APPLE__)
 
 #include <os/lock.h>
 
@@ -166,6 +174,16 @@ struct cckprng_lock_ctx {
     cckprng_lock_mutex mutex;
 };
 
+#else
+
+#include <pthread.h>
+
+typedef pthread_mutex_t cckprng_lock_mutex;
+
+struct cckprng_lock_ctx {
+    cckprng_lock_mutex mutex;
+};
+
 #endif
 
 struct cckprng_key_ctx {
@@ -352,4 +370,14 @@ void cckprng_refresh(struct cckprng_ctx *ctx);
 */
 void cckprng_generate(struct cckprng_ctx *ctx, unsigned gen_idx, size_t nbytes, void *out);
 
+/*
+  @function cckprng_done
+  @abstract Tear down a kernel PRNG context.
+
+  @param ctx Context for this instance
+
+  @discussion Clears and frees the output generators and their diagnostics, destroys the mutexes and clears @p ctx. No other call may be in progress on @p ctx, and @p ctx must be passed to @p cckprng_init again before any further use.
+*/
+void cckprng_done(struct cckprng_ctx *ctx);
+
 #endif /* _CORECRYPTO_CCKPRNG_H_ */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#ifndef _CORECRYPTO_CCMERKLE_H_
+#define _CORECRYPTO_CCMERKLE_H_
+
+#include <corecrypto/ccdigest.h>
+
+/*
+ * Hash tree over an object cut into leaf_nbytes leaves (the last one may be
+ * shorter). Leaves hash as H(0x00 || leaf) and interior nodes as
+ * H(0x01 || left || right); the last node of a level with an odd number of
+ * nodes moves up unchanged. This is the RFC 6962 Merkle Tree Hash.
+ *
+ * The tree keeps every node digest in caller provided storage, level 0 (the
+ * leaf digests) first and the root last, each level in order. That buffer is
+ * also the serialised tree: ccmerkle_init() over a buffer saved earlier gives
+ * back the same tree, ready for ccmerkle_proof() or ccmerkle_update_leaf().
+ */
+
+struct ccmerkle_tree {
+    const struct ccdigest_info *di;
+    size_t leaf_nbytes;
+    size_t nleaves;
+    size_t nlevels;
+    uint8_t *nodes;
+};
+
+/* Number of leaves for an object of object_nbytes, an empty object has a single empty leaf. */
+#define ccmerkle_nleaves(_leaf_nbytes_, _object_nbytes_) \
+    ((_object_nbytes_) ? ((_object_nbytes_) + (_leaf_nbytes_) - 1) / (_leaf_nbytes_) : 1)
+
+/* Size of the node storage of a tree of nleaves leaves, 0 if it does not fit in a size_t. */
+size_t ccmerkle_nodes_nbytes(const struct ccdigest_info *di, size_t nleaves);
+
+/*!
+    @function   ccmerkle_init
+    @abstract   Set up a tree of nleaves leaves of leaf_nbytes over ccmerkle_nodes_nbytes(di, nleaves) bytes at nodes.
+    @discussion nodes is not touched. Digests with a state over 64 bytes or a block over 128 bytes are not supported.
+ */
+int ccmerkle_init(struct ccmerkle_tree *tree, const struct ccdigest_info *di,
+                  size_t leaf_nbytes, size_t nleaves, void *nodes);
+
+/*!
+    @function   ccmerkle_hash_leaves
+    @abstract   Hash the leaves held in nbytes of data, the first one being leaf first.
+    @discussion nbytes must be a whole number of leaves, but for a range ending with the last leaf of the tree.
+                Leaves are hashed several at a time through ccdigest_multi_update(). Calls on disjoint
+                ranges only write their own leaf digests, so the leaves of a large object can be spread
+                over threads, followed by a single ccmerkle_build().
+ */
+int ccmerkle_hash_leaves(struct ccmerkle_tree *tree, size_t first,
+                         size_t nbytes, const void *data);
+
+/* Hash every interior level from the leaf digests. */
+int ccmerkle_build(struct ccmerkle_tree *tree);
+
+/* Replace leaf leaf with nbytes of data and rehash the nodes on its path to the root. */
+int ccmerkle_update_leaf(struct ccmerkle_tree *tree, size_t leaf,
+                         size_t nbytes, const void *data);
+
+/* Digest of node index of level (0 is the leaf level), NULL if there is no such node. */
+const uint8_t *ccmerkle_node(const struct ccmerkle_tree *tree, size_t level, size_t index);
+
+/* The root digest, di->output_size bytes. */
+#define ccmerkle_root(_tree_) ccmerkle_node((_tree_), (_tree_)->nlevels - 1, 0)
+
+/* Leaf digest of nbytes of data, as stored in the tree. */
+void ccmerkle_hash_leaf(const struct ccdigest_info *di, size_t nbytes,
+                        const void *data, void *digest);
+
+/*!
+    @function   ccmerkle_proof
+    @abstract   Audit path of leaf leaf: the digests of the siblings on its way to the root, lowest first.
+    @param      proof_nbytes  in: size of proof, at most (nlevels - 1) * output_size is needed. out: bytes written.
+ */
+int ccmerkle_proof(const struct ccmerkle_tree *tree, size_t leaf,
+                   size_t *proof_nbytes, void *proof);
+
+/*!
+    @function   ccmerkle_verify_proof
+    @abstract   Check a ccmerkle_proof() of leaf leaf, whose digest is leaf_digest, against root.
+    @result     CCERR_OK if the path leads to root, CCERR_INTEGRITY if not.
+ */
+int ccmerkle_verify_proof(const struct ccdigest_info *di, size_t nleaves, size_t leaf,
+                          const void *leaf_digest, size_t proof_nbytes, const void *proof,
+                          const void *root);
+
+#endif /* _CORECRYPTO_CCMERKLE_H_ */
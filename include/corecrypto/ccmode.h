@@ -420,6 +420,38 @@ int ccxts_one_shot(const struct ccmode_xts *mode,
                    const void *in,
                    void *out);
 
+/*!
+ @function   ccxts_update_sectors
+ @abstract   Encrypt or decrypt a run of consecutive sectors in XTS mode.
+
+ @param      mode          Descriptor for the mode
+ @param      ctx           Context for an instance
+ @param      data_unit     Data unit sequence number of the first sector
+ @param      sector_nbytes Length of a sector in bytes
+ @param      nbytes        Length of the data in bytes
+ @param      in            Input data
+ @param      out           Output buffer
+
+ @result     0 iff successful.
+
+ @discussion Sector i uses the tweak E(tweak_key, data_unit + i), with the
+             sequence number stored little-endian in a 16-byte block as in
+             IEEE 1619. The tweaks of several sectors are encrypted together,
+             and the data blocks are batched across sector boundaries, so
+             sectors shorter than the cipher's batch (8 blocks for the AES
+             modes) do not leave it half empty. Modes without a sector hook
+             fall back to set_tweak and update for each sector.
+             sector_nbytes must be a nonzero multiple of the block size and
+             at most 2^20 blocks, and nbytes a multiple of sector_nbytes.
+ */
+int ccxts_update_sectors(const struct ccmode_xts *mode,
+                         ccxts_ctx *ctx,
+                         uint64_t data_unit,
+                         size_t sector_nbytes,
+                         size_t nbytes,
+                         const void *in,
+                         void *out);
+
 /* Authenticated cipher modes. */
 
 /* GCM mode. */
@@ -786,6 +818,57 @@ int ccgcm_one_shot_legacy(const struct ccmode_gcm *mode,
                           size_t tag_nbytes,
                           void *tag);
 
+/*!
+ @struct     ccgcm_packet
+ @abstract   One message of a @p ccgcm_one_shot_batch call.
+
+ @field      iv_nbytes      Length of the IV in bytes
+ @field      iv             Initialization vector
+ @field      adata_nbytes   Length of the additional data in bytes
+ @field      adata          Additional data to authenticate
+ @field      nbytes         Length of the data in bytes
+ @field      in             Input plaintext or ciphertext
+ @field      out            Output ciphertext or plaintext
+ @field      tag            Authentication tag, as in @p ccgcm_one_shot
+ */
+struct ccgcm_packet {
+    size_t iv_nbytes;
+    const void *iv;
+    size_t adata_nbytes;
+    const void *adata;
+    size_t nbytes;
+    const void *in;
+    void *out;
+    void *tag;
+};
+
+/*!
+ @function   ccgcm_one_shot_batch
+ @abstract   Encrypt or decrypt many messages under one key with GCM.
+
+ @param      mode           Descriptor for the mode
+ @param      key_nbytes     Length of the key in bytes
+ @param      key            Key for the underlying blockcipher (AES)
+ @param      tag_nbytes     Length of every tag in bytes
+ @param      npackets       Number of messages
+ @param      packets        Message descriptors
+ @param      results        Optional, receives the @p ccgcm_one_shot result of each message
+
+ @result     0 iff every message was successful.
+
+ @discussion Equivalent to calling @p ccgcm_one_shot on every packet, but the key schedule and the GHASH key tables are
+ set up once for the whole batch.
+
+ On decryption, the output of a message that fails authentication is still written and must be discarded.
+ */
+int ccgcm_one_shot_batch(const struct ccmode_gcm *mode,
+                         size_t key_nbytes,
+                         const void *key,
+                         size_t tag_nbytes,
+                         size_t npackets,
+                         const struct ccgcm_packet *packets,
+                         int *results);
+
 /* CCM */
 
 #define ccccm_ctx_decl(_size_, _name_) cc_ctx_decl(ccccm_ctx, _size_, _name_)
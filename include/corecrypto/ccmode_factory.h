@@ -266,6 +266,7 @@ struct _ccmode_ctr_key {
 #define CCMODE_FACTORY_CTR_CRYPT(ECB_ENCRYPT) { \
 .size = ccn_sizeof_size(sizeof(struct _ccmode_ctr_key)) + 2 * ccn_sizeof_size((ECB_ENCRYPT)->block_size) + ccn_sizeof_size((ECB_ENCRYPT)->size), \
 .block_size = 1, \
+.ecb_block_size = (ECB_ENCRYPT)->block_size, \
 .init = ccmode_ctr_init, \
 .setctr = ccmode_ctr_setctr, \
 .ctr = ccmode_ctr_crypt, \
@@ -333,6 +334,9 @@ struct _ccmode_gcm_key {
     void *ecb_key;                             // address of the ecb_key in u, set in init function
     int encdec; //is it an encrypt or decrypt object
 
+    // X = (X ^ in[i]) * H for each block, table driven or PCLMULQDQ, set in init function
+    void (*ghash)(struct _ccmode_gcm_key *key, size_t nblocks, const unsigned char *in);
+
     // Buffer with ECB key and H table if applicable
     unsigned char u[] __attribute__ ((aligned (16))); // ecb key + tables
 };
@@ -515,6 +519,9 @@ void *ccmode_xts_crypt(const ccxts_ctx *ctx, ccxts_tweak *tweak,
                        size_t nblocks, const void *in, void *out);
 int ccmode_xts_set_tweak(const ccxts_ctx *ctx, ccxts_tweak *tweak,
                          const void *iv);
+int ccmode_xts_sectors(const ccxts_ctx *ctx, uint64_t data_unit,
+                       size_t sector_nbytes, size_t nbytes,
+                       const void *in, void *out);
 
 
 struct _ccmode_xts_key {
@@ -535,7 +542,7 @@ struct _ccmode_xts_tweak {
 
 /* Use this to statically initialize a ccmode_xts object for decryption. */
 #define CCMODE_FACTORY_XTS_DECRYPT(ECB, ECB_ENCRYPT) { \
-.size = ccn_sizeof_size(sizeof(struct _ccmode_xts_key)) + 2 * ccn_sizeof_size((ECB)->size), \
+.size = ccn_sizeof_size(sizeof(struct _ccmode_xts_key)) + ccn_sizeof_size((ECB)->size) + ccn_sizeof_size((ECB_ENCRYPT)->size), \
 .tweak_size = ccn_sizeof_size(sizeof(struct _ccmode_xts_tweak)) + ccn_sizeof_size(ecb->block_size), \
 .block_size = ecb->block_size, \
 .init = ccmode_xts_init, \
@@ -543,12 +550,13 @@ struct _ccmode_xts_tweak {
 .set_tweak = ccmode_xts_set_tweak, \
 .xts = ccmode_xts_crypt, \
 .custom = (ECB), \
-.custom1 = (ECB_ENCRYPT) \
+.custom1 = (ECB_ENCRYPT), \
+.xts_sectors = ccmode_xts_sectors \
 }
 
 /* Use this to statically initialize a ccmode_xts object for encryption. */
 #define CCMODE_FACTORY_XTS_ENCRYPT(ECB, ECB_ENCRYPT) { \
-.size = ccn_sizeof_size(sizeof(struct _ccmode_xts_key)) + 2 * ccn_sizeof_size((ECB)->size), \
+.size = ccn_sizeof_size(sizeof(struct _ccmode_xts_key)) + ccn_sizeof_size((ECB)->size) + ccn_sizeof_size((ECB_ENCRYPT)->size), \
 .tweak_size = ccn_sizeof_size(sizeof(struct _ccmode_xts_tweak)) + ccn_sizeof_size(ecb->block_size), \
 .block_size = ecb->block_size, \
 .init = ccmode_xts_init, \
@@ -556,7 +564,8 @@ struct _ccmode_xts_tweak {
 .set_tweak = ccmode_xts_set_tweak, \
 .xts = ccmode_xts_crypt, \
 .custom = (ECB), \
-.custom1 = (ECB_ENCRYPT) \
+.custom1 = (ECB_ENCRYPT), \
+.xts_sectors = ccmode_xts_sectors \
 }
 
 /* Use these function to runtime initialize a ccmode_xts decrypt object (for
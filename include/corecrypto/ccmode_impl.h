@@ -153,6 +153,12 @@ struct ccmode_xts {
 
     const void *custom;
     const void *custom1;
+
+    /* Optional. Encrypt or decrypt nbytes of whole sector_nbytes sectors, the
+       first one being data unit data_unit. Arguments are checked by
+       ccxts_update_sectors(), NULL makes it fall back to set_tweak + xts. */
+    int (*xts_sectors)(const ccxts_ctx *ctx, uint64_t data_unit,
+                       size_t sector_nbytes, size_t nbytes, const void *in, void *out);
 };
 
 //7- GCM mode, statful
@@ -204,6 +210,9 @@ struct _ccmode_ccm_nonce {
     uint32_t buflen;       /* length of data in buf */
     uint32_t b_i_len;      /* length of cbcmac data in B_i */
 
+    size_t aad_nbytes;     /* AAD still expected, out of the auth_len given to set_iv */
+    size_t text_nbytes;    /* text still expected, out of the data_len given to set_iv */
+
     size_t nonce_size;
     size_t mac_size;
 };
@@ -19,12 +19,40 @@
 #ifndef _CORECRYPTO_CCMODE_INTERNAL_H_
 #define _CORECRYPTO_CCMODE_INTERNAL_H_
 
+#include <corecrypto/cc_priv.h>
 #include <corecrypto/ccmode.h>
 #include <corecrypto/ccmode_factory.h>
 
+/* XOR two buffers a 64-bit word at a time, finishing any ragged tail bytewise. r may alias s or t. */
+CC_INLINE void ccmode_xor(size_t nbytes, void *r, const void *s, const void *t)
+{
+    uint8_t *_r = (uint8_t *)r;
+    const uint8_t *_s = (const uint8_t *)s;
+    const uint8_t *_t = (const uint8_t *)t;
+
+    for (; nbytes >= sizeof(uint64_t); nbytes -= sizeof(uint64_t)) {
+        uint64_t a, b;
+        cc_memcpy(&a, _s, sizeof(a));
+        cc_memcpy(&b, _t, sizeof(b));
+        a ^= b;
+        cc_memcpy(_r, &a, sizeof(a));
+
+        _r += sizeof(uint64_t);
+        _s += sizeof(uint64_t);
+        _t += sizeof(uint64_t);
+    }
+
+    while (nbytes--) {
+        *_r++ = *_s++ ^ *_t++;
+    }
+}
+
 /* CBC key positioning */
 #define CCMODE_CBC_KEY_ECB_CTX(cbckey) (ccecb_ctx *)cbckey->u
-#define CCMODE_CBC_SCRATCH(ctx) (ctx->u + ccn_sizeof_size(ctx->ecb->size))
+#define CCMODE_CBC_SCRATCH(ctx) (ctx->u + ccn_nof_size(ctx->ecb->size))
+
+/* bytes handed to the ECB backend per call by ccmode_cbc_decrypt, a whole number of 8 and 16 byte blocks */
+#define CCMODE_CBC_DECRYPT_BATCH_NBYTES 256
 
 /* CFB key fields */
 #define CCMODE_CFB_KEY_FEEDBACK(ctx) ctx->u
@@ -39,8 +67,30 @@
 #define CCMODE_CFB8_KEY_ECB_CTX(ctx) (ccecb_ctx *)ctx->u + (2 * ccn_sizeof_size(ctx->ecb->block_size))
 
 #define CCMODE_CTR_KEY_COUNTER(ckey) ckey->u
-#define CCMODE_CTR_KEY_PAD(ckey)     (ckey->u + ccn_sizeof_size(ckey->ecb->block_size))
-#define CCMODE_CTR_KEY_ECB_CTX(ckey) (ccecb_ctx *)(ckey->u + ccn_sizeof_size(ckey->ecb->block_size) * 2)
+#define CCMODE_CTR_KEY_PAD(ckey)     (ckey->u + ccn_nof_size(ckey->ecb->block_size))
+#define CCMODE_CTR_KEY_ECB_CTX(ckey) (ccecb_ctx *)(ckey->u + ccn_nof_size(ckey->ecb->block_size) * 2)
+
+/* Number of counter blocks handed to the ECB backend in one call. */
+#define CCMODE_CTR_MAX_PARALLEL_NBLOCKS 8
+
+/* Largest ECB block the generic CTR bulk path sizes its keystream buffer for. */
+#define CCMODE_CTR_MAX_BLOCK_NBYTES 16
+
+/* Big-endian increment of the whole counter block. */
+CC_INLINE void ccmode_ctr_inc(size_t nbytes, uint8_t *ctr)
+{
+    while (nbytes--) {
+        if (++ctr[nbytes] != 0) {
+            break;
+        }
+    }
+}
+
+/* Encrypts nblocks whole blocks of in into out and advances the counter by nblocks. */
+typedef void (*ccmode_ctr_blocks_f)(struct _ccmode_ctr_key *ckey, size_t nblocks, const uint8_t *in, uint8_t *out);
+
+/* Drains buffered keystream, hands whole blocks to blocks_f, then buffers keystream for the tail. */
+int ccmode_ctr_crypt_with(struct _ccmode_ctr_key *ckey, size_t nbytes, const void *in, void *out, ccmode_ctr_blocks_f blocks_f);
 
 #define CCMODE_OFB_KEY_IV(okey)      okey->u
 #define CCMODE_OFB_KEY_ECB_CTX(okey) (ccecb_ctx *)okey->u + ccn_sizeof_size(okey->ecb->block_size)
@@ -48,9 +98,116 @@
 #define CCMODE_XTS_TWEAK_MAX_BLOCKS_PROCESSED 0x100000
 
 #define CCMODE_XTS_KEY_ECB_CTX(xkey) (ccecb_ctx *)xkey->u
-#define CCMODE_XTS_KEY_ECB_ENCRYPT_CTX(xkey) (ccecb_ctx *)xkey->u + ccn_sizeof_size(xkey->ecb->block_size)
+#define CCMODE_XTS_KEY_ECB_ENCRYPT_CTX(xkey) (ccecb_ctx *)(xkey->u + ccn_nof_size(xkey->ecb->size))
+
+/* blocks per ECB call in ccmode_xts_crypt */
+#define CCMODE_XTS_MAX_PARALLEL_NBLOCKS 8
+
+/* sector tweaks per ECB call in ccmode_xts_sectors */
+#define CCMODE_XTS_SECTORS_NTWEAKS 8
+
+/* T = T * alpha in GF(2^128), see ccmode_xts_crypt.c */
+void ccmode_xts_mult_alpha(uint8_t *I);
+
+/* IEEE 1619 tweak input: the data unit sequence number as a 128-bit little-endian value */
+CC_INLINE void ccmode_xts_data_unit_iv(uint64_t data_unit, uint8_t *iv)
+{
+    CC_STORE64_LE(data_unit, iv);
+    cc_clear(8, iv + 8);
+}
+
+/* GCM key fields, the ECB key sits at the start of u[] with the H table right after it */
+#define _CCMODE_GCM_KEY(ctx)         ((struct _ccmode_gcm_key *)(ctx))
+#define CCMODE_GCM_KEY_ECB_CTX(gkey) ((ccecb_ctx *)(gkey)->ecb_key)
+#define CCMODE_GCM_KEY_HTABLE(gkey)  ((gkey)->u + ccn_sizeof_size((gkey)->ecb->size))
+
+/* 4-bit Shoup table (16 x 128-bit entries); the PCLMULQDQ path keeps H^1..H^8 and their Karatsuba halves here instead. */
+#define CCMODE_GCM_HTABLE_NBYTES 256
+
+#define CCMODE_GCM_KEY_SIZE(ecb) \
+    (sizeof(struct _ccmode_gcm_key) + ccn_sizeof_size((ecb)->size) + CCMODE_GCM_HTABLE_NBYTES)
+
+/* _ccmode_gcm_key->state */
+#define CCMODE_GCM_STATE_INIT  1 /* key set, needs an IV */
+#define CCMODE_GCM_STATE_IV    2
+#define CCMODE_GCM_STATE_AAD   3
+#define CCMODE_GCM_STATE_TEXT  4
+#define CCMODE_GCM_STATE_FINAL 5
+
+/* Increment the low 32 bits of a counter block, as GCM's inc32() does. */
+CC_INLINE void ccmode_gcm_inc32(uint8_t *Y)
+{
+    uint32_t ctr;
+    CC_LOAD32_BE(ctr, Y + 12);
+    ctr++;
+    CC_STORE32_BE(ctr, Y + 12);
+}
+
+/* Number of counter blocks the generic path encrypts per ECB call. */
+#define CCMODE_GCM_MAX_PARALLEL_NBLOCKS 8
+
+/* ks = E(K, inc32(Y)) .. E(K, inc32^n(Y)), leaving Y at the last counter used. */
+CC_INLINE void ccmode_gcm_keystream(struct _ccmode_gcm_key *key, size_t nblocks, uint8_t *ks)
+{
+    for (size_t i = 0; i < nblocks; i++) {
+        ccmode_gcm_inc32(key->Y);
+        cc_memcpy(ks + i * CCGCM_BLOCK_NBYTES, key->Y, CCGCM_BLOCK_NBYTES);
+    }
+
+    key->ecb->ecb(CCMODE_GCM_KEY_ECB_CTX(key), nblocks, ks, ks);
+}
+
+/* X = X * H, for when a partial block has already been XORed into X. */
+CC_INLINE void ccmode_gcm_mult_x(struct _ccmode_gcm_key *key)
+{
+    static const unsigned char zero[CCGCM_BLOCK_NBYTES] = { 0 };
+    key->ghash(key, 1, zero);
+}
+
+/* Portable GHASH, see ccmode_gcm_ghash.c */
+void ccmode_gcm_gen_table(struct _ccmode_gcm_key *key);
+void ccmode_gcm_ghash_table(struct _ccmode_gcm_key *key, size_t nblocks, const unsigned char *in);
+
+#if CCMODE_GCM_VNG_SPEEDUP
+/* PCLMULQDQ GHASH, see src/aes/intel/ccaes_vng_gcm_ghash.c */
+void ccmode_gcm_gen_table_clmul(struct _ccmode_gcm_key *key);
+void ccmode_gcm_ghash_clmul(struct _ccmode_gcm_key *key, size_t nblocks, const unsigned char *in);
+#endif
+
+/* Set the IV without the zero-length check, shared with ccgcm_set_iv_legacy(). */
+int ccmode_gcm_set_iv_internal(ccgcm_ctx *ctx, size_t iv_nbytes, const void *iv);
+
+/* Encrypts or decrypts nblocks whole blocks and folds the ciphertext into X, Y is advanced by nblocks. */
+typedef void (*ccmode_gcm_blocks_f)(struct _ccmode_gcm_key *key, size_t nblocks, const uint8_t *in, uint8_t *out);
+
+/* State checks, partial blocks and length accounting around blocks_f. */
+int ccmode_gcm_crypt_with(ccgcm_ctx *ctx, size_t nbytes, const void *in, void *out, ccmode_gcm_blocks_f blocks_f);
+
+/* CCM key and nonce fields */
+#define CCMODE_CCM_BLOCK_NBYTES      16
+#define _CCMODE_CCM_KEY(ctx)         ((struct _ccmode_ccm_key *)(ctx))
+#define _CCMODE_CCM_NONCE(nonce_ctx) ((struct _ccmode_ccm_nonce *)(nonce_ctx))
+#define CCMODE_CCM_KEY_ECB_CTX(ckey) ((ccecb_ctx *)(ckey)->u)
+
+/* _ccmode_ccm_nonce->mode */
+#define CCMODE_CCM_STATE_IV   1 /* nonce set, B_0 and the AAD length are in the MAC */
+#define CCMODE_CCM_STATE_AAD  2
+#define CCMODE_CCM_STATE_TEXT 3
+#define CCMODE_CCM_STATE_MAC  4
+
+/* length of the counter field at the end of A_i */
+#define CCMODE_CCM_L(nonce) (15 - (nonce)->nonce_size)
+
+/*
+ * Runs nblocks whole blocks through CTR and CBC-MAC together. Called with no partial block pending; advances A_i
+ * by nblocks and leaves the MAC in B_i.
+ */
+typedef void (*ccmode_ccm_blocks_f)(struct _ccmode_ccm_key *key, struct _ccmode_ccm_nonce *nonce, size_t nblocks,
+                                    const uint8_t *in, uint8_t *out);
 
-#define CCMODE_GCM_KEY_ECB_CTX(gkey) (ccecb_ctx *)gkey->u + ccn_sizeof_size(gkey->ecb->block_size)
+/* State checks and partial blocks around blocks_f, shared by the encrypt and decrypt entry points. */
+int ccmode_ccm_crypt_with(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out,
+                          int encrypting, ccmode_ccm_blocks_f blocks_f);
 
 /* this is exported to the symbol table, see cc_exports.txt */
 void ccmode_gcm_gf_mult(const unsigned char *a, const unsigned char *b, unsigned char *c);
@@ -62,11 +62,11 @@ size_t ccpad_pkcs7_ecb_encrypt(const struct ccmode_ecb *ecb, ccecb_ctx *ctx,
 /* Function common to ccpad_pkcs7_ecb_decrypt and ccpad_pkcs7_decrypt */
 size_t ccpad_pkcs7_decode(const size_t block_size, const uint8_t* last_block);
 
-/* Contract is nbytes is at least 1 block + 1 byte.  Also in is nbytes long out is nbytes long. */
+/* Contract is nbytes is at least 1 block.  Also in is nbytes long out is nbytes long.  Anything shorter is left alone, and 0 is returned. */
 size_t ccpad_xts_decrypt(const struct ccmode_xts *xts, ccxts_ctx *ctx, ccxts_tweak *tweak,
                        size_t nbytes, const void *in, void *out);
 
-/* Contract is nbytes is at least 1 block + 1 byte.  Also in is nbytes long out is nbytes long. */
+/* Contract is nbytes is at least 1 block.  Also in is nbytes long out is nbytes long.  Anything shorter is left alone. */
 void ccpad_xts_encrypt(const struct ccmode_xts *xts, ccxts_ctx *ctx, ccxts_tweak *tweak,
                        size_t nbytes, const void *in, void *out);
 
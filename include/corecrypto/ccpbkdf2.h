@@ -39,4 +39,23 @@ int ccpbkdf2_hmac(const struct ccdigest_info *di,
                    size_t iterations,
                    size_t dkLen, void *dk);
 
+struct ccpbkdf2_hmac_job {
+    size_t password_nbytes;
+    const void *password;
+    size_t salt_nbytes;
+    const void *salt;
+    void *dk;       /* dk_nbytes of output */
+};
+
+/*!
+    @function   ccpbkdf2_hmac_multi
+    @abstract   ccpbkdf2_hmac() for several passwords with the same digest, iteration count and output length.
+    @discussion The output blocks of all jobs are iterated side by side, several to a vector register when
+                di has a multi-buffer compress (see ccdigest_multi_update()).
+ */
+int ccpbkdf2_hmac_multi(const struct ccdigest_info *di,
+                        size_t njobs, const struct ccpbkdf2_hmac_job *jobs,
+                        size_t iterations,
+                        size_t dk_nbytes);
+
 #endif /* _CORECRYPTO_CCPBKDF2_H_ */
@@ -41,6 +41,7 @@ struct ccrng_state {
  - Entropy accumulation
  - Backtracing resistance
  - Prediction break with frequent (asynchronous) reseed
+ - Each thread generates from its own DRBG, without locks. A forked child reseeds before its first output.
  */
 
 struct ccrng_state *ccrng(int *error);
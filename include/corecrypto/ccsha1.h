@@ -27,6 +27,8 @@ extern const struct ccdigest_info ccsha1_eay_di;
 
 #if  CCSHA1_VNG_INTEL
 extern const struct ccdigest_info ccsha1_vng_intel_SupplementalSSE3_di;
+extern const struct ccdigest_info ccsha1_vng_intel_AVX2_di;
+extern const struct ccdigest_info ccsha1_vng_intel_shani_di;
 #endif
 
 #if  CCSHA1_VNG_ARM
@@ -72,6 +72,16 @@ extern const struct ccdigest_info ccsha224_vng_intel_SupplementalSSE3_di;
 extern const struct ccdigest_info ccsha256_vng_intel_SupplementalSSE3_di;
 extern const struct ccdigest_info ccsha224_vng_intel_shani_di;
 extern const struct ccdigest_info ccsha256_vng_intel_shani_di;
+extern const struct ccdigest_info ccsha224_vng_intel_AVX2_di;
+extern const struct ccdigest_info ccsha256_vng_intel_AVX2_di;
+extern const struct ccdigest_info ccsha384_vng_intel_AVX2_di;
+extern const struct ccdigest_info ccsha512_vng_intel_AVX2_di;
+extern const struct ccdigest_info ccsha512_224_vng_intel_AVX2_di;
+extern const struct ccdigest_info ccsha512_256_vng_intel_AVX2_di;
+extern const struct ccdigest_info ccsha384_vng_intel_AVX512_di;
+extern const struct ccdigest_info ccsha512_vng_intel_AVX512_di;
+extern const struct ccdigest_info ccsha512_224_vng_intel_AVX512_di;
+extern const struct ccdigest_info ccsha512_256_vng_intel_AVX512_di;
 #endif
 #if  CCSHA2_VNG_ARM
 extern const struct ccdigest_info ccsha224_vng_arm_di;
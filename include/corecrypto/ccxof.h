@@ -20,6 +20,7 @@
 #define _CORECRYPTO_CCXOF_H_
 
 #include <corecrypto/cc.h>
+#include <stdbool.h>
 
 /*
  zormeister@Zormeisters-Mac-Pro ~ % nm /Volumes/Developer/Binaries/Apple/15.2/KDK.pkg/Payload/System/Library/Extensions/corecrypto.kext/Contents/MacOS/corecrypto | grep shake
@@ -54,10 +55,60 @@
     00000000000413ea T _ccxof_squeeze
  */
 
-struct ccxof_info {};
+#define CCXOF_STATE_MAX_NBYTES 200
+#define CCXOF_BLOCK_MAX_NBYTES 168
+
+#define CCSHAKE128_RATE 168
+#define CCSHAKE256_RATE 136
+
+struct ccxof_state {
+    uint64_t u64[CCXOF_STATE_MAX_NBYTES / 8];
+};
+
+typedef struct ccxof_state *ccxof_state_t;
+
+struct ccxof_info {
+    size_t state_nbytes;
+    size_t block_nbytes;
+    void (*init)(const struct ccxof_info *xi, ccxof_state_t state);
+    /* absorb whole blocks */
+    void (*absorb)(const struct ccxof_info *xi, ccxof_state_t state, size_t nblocks, const uint8_t *in);
+    /* absorb the final in_nbytes (< block_nbytes) and pad */
+    void (*absorb_last)(const struct ccxof_info *xi, ccxof_state_t state, size_t in_nbytes, const uint8_t *in);
+    /* produce out_nbytes, a multiple of block_nbytes unless it is the last call */
+    void (*squeeze)(const struct ccxof_info *xi, ccxof_state_t state, size_t out_nbytes, uint8_t *out);
+};
+
+/* buffer holds unabsorbed input while absorbing and unread output once squeezing */
+struct ccxof_ctx {
+    struct ccxof_state state;
+    uint8_t buffer[CCXOF_BLOCK_MAX_NBYTES];
+    size_t nbytes;
+    bool squeezing;
+};
+
+typedef struct ccxof_ctx *ccxof_ctx_t;
+
+void ccxof_init(const struct ccxof_info *xi, ccxof_ctx_t ctx);
+
+/* returns CCERR_CALL_SEQUENCE once ccxof_squeeze() has been called */
+int ccxof_absorb(const struct ccxof_info *xi, ccxof_ctx_t ctx, size_t in_nbytes, const void *in);
+
+/* may be called any number of times, the output is one continuous stream */
+void ccxof_squeeze(const struct ccxof_info *xi, ccxof_ctx_t ctx, size_t out_nbytes, void *out);
 
 // found in 15.2 corecrypto.kext by running NM
 const struct ccxof_info *ccshake128_xi(void);
 const struct ccxof_info *ccshake256_xi(void);
 
+void ccshake128(size_t in_nbytes, const void *in, size_t out_nbytes, void *out);
+void ccshake256(size_t in_nbytes, const void *in, size_t out_nbytes, void *out);
+
+/*
+ * Four SHAKE calls of the same input and output length at once, on the 4-way
+ * Keccak permutation. Meant for the many short hashes of hash-based signatures.
+ */
+void ccshake128_x4(size_t in_nbytes, const void *const in[4], size_t out_nbytes, void *const out[4]);
+void ccshake256_x4(size_t in_nbytes, const void *const in[4], size_t out_nbytes, void *const out[4]);
+
 #endif
@@ -99,9 +99,10 @@ int cczp_init(cczp_t zp);
 CC_NONNULL((1, 2))
 void cczp_init_with_recip(cczp_t zp, const cc_unit *recip);
 
-/* Compute r = m ^ e mod cczp_prime(zp), using Montgomery ladder.
+/* Compute r = m ^ e mod cczp_prime(zp), using a fixed-window exponentiation in
+   the Montgomery domain whose running time only depends on cczp_n(zp).
    - writes cczp_n(zp) units to r
-   - reads  cczp_n(zp) units units from m and e
+   - reads  cczp_n(zp) units units from m and e, m need not be reduced mod p
    - if r and m are not identical they must not overlap.
    - r and e must not overlap nor be identical.
    - before calling this function either cczp_init(zp) must have been called
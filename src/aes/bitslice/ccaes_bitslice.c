@@ -0,0 +1,530 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include "ccaes_bitslice_internal.h"
+#include <corecrypto/cc_priv.h>
+
+typedef ccaes_bitslice_word bs_word;
+
+/* Boyar-Peralta S-box circuit: 32 AND, 83 XOR, 4 NOT. */
+static void ccaes_bitslice_sbox(bs_word *q)
+{
+    bs_word x0, x1, x2, x3, x4, x5, x6, x7;
+    bs_word y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11, y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+    bs_word z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15, z16, z17;
+    bs_word t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16, t17, t18, t19, t20, t21,
+        t22, t23, t24, t25, t26, t27, t28, t29, t30, t31, t32, t33, t34, t35, t36, t37, t38, t39, t40, t41, t42,
+        t43, t44, t45, t46, t47, t48, t49, t50, t51, t52, t53, t54, t55, t56, t57, t58, t59, t60, t61, t62, t63,
+        t64, t65, t66, t67;
+    bs_word s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    /* top linear transformation */
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    /* non-linear section, the inversion in GF(2^8) */
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    /* bottom linear transformation, with the affine constant folded into the NOTs */
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+/* the inverse of the S-box affine map, a linear map plus the constant 0x05 */
+static void ccaes_bitslice_inv_affine(bs_word *q)
+{
+    bs_word q0 = ~q[0], q1 = ~q[1], q2 = q[2], q3 = q[3], q4 = q[4], q5 = ~q[5], q6 = ~q[6], q7 = q[7];
+
+    q[7] = q1 ^ q4 ^ q6;
+    q[6] = q0 ^ q3 ^ q5;
+    q[5] = q7 ^ q2 ^ q4;
+    q[4] = q6 ^ q1 ^ q3;
+    q[3] = q5 ^ q0 ^ q2;
+    q[2] = q4 ^ q7 ^ q1;
+    q[1] = q3 ^ q6 ^ q0;
+    q[0] = q2 ^ q5 ^ q7;
+}
+
+/* InvS = A^-1 . S . A^-1, since the inversion is its own inverse */
+static void ccaes_bitslice_inv_sbox(bs_word *q)
+{
+    ccaes_bitslice_inv_affine(q);
+    ccaes_bitslice_sbox(q);
+    ccaes_bitslice_inv_affine(q);
+}
+
+/* transposes between byte-interleaved words and bit planes, its own inverse */
+static void ccaes_bitslice_ortho(bs_word *q)
+{
+#define SWAPN(cl, ch, s, x, y)                            \
+    do {                                                  \
+        bs_word a = (x), b = (y);                         \
+        (x) = (a & (uint64_t)(cl)) | ((b & (uint64_t)(cl)) << (s)); \
+        (y) = ((a & (uint64_t)(ch)) >> (s)) | (b & (uint64_t)(ch)); \
+    } while (0)
+
+#define SWAP2(x, y) SWAPN(0x5555555555555555, 0xAAAAAAAAAAAAAAAA, 1, x, y)
+#define SWAP4(x, y) SWAPN(0x3333333333333333, 0xCCCCCCCCCCCCCCCC, 2, x, y)
+#define SWAP8(x, y) SWAPN(0x0F0F0F0F0F0F0F0F, 0xF0F0F0F0F0F0F0F0, 4, x, y)
+
+    SWAP2(q[0], q[1]);
+    SWAP2(q[2], q[3]);
+    SWAP2(q[4], q[5]);
+    SWAP2(q[6], q[7]);
+
+    SWAP4(q[0], q[2]);
+    SWAP4(q[1], q[3]);
+    SWAP4(q[4], q[6]);
+    SWAP4(q[5], q[7]);
+
+    SWAP8(q[0], q[4]);
+    SWAP8(q[1], q[5]);
+    SWAP8(q[2], q[6]);
+    SWAP8(q[3], q[7]);
+
+#undef SWAP8
+#undef SWAP4
+#undef SWAP2
+#undef SWAPN
+}
+
+/* spreads the four little-endian words of a block over two 64-bit words, 16 bits at a time */
+static void ccaes_bitslice_interleave_in(uint64_t *q0, uint64_t *q1, const uint32_t *w)
+{
+    uint64_t x0 = w[0], x1 = w[1], x2 = w[2], x3 = w[3];
+
+    x0 |= (x0 << 16);
+    x1 |= (x1 << 16);
+    x2 |= (x2 << 16);
+    x3 |= (x3 << 16);
+    x0 &= 0x0000FFFF0000FFFF;
+    x1 &= 0x0000FFFF0000FFFF;
+    x2 &= 0x0000FFFF0000FFFF;
+    x3 &= 0x0000FFFF0000FFFF;
+    x0 |= (x0 << 8);
+    x1 |= (x1 << 8);
+    x2 |= (x2 << 8);
+    x3 |= (x3 << 8);
+    x0 &= 0x00FF00FF00FF00FF;
+    x1 &= 0x00FF00FF00FF00FF;
+    x2 &= 0x00FF00FF00FF00FF;
+    x3 &= 0x00FF00FF00FF00FF;
+    *q0 = x0 | (x2 << 8);
+    *q1 = x1 | (x3 << 8);
+}
+
+static void ccaes_bitslice_interleave_out(uint32_t *w, uint64_t q0, uint64_t q1)
+{
+    uint64_t x0, x1, x2, x3;
+
+    x0 = q0 & 0x00FF00FF00FF00FF;
+    x1 = q1 & 0x00FF00FF00FF00FF;
+    x2 = (q0 >> 8) & 0x00FF00FF00FF00FF;
+    x3 = (q1 >> 8) & 0x00FF00FF00FF00FF;
+    x0 |= (x0 >> 8);
+    x1 |= (x1 >> 8);
+    x2 |= (x2 >> 8);
+    x3 |= (x3 >> 8);
+    x0 &= 0x0000FFFF0000FFFF;
+    x1 &= 0x0000FFFF0000FFFF;
+    x2 &= 0x0000FFFF0000FFFF;
+    x3 &= 0x0000FFFF0000FFFF;
+    w[0] = (uint32_t)x0 | (uint32_t)(x0 >> 16);
+    w[1] = (uint32_t)x1 | (uint32_t)(x1 >> 16);
+    w[2] = (uint32_t)x2 | (uint32_t)(x2 >> 16);
+    w[3] = (uint32_t)x3 | (uint32_t)(x3 >> 16);
+}
+
+static uint32_t ccaes_bitslice_sub_word(uint32_t x)
+{
+    bs_word q[8];
+
+    cc_clear(sizeof(q), q);
+    CCAES_BITSLICE_LANE(q[0], 0) = x;
+    ccaes_bitslice_ortho(q);
+    ccaes_bitslice_sbox(q);
+    ccaes_bitslice_ortho(q);
+
+    return (uint32_t)CCAES_BITSLICE_LANE(q[0], 0);
+}
+
+int ccaes_bitslice_init(struct ccaes_bitslice_key *key, size_t key_nbytes, const void *rawkey)
+{
+    static const uint8_t rcon[] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36 };
+    const uint8_t *k = rawkey;
+    uint32_t w[60];
+    uint32_t tmp;
+    size_t nk, nw, i, j, r;
+
+    if (key_nbytes != CCAES_KEY_SIZE_128 && key_nbytes != CCAES_KEY_SIZE_192 && key_nbytes != CCAES_KEY_SIZE_256) {
+        return CCERR_PARAMETER;
+    }
+
+    nk = key_nbytes / 4;
+    key->nrounds = (uint32_t)(nk + 6);
+    nw = 4 * (key->nrounds + 1);
+
+    /* FIPS-197 key expansion, on little-endian words */
+    for (i = 0; i < nk; i++) {
+        CC_LOAD32_LE(w[i], k + 4 * i);
+    }
+    tmp = w[nk - 1];
+    for (i = nk, j = 0, r = 0; i < nw; i++) {
+        if (j == 0) {
+            tmp = (tmp << 24) | (tmp >> 8);
+            tmp = ccaes_bitslice_sub_word(tmp) ^ rcon[r];
+        } else if (nk > 6 && j == 4) {
+            tmp = ccaes_bitslice_sub_word(tmp);
+        }
+        tmp ^= w[i - nk];
+        w[i] = tmp;
+        if (++j == nk) {
+            j = 0;
+            r++;
+        }
+    }
+
+    /* each round key to bit planes, replicated across the four block slots of a lane */
+    for (i = 0; i < nw; i += 4) {
+        bs_word q[8];
+        uint64_t q0, q4;
+
+        cc_clear(sizeof(q), q);
+        ccaes_bitslice_interleave_in(&q0, &q4, w + i);
+        for (j = 0; j < 4; j++) {
+            CCAES_BITSLICE_LANE(q[j], 0) = q0;
+            CCAES_BITSLICE_LANE(q[j + 4], 0) = q4;
+        }
+        ccaes_bitslice_ortho(q);
+        for (j = 0; j < 8; j++) {
+            key->sk[2 * i + j] = CCAES_BITSLICE_LANE(q[j], 0);
+        }
+        cc_clear(sizeof(q), q);
+    }
+
+    cc_clear(sizeof(w), w);
+
+    return CCERR_OK;
+}
+
+static void ccaes_bitslice_add_round_key(bs_word *q, const uint64_t *sk)
+{
+    for (int i = 0; i < 8; i++) {
+        q[i] ^= sk[i];
+    }
+}
+
+static void ccaes_bitslice_shift_rows(bs_word *q)
+{
+    for (int i = 0; i < 8; i++) {
+        bs_word x = q[i];
+
+        q[i] = (x & (uint64_t)0x000000000000FFFF) | ((x & (uint64_t)0x00000000FFF00000) >> 4) |
+               ((x & (uint64_t)0x00000000000F0000) << 12) | ((x & (uint64_t)0x0000FF0000000000) >> 8) |
+               ((x & (uint64_t)0x000000FF00000000) << 8) | ((x & (uint64_t)0xF000000000000000) >> 12) |
+               ((x & (uint64_t)0x0FFF000000000000) << 4);
+    }
+}
+
+static void ccaes_bitslice_inv_shift_rows(bs_word *q)
+{
+    for (int i = 0; i < 8; i++) {
+        bs_word x = q[i];
+
+        q[i] = (x & (uint64_t)0x000000000000FFFF) | ((x & (uint64_t)0x000000000FFF0000) << 4) |
+               ((x & (uint64_t)0x00000000F0000000) >> 12) | ((x & (uint64_t)0x000000FF00000000) << 8) |
+               ((x & (uint64_t)0x0000FF0000000000) >> 8) | ((x & (uint64_t)0x000F000000000000) << 12) |
+               ((x & (uint64_t)0xFFF0000000000000) >> 4);
+    }
+}
+
+#define ROTR32(x) (((x) << 32) | ((x) >> 32))
+
+static void ccaes_bitslice_mix_columns(bs_word *q)
+{
+    bs_word q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3], q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    bs_word r0, r1, r2, r3, r4, r5, r6, r7;
+
+    r0 = (q0 >> 16) | (q0 << 48);
+    r1 = (q1 >> 16) | (q1 << 48);
+    r2 = (q2 >> 16) | (q2 << 48);
+    r3 = (q3 >> 16) | (q3 << 48);
+    r4 = (q4 >> 16) | (q4 << 48);
+    r5 = (q5 >> 16) | (q5 << 48);
+    r6 = (q6 >> 16) | (q6 << 48);
+    r7 = (q7 >> 16) | (q7 << 48);
+
+    q[0] = q7 ^ r7 ^ r0 ^ ROTR32(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ ROTR32(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ ROTR32(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ ROTR32(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ ROTR32(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ ROTR32(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ ROTR32(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ ROTR32(q7 ^ r7);
+}
+
+static void ccaes_bitslice_inv_mix_columns(bs_word *q)
+{
+    bs_word q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3], q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    bs_word r0, r1, r2, r3, r4, r5, r6, r7;
+
+    r0 = (q0 >> 16) | (q0 << 48);
+    r1 = (q1 >> 16) | (q1 << 48);
+    r2 = (q2 >> 16) | (q2 << 48);
+    r3 = (q3 >> 16) | (q3 << 48);
+    r4 = (q4 >> 16) | (q4 << 48);
+    r5 = (q5 >> 16) | (q5 << 48);
+    r6 = (q6 >> 16) | (q6 << 48);
+    r7 = (q7 >> 16) | (q7 << 48);
+
+    q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ ROTR32(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+    q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^ ROTR32(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+    q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^ ROTR32(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+    q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5 ^ ROTR32(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+    q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7 ^ ROTR32(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+    q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7 ^ ROTR32(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+    q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7 ^ ROTR32(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+    q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^ ROTR32(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+/* loads up to CCAES_BITSLICE_NBLOCKS blocks into bit planes, missing blocks are zero */
+static void ccaes_bitslice_load(bs_word *q, size_t nblocks, const uint8_t *in)
+{
+    for (int i = 0; i < 8; i++) {
+        q[i] = (bs_word){ 0 };
+    }
+
+    for (size_t b = 0; b < nblocks; b++) {
+        uint32_t w[4];
+        uint64_t q0, q1;
+
+        for (int i = 0; i < 4; i++) {
+            CC_LOAD32_LE(w[i], in + 16 * b + 4 * i);
+        }
+        ccaes_bitslice_interleave_in(&q0, &q1, w);
+        CCAES_BITSLICE_LANE(q[b & 3], b >> 2) = q0;
+        CCAES_BITSLICE_LANE(q[(b & 3) + 4], b >> 2) = q1;
+    }
+
+    ccaes_bitslice_ortho(q);
+}
+
+static void ccaes_bitslice_store(bs_word *q, size_t nblocks, uint8_t *out)
+{
+    ccaes_bitslice_ortho(q);
+
+    for (size_t b = 0; b < nblocks; b++) {
+        uint32_t w[4];
+
+        ccaes_bitslice_interleave_out(w, CCAES_BITSLICE_LANE(q[b & 3], b >> 2), CCAES_BITSLICE_LANE(q[(b & 3) + 4], b >> 2));
+        for (int i = 0; i < 4; i++) {
+            CC_STORE32_LE(w[i], out + 16 * b + 4 * i);
+        }
+    }
+}
+
+void ccaes_bitslice_encrypt(const struct ccaes_bitslice_key *key, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    bs_word q[8];
+
+    while (nblocks) {
+        size_t n = CC_MIN(nblocks, CCAES_BITSLICE_NBLOCKS);
+
+        ccaes_bitslice_load(q, n, in);
+
+        ccaes_bitslice_add_round_key(q, key->sk);
+        for (uint32_t r = 1; r < key->nrounds; r++) {
+            ccaes_bitslice_sbox(q);
+            ccaes_bitslice_shift_rows(q);
+            ccaes_bitslice_mix_columns(q);
+            ccaes_bitslice_add_round_key(q, key->sk + 8 * r);
+        }
+        ccaes_bitslice_sbox(q);
+        ccaes_bitslice_shift_rows(q);
+        ccaes_bitslice_add_round_key(q, key->sk + 8 * key->nrounds);
+
+        ccaes_bitslice_store(q, n, out);
+
+        in += 16 * n;
+        out += 16 * n;
+        nblocks -= n;
+    }
+
+    cc_clear(sizeof(q), q);
+}
+
+void ccaes_bitslice_decrypt(const struct ccaes_bitslice_key *key, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    bs_word q[8];
+
+    while (nblocks) {
+        size_t n = CC_MIN(nblocks, CCAES_BITSLICE_NBLOCKS);
+
+        ccaes_bitslice_load(q, n, in);
+
+        ccaes_bitslice_add_round_key(q, key->sk + 8 * key->nrounds);
+        for (uint32_t r = key->nrounds - 1; r > 0; r--) {
+            ccaes_bitslice_inv_shift_rows(q);
+            ccaes_bitslice_inv_sbox(q);
+            ccaes_bitslice_add_round_key(q, key->sk + 8 * r);
+            ccaes_bitslice_inv_mix_columns(q);
+        }
+        ccaes_bitslice_inv_shift_rows(q);
+        ccaes_bitslice_inv_sbox(q);
+        ccaes_bitslice_add_round_key(q, key->sk);
+
+        ccaes_bitslice_store(q, n, out);
+
+        in += 16 * n;
+        out += 16 * n;
+        nblocks -= n;
+    }
+
+    cc_clear(sizeof(q), q);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#ifndef _CORECRYPTO_CCAES_BITSLICE_INTERNAL_H_
+#define _CORECRYPTO_CCAES_BITSLICE_INTERNAL_H_
+
+#include <corecrypto/ccaes.h>
+
+/*
+ * Constant-time bitsliced AES, after Käsper & Schwabe and the 64-bit layout of Thomas Pornin's BearSSL aes_ct64.
+ *
+ * Eight words hold one bit plane each of four blocks per 64-bit lane. With GCC/clang vector extensions a word is two
+ * lanes (an SSE2/NEON register), so eight blocks go through the rounds together; otherwise it is a plain uint64_t and
+ * four blocks do. There are no table lookups and no secret-dependent branches or addresses.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+typedef uint64_t ccaes_bitslice_word __attribute__((vector_size(16)));
+#define CCAES_BITSLICE_LANES 2
+#define CCAES_BITSLICE_LANE(w, i) ((w)[i])
+#else
+typedef uint64_t ccaes_bitslice_word;
+#define CCAES_BITSLICE_LANES 1
+#define CCAES_BITSLICE_LANE(w, i) (w)
+#endif
+
+#define CCAES_BITSLICE_NBLOCKS (4 * CCAES_BITSLICE_LANES)
+
+/* round keys in bitsliced form, one set of eight words per round, shared by both directions */
+struct ccaes_bitslice_key {
+    uint64_t sk[8 * 15];
+    uint32_t nrounds;
+};
+
+int ccaes_bitslice_init(struct ccaes_bitslice_key *key, size_t key_nbytes, const void *rawkey);
+void ccaes_bitslice_encrypt(const struct ccaes_bitslice_key *key, size_t nblocks, const uint8_t *in, uint8_t *out);
+void ccaes_bitslice_decrypt(const struct ccaes_bitslice_key *key, size_t nblocks, const uint8_t *in, uint8_t *out);
+
+#endif /* _CORECRYPTO_CCAES_BITSLICE_INTERNAL_H_ */
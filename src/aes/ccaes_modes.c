@@ -38,6 +38,15 @@ const struct ccmode_ecb *ccaes_ecb_encrypt_mode(void)
     }
 #endif
 
+#if CCAES_VPERM
+    if (CC_HAS_SupplementalSSE3()) {
+#if CORECRYPTO_DEBUG
+        cc_printf("corecrypto(aes): using SSSE3 vector permute for ECB encrypt\n");
+#endif
+        return &ccaes_vperm_ecb_encrypt_mode;
+    }
+#endif
+
     return &ccaes_ltc_ecb_encrypt_mode;
 };
 
@@ -55,9 +64,44 @@ const struct ccmode_ecb *ccaes_ecb_decrypt_mode(void)
     }
 #endif
 
+#if CCAES_VPERM
+    if (CC_HAS_SupplementalSSE3()) {
+#if CORECRYPTO_DEBUG
+        cc_printf("corecrypto(aes): using SSSE3 vector permute for ECB decrypt\n");
+#endif
+        return &ccaes_vperm_ecb_decrypt_mode;
+    }
+#endif
+
     return &ccaes_ltc_ecb_decrypt_mode;
 };
 
+#if !CCAES_INTEL_ASM
+/*
+ * The constant-time cipher for the C modes that always hand over runs of blocks: vector permute if the CPU has SSSE3,
+ * else the bitsliced one, which needs eight blocks to pay off. Neither has LTC's key- and data-dependent table loads.
+ */
+static const struct ccmode_ecb *ccaes_bulk_ecb_encrypt_mode(void)
+{
+#if CCAES_VPERM
+    if (CC_HAS_SupplementalSSE3()) {
+        return &ccaes_vperm_ecb_encrypt_mode;
+    }
+#endif
+    return &ccaes_bitslice_ecb_encrypt_mode;
+}
+#endif
+
+static const struct ccmode_ecb *ccaes_bulk_ecb_decrypt_mode(void)
+{
+#if CCAES_VPERM
+    if (CC_HAS_SupplementalSSE3()) {
+        return &ccaes_vperm_ecb_decrypt_mode;
+    }
+#endif
+    return &ccaes_bitslice_ecb_decrypt_mode;
+}
+
 #pragma mark - CBC mode
 
 const struct ccmode_cbc *ccaes_cbc_encrypt_mode(void)
@@ -74,7 +118,10 @@ const struct ccmode_cbc *ccaes_cbc_encrypt_mode(void)
     }
 #endif
 
-    return &ccaes_tinyaes_cbc_encrypt_mode;
+    /* generic CBC over the ECB choice above: the serial chain has no batch for the bitsliced cipher */
+    static struct ccmode_cbc cbc_aes_encrypt;
+    ccmode_factory_cbc_encrypt(&cbc_aes_encrypt, ccaes_ecb_encrypt_mode());
+    return &cbc_aes_encrypt;
 };
 
 const struct ccmode_cbc *ccaes_cbc_decrypt_mode(void)
@@ -91,7 +138,10 @@ const struct ccmode_cbc *ccaes_cbc_decrypt_mode(void)
     }
 #endif
 
-    return &ccaes_tinyaes_cbc_decrypt_mode;
+    /* generic CBC over the constant-time decryptor, which gets whole batches per ECB call */
+    static struct ccmode_cbc cbc_aes_decrypt;
+    ccmode_factory_cbc_decrypt(&cbc_aes_decrypt, ccaes_bulk_ecb_decrypt_mode());
+    return &cbc_aes_decrypt;
 };
 
 #pragma mark - XTS mode
@@ -99,9 +149,24 @@ const struct ccmode_cbc *ccaes_cbc_decrypt_mode(void)
 /* If the Intel accelerated modes are available, use them instead */
 #if !CCAES_INTEL_ASM
 
-/* Use generic constructors for an unaccelerated build */
-CCMODE_XTS_FACTORY(aes, encrypt);
-CCMODE_XTS_FACTORY(aes, decrypt);
+/*
+ * Use generic constructors for an unaccelerated build. Data and tweak both go through the constant-time cipher: the
+ * tweak key is as secret as the data key. ccxts_set_tweak() encrypts one block, which vector permute does at its
+ * usual cost; without SSSE3, ccxts_update_sectors() batches the tweaks so the bitsliced passes stay full.
+ */
+const struct ccmode_xts *ccaes_xts_encrypt_mode(void)
+{
+    static struct ccmode_xts xts_aes_encrypt;
+    ccmode_factory_xts_encrypt(&xts_aes_encrypt, ccaes_bulk_ecb_encrypt_mode(), ccaes_bulk_ecb_encrypt_mode());
+    return &xts_aes_encrypt;
+}
+
+const struct ccmode_xts *ccaes_xts_decrypt_mode(void)
+{
+    static struct ccmode_xts xts_aes_decrypt;
+    ccmode_factory_xts_decrypt(&xts_aes_decrypt, ccaes_bulk_ecb_decrypt_mode(), ccaes_bulk_ecb_encrypt_mode());
+    return &xts_aes_decrypt;
+}
 
 /* I wonder if libcorecrypto_noasm.dylib uses the intel opt mode or not. I'll have to check. */
 
@@ -146,6 +211,21 @@ CCMODE_CFB_FACTORY(aes, cfb, decrypt)
 CCMODE_CFB_FACTORY(aes, cfb8, decrypt);
 CCMODE_CFB_FACTORY(aes, cfb8, encrypt);
 
+#if CCAES_INTEL_ASM
 CCMODE_CTR_FACTORY(aes);
+#else
+/* same as CCMODE_CTR_FACTORY, but on the constant-time cipher: CTR always has a batch of counter blocks to encrypt */
+const struct ccmode_ctr *ccaes_ctr_crypt_mode(void)
+{
+    static struct ccmode_ctr ctr_aes;
+    ccmode_factory_ctr_crypt(&ctr_aes, ccaes_bulk_ecb_encrypt_mode());
+    return &ctr_aes;
+}
+#endif
+
+CCMODE_GCM_FACTORY(aes, encrypt)
+CCMODE_GCM_FACTORY(aes, decrypt)
+CCMODE_CCM_FACTORY(aes, encrypt)
+CCMODE_CCM_FACTORY(aes, decrypt)
 
 CCMODE_OFB_FACTORY(aes);
@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_config.h>
+
+#if CCAES_INTEL_ASM && defined(__x86_64__)
+
+/*
+	AES-NI counter mode, 8 blocks in flight.
+
+	void vng_aes_ctr_crypt_aesni(const void *in, void *out, size_t nblocks, void *ctr, const vng_aes_intel_encrypt_ctx *ctx);
+
+	The counter is a 128-bit big-endian integer. It is kept byte-swapped in rbx:r12 while we work and is
+	written back (advanced by nblocks) before returning. Only whole blocks are handled here; the partial
+	head and tail of a request are dealt with in ccmode_ctr_crypt_with().
+
+	Each iteration of the main loop lays out 8 consecutive counter blocks on the stack, runs the rounds
+	on all of them interleaved so the aesenc latency is hidden, then XORs the keystream into the output.
+	Whatever is left (< 8 blocks) goes through the single block loop.
+
+	This SHOULD NOT be called without checking for AES-NI first.
+*/
+
+	#define	in			%rdi
+	#define	out			%rsi
+	#define	nblocks		%rdx
+	#define	ctr			%rcx
+	#define	ctx			%r8
+	#define	lastkey		%r9
+	#define	rkey		%r11
+	#define	ctr_hi		%rbx
+	#define	ctr_lo		%r12
+
+	#define	SCRATCH_SIZE	(8*16)
+#if CC_KERNEL
+	#define	LOCAL_SIZE		(SCRATCH_SIZE + 9*16)
+#else
+	#define	LOCAL_SIZE		SCRATCH_SIZE
+#endif
+
+	.text
+	.align	4,0x90
+	.globl	_vng_aes_ctr_crypt_aesni
+_vng_aes_ctr_crypt_aesni:
+
+	push	%rbp
+	mov		%rsp, %rbp
+	push	%rbx
+	push	%r12
+	sub		$LOCAL_SIZE, %rsp		// rsp is 16-byte aligned here
+
+#if CC_KERNEL
+	movaps	%xmm0, SCRATCH_SIZE+0*16(%rsp)
+	movaps	%xmm1, SCRATCH_SIZE+1*16(%rsp)
+	movaps	%xmm2, SCRATCH_SIZE+2*16(%rsp)
+	movaps	%xmm3, SCRATCH_SIZE+3*16(%rsp)
+	movaps	%xmm4, SCRATCH_SIZE+4*16(%rsp)
+	movaps	%xmm5, SCRATCH_SIZE+5*16(%rsp)
+	movaps	%xmm6, SCRATCH_SIZE+6*16(%rsp)
+	movaps	%xmm7, SCRATCH_SIZE+7*16(%rsp)
+	movaps	%xmm8, SCRATCH_SIZE+8*16(%rsp)
+#endif
+
+	// load the counter as a native 128-bit integer
+	mov		(ctr), ctr_hi
+	mov		8(ctr), ctr_lo
+	bswap	ctr_hi
+	bswap	ctr_lo
+
+	// 240(ctx) holds 16 * rounds (160, 192 or 224), which is also the offset of the last round key
+	mov		240(ctx), %eax
+	lea		(ctx, %rax), lastkey
+
+	cmp		$8, nblocks
+	jb		L_ctr_single
+
+L_ctr_loop8:
+
+	// write out ctr+0 .. ctr+7 in big-endian order
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, 0(%rsp)
+	mov		%rax, 8(%rsp)
+
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	add		$1, %rax
+	adc		$0, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, 16(%rsp)
+	mov		%rax, 24(%rsp)
+
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	add		$2, %rax
+	adc		$0, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, 32(%rsp)
+	mov		%rax, 40(%rsp)
+
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	add		$3, %rax
+	adc		$0, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, 48(%rsp)
+	mov		%rax, 56(%rsp)
+
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	add		$4, %rax
+	adc		$0, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, 64(%rsp)
+	mov		%rax, 72(%rsp)
+
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	add		$5, %rax
+	adc		$0, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, 80(%rsp)
+	mov		%rax, 88(%rsp)
+
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	add		$6, %rax
+	adc		$0, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, 96(%rsp)
+	mov		%rax, 104(%rsp)
+
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	add		$7, %rax
+	adc		$0, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, 112(%rsp)
+	mov		%rax, 120(%rsp)
+
+	movdqa	0(%rsp), %xmm0
+	movdqa	16(%rsp), %xmm1
+	movdqa	32(%rsp), %xmm2
+	movdqa	48(%rsp), %xmm3
+	movdqa	64(%rsp), %xmm4
+	movdqa	80(%rsp), %xmm5
+	movdqa	96(%rsp), %xmm6
+	movdqa	112(%rsp), %xmm7
+
+	// round 0
+	movups	(ctx), %xmm8
+	pxor	%xmm8, %xmm0
+	pxor	%xmm8, %xmm1
+	pxor	%xmm8, %xmm2
+	pxor	%xmm8, %xmm3
+	pxor	%xmm8, %xmm4
+	pxor	%xmm8, %xmm5
+	pxor	%xmm8, %xmm6
+	pxor	%xmm8, %xmm7
+
+	// middle rounds, the same loop serves 128, 192 and 256-bit keys
+	lea		16(ctx), rkey
+0:
+	movups	(rkey), %xmm8
+	aesenc	%xmm8, %xmm0
+	aesenc	%xmm8, %xmm1
+	aesenc	%xmm8, %xmm2
+	aesenc	%xmm8, %xmm3
+	aesenc	%xmm8, %xmm4
+	aesenc	%xmm8, %xmm5
+	aesenc	%xmm8, %xmm6
+	aesenc	%xmm8, %xmm7
+	add		$16, rkey
+	cmp		lastkey, rkey
+	jb		0b
+
+	movups	(lastkey), %xmm8
+	aesenclast	%xmm8, %xmm0
+	aesenclast	%xmm8, %xmm1
+	aesenclast	%xmm8, %xmm2
+	aesenclast	%xmm8, %xmm3
+	aesenclast	%xmm8, %xmm4
+	aesenclast	%xmm8, %xmm5
+	aesenclast	%xmm8, %xmm6
+	aesenclast	%xmm8, %xmm7
+
+	// out = in ^ keystream, one block at a time so in == out is fine
+	movups	0(in), %xmm8
+	pxor	%xmm8, %xmm0
+	movups	%xmm0, 0(out)
+	movups	16(in), %xmm8
+	pxor	%xmm8, %xmm1
+	movups	%xmm1, 16(out)
+	movups	32(in), %xmm8
+	pxor	%xmm8, %xmm2
+	movups	%xmm2, 32(out)
+	movups	48(in), %xmm8
+	pxor	%xmm8, %xmm3
+	movups	%xmm3, 48(out)
+	movups	64(in), %xmm8
+	pxor	%xmm8, %xmm4
+	movups	%xmm4, 64(out)
+	movups	80(in), %xmm8
+	pxor	%xmm8, %xmm5
+	movups	%xmm5, 80(out)
+	movups	96(in), %xmm8
+	pxor	%xmm8, %xmm6
+	movups	%xmm6, 96(out)
+	movups	112(in), %xmm8
+	pxor	%xmm8, %xmm7
+	movups	%xmm7, 112(out)
+
+	add		$8, ctr_lo
+	adc		$0, ctr_hi
+	add		$(8*16), in
+	add		$(8*16), out
+	sub		$8, nblocks
+	cmp		$8, nblocks
+	jae		L_ctr_loop8
+
+L_ctr_single:
+	test	nblocks, nblocks
+	je		L_ctr_done
+
+1:
+	mov		ctr_lo, %rax
+	mov		ctr_hi, %r10
+	bswap	%rax
+	bswap	%r10
+	mov		%r10, (%rsp)
+	mov		%rax, 8(%rsp)
+	movdqa	(%rsp), %xmm0
+
+	movups	(ctx), %xmm8
+	pxor	%xmm8, %xmm0
+	lea		16(ctx), rkey
+0:
+	movups	(rkey), %xmm8
+	aesenc	%xmm8, %xmm0
+	add		$16, rkey
+	cmp		lastkey, rkey
+	jb		0b
+	movups	(lastkey), %xmm8
+	aesenclast	%xmm8, %xmm0
+
+	movups	(in), %xmm8
+	pxor	%xmm8, %xmm0
+	movups	%xmm0, (out)
+
+	add		$1, ctr_lo
+	adc		$0, ctr_hi
+	add		$16, in
+	add		$16, out
+	sub		$1, nblocks
+	jne		1b
+
+L_ctr_done:
+	// hand the advanced counter back in big-endian order
+	bswap	ctr_hi
+	bswap	ctr_lo
+	mov		ctr_hi, (ctr)
+	mov		ctr_lo, 8(ctr)
+
+	// don't leave counter blocks lying around on the stack
+	pxor	%xmm0, %xmm0
+	movdqa	%xmm0, 0(%rsp)
+	movdqa	%xmm0, 16(%rsp)
+	movdqa	%xmm0, 32(%rsp)
+	movdqa	%xmm0, 48(%rsp)
+	movdqa	%xmm0, 64(%rsp)
+	movdqa	%xmm0, 80(%rsp)
+	movdqa	%xmm0, 96(%rsp)
+	movdqa	%xmm0, 112(%rsp)
+
+#if CC_KERNEL
+	movaps	SCRATCH_SIZE+0*16(%rsp), %xmm0
+	movaps	SCRATCH_SIZE+1*16(%rsp), %xmm1
+	movaps	SCRATCH_SIZE+2*16(%rsp), %xmm2
+	movaps	SCRATCH_SIZE+3*16(%rsp), %xmm3
+	movaps	SCRATCH_SIZE+4*16(%rsp), %xmm4
+	movaps	SCRATCH_SIZE+5*16(%rsp), %xmm5
+	movaps	SCRATCH_SIZE+6*16(%rsp), %xmm6
+	movaps	SCRATCH_SIZE+7*16(%rsp), %xmm7
+	movaps	SCRATCH_SIZE+8*16(%rsp), %xmm8
+#endif
+
+	add		$LOCAL_SIZE, %rsp
+	pop		%r12
+	pop		%rbx
+	pop		%rbp
+	ret
+
+#endif /* CCAES_INTEL_ASM && defined(__x86_64__) */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/ccaes.h>
+
+#if CCAES_INTEL_ASM && defined(__x86_64__)
+
+#include "vng_aes_intel.h"
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * The ECB context embedded in the CTR key is the one ccaes_intel_ecb_encrypt_aesni_mode set up,
+ * so the expanded key can go straight to the assembly.
+ */
+static void ccaes_intel_ctr_crypt_blocks_aesni(struct _ccmode_ctr_key *ckey, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    vng_aes_ctr_crypt_aesni(in, out, nblocks, (unsigned char *)CCMODE_CTR_KEY_COUNTER(ckey),
+                            (const vng_aes_intel_encrypt_ctx *)CCMODE_CTR_KEY_ECB_CTX(ckey));
+}
+
+int ccaes_intel_ctr_crypt_aesni(ccctr_ctx *ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_ctr_crypt_with((struct _ccmode_ctr_key *)ctx, nbytes, in, out, ccaes_intel_ctr_crypt_blocks_aesni);
+}
+
+#endif
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccaes.h>
+
+#if CCAES_INTEL_ASM
+
+#include "vng_aes_intel.h"
+#include <immintrin.h>
+
+/*
+ * XTS on AES-NI, eight blocks in flight. The next eight tweaks are worked out
+ * with 64-bit lane shifts while the current eight go through the rounds.
+ * ccpad_xts_encrypt() and ccpad_xts_decrypt() do the ciphertext stealing on
+ * top of whole blocks.
+ */
+
+/* t * alpha in GF(2^128): shift both halves, carry the low half's top bit up and fold the high one back as 0x87 */
+#define XTS_MUL_ALPHA(t) \
+    _mm_xor_si128(_mm_add_epi64(t, t), _mm_and_si128(_mm_srai_epi32(_mm_shuffle_epi32(t, 0x13), 31), poly))
+
+#define XTS_LOAD_KEYS(key)                                                 \
+    nr = (key)->rounds / 16;                                               \
+    for (r = 0; r <= nr; r++) {                                            \
+        rk[r] = _mm_loadu_si128((const __m128i *)((key)->ks + 4 * r));     \
+    }
+
+/* written out by hand, compilers keep a b[8] loop in memory and reload it every round */
+#define XTS_ROUND8(op, k)                                                     \
+    do {                                                                      \
+        const __m128i _k = (k);                                               \
+        b0 = op(b0, _k); b1 = op(b1, _k); b2 = op(b2, _k); b3 = op(b3, _k);   \
+        b4 = op(b4, _k); b5 = op(b5, _k); b6 = op(b6, _k); b7 = op(b7, _k);   \
+    } while (0)
+
+#define XTS_LOAD8(k)                                                                                  \
+    b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in + 0), _mm_xor_si128(t[0], k));           \
+    b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in + 1), _mm_xor_si128(t[1], k));           \
+    b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in + 2), _mm_xor_si128(t[2], k));           \
+    b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in + 3), _mm_xor_si128(t[3], k));           \
+    b4 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in + 4), _mm_xor_si128(t[4], k));           \
+    b5 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in + 5), _mm_xor_si128(t[5], k));           \
+    b6 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in + 6), _mm_xor_si128(t[6], k));           \
+    b7 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in + 7), _mm_xor_si128(t[7], k));
+
+#define XTS_STORE8(op, k)                                                                             \
+    _mm_storeu_si128((__m128i *)out + 0, _mm_xor_si128(op(b0, k), t[0]));                           \
+    _mm_storeu_si128((__m128i *)out + 1, _mm_xor_si128(op(b1, k), t[1]));                           \
+    _mm_storeu_si128((__m128i *)out + 2, _mm_xor_si128(op(b2, k), t[2]));                           \
+    _mm_storeu_si128((__m128i *)out + 3, _mm_xor_si128(op(b3, k), t[3]));                           \
+    _mm_storeu_si128((__m128i *)out + 4, _mm_xor_si128(op(b4, k), t[4]));                           \
+    _mm_storeu_si128((__m128i *)out + 5, _mm_xor_si128(op(b5, k), t[5]));                           \
+    _mm_storeu_si128((__m128i *)out + 6, _mm_xor_si128(op(b6, k), t[6]));                           \
+    _mm_storeu_si128((__m128i *)out + 7, _mm_xor_si128(op(b7, k), t[7]));
+
+__attribute__((target("aes")))
+static inline __m128i xts_encrypt_block(const __m128i *rk, int nr, __m128i b)
+{
+    b = _mm_xor_si128(b, rk[0]);
+    for (int r = 1; r < nr; r++) {
+        b = _mm_aesenc_si128(b, rk[r]);
+    }
+    return _mm_aesenclast_si128(b, rk[nr]);
+}
+
+/* the decrypt schedule is in encryption order, with InvMixColumns applied to the inner keys */
+__attribute__((target("aes")))
+static inline __m128i xts_decrypt_block(const __m128i *rk, int nr, __m128i b)
+{
+    b = _mm_xor_si128(b, rk[nr]);
+    for (int r = nr - 1; r > 0; r--) {
+        b = _mm_aesdec_si128(b, rk[r]);
+    }
+    return _mm_aesdeclast_si128(b, rk[0]);
+}
+
+__attribute__((target("aes")))
+void ccaes_intel_xts_encrypt_aesni(const vng_aes_intel_encrypt_ctx *key, uint8_t *tweak, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    const __m128i poly = _mm_set_epi32(0, 1, 0, 0x87);
+    __m128i rk[15], t[8], b0, b1, b2, b3, b4, b5, b6, b7, T, cc;
+    int nr, r, i;
+
+    XTS_LOAD_KEYS(key);
+    T = _mm_loadu_si128((const __m128i *)tweak);
+
+    for (; nblocks >= 8; nblocks -= 8) {
+        t[0] = T;
+        for (i = 1; i < 8; i++) {
+            t[i] = XTS_MUL_ALPHA(t[i - 1]);
+        }
+        T = XTS_MUL_ALPHA(t[7]);
+
+        XTS_LOAD8(rk[0]);
+        for (r = 1; r < nr; r++) {
+            XTS_ROUND8(_mm_aesenc_si128, rk[r]);
+        }
+        XTS_STORE8(_mm_aesenclast_si128, rk[nr]);
+
+        in += 8 * 16;
+        out += 8 * 16;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        cc = _mm_xor_si128(xts_encrypt_block(rk, nr, _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), T)), T);
+        _mm_storeu_si128((__m128i *)out, cc);
+        T = XTS_MUL_ALPHA(T);
+        in += 16;
+        out += 16;
+    }
+
+    _mm_storeu_si128((__m128i *)tweak, T);
+}
+
+__attribute__((target("aes")))
+void ccaes_intel_xts_decrypt_aesni(const vng_aes_intel_decrypt_ctx *key, uint8_t *tweak, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    const __m128i poly = _mm_set_epi32(0, 1, 0, 0x87);
+    __m128i rk[15], t[8], b0, b1, b2, b3, b4, b5, b6, b7, T, pp;
+    int nr, r, i;
+
+    XTS_LOAD_KEYS(key);
+    T = _mm_loadu_si128((const __m128i *)tweak);
+
+    for (; nblocks >= 8; nblocks -= 8) {
+        t[0] = T;
+        for (i = 1; i < 8; i++) {
+            t[i] = XTS_MUL_ALPHA(t[i - 1]);
+        }
+        T = XTS_MUL_ALPHA(t[7]);
+
+        XTS_LOAD8(rk[nr]);
+        for (r = nr - 1; r > 0; r--) {
+            XTS_ROUND8(_mm_aesdec_si128, rk[r]);
+        }
+        XTS_STORE8(_mm_aesdeclast_si128, rk[0]);
+
+        in += 8 * 16;
+        out += 8 * 16;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        pp = _mm_xor_si128(xts_decrypt_block(rk, nr, _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), T)), T);
+        _mm_storeu_si128((__m128i *)out, pp);
+        T = XTS_MUL_ALPHA(T);
+        in += 16;
+        out += 16;
+    }
+
+    _mm_storeu_si128((__m128i *)tweak, T);
+}
+
+__attribute__((target("aes")))
+void ccaes_intel_xts_tweaks_aesni(const vng_aes_intel_encrypt_ctx *key, uint64_t data_unit, size_t ntweaks, uint8_t *tweaks)
+{
+    __m128i rk[15], b0, b1, b2, b3, b4, b5, b6, b7;
+    int nr, r;
+
+    XTS_LOAD_KEYS(key);
+
+    /* the sequence number is little-endian in the low 64 bits and the high half is zero */
+    for (; ntweaks >= 8; ntweaks -= 8) {
+        b0 = _mm_xor_si128(_mm_cvtsi64_si128((long long)(data_unit + 0)), rk[0]);
+        b1 = _mm_xor_si128(_mm_cvtsi64_si128((long long)(data_unit + 1)), rk[0]);
+        b2 = _mm_xor_si128(_mm_cvtsi64_si128((long long)(data_unit + 2)), rk[0]);
+        b3 = _mm_xor_si128(_mm_cvtsi64_si128((long long)(data_unit + 3)), rk[0]);
+        b4 = _mm_xor_si128(_mm_cvtsi64_si128((long long)(data_unit + 4)), rk[0]);
+        b5 = _mm_xor_si128(_mm_cvtsi64_si128((long long)(data_unit + 5)), rk[0]);
+        b6 = _mm_xor_si128(_mm_cvtsi64_si128((long long)(data_unit + 6)), rk[0]);
+        b7 = _mm_xor_si128(_mm_cvtsi64_si128((long long)(data_unit + 7)), rk[0]);
+        for (r = 1; r < nr; r++) {
+            XTS_ROUND8(_mm_aesenc_si128, rk[r]);
+        }
+        XTS_ROUND8(_mm_aesenclast_si128, rk[nr]);
+        _mm_storeu_si128((__m128i *)tweaks + 0, b0);
+        _mm_storeu_si128((__m128i *)tweaks + 1, b1);
+        _mm_storeu_si128((__m128i *)tweaks + 2, b2);
+        _mm_storeu_si128((__m128i *)tweaks + 3, b3);
+        _mm_storeu_si128((__m128i *)tweaks + 4, b4);
+        _mm_storeu_si128((__m128i *)tweaks + 5, b5);
+        _mm_storeu_si128((__m128i *)tweaks + 6, b6);
+        _mm_storeu_si128((__m128i *)tweaks + 7, b7);
+        data_unit += 8;
+        tweaks += 8 * 16;
+    }
+
+    for (; ntweaks > 0; ntweaks--) {
+        _mm_storeu_si128((__m128i *)tweaks, xts_encrypt_block(rk, nr, _mm_cvtsi64_si128((long long)data_unit++)));
+        tweaks += 16;
+    }
+}
+
+/*
+ * Whole sectors back to back. The eight blocks in flight may straddle a sector boundary, each one takes the tweak of
+ * its own sector, so short sectors or ones that are not a multiple of eight blocks still keep the pipeline full.
+ * Sector tweaks are encrypted eight at a time as they are needed.
+ */
+#define XTS_SECTOR_TWEAK(dst)                                                                   \
+    do {                                                                                        \
+        if (left == 0) {                                                                        \
+            if (next == avail) {                                                                \
+                avail = CC_MIN(nsectors, (size_t)CCAES_INTEL_XTS_SECTORS_NTWEAKS);              \
+                ccaes_intel_xts_tweaks_aesni(tweak_key, data_unit, avail, tweaks);              \
+                data_unit += avail;                                                             \
+                nsectors -= avail;                                                              \
+                next = 0;                                                                       \
+            }                                                                                   \
+            T = _mm_loadu_si128((const __m128i *)tweaks + next++);                              \
+            left = sector_nblocks;                                                              \
+        }                                                                                       \
+        (dst) = T;                                                                              \
+        T = XTS_MUL_ALPHA(T);                                                                   \
+        left--;                                                                                 \
+    } while (0)
+
+#define XTS_SECTORS_DECL                                                                        \
+    const __m128i poly = _mm_set_epi32(0, 1, 0, 0x87);                                          \
+    __m128i rk[15], t[8], b0, b1, b2, b3, b4, b5, b6, b7, T = _mm_setzero_si128();              \
+    uint8_t tweaks[CCAES_INTEL_XTS_SECTORS_NTWEAKS * 16];                                       \
+    size_t sector_nblocks = sector_nbytes / 16, nsectors = nbytes / sector_nbytes;              \
+    size_t nblocks = nbytes / 16, left = 0, next = 0, avail = 0;                                \
+    int nr, r, i
+
+__attribute__((target("aes")))
+void ccaes_intel_xts_sectors_encrypt_aesni(const vng_aes_intel_encrypt_ctx *key, const vng_aes_intel_encrypt_ctx *tweak_key,
+                                           uint64_t data_unit, size_t sector_nbytes, size_t nbytes, const uint8_t *in, uint8_t *out)
+{
+    XTS_SECTORS_DECL;
+
+    XTS_LOAD_KEYS(key);
+
+    for (; nblocks >= 8; nblocks -= 8) {
+        for (i = 0; i < 8; i++) {
+            XTS_SECTOR_TWEAK(t[i]);
+        }
+
+        XTS_LOAD8(rk[0]);
+        for (r = 1; r < nr; r++) {
+            XTS_ROUND8(_mm_aesenc_si128, rk[r]);
+        }
+        XTS_STORE8(_mm_aesenclast_si128, rk[nr]);
+
+        in += 8 * 16;
+        out += 8 * 16;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        XTS_SECTOR_TWEAK(t[0]);
+        b0 = _mm_xor_si128(xts_encrypt_block(rk, nr, _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), t[0])), t[0]);
+        _mm_storeu_si128((__m128i *)out, b0);
+        in += 16;
+        out += 16;
+    }
+
+    cc_clear(sizeof(tweaks), tweaks);
+}
+
+__attribute__((target("aes")))
+void ccaes_intel_xts_sectors_decrypt_aesni(const vng_aes_intel_decrypt_ctx *key, const vng_aes_intel_encrypt_ctx *tweak_key,
+                                           uint64_t data_unit, size_t sector_nbytes, size_t nbytes, const uint8_t *in, uint8_t *out)
+{
+    XTS_SECTORS_DECL;
+
+    XTS_LOAD_KEYS(key);
+
+    for (; nblocks >= 8; nblocks -= 8) {
+        for (i = 0; i < 8; i++) {
+            XTS_SECTOR_TWEAK(t[i]);
+        }
+
+        XTS_LOAD8(rk[nr]);
+        for (r = nr - 1; r > 0; r--) {
+            XTS_ROUND8(_mm_aesdec_si128, rk[r]);
+        }
+        XTS_STORE8(_mm_aesdeclast_si128, rk[0]);
+
+        in += 8 * 16;
+        out += 8 * 16;
+    }
+
+    for (; nblocks > 0; nblocks--) {
+        XTS_SECTOR_TWEAK(t[0]);
+        b0 = _mm_xor_si128(xts_decrypt_block(rk, nr, _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), t[0])), t[0]);
+        _mm_storeu_si128((__m128i *)out, b0);
+        in += 16;
+        out += 16;
+    }
+
+    cc_clear(sizeof(tweaks), tweaks);
+}
+
+#endif /* CCAES_INTEL_ASM */
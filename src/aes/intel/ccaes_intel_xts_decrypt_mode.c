@@ -65,6 +65,14 @@ static void *xts_wrapper_aesni(const ccxts_ctx *ctx, ccxts_tweak *tweak, size_t
     }
 }
 
+static int xts_sectors_wrapper_aesni(const ccxts_ctx *ctx, uint64_t data_unit, size_t sector_nbytes, size_t nbytes, const void *in, void *out)
+{
+    struct ccaes_intel_xts_decrypt_ctx *key = (struct ccaes_intel_xts_decrypt_ctx *)ctx;
+
+    ccaes_intel_xts_sectors_decrypt_aesni(key->decrypt, key->encrypt_tweak, data_unit, sector_nbytes, nbytes, in, out);
+    return CCERR_OK;
+}
+
 const struct ccmode_xts ccaes_intel_xts_decrypt_aesni_mode = {
     /* constants */
     .size = sizeof(struct ccaes_intel_xts_decrypt_ctx),
@@ -79,6 +87,8 @@ const struct ccmode_xts ccaes_intel_xts_decrypt_aesni_mode = {
 
     .custom = NULL,
     .custom1 = NULL,
+
+    .xts_sectors = xts_sectors_wrapper_aesni,
 };
 
 // forward declaration
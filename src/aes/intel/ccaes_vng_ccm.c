@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/ccaes.h>
+
+#if CCAES_INTEL_ASM && defined(__x86_64__)
+
+#include "vng_aes_intel.h"
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+#include <immintrin.h>
+
+/*
+ * CCM with the CBC-MAC block and the CTR block of each step sharing one AES-NI round loop.
+ *
+ * The CBC-MAC is a serial chain, so on its own every aesenc waits out the full latency of the previous one; the
+ * counter block is independent and fills those slots for free. Decryption needs E(A_i) before it can MAC P_i, so
+ * there the keystream runs one block ahead of the MAC.
+ *
+ * The counter is bumped as a 64-bit big-endian integer. set_iv bounds data_len by the L byte length field, so it
+ * never carries out of the last L bytes and this matches the generic path.
+ */
+
+#define VNG_CCM_TARGET __attribute__((target("aes,sse2")))
+
+VNG_CCM_TARGET
+static __m128i ccaes_vng_ccm_aes1(const __m128i *rk, unsigned nrounds, __m128i b)
+{
+    b = _mm_xor_si128(b, _mm_loadu_si128(rk));
+    for (unsigned r = 1; r < nrounds; r++) {
+        b = _mm_aesenc_si128(b, _mm_loadu_si128(rk + r));
+    }
+    return _mm_aesenclast_si128(b, _mm_loadu_si128(rk + nrounds));
+}
+
+VNG_CCM_TARGET
+static void ccaes_vng_ccm_aes2(const __m128i *rk, unsigned nrounds, __m128i *a, __m128i *b)
+{
+    __m128i k = _mm_loadu_si128(rk);
+    __m128i x = _mm_xor_si128(*a, k);
+    __m128i y = _mm_xor_si128(*b, k);
+
+    for (unsigned r = 1; r < nrounds; r++) {
+        k = _mm_loadu_si128(rk + r);
+        x = _mm_aesenc_si128(x, k);
+        y = _mm_aesenc_si128(y, k);
+    }
+    k = _mm_loadu_si128(rk + nrounds);
+    *a = _mm_aesenclast_si128(x, k);
+    *b = _mm_aesenclast_si128(y, k);
+}
+
+/* A_i with the low qword replaced by the big-endian counter ctr */
+#define VNG_CCM_CTR_BLOCK(hi, ctr) _mm_set_epi64x((long long)__builtin_bswap64(ctr), (long long)(hi))
+
+VNG_CCM_TARGET
+static void ccaes_vng_ccm_encrypt_blocks(struct _ccmode_ccm_key *key, struct _ccmode_ccm_nonce *n, size_t nblocks,
+                                           const uint8_t *in, uint8_t *out)
+{
+    const vng_aes_intel_encrypt_ctx *aes = (const vng_aes_intel_encrypt_ctx *)CCMODE_CCM_KEY_ECB_CTX(key);
+    const __m128i *rk = (const __m128i *)aes->ks;
+    unsigned nrounds = aes->rounds / 16;
+    __m128i mac = _mm_loadu_si128((const __m128i *)n->B_i);
+    uint64_t hi, ctr;
+
+    cc_memcpy(&hi, n->A_i, sizeof(hi));
+    CC_LOAD64_BE(ctr, n->A_i + 8);
+
+    while (nblocks--) {
+        __m128i p = _mm_loadu_si128((const __m128i *)in);
+        __m128i ks = VNG_CCM_CTR_BLOCK(hi, ++ctr);
+
+        mac = _mm_xor_si128(mac, p);
+        ccaes_vng_ccm_aes2(rk, nrounds, &ks, &mac);
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(p, ks));
+
+        in += CCMODE_CCM_BLOCK_NBYTES;
+        out += CCMODE_CCM_BLOCK_NBYTES;
+    }
+
+    _mm_storeu_si128((__m128i *)n->B_i, mac);
+    CC_STORE64_BE(ctr, n->A_i + 8);
+}
+
+VNG_CCM_TARGET
+static void ccaes_vng_ccm_decrypt_blocks(struct _ccmode_ccm_key *key, struct _ccmode_ccm_nonce *n, size_t nblocks,
+                                           const uint8_t *in, uint8_t *out)
+{
+    const vng_aes_intel_encrypt_ctx *aes = (const vng_aes_intel_encrypt_ctx *)CCMODE_CCM_KEY_ECB_CTX(key);
+    const __m128i *rk = (const __m128i *)aes->ks;
+    unsigned nrounds = aes->rounds / 16;
+    __m128i mac = _mm_loadu_si128((const __m128i *)n->B_i);
+    __m128i ks;
+    uint64_t hi, ctr;
+
+    cc_memcpy(&hi, n->A_i, sizeof(hi));
+    CC_LOAD64_BE(ctr, n->A_i + 8);
+
+    ks = ccaes_vng_ccm_aes1(rk, nrounds, VNG_CCM_CTR_BLOCK(hi, ++ctr));
+
+    while (nblocks--) {
+        __m128i p = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), ks);
+
+        _mm_storeu_si128((__m128i *)out, p);
+        mac = _mm_xor_si128(mac, p);
+        if (nblocks) {
+            ks = VNG_CCM_CTR_BLOCK(hi, ++ctr);
+            ccaes_vng_ccm_aes2(rk, nrounds, &ks, &mac);
+        } else {
+            mac = ccaes_vng_ccm_aes1(rk, nrounds, mac);
+        }
+
+        in += CCMODE_CCM_BLOCK_NBYTES;
+        out += CCMODE_CCM_BLOCK_NBYTES;
+    }
+
+    _mm_storeu_si128((__m128i *)n->B_i, mac);
+    CC_STORE64_BE(ctr, n->A_i + 8);
+}
+
+int ccaes_vng_ccm_encrypt(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_ccm_crypt_with(ctx, nonce_ctx, nbytes, in, out, 1, ccaes_vng_ccm_encrypt_blocks);
+}
+
+int ccaes_vng_ccm_decrypt(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_ccm_crypt_with(ctx, nonce_ctx, nbytes, in, out, 0, ccaes_vng_ccm_decrypt_blocks);
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccaes.h>
+#include <corecrypto/ccmode_internal.h>
+
+#if CCMODE_GCM_VNG_SPEEDUP
+
+#include "vng_aes_intel.h"
+#include "vng_gcm_clmul.h"
+
+/*
+ * Stitched AES-NI CTR + PCLMULQDQ GHASH.
+ *
+ * Eight counter blocks go through the AES rounds together, and one GHASH multiply is slotted in after each round so
+ * the aesenc and pclmulqdq latencies overlap instead of running back to back. Decryption hashes the very blocks it
+ * is decrypting (the ciphertext is already there); encryption hashes the previous eight blocks of ciphertext while
+ * producing the next eight, and catches up on the last batch at the end.
+ *
+ * Only set up by ccmode_factory_gcm_* for ccaes_intel_ecb_encrypt_aesni_mode when PCLMULQDQ is present, in which
+ * case ccmode_gcm_init() has also picked the PCLMULQDQ GHASH table.
+ */
+
+#define AES_ROUND8(op, k)          \
+    do {                           \
+        b0 = op(b0, k);            \
+        b1 = op(b1, k);            \
+        b2 = op(b2, k);            \
+        b3 = op(b3, k);            \
+        b4 = op(b4, k);            \
+        b5 = op(b5, k);            \
+        b6 = op(b6, k);            \
+        b7 = op(b7, k);            \
+    } while (0)
+
+#define XOR_STORE(i, b)                                                                                                \
+    _mm_storeu_si128((__m128i *)(out + 16 * (i)), _mm_xor_si128(b, _mm_loadu_si128((const __m128i *)(in + 16 * (i)))))
+
+/* counter i blocks past ybs (the byte-reversed Y), inc32 wraps in the low dword just like the spec wants */
+#define CTR_BLOCK(i) vng_gcm_bswap(_mm_add_epi32(ybs, _mm_set_epi32(0, 0, 0, (i))))
+
+VNG_GCM_TARGET
+static __m128i ccaes_vng_gcm_ctr1(const __m128i *rk, unsigned nrounds, __m128i b)
+{
+    b = _mm_xor_si128(b, _mm_loadu_si128(rk));
+    for (unsigned r = 1; r < nrounds; r++) {
+        b = _mm_aesenc_si128(b, _mm_loadu_si128(rk + r));
+    }
+    return _mm_aesenclast_si128(b, _mm_loadu_si128(rk + nrounds));
+}
+
+/*
+ * out = in ^ E(K, ybs + 1 .. ybs + 8). If hash is non-NULL its eight blocks are folded into *X along the way; it is
+ * read before out is written, so it may point at in.
+ */
+VNG_GCM_TARGET
+static void ccaes_vng_gcm_crypt8(const __m128i *rk, unsigned nrounds, const uint8_t *htable, __m128i *X, __m128i ybs,
+                                 const uint8_t *hash, const uint8_t *in, uint8_t *out)
+{
+    __m128i b0, b1, b2, b3, b4, b5, b6, b7, k;
+    vng_gcm_acc acc;
+
+    k = _mm_loadu_si128(rk);
+    b0 = _mm_xor_si128(CTR_BLOCK(1), k);
+    b1 = _mm_xor_si128(CTR_BLOCK(2), k);
+    b2 = _mm_xor_si128(CTR_BLOCK(3), k);
+    b3 = _mm_xor_si128(CTR_BLOCK(4), k);
+    b4 = _mm_xor_si128(CTR_BLOCK(5), k);
+    b5 = _mm_xor_si128(CTR_BLOCK(6), k);
+    b6 = _mm_xor_si128(CTR_BLOCK(7), k);
+    b7 = _mm_xor_si128(CTR_BLOCK(8), k);
+
+    vng_gcm_acc_init(&acc);
+
+    /* AES-128 has 9 middle rounds, enough to hide all 8 multiplies */
+    for (unsigned r = 1; r < nrounds; r++) {
+        k = _mm_loadu_si128(rk + r);
+        AES_ROUND8(_mm_aesenc_si128, k);
+
+        if (hash && r <= VNG_GCM_AGGREGATE_NBLOCKS) {
+            unsigned j = r - 1;
+            __m128i a = vng_gcm_bswap(_mm_loadu_si128((const __m128i *)(hash + 16 * j)));
+            if (j == 0) {
+                a = _mm_xor_si128(a, *X);
+            }
+            vng_gcm_mul_acc(&acc, a, _mm_loadu_si128(VNG_GCM_HPOW(htable, 8 - j)), _mm_loadu_si128(VNG_GCM_HKARA(htable, 8 - j)));
+        }
+    }
+
+    k = _mm_loadu_si128(rk + nrounds);
+    AES_ROUND8(_mm_aesenclast_si128, k);
+
+    if (hash) {
+        *X = vng_gcm_reduce(&acc);
+    }
+
+    XOR_STORE(0, b0);
+    XOR_STORE(1, b1);
+    XOR_STORE(2, b2);
+    XOR_STORE(3, b3);
+    XOR_STORE(4, b4);
+    XOR_STORE(5, b5);
+    XOR_STORE(6, b6);
+    XOR_STORE(7, b7);
+}
+
+VNG_GCM_TARGET
+static void ccaes_vng_gcm_blocks(struct _ccmode_gcm_key *key, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    const vng_aes_intel_encrypt_ctx *aes = (const vng_aes_intel_encrypt_ctx *)CCMODE_GCM_KEY_ECB_CTX(key);
+    const __m128i *rk = (const __m128i *)aes->ks;
+    unsigned nrounds = aes->rounds / 16;
+    const uint8_t *htable = CCMODE_GCM_KEY_HTABLE(key);
+    int decrypting = (key->encdec == CCMODE_GCM_DECRYPTOR);
+    __m128i X = vng_gcm_bswap(_mm_loadu_si128((const __m128i *)key->X));
+    __m128i ybs = vng_gcm_bswap(_mm_loadu_si128((const __m128i *)key->Y));
+    const uint8_t *pending = NULL;
+
+    while (nblocks >= 8) {
+        /* decrypt: hash this batch's ciphertext, encrypt: the previous batch's, if there was one */
+        ccaes_vng_gcm_crypt8(rk, nrounds, htable, &X, ybs, decrypting ? in : pending, in, out);
+
+        if (!decrypting) {
+            pending = out;
+        }
+
+        ybs = _mm_add_epi32(ybs, _mm_set_epi32(0, 0, 0, 8));
+        in += 8 * 16;
+        out += 8 * 16;
+        nblocks -= 8;
+    }
+
+    if (pending) {
+        X = vng_gcm_ghash(htable, X, 8, pending);
+    }
+
+    /* fewer than eight left, one at a time; in is read before out is written so in-place works */
+    while (nblocks--) {
+        __m128i c = _mm_loadu_si128((const __m128i *)in);
+        __m128i ks;
+
+        ybs = _mm_add_epi32(ybs, _mm_set_epi32(0, 0, 0, 1));
+        ks = ccaes_vng_gcm_ctr1(rk, nrounds, vng_gcm_bswap(ybs));
+
+        if (decrypting) {
+            X = vng_gcm_ghash(htable, X, 1, in);
+            _mm_storeu_si128((__m128i *)out, _mm_xor_si128(c, ks));
+        } else {
+            _mm_storeu_si128((__m128i *)out, _mm_xor_si128(c, ks));
+            X = vng_gcm_ghash(htable, X, 1, out);
+        }
+
+        in += 16;
+        out += 16;
+    }
+
+    _mm_storeu_si128((__m128i *)key->X, vng_gcm_bswap(X));
+    _mm_storeu_si128((__m128i *)key->Y, vng_gcm_bswap(ybs));
+}
+
+int ccaes_vng_gcm_encrypt(ccgcm_ctx *ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_gcm_crypt_with(ctx, nbytes, in, out, ccaes_vng_gcm_blocks);
+}
+
+int ccaes_vng_gcm_decrypt(ccgcm_ctx *ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_gcm_crypt_with(ctx, nbytes, in, out, ccaes_vng_gcm_blocks);
+}
+
+#endif /* CCMODE_GCM_VNG_SPEEDUP */
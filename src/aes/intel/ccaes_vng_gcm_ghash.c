@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+#if CCMODE_GCM_VNG_SPEEDUP
+
+#include "vng_gcm_clmul.h"
+
+/* H^1 .. H^8 and their Karatsuba terms, see vng_gcm_clmul.h for the layout. */
+VNG_GCM_TARGET
+void ccmode_gcm_gen_table_clmul(struct _ccmode_gcm_key *key)
+{
+    uint8_t *htable = CCMODE_GCM_KEY_HTABLE(key);
+    __m128i H = vng_gcm_bswap(_mm_loadu_si128((const __m128i *)key->H));
+    __m128i Hk = _mm_xor_si128(H, _mm_shuffle_epi32(H, 0x4e));
+    __m128i Hi = H;
+
+    for (size_t i = 1; i <= VNG_GCM_AGGREGATE_NBLOCKS; i++) {
+        __m128i Hik = _mm_xor_si128(Hi, _mm_shuffle_epi32(Hi, 0x4e));
+        vng_gcm_acc acc;
+
+        _mm_storeu_si128((__m128i *)VNG_GCM_HPOW(htable, i), Hi);
+        _mm_storeu_si128((__m128i *)VNG_GCM_HKARA(htable, i), Hik);
+
+        vng_gcm_acc_init(&acc);
+        vng_gcm_mul_acc(&acc, Hi, H, Hk);
+        Hi = vng_gcm_reduce(&acc);
+    }
+}
+
+VNG_GCM_TARGET
+void ccmode_gcm_ghash_clmul(struct _ccmode_gcm_key *key, size_t nblocks, const unsigned char *in)
+{
+    __m128i X = vng_gcm_bswap(_mm_loadu_si128((const __m128i *)key->X));
+
+    X = vng_gcm_ghash(CCMODE_GCM_KEY_HTABLE(key), X, nblocks, in);
+    _mm_storeu_si128((__m128i *)key->X, vng_gcm_bswap(X));
+}
+
+#endif /* CCMODE_GCM_VNG_SPEEDUP */
@@ -115,6 +115,10 @@ extern int vng_aes_decrypt_aesni_cbc(const unsigned char *ibuf, unsigned char *i
 extern int vng_aes_encrypt_aesni_cbc(const unsigned char *ibuf, unsigned char *in_iv, unsigned int num_blk,
                               unsigned char *obuf, const vng_aes_intel_encrypt_ctx ctx[1]) __asm__("_vng_aes_encrypt_aesni_cbc");
 
+/* aes_ctr_hw.s, whole blocks only. ctr is advanced by num_blk. */
+extern void vng_aes_ctr_crypt_aesni(const unsigned char *ibuf, unsigned char *obuf, size_t num_blk,
+                                    unsigned char *ctr, const vng_aes_intel_encrypt_ctx cx[1]) __asm__("_vng_aes_ctr_crypt_aesni");
+
 /* accessors to the assembly code */
 extern void aesxts_mult_x(uint8_t *I) __asm__("_aesxts_mult_x");
 
@@ -130,6 +134,22 @@ extern int aesxts_tweak_uncrypt_opt(const uint8_t *C, uint8_t *P, const uint8_t
 extern int aesxts_tweak_uncrypt_group_aesni(const uint8_t *C, uint8_t *P, const uint8_t *T, vng_aes_intel_decrypt_ctx *ctx, uint32_t lim) __asm__("_aesxts_tweak_uncrypt_group_aesni");
 extern int aesxts_tweak_uncrypt_group_opt(const uint8_t *C, uint8_t *P, const uint8_t *T, vng_aes_intel_decrypt_ctx *ctx, uint32_t lim) __asm__("_aesxts_tweak_uncrypt_group_opt");
 
+/* ccaes_intel_xts_aesni.c: XTS over nblocks whole blocks. The tweak is advanced past the data. */
+void ccaes_intel_xts_encrypt_aesni(const vng_aes_intel_encrypt_ctx *key, uint8_t *tweak, size_t nblocks, const uint8_t *in, uint8_t *out);
+void ccaes_intel_xts_decrypt_aesni(const vng_aes_intel_decrypt_ctx *key, uint8_t *tweak, size_t nblocks, const uint8_t *in, uint8_t *out);
+
+/* Encrypts the IEEE 1619 tweak inputs for data units data_unit .. data_unit + ntweaks - 1, eight at a time. */
+void ccaes_intel_xts_tweaks_aesni(const vng_aes_intel_encrypt_ctx *key, uint64_t data_unit, size_t ntweaks, uint8_t *tweaks);
+
+/* sector tweaks per ccaes_intel_xts_tweaks_aesni call in the sector wrappers */
+#define CCAES_INTEL_XTS_SECTORS_NTWEAKS 8
+
+/* Whole sectors of sector_nbytes (a multiple of 16) starting at data unit data_unit, see ccxts_update_sectors(). */
+void ccaes_intel_xts_sectors_encrypt_aesni(const vng_aes_intel_encrypt_ctx *key, const vng_aes_intel_encrypt_ctx *tweak_key,
+                                           uint64_t data_unit, size_t sector_nbytes, size_t nbytes, const uint8_t *in, uint8_t *out);
+void ccaes_intel_xts_sectors_decrypt_aesni(const vng_aes_intel_decrypt_ctx *key, const vng_aes_intel_encrypt_ctx *tweak_key,
+                                           uint64_t data_unit, size_t sector_nbytes, size_t nbytes, const uint8_t *in, uint8_t *out);
+
 int vng_aes_xts_encrypt_aesni(
    const uint8_t *pt, unsigned long ptlen,
          uint8_t *ct,
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#ifndef _CORECRYPTO_CCAES_INTEL_VNG_GCM_CLMUL_H_
+#define _CORECRYPTO_CCAES_INTEL_VNG_GCM_CLMUL_H_
+
+#include <corecrypto/cc_config.h>
+
+#if CCMODE_GCM_VNG_SPEEDUP
+
+#include <immintrin.h>
+
+/*
+ * GHASH with PCLMULQDQ, shared by the plain GHASH and the stitched AES-NI paths.
+ *
+ * Blocks are kept byte-reversed in registers so carry-less products line up with GCM's reflected bit order; the
+ * 256-bit product is then shifted left by one and reduced modulo x^128 + x^7 + x^2 + x + 1 (Gueron & Kounavis,
+ * "Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode", algorithm 5).
+ *
+ * Products are summed before reduction, so n blocks cost n Karatsuba multiplies and a single reduction when
+ * multiplied by H^n .. H^1 (aggregated reduction). The key table holds H^1..H^8 at 16 * (i - 1) and the matching
+ * Karatsuba terms (hi ^ lo in the low qword) 128 bytes further on.
+ */
+
+#define VNG_GCM_TARGET __attribute__((target("pclmul,ssse3,aes")))
+
+#define VNG_GCM_AGGREGATE_NBLOCKS 8
+
+#define VNG_GCM_HPOW(htable, i)  ((const __m128i *)((const uint8_t *)(htable) + 16 * ((i) - 1)))
+#define VNG_GCM_HKARA(htable, i) ((const __m128i *)((const uint8_t *)(htable) + 128 + 16 * ((i) - 1)))
+
+VNG_GCM_TARGET
+static inline __m128i vng_gcm_bswap(__m128i x)
+{
+    const __m128i mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(x, mask);
+}
+
+/* Unreduced 256-bit sum of products, lo ^ mid ^ hi make up the Karatsuba middle term. */
+typedef struct {
+    __m128i lo, mid, hi;
+} vng_gcm_acc;
+
+VNG_GCM_TARGET
+static inline void vng_gcm_acc_init(vng_gcm_acc *acc)
+{
+    acc->lo = _mm_setzero_si128();
+    acc->mid = _mm_setzero_si128();
+    acc->hi = _mm_setzero_si128();
+}
+
+/* acc += a * h, hk is (h.hi ^ h.lo) in the low qword */
+VNG_GCM_TARGET
+static inline void vng_gcm_mul_acc(vng_gcm_acc *acc, __m128i a, __m128i h, __m128i hk)
+{
+    __m128i ak = _mm_xor_si128(a, _mm_shuffle_epi32(a, 0x4e));
+
+    acc->lo = _mm_xor_si128(acc->lo, _mm_clmulepi64_si128(a, h, 0x00));
+    acc->hi = _mm_xor_si128(acc->hi, _mm_clmulepi64_si128(a, h, 0x11));
+    acc->mid = _mm_xor_si128(acc->mid, _mm_clmulepi64_si128(ak, hk, 0x00));
+}
+
+VNG_GCM_TARGET
+static inline __m128i vng_gcm_reduce(const vng_gcm_acc *acc)
+{
+    __m128i lo = acc->lo, hi = acc->hi;
+    __m128i mid = _mm_xor_si128(acc->mid, _mm_xor_si128(lo, hi));
+    __m128i t2, t4, t5, t7, t8, t9;
+
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    /* hi:lo <<= 1 */
+    t7 = _mm_srli_epi32(lo, 31);
+    t8 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t9 = _mm_srli_si128(t7, 12);
+    t8 = _mm_slli_si128(t8, 4);
+    t7 = _mm_slli_si128(t7, 4);
+    lo = _mm_or_si128(lo, t7);
+    hi = _mm_or_si128(hi, t8);
+    hi = _mm_or_si128(hi, t9);
+
+    /* first phase */
+    t7 = _mm_slli_epi32(lo, 31);
+    t8 = _mm_slli_epi32(lo, 30);
+    t9 = _mm_slli_epi32(lo, 25);
+    t7 = _mm_xor_si128(t7, _mm_xor_si128(t8, t9));
+    t8 = _mm_srli_si128(t7, 4);
+    t7 = _mm_slli_si128(t7, 12);
+    lo = _mm_xor_si128(lo, t7);
+
+    /* second phase */
+    t2 = _mm_srli_epi32(lo, 1);
+    t4 = _mm_srli_epi32(lo, 2);
+    t5 = _mm_srli_epi32(lo, 7);
+    t2 = _mm_xor_si128(t2, _mm_xor_si128(t4, t5));
+    t2 = _mm_xor_si128(t2, t8);
+    lo = _mm_xor_si128(lo, t2);
+
+    return _mm_xor_si128(hi, lo);
+}
+
+/* acc += (X ^ in[0]) * H^n ^ in[1] * H^(n-1) ^ ... ^ in[n-1] * H, in is raw (big-endian) ciphertext */
+VNG_GCM_TARGET
+static inline void vng_gcm_mul_acc_blocks(vng_gcm_acc *acc, const uint8_t *htable, __m128i X, size_t n, const uint8_t *in)
+{
+    for (size_t j = 0; j < n; j++) {
+        __m128i a = vng_gcm_bswap(_mm_loadu_si128((const __m128i *)(in + 16 * j)));
+        if (j == 0) {
+            a = _mm_xor_si128(a, X);
+        }
+        vng_gcm_mul_acc(acc, a, _mm_loadu_si128(VNG_GCM_HPOW(htable, n - j)), _mm_loadu_si128(VNG_GCM_HKARA(htable, n - j)));
+    }
+}
+
+/* X = GHASH_H(X, in[0 .. nblocks-1]), X byte-reversed */
+VNG_GCM_TARGET
+static inline __m128i vng_gcm_ghash(const uint8_t *htable, __m128i X, size_t nblocks, const uint8_t *in)
+{
+    vng_gcm_acc acc;
+
+    while (nblocks) {
+        size_t n = nblocks < VNG_GCM_AGGREGATE_NBLOCKS ? nblocks : VNG_GCM_AGGREGATE_NBLOCKS;
+
+        vng_gcm_acc_init(&acc);
+        vng_gcm_mul_acc_blocks(&acc, htable, X, n, in);
+        X = vng_gcm_reduce(&acc);
+
+        in += 16 * n;
+        nblocks -= n;
+    }
+
+    return X;
+}
+
+#endif /* CCMODE_GCM_VNG_SPEEDUP */
+
+#endif /* _CORECRYPTO_CCAES_INTEL_VNG_GCM_CLMUL_H_ */
@@ -21,8 +21,6 @@
 
 static int pdcmode_aes_cbc_init(const struct ccmode_cbc *cbc, cccbc_ctx *ctx, size_t key_len, const void *key)
 {
-    printf("%s\n", __func__);
-
     // normalize key lenght
     //  " Key lengths in the range 16 <= key_len <= 32 are given in bytes,
     //   those in the range 128 <= key_len <= 256 are given in bits " xnu/libkern/libkern/crypto/aes.h
@@ -47,16 +45,12 @@ static int pdcmode_aes_cbc_init(const struct ccmode_cbc *cbc, cccbc_ctx *ctx, si
 
 static int pdcmode_aes_cbc_encrypt(const cccbc_ctx *ctx, cccbc_iv *iv, size_t nblocks, const void *in, void *out)
 {
-    printf("%s\n", __func__);
-
     AES128_CBC_encrypt((struct _pdcmode_aes128_ctx *)ctx, (struct pdccbc_iv *)iv, nblocks, in, out);
     return 0;
 }
 
 static int pdcmode_aes_cbc_decrypt(const cccbc_ctx *ctx, cccbc_iv *iv, size_t nblocks, const void *in, void *out)
 {
-    printf("%s\n", __func__);
-
     AES128_CBC_decrypt((struct _pdcmode_aes128_ctx *)ctx, (struct pdccbc_iv *)iv, nblocks, in, out);
     return 0;
 }
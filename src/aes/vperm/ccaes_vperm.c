@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include "ccaes_vperm_internal.h"
+#include <corecrypto/cc_priv.h>
+
+#if CCAES_VPERM
+
+#include <immintrin.h>
+
+#define CCAES_VPERM_TARGET __attribute__((target("ssse3")))
+
+/*
+ * Nibble tables, entries 0-7 in the first word. P is the input basis change; R, the inverse of the GF(2^4)
+ * decomposition, underlies all the output tables: sb1 = P.L.R, sb2 = P.2.L.R, sbo = L.R, where L is the linear part of
+ * the S-box affine map. Decryption works in Q = P.L^-1 and its tables are Q.c.R for the InvMixColumns
+ * coefficients c, and dsbo = R.
+ */
+static const uint64_t ccaes_vperm_inv[4] CC_ALIGNED(16) = {
+    0x0E05060F0D080180, 0x040703090A0B0C02, 0x01040A060F0B0780, 0x030D0E0C02050809 // 1/x, a/x
+};
+static const uint64_t ccaes_vperm_ipt[4] CC_ALIGNED(16) = {
+    0xC2B2E8985A2A7000, 0xCABAE09052227808, 0x4C01307D317C4D00, 0xCD80B1FCB0FDCC81
+};
+static const uint64_t ccaes_vperm_sb1[4] CC_ALIGNED(16) = {
+    0xB19BE18FCB503E00, 0xA5DF7A6E142AF544, 0x3618D415FAE22300, 0x3BF7CCC10D2ED9EF
+};
+static const uint64_t ccaes_vperm_sb2[4] CC_ALIGNED(16) = {
+    0xE27A93C60B712400, 0x5EB7E955BC982FCD, 0x69EB88400AE12900, 0xC2A163C8AB82234A
+};
+static const uint64_t ccaes_vperm_sbo[4] CC_ALIGNED(16) = {
+    0xD0D26D176FBDC700, 0x15AABF7AC502A878, 0xCFE474A55FBB6A00, 0x8E1E90D1412B35FA
+};
+static const uint64_t ccaes_vperm_dipt[4] CC_ALIGNED(16) = {
+    0x0F505B040B545F00, 0x154A411E114E451A, 0x86E383E660056500, 0x12771772F491F194
+};
+static const uint64_t ccaes_vperm_dsb9[4] CC_ALIGNED(16) = {
+    0x851C03539A86D600, 0xCAD51F504F994CC9, 0xC03B1789ECD74900, 0x725E2C9EB2FBA565
+};
+static const uint64_t ccaes_vperm_dsbd[4] CC_ALIGNED(16) = {
+    0x7D57CCDFE6B1A200, 0xF56E9B13882A4439, 0x3CE2FAF724C6CB00, 0x2931180D15DEEFD3
+};
+static const uint64_t ccaes_vperm_dsbb[4] CC_ALIGNED(16) = {
+    0xD022649296B44200, 0x602646F6B0F2D404, 0xC19498A6CD596700, 0xF3FF0C3E3255AA6B
+};
+static const uint64_t ccaes_vperm_dsbe[4] CC_ALIGNED(16) = {
+    0x46F2929626D4D000, 0x2242600464B4F6B0, 0x0C55A6CDFFAAC100, 0x9467F36B98593E32
+};
+static const uint64_t ccaes_vperm_dsbo[4] CC_ALIGNED(16) = {
+    0x1387EA537EF94000, 0xC7AA6DB9D4943E2D, 0x12D7560F93441D00, 0xCA4B8159D8C58E9C
+};
+
+/* byte shuffles: ShiftRows, InvShiftRows, and each column rotated by one byte either way */
+static const uint64_t ccaes_vperm_sr[2] CC_ALIGNED(16) = { 0x030E09040F0A0500, 0x0B06010C07020D08 };
+static const uint64_t ccaes_vperm_isr[2] CC_ALIGNED(16) = { 0x0B0E0104070A0D00, 0x0306090C0F020508 };
+static const uint64_t ccaes_vperm_fwd[2] CC_ALIGNED(16) = { 0x0407060500030201, 0x0C0F0E0D080B0A09 };
+static const uint64_t ccaes_vperm_bwd[2] CC_ALIGNED(16) = { 0x0605040702010003, 0x0E0D0C0F0A09080B };
+
+/* 0x63 and 0x05, the S-box constants, as seen in the input basis */
+#define CCAES_VPERM_S63 0x63
+#define CCAES_VPERM_P05 0xE8
+
+#define LOAD(t) _mm_load_si128((const __m128i *)(t))
+#define LOAD_HI(t) _mm_load_si128((const __m128i *)(t) + 1)
+#define SHUF(t, x) _mm_shuffle_epi8(LOAD(t), (x))
+#define XOR(a, b) _mm_xor_si128((a), (b))
+
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_lo(__m128i x)
+{
+    return _mm_and_si128(x, _mm_set1_epi8(0x0f));
+}
+
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_hi(__m128i x)
+{
+    return _mm_and_si128(_mm_srli_epi32(x, 4), _mm_set1_epi8(0x0f));
+}
+
+/* a linear map on every byte, as the XOR of a table for each nibble */
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_transform(const uint64_t *t, __m128i x)
+{
+    return XOR(_mm_shuffle_epi8(LOAD(t), ccaes_vperm_lo(x)), _mm_shuffle_epi8(LOAD_HI(t), ccaes_vperm_hi(x)));
+}
+
+/* the two-table output of an S-box lookup */
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_output(const uint64_t *t, __m128i io, __m128i jo)
+{
+    return XOR(_mm_shuffle_epi8(LOAD(t), io), _mm_shuffle_epi8(LOAD_HI(t), jo));
+}
+
+/*
+ * GF(2^8) inversion of every byte of x, in the input basis, as the pair (io, jo) the output tables take. Index bytes
+ * with the top bit set, from the inverse of zero, look up zero.
+ */
+CCAES_VPERM_TARGET static inline void ccaes_vperm_invert(__m128i x, __m128i *io, __m128i *jo)
+{
+    __m128i i = ccaes_vperm_hi(x), k = ccaes_vperm_lo(x), j = XOR(i, k);
+    __m128i ak = _mm_shuffle_epi8(LOAD_HI(ccaes_vperm_inv), k);
+    __m128i iak = XOR(SHUF(ccaes_vperm_inv, i), ak);
+    __m128i jak = XOR(SHUF(ccaes_vperm_inv, j), ak);
+
+    *io = XOR(SHUF(ccaes_vperm_inv, iak), j);
+    *jo = XOR(SHUF(ccaes_vperm_inv, jak), i);
+}
+
+/*
+ * One middle encryption round. MixColumns is 2S + 3 rot(S) + rot^2(S) + rot^3(S); the key comes in with S through A
+ * and so picks up rot + rot^2 + rot^3, which the key schedule undoes ahead of time.
+ */
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_encrypt_round(__m128i v, __m128i k)
+{
+    __m128i io, jo, a, t;
+
+    ccaes_vperm_invert(_mm_shuffle_epi8(v, LOAD(ccaes_vperm_sr)), &io, &jo);
+    a = XOR(ccaes_vperm_output(ccaes_vperm_sb1, io, jo), k);
+    t = XOR(ccaes_vperm_output(ccaes_vperm_sb2, io, jo), _mm_shuffle_epi8(a, LOAD(ccaes_vperm_fwd)));
+
+    return XOR(_mm_shuffle_epi8(t, LOAD(ccaes_vperm_fwd)), XOR(t, _mm_shuffle_epi8(a, LOAD(ccaes_vperm_bwd))));
+}
+
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_encrypt_last(__m128i v, __m128i k)
+{
+    __m128i io, jo;
+
+    ccaes_vperm_invert(_mm_shuffle_epi8(v, LOAD(ccaes_vperm_sr)), &io, &jo);
+    return XOR(ccaes_vperm_output(ccaes_vperm_sbo, io, jo), k);
+}
+
+/* One middle round of the equivalent inverse cipher, InvMixColumns by Horner's rule over the column rotation. */
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_decrypt_round(__m128i v, __m128i k)
+{
+    __m128i io, jo, fwd = LOAD(ccaes_vperm_fwd), t;
+
+    ccaes_vperm_invert(_mm_shuffle_epi8(v, LOAD(ccaes_vperm_isr)), &io, &jo);
+    t = ccaes_vperm_output(ccaes_vperm_dsb9, io, jo);
+    t = XOR(_mm_shuffle_epi8(t, fwd), ccaes_vperm_output(ccaes_vperm_dsbd, io, jo));
+    t = XOR(_mm_shuffle_epi8(t, fwd), ccaes_vperm_output(ccaes_vperm_dsbb, io, jo));
+    t = XOR(_mm_shuffle_epi8(t, fwd), ccaes_vperm_output(ccaes_vperm_dsbe, io, jo));
+
+    return XOR(t, k);
+}
+
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_decrypt_last(__m128i v, __m128i k)
+{
+    __m128i io, jo;
+
+    ccaes_vperm_invert(_mm_shuffle_epi8(v, LOAD(ccaes_vperm_isr)), &io, &jo);
+    return XOR(ccaes_vperm_output(ccaes_vperm_dsbo, io, jo), k);
+}
+
+#define RK(key, r) _mm_loadu_si128((const __m128i *)(key)->rk + (r))
+
+/* Two blocks at a time so the two dependency chains overlap, then a last single block. */
+CCAES_VPERM_TARGET void ccaes_vperm_encrypt(const struct ccaes_vperm_key *key, size_t nblocks, const uint8_t *in,
+                                            uint8_t *out)
+{
+    uint32_t nr = key->nrounds;
+
+    for (; nblocks >= 2; nblocks -= 2, in += 32, out += 32) {
+        __m128i v0 = XOR(ccaes_vperm_transform(ccaes_vperm_ipt, _mm_loadu_si128((const __m128i *)in)), RK(key, 0));
+        __m128i v1 = XOR(ccaes_vperm_transform(ccaes_vperm_ipt, _mm_loadu_si128((const __m128i *)in + 1)), RK(key, 0));
+
+        for (uint32_t r = 1; r < nr; r++) {
+            v0 = ccaes_vperm_encrypt_round(v0, RK(key, r));
+            v1 = ccaes_vperm_encrypt_round(v1, RK(key, r));
+        }
+        _mm_storeu_si128((__m128i *)out, ccaes_vperm_encrypt_last(v0, RK(key, nr)));
+        _mm_storeu_si128((__m128i *)out + 1, ccaes_vperm_encrypt_last(v1, RK(key, nr)));
+    }
+
+    if (nblocks) {
+        __m128i v = XOR(ccaes_vperm_transform(ccaes_vperm_ipt, _mm_loadu_si128((const __m128i *)in)), RK(key, 0));
+
+        for (uint32_t r = 1; r < nr; r++) {
+            v = ccaes_vperm_encrypt_round(v, RK(key, r));
+        }
+        _mm_storeu_si128((__m128i *)out, ccaes_vperm_encrypt_last(v, RK(key, nr)));
+    }
+}
+
+CCAES_VPERM_TARGET void ccaes_vperm_decrypt(const struct ccaes_vperm_key *key, size_t nblocks, const uint8_t *in,
+                                            uint8_t *out)
+{
+    uint32_t nr = key->nrounds;
+
+    for (; nblocks >= 2; nblocks -= 2, in += 32, out += 32) {
+        __m128i v0 = XOR(ccaes_vperm_transform(ccaes_vperm_dipt, _mm_loadu_si128((const __m128i *)in)), RK(key, nr));
+        __m128i v1 =
+            XOR(ccaes_vperm_transform(ccaes_vperm_dipt, _mm_loadu_si128((const __m128i *)in + 1)), RK(key, nr));
+
+        for (uint32_t r = nr - 1; r > 0; r--) {
+            v0 = ccaes_vperm_decrypt_round(v0, RK(key, r));
+            v1 = ccaes_vperm_decrypt_round(v1, RK(key, r));
+        }
+        _mm_storeu_si128((__m128i *)out, ccaes_vperm_decrypt_last(v0, RK(key, 0)));
+        _mm_storeu_si128((__m128i *)out + 1, ccaes_vperm_decrypt_last(v1, RK(key, 0)));
+    }
+
+    if (nblocks) {
+        __m128i v = XOR(ccaes_vperm_transform(ccaes_vperm_dipt, _mm_loadu_si128((const __m128i *)in)), RK(key, nr));
+
+        for (uint32_t r = nr - 1; r > 0; r--) {
+            v = ccaes_vperm_decrypt_round(v, RK(key, r));
+        }
+        _mm_storeu_si128((__m128i *)out, ccaes_vperm_decrypt_last(v, RK(key, 0)));
+    }
+}
+
+/* the S-box on the low word, for the key expansion */
+CCAES_VPERM_TARGET static uint32_t ccaes_vperm_sub_word(uint32_t x)
+{
+    __m128i io, jo;
+
+    ccaes_vperm_invert(ccaes_vperm_transform(ccaes_vperm_ipt, _mm_cvtsi32_si128((int)x)), &io, &jo);
+    return (uint32_t)_mm_cvtsi128_si32(XOR(ccaes_vperm_output(ccaes_vperm_sbo, io, jo), _mm_set1_epi8(CCAES_VPERM_S63)));
+}
+
+/* FIPS-197 key expansion into w, on little-endian words; returns the number of rounds */
+CCAES_VPERM_TARGET static uint32_t ccaes_vperm_expand(uint32_t *w, size_t key_nbytes, const uint8_t *k)
+{
+    static const uint8_t rcon[] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36 };
+    size_t nk = key_nbytes / 4, nw = 4 * (nk + 7), i, j, r;
+    uint32_t tmp;
+
+    for (i = 0; i < nk; i++) {
+        CC_LOAD32_LE(w[i], k + 4 * i);
+    }
+    tmp = w[nk - 1];
+    for (i = nk, j = 0, r = 0; i < nw; i++) {
+        if (j == 0) {
+            tmp = (tmp << 24) | (tmp >> 8);
+            tmp = ccaes_vperm_sub_word(tmp) ^ rcon[r];
+        } else if (nk > 6 && j == 4) {
+            tmp = ccaes_vperm_sub_word(tmp);
+        }
+        tmp ^= w[i - nk];
+        w[i] = tmp;
+        if (++j == nk) {
+            j = 0;
+            r++;
+        }
+    }
+
+    return (uint32_t)(nk + 6);
+}
+
+static int ccaes_vperm_check_key(size_t key_nbytes)
+{
+    if (key_nbytes != CCAES_KEY_SIZE_128 && key_nbytes != CCAES_KEY_SIZE_192 && key_nbytes != CCAES_KEY_SIZE_256) {
+        return CCERR_PARAMETER;
+    }
+    return CCERR_OK;
+}
+
+/*
+ * rk_0 goes in the input basis. A middle round key k becomes (rot + rot^2 + rot^3)(P(k ^ 0x63)): that map is its own
+ * inverse, and 0x63 is what the S-box tables leave out. The last one stays in the standard basis, with 0x63.
+ */
+CCAES_VPERM_TARGET int ccaes_vperm_init_encrypt(struct ccaes_vperm_key *key, size_t key_nbytes, const void *rawkey)
+{
+    __m128i *rk = (__m128i *)key->rk;
+    __m128i fwd = LOAD(ccaes_vperm_fwd), s63 = _mm_set1_epi8(CCAES_VPERM_S63);
+    uint32_t w[60];
+    uint32_t nr;
+
+    if (ccaes_vperm_check_key(key_nbytes)) {
+        return CCERR_PARAMETER;
+    }
+
+    nr = ccaes_vperm_expand(w, key_nbytes, rawkey);
+    key->nrounds = nr;
+
+    _mm_storeu_si128(rk, ccaes_vperm_transform(ccaes_vperm_ipt, _mm_loadu_si128((const __m128i *)w)));
+    for (uint32_t r = 1; r < nr; r++) {
+        __m128i k = ccaes_vperm_transform(ccaes_vperm_ipt, XOR(_mm_loadu_si128((const __m128i *)(w + 4 * r)), s63));
+        __m128i k1 = _mm_shuffle_epi8(k, fwd), k2 = _mm_shuffle_epi8(k1, fwd);
+
+        _mm_storeu_si128(rk + r, XOR(XOR(k1, k2), _mm_shuffle_epi8(k2, fwd)));
+    }
+    _mm_storeu_si128(rk + nr, XOR(_mm_loadu_si128((const __m128i *)(w + 4 * nr)), s63));
+
+    cc_clear(sizeof(w), w);
+
+    return CCERR_OK;
+}
+
+/* GF(2^8) doubling of every byte */
+CCAES_VPERM_TARGET static inline __m128i ccaes_vperm_xtime(__m128i x)
+{
+    __m128i carry = _mm_and_si128(_mm_cmpgt_epi8(_mm_setzero_si128(), x), _mm_set1_epi8(0x1b));
+
+    return XOR(_mm_add_epi8(x, x), carry);
+}
+
+/*
+ * The equivalent inverse cipher adds InvMixColumns(k) in the middle rounds. Those and the first key go in the
+ * decryption basis Q, with P(0x05), the constant of the inverse affine map, added; the last key is plain.
+ */
+CCAES_VPERM_TARGET int ccaes_vperm_init_decrypt(struct ccaes_vperm_key *key, size_t key_nbytes, const void *rawkey)
+{
+    __m128i *rk = (__m128i *)key->rk;
+    __m128i fwd = LOAD(ccaes_vperm_fwd), p05 = _mm_set1_epi8((char)CCAES_VPERM_P05);
+    uint32_t w[60];
+    uint32_t nr;
+
+    if (ccaes_vperm_check_key(key_nbytes)) {
+        return CCERR_PARAMETER;
+    }
+
+    nr = ccaes_vperm_expand(w, key_nbytes, rawkey);
+    key->nrounds = nr;
+
+    _mm_storeu_si128(rk, _mm_loadu_si128((const __m128i *)w));
+    for (uint32_t r = 1; r < nr; r++) {
+        __m128i k = _mm_loadu_si128((const __m128i *)(w + 4 * r));
+        __m128i k2 = ccaes_vperm_xtime(k), k4 = ccaes_vperm_xtime(k2), k8 = ccaes_vperm_xtime(k4);
+        __m128i k9 = XOR(k8, k), kb = XOR(k9, k2), kd = XOR(k9, k4), ke = XOR(XOR(k8, k4), k2);
+
+        /* e k_j + b k_(j+1) + d k_(j+2) + 9 k_(j+3) */
+        k = XOR(_mm_shuffle_epi8(k9, fwd), kd);
+        k = XOR(_mm_shuffle_epi8(k, fwd), kb);
+        k = XOR(_mm_shuffle_epi8(k, fwd), ke);
+        _mm_storeu_si128(rk + r, XOR(ccaes_vperm_transform(ccaes_vperm_dipt, k), p05));
+    }
+    _mm_storeu_si128(rk + nr,
+                     XOR(ccaes_vperm_transform(ccaes_vperm_dipt, _mm_loadu_si128((const __m128i *)(w + 4 * nr))), p05));
+
+    cc_clear(sizeof(w), w);
+
+    return CCERR_OK;
+}
+
+#endif /* CCAES_VPERM */
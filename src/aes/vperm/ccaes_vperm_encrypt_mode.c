@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include "ccaes_vperm_internal.h"
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccaes.h>
+
+#if CCAES_VPERM
+
+static int ccaes_vperm_ecb_encrypt_init(const struct ccmode_ecb *ecb CC_UNUSED, ccecb_ctx *ctx, size_t key_nbytes,
+                                      const void *key)
+{
+    return ccaes_vperm_init_encrypt((struct ccaes_vperm_key *)ctx, key_nbytes, key);
+}
+
+static int ccaes_vperm_ecb_encrypt(const ccecb_ctx *ctx, size_t nblocks, const void *in, void *out)
+{
+    ccaes_vperm_encrypt((const struct ccaes_vperm_key *)ctx, nblocks, in, out);
+
+    return CCERR_OK;
+}
+
+const struct ccmode_ecb ccaes_vperm_ecb_encrypt_mode = {
+    .size = sizeof(struct ccaes_vperm_key),
+    .block_size = CCAES_BLOCK_SIZE,
+    .init = ccaes_vperm_ecb_encrypt_init,
+    .ecb = ccaes_vperm_ecb_encrypt,
+};
+
+#endif /* CCAES_VPERM */
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#ifndef _CORECRYPTO_CCAES_VPERM_INTERNAL_H_
+#define _CORECRYPTO_CCAES_VPERM_INTERNAL_H_
+
+#include <corecrypto/ccaes.h>
+
+#if CCAES_VPERM
+
+/*
+ * Constant-time AES with SSSE3 vector permutes, after Hamburg, "Accelerating AES with Vector Permute Instructions"
+ * (CHES 2009).
+ *
+ * The state lives in a basis where GF(2^8) inversion splits into GF(2^4) inversions of the two nibbles, and every
+ * GF(2^4) table has 16 entries, so pshufb does each lookup on all 16 bytes at once from registers. There are no
+ * memory lookups indexed by secrets. A block costs the same alone as in a batch, which suits single-block callers
+ * like ccxts_set_tweak() and the CBC-MAC chain.
+ */
+
+/* round keys, already mapped into the basis and form each round adds them in; the two directions differ */
+struct ccaes_vperm_key {
+    uint64_t rk[2 * 15];
+    uint32_t nrounds;
+};
+
+int ccaes_vperm_init_encrypt(struct ccaes_vperm_key *key, size_t key_nbytes, const void *rawkey);
+int ccaes_vperm_init_decrypt(struct ccaes_vperm_key *key, size_t key_nbytes, const void *rawkey);
+void ccaes_vperm_encrypt(const struct ccaes_vperm_key *key, size_t nblocks, const uint8_t *in, uint8_t *out);
+void ccaes_vperm_decrypt(const struct ccaes_vperm_key *key, size_t nblocks, const uint8_t *in, uint8_t *out);
+
+#endif /* CCAES_VPERM */
+
+#endif /* _CORECRYPTO_CCAES_VPERM_INTERNAL_H_ */
@@ -1,11 +1,23 @@
 #include <corecrypto/cc.h>
 #include <stddef.h>
+#include <string.h>
 
 void cc_clear(size_t len, void *dst)
 {
+#if defined(__GNUC__) || defined(__clang__)
+    // The empty asm takes dst and clobbers memory, so the compiler has to
+    // assume it reads the zeroed bytes. Inline asm is just as opaque in LTO
+    // IR, so the memset can't be dropped as a dead store after cross-module
+    // inlining either, and it stays a plain (vectorised) memset.
+    memset(dst, 0, len);
+    __asm__ __volatile__("" : : "r"(dst) : "memory");
+#else
+    // No way to fence a memset here, so every byte goes through a volatile
+    // store instead. Slower, but never elided.
     // This implementation is taken from the mbedtls_zeroize() function in mbedtls/aes.c
     volatile unsigned char *p = dst;
     while (len--) {
         *p++ = 0;
     }
+#endif
 }
@@ -22,18 +22,17 @@
 
 cc_unit ccn_add(cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t)
 {
-#if CCN_ADD_ASM
+#if CCN_ADD_ASM && (defined(__x86_64__) || defined(__i386__))
     return ccn_add_asm(n, r, s, t);
 #else
     cc_unit carry = 0;
 
-    for (int i = 0; i < n; i++) {
-        cc_unit u = s[i] + t[i] + carry;
-        if (u < s[i] || u == s[i] && carry) {
-            carry = 1;
-        } else {
-            carry = 0;
-        }
+    /* branch-free, the carry chain must not depend on the operands */
+    for (cc_size i = 0; i < n; i++) {
+        cc_unit u = s[i] + carry;
+        carry = u < carry;
+        u += t[i];
+        carry |= u < t[i];
 
         r[i] = u;
     }
@@ -24,6 +24,10 @@ cc_size ccn_bitlen(cc_size n, const cc_unit *s)
     cc_size avail = ccn_n(n, s);
     cc_size size = ccn_bitsof_n(avail);
 
+    if (avail == 0) {
+        return 0;
+    }
+
     cc_unit u = s[avail - 1];
 
 #if CCN_UNIT_SIZE == 8
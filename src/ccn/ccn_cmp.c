@@ -21,7 +21,8 @@
 int ccn_cmp(cc_size n, const cc_unit *s, const cc_unit *t)
 {
     if (n) {
-        for (cc_size i = 0; i < n; i++) {
+        /* most significant unit first */
+        for (cc_size i = n; i-- > 0;) {
             if (s[i] > t[i]) {
                 return 1;
             } else if (s[i] < t[i]) {
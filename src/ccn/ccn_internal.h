@@ -25,4 +25,47 @@
 cc_unit ccn_add_asm(cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t);
 cc_unit ccn_sub_asm(cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t);
 
+/* a * b + c + d -> (return value, *lo), this never overflows two units */
+#if CCN_UNIT_SIZE == 8 && !CCN_UINT128_SUPPORT_FOR_64BIT_ARCH
+CC_INLINE cc_unit ccn_mul_add2(cc_unit a, cc_unit b, cc_unit c, cc_unit d, cc_unit *lo)
+{
+    uint64_t a0 = a & UINT32_MAX, a1 = a >> 32;
+    uint64_t b0 = b & UINT32_MAX, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (p01 & UINT32_MAX) + (p10 & UINT32_MAX);
+    uint64_t l = (p00 & UINT32_MAX) | (mid << 32);
+    uint64_t h = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+
+    l += c;
+    h += l < c;
+    l += d;
+    h += l < d;
+
+    *lo = l;
+    return h;
+}
+#else
+CC_INLINE cc_unit ccn_mul_add2(cc_unit a, cc_unit b, cc_unit c, cc_unit d, cc_unit *lo)
+{
+    cc_dunit t = (cc_dunit)a * b + c + d;
+
+    *lo = (cc_unit)t;
+    return (cc_unit)(t >> CCN_UNIT_BITS);
+}
+#endif
+
+/* r = s ? a : b in constant time, s must be 0 or 1 */
+CC_INLINE void ccn_mux(cc_size n, cc_unit s, cc_unit *r, const cc_unit *a, const cc_unit *b)
+{
+    cc_unit mask = (cc_unit)0 - s;
+
+    for (cc_size i = 0; i < n; i++) {
+        r[i] = b[i] ^ ((a[i] ^ b[i]) & mask);
+    }
+}
+
+/* s^2 -> r_2n, r_2n must not overlap with s. Same as ccn_mul(n, r_2n, s, s)
+   but computes each cross product once when CCN_DEDICATED_SQR is set. */
+void ccn_sqr(cc_size n, cc_unit *r_2n, const cc_unit *s);
+
 #endif /* _CORECRYPTO_CCN_INTERNAL_H_ */
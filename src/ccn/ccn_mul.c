@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "ccn_internal.h"
+#include <corecrypto/ccn.h>
+
+void ccn_mul(cc_size n, cc_unit *r_2n, const cc_unit *s, const cc_unit *t)
+{
+    if (n == 0) {
+        return;
+    }
+
+    /* schoolbook, one row of s * t[i] per unit of t */
+    r_2n[n] = ccn_mul1(n, r_2n, s, t[0]);
+
+    for (cc_size i = 1; i < n; i++) {
+        r_2n[n + i] = ccn_addmul1(n, r_2n + i, s, t[i]);
+    }
+}
@@ -22,13 +22,10 @@
 
 cc_size ccn_n(cc_size n, const cc_unit *s)
 {
-    cc_size size = n; /* ccn_is_zero relies on this returning zero when s[0] is zero. */
-
-    while (n--) {
-        if (s[n] == 0) {
-            size--;
-        }
+    /* strip leading (most significant) zero units only */
+    while (n && s[n - 1] == 0) {
+        n--;
     }
 
-    return size;
+    return n;
 }
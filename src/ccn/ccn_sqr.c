@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "ccn_internal.h"
+#include <corecrypto/ccn.h>
+
+void ccn_sqr(cc_size n, cc_unit *r_2n, const cc_unit *s)
+{
+#if CCN_DEDICATED_SQR
+    cc_unit carry = 0;
+
+    ccn_zero(2 * n, r_2n);
+
+    /* cross products s[i] * s[j] for j > i, each computed once */
+    for (cc_size i = 0; i + 1 < n; i++) {
+        r_2n[i + n] = ccn_addmul1(n - 1 - i, r_2n + 2 * i + 1, s + i + 1, s[i]);
+    }
+
+    /* double them */
+    for (cc_size i = 0; i < 2 * n; i++) {
+        cc_unit u = r_2n[i];
+        r_2n[i] = (u << 1) | carry;
+        carry = u >> (CCN_UNIT_BITS - 1);
+    }
+
+    /* and add the squares on the diagonal */
+    carry = 0;
+    for (cc_size i = 0; i < n; i++) {
+        cc_unit hi = ccn_mul_add2(s[i], s[i], r_2n[2 * i], carry, &r_2n[2 * i]);
+        cc_unit u = r_2n[2 * i + 1] + hi;
+        carry = u < hi;
+        r_2n[2 * i + 1] = u;
+    }
+#else
+    ccn_mul(n, r_2n, s, s);
+#endif
+}
@@ -22,28 +22,16 @@
 
 cc_unit ccn_sub(cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t)
 {
-#if CCN_ADD_ASM
+#if CCN_SUB_ASM && (defined(__x86_64__) || defined(__i386__))
     return ccn_sub_asm(n, r, s, t);
 #else
     cc_unit borrow = 0;
 
-    for (int i = 0; i < n; i++) {
-        cc_unit u = s[i];
-
-        /* first, handle any borrow that may be needed */
-        if (borrow) {
-            /* borrow flag, because this is absoultely a disaster. */
-            if (u > 0) {
-                borrow = 0; /* no borrowing here */
-            }
-
-            u -= 1;
-        }
-
-        if (u < t[i]) {
-            borrow = 1;
-        }
-
+    /* branch-free, the borrow chain must not depend on the operands */
+    for (cc_size i = 0; i < n; i++) {
+        cc_unit u = s[i] - borrow;
+        borrow = u > s[i];
+        borrow |= u < t[i];
         u -= t[i];
 
         r[i] = u;
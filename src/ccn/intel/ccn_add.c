@@ -7,16 +7,15 @@
 
 #include <corecrypto/ccn.h>
 
-#if 0
-
-#if CCN_ADD_ASM
+/* x86 only, the other targets that set CCN_ADD_ASM have no such helper */
+#if CCN_ADD_ASM && (defined(__x86_64__) || defined(__i386__))
 
 #include <immintrin.h>
 
 #if CCN_UNIT_SIZE == 8
-#define cc_addcarry(cin, a, b, out) _addcarry_u64(cin, a, b, out)
+#define cc_addcarry(cin, a, b, out) _addcarry_u64(cin, a, b, (unsigned long long *)(out))
 #elif CCN_UNIT_SIZE == 4
-#define cc_addcarry(cin, a, b, out) _addcarry_u32(cin, a, b, out)
+#define cc_addcarry(cin, a, b, out) _addcarry_u32(cin, a, b, (unsigned int *)(out))
 #endif
 
 cc_unit ccn_add_asm(cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t)
@@ -38,5 +37,3 @@ cc_unit ccn_add_asm(cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t)
 }
 
 #endif
-
-#endif
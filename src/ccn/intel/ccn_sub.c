@@ -7,27 +7,21 @@
 
 #include <corecrypto/ccn.h>
 
-#if 0
-
-#if CCN_SUB_ASM
+/* x86 only, the other targets that set CCN_SUB_ASM have no such helper */
+#if CCN_SUB_ASM && (defined(__x86_64__) || defined(__i386__))
 
 #include <immintrin.h>
 
 #if CCN_UNIT_SIZE == 8
-#define cc_subborrow(bin, x, y, out) _subborrow_u64(bin, x, y, out)
+#define cc_subborrow(bin, x, y, out) _subborrow_u64(bin, x, y, (unsigned long long *)(out))
 #elif CCN_UNIT_SIZE == 4
-#define cc_subborrow(bin, x, y, out) _subborrow_u32(bin, x, y, out)
+#define cc_subborrow(bin, x, y, out) _subborrow_u32(bin, x, y, (unsigned int *)(out))
 #endif
 
 cc_unit ccn_sub_asm(cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t)
 {
     uint8_t borrow_in = 0;
 
-    if (ccn_cmp(n, s, t) == -1) {
-        return 1;
-        /* ^ i believe this is what the comment at the header declaration meant */
-    }
-
     for (cc_size i = 0; i < n; i++) {
         borrow_in = cc_subborrow(borrow_in, s[i], t[i], &r[i]);
     }
@@ -36,5 +30,3 @@ cc_unit ccn_sub_asm(cc_size n, cc_unit *r, const cc_unit *s, const cc_unit *t)
 }
 
 #endif
-
-#endif
@@ -16,23 +16,27 @@
  * @LICENSE_HEADER_END@
  */
 
+#include "ccchacha20_internal.h"
 #include <corecrypto/cc_priv.h>
-#include <corecrypto/ccchacha20poly1305_priv.h>
+#include <corecrypto/cc_runtime_config.h>
 
 /*
  * REFERENCE SOURCES:
  *  - https://datatracker.ietf.org/doc/html/rfc7539
  */
 
-#define CHACHA_QUARTERROUND(state, a, b, c, d)  \
-    state[a] += state[b];                       \
-    state[d] = CC_ROL(state[d] ^ state[a], 16); \
-    state[c] += state[d];                       \
-    state[b] = CC_ROL(state[b] ^ state[c], 12); \
-    state[a] += state[b];                       \
-    state[d] = CC_ROL(state[d] ^ state[a], 8);  \
-    state[c] += state[d];                       \
-    state[b] = CC_ROL(state[b] ^ state[c], 7);
+/* constant rotates in plain C, the inline asm CC_ROL pins the count to %cl and serializes the rounds */
+#define CCCHACHA_ROTL(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define CHACHA_QUARTERROUND(state, a, b, c, d)          \
+    state[a] += state[b];                               \
+    state[d] = CCCHACHA_ROTL(state[d] ^ state[a], 16);  \
+    state[c] += state[d];                               \
+    state[b] = CCCHACHA_ROTL(state[b] ^ state[c], 12);  \
+    state[a] += state[b];                               \
+    state[d] = CCCHACHA_ROTL(state[d] ^ state[a], 8);   \
+    state[c] += state[d];                               \
+    state[b] = CCCHACHA_ROTL(state[b] ^ state[c], 7);
 
 /*
  *  c = constant, k - key, b = counter, n = nonce
@@ -69,6 +73,8 @@ int ccchacha20_init(ccchacha20_ctx *ctx, const uint8_t *key)
     CC_WRITE_LE32(&ctx->state[10], *(uint32_t *)(key + 24));
     CC_WRITE_LE32(&ctx->state[11], *(uint32_t *)(key + 28));
 
+    ctx->leftover = 0;
+
     return CCERR_OK;
 }
 
@@ -78,7 +84,8 @@ int ccchacha20_setcounter(ccchacha20_ctx *ctx, uint32_t counter)
         return CCERR_PARAMETER;
     }
 
-    ctx->state[11] = CC_H2LE32(counter);
+    ctx->state[12] = CC_H2LE32(counter);
+    ctx->leftover = 0;
 
     return CCERR_OK;
 }
@@ -94,6 +101,7 @@ int ccchacha20_setnonce(ccchacha20_ctx *ctx, const uint8_t *nonce)
         CC_WRITE_LE32(&ctx->state[13], *(uint32_t *)(nonce));
         CC_WRITE_LE32(&ctx->state[14], *(uint32_t *)(nonce + 4));
         CC_WRITE_LE32(&ctx->state[15], *(uint32_t *)(nonce + 8));
+        ctx->leftover = 0;
     } else {
         return CCERR_CALL_SEQUENCE;
     }
@@ -104,64 +112,115 @@ int ccchacha20_setnonce(ccchacha20_ctx *ctx, const uint8_t *nonce)
 int _ccchacha20_block(ccchacha20_ctx *ctx)
 {
     uint32_t *buf = (uint32_t *)ctx->buffer;
+    uint32_t x[16];
 
-    /* copy our initial state to the buffer */
-    CC_MEMCPY(buf, ctx->state, CCCHACHA20_BLOCK_NBYTES);
+    /* work on a local copy, through buf the compiler has to assume aliasing and keeps every word in memory */
+    CC_MEMCPY(x, ctx->state, CCCHACHA20_BLOCK_NBYTES);
 
     /* Setup our state */
     for (int r = 20; r > 0; r -= 2) {
-        CHACHA_QUARTERROUND(buf, 0, 4, 8, 12);
-        CHACHA_QUARTERROUND(buf, 1, 5, 9, 13);
-        CHACHA_QUARTERROUND(buf, 2, 6, 10, 14);
-        CHACHA_QUARTERROUND(buf, 3, 7, 11, 15);
-        CHACHA_QUARTERROUND(buf, 0, 5, 10, 15);
-        CHACHA_QUARTERROUND(buf, 1, 6, 11, 12);
-        CHACHA_QUARTERROUND(buf, 2, 7, 8, 13);
-        CHACHA_QUARTERROUND(buf, 3, 4, 9, 14);
+        CHACHA_QUARTERROUND(x, 0, 4, 8, 12);
+        CHACHA_QUARTERROUND(x, 1, 5, 9, 13);
+        CHACHA_QUARTERROUND(x, 2, 6, 10, 14);
+        CHACHA_QUARTERROUND(x, 3, 7, 11, 15);
+        CHACHA_QUARTERROUND(x, 0, 5, 10, 15);
+        CHACHA_QUARTERROUND(x, 1, 6, 11, 12);
+        CHACHA_QUARTERROUND(x, 2, 7, 8, 13);
+        CHACHA_QUARTERROUND(x, 3, 4, 9, 14);
     }
 
     /* once we're done, we have to add the initial state to the current state, or vice versa. */
     for (int s = 0; s < 16; s++) {
-        buf[s] += ctx->state[s];
+        buf[s] = x[s] + ctx->state[s];
     }
 
     return CCERR_OK;
 }
 
-int ccchacha20_update(ccchacha20_ctx *ctx, size_t nbytes, const void *in, void *out)
+#define CCCHACHA20_ADVANCE(n)                         \
+    do {                                              \
+        ctx->state[12] += (uint32_t)(n);              \
+        nblocks -= (n);                               \
+        in += (n) * CCCHACHA20_BLOCK_NBYTES;          \
+        out += (n) * CCCHACHA20_BLOCK_NBYTES;         \
+    } while (0)
+
+/* whole blocks straight from in to out, as many at a time as the cpu allows */
+static void ccchacha20_xor_blocks(ccchacha20_ctx *ctx, size_t nblocks, const uint8_t *in, uint8_t *out)
 {
-    const uint32_t *data_chunk_ptr = in;
-    uint32_t *out_chunk_buf = out;
     uint32_t *buf = (uint32_t *)ctx->buffer;
+    size_t n;
+
+#if CCCHACHA20_INTEL
+    /* widest first, each narrower kernel takes what the previous one left */
+    if (nblocks >= 16 && CC_HAS_AVX512_AND_IN_KERNEL()) {
+        n = nblocks & ~(size_t)15;
+        ccchacha20_intel_avx512_xor(ctx->state, n, in, out);
+        CCCHACHA20_ADVANCE(n);
+    }
+    if (nblocks >= 8 && CC_HAS_AVX2()) {
+        n = nblocks & ~(size_t)7;
+        ccchacha20_intel_avx2_xor(ctx->state, n, in, out);
+        CCCHACHA20_ADVANCE(n);
+    }
+    if (nblocks >= 4 && CC_HAS_SupplementalSSE3()) {
+        n = nblocks & ~(size_t)3;
+        ccchacha20_intel_ssse3_xor(ctx->state, n, in, out);
+        CCCHACHA20_ADVANCE(n);
+    }
+#endif
+
+    /* the scalar block function picks up what the kernels leave */
+    for (; nblocks > 0; nblocks--) {
+        _ccchacha20_block(ctx);
+        for (n = 0; n < 16; n++) {
+            CC_WRITE_LE32(out + 4 * n, CC_READ_LE32(in + 4 * n) ^ buf[n]);
+        }
+        ctx->state[12]++;
+        in += CCCHACHA20_BLOCK_NBYTES;
+        out += CCCHACHA20_BLOCK_NBYTES;
+    }
+}
+
+int ccchacha20_update(ccchacha20_ctx *ctx, size_t nbytes, const void *in, void *out)
+{
+    const uint8_t *ip = in;
+    uint8_t *op = out;
+    size_t n, i;
 
     if (ctx == NULL || in == NULL || out == NULL) {
         return CCERR_PARAMETER;
     }
 
-    for (;;) {
-        if (nbytes == 0) { break; }
+    /* finish the keystream block a previous call started */
+    n = CC_MIN(nbytes, ctx->leftover);
+    for (i = 0; i < n; i++) {
+        op[i] = ip[i] ^ ctx->buffer[CCCHACHA20_BLOCK_NBYTES - ctx->leftover + i];
+    }
+    ctx->leftover -= n;
+    nbytes -= n;
+    ip += n;
+    op += n;
+
+    n = nbytes / CCCHACHA20_BLOCK_NBYTES;
+    ccchacha20_xor_blocks(ctx, n, ip, op);
+    nbytes -= n * CCCHACHA20_BLOCK_NBYTES;
+    ip += n * CCCHACHA20_BLOCK_NBYTES;
+    op += n * CCCHACHA20_BLOCK_NBYTES;
 
-        _ccchacha20_block(ctx);
+    /* keep the rest of a partial block for the next call */
+    if (nbytes > 0) {
+        uint32_t *buf = (uint32_t *)ctx->buffer;
 
-        if (nbytes >= 64) {
-            for (int x = 0; x < 16; x++) {
-                buf[x] ^= CC_H2LE32(data_chunk_ptr[x]);
-            }
-            CC_MEMCPY(out_chunk_buf, ctx->buffer, 64);
-        } else {
-            uint8_t tmp[CCCHACHA20_BLOCK_NBYTES];
-            CC_MEMCPY(tmp, data_chunk_ptr, nbytes);
-            for (int x = 0; x < 16; x++) {
-                buf[x] ^= CC_H2LE32(tmp[x]);
-            }
-            CC_MEMCPY(out_chunk_buf, ctx->buffer, nbytes);
-            break; /* i ASSUME this means we're done here. */
+        _ccchacha20_block(ctx);
+        for (i = 0; i < 16; i++) {
+            CC_WRITE_LE32(&buf[i], buf[i]);
         }
-
-        ctx->state[12]++; /* if the counter spills over 0xFFFFFFFF then I think whoever is using this is stupid. */
-        nbytes -= 64;
-        data_chunk_ptr += 16;
-        out_chunk_buf += 16;
+        for (i = 0; i < nbytes; i++) {
+            op[i] = ip[i] ^ ctx->buffer[i];
+        }
+        ctx->state[12]++;
+        ctx->leftover = CCCHACHA20_BLOCK_NBYTES - nbytes;
     }
 
     return CCERR_OK;
@@ -191,6 +250,8 @@ int ccchacha20(const void *key, const void *nonce, uint32_t counter, size_t nbyt
     }
     ccchacha20_ctx ctx;
 
+    /* ccchacha20_init() wants a cleared context */
+    cc_clear(sizeof(ctx), &ctx);
     ccchacha20_init(&ctx, key);
     ccchacha20_setnonce(&ctx, nonce);
     ccchacha20_setcounter(&ctx, counter);
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#ifndef _CORECRYPTO_CCCHACHA20_INTERNAL_H_
+#define _CORECRYPTO_CCCHACHA20_INTERNAL_H_
+
+#include <corecrypto/cc_config.h>
+#include <corecrypto/ccchacha20poly1305_priv.h>
+
+/* the wide kernels are only built where cc_runtime_config.h can probe for them */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && (CCSHA1_VNG_INTEL || CCSHA2_VNG_INTEL || CCAES_INTEL_ASM)
+#define CCCHACHA20_INTEL 1
+#else
+#define CCCHACHA20_INTEL 0
+#endif
+
+/* keystream block for the current counter into ctx->buffer, the counter is left alone */
+int _ccchacha20_block(ccchacha20_ctx *ctx);
+
+/*
+ * XOR nblocks (a multiple of the kernel width) of keystream from in to out.
+ * Block i uses counter state[12] + i; the caller advances state[12].
+ */
+#if CCCHACHA20_INTEL
+void ccchacha20_intel_ssse3_xor(const uint32_t *state, size_t nblocks, const uint8_t *in, uint8_t *out);
+void ccchacha20_intel_avx2_xor(const uint32_t *state, size_t nblocks, const uint8_t *in, uint8_t *out);
+void ccchacha20_intel_avx512_xor(const uint32_t *state, size_t nblocks, const uint8_t *in, uint8_t *out);
+
+/* one keystream block for each of up to 8 lanes, words 12..15 of lane j taken from words[j] */
+void ccchacha20_intel_avx2_lanes(const uint32_t *state, size_t nlanes, const uint32_t (*words)[4], uint8_t *out);
+
+/* absorb nblocks (a multiple of 4, at least 8) full blocks into the 26-bit limbs of acc, four per step; r[i] is r^(i + 1) */
+void ccpoly1305_intel_avx2_blocks(uint32_t acc[5], const uint32_t r[4][5], size_t nblocks, const uint8_t *in);
+#endif
+
+#endif /* _CORECRYPTO_CCCHACHA20_INTERNAL_H_ */
@@ -21,9 +21,13 @@
 #include <corecrypto/cc_macros.h>
 #include <corecrypto/ccchacha20poly1305.h>
 #include <corecrypto/ccchacha20poly1305_priv.h>
+#include "ccchacha20_internal.h"
 
-// decl from chacha20.c
-extern int _ccchacha20_block(ccchacha20_ctx *ctx);
+/*
+ * Text is ciphered and MACed a chunk at a time, so the ciphertext is still in
+ * L1 when Poly1305 reads it back. A multiple of the widest ChaCha20 kernel.
+ */
+#define CCCHACHA20POLY1305_CHUNK_NBYTES 2048
 
 static const uint8_t constant_zero_64[64] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -38,7 +42,10 @@ const struct ccchacha20poly1305_info *ccchacha20poly1305_info(void) { return &cc
 
 int ccchacha20poly1305_init(const struct ccchacha20poly1305_info *info, ccchacha20poly1305_ctx *ctx, const uint8_t *key)
 {
+    /* ccchacha20_init() wants a cleared context */
+    cc_clear(sizeof(*ctx), ctx);
     ccchacha20_init(&ctx->chacha20_ctx, key);
+    ctx->state = CCCHACHA20POLY1305_STATE_SETNONCE;
 
     return 0;
 }
@@ -50,6 +57,9 @@ int ccchacha20poly1305_reset(const struct ccchacha20poly1305_info *info, ccchach
     ctx->state = CCCHACHA20POLY1305_STATE_SETNONCE;
 
     ccchacha20_reset(&ctx->chacha20_ctx);
+    /* ccchacha20_setnonce() only takes a nonce over a cleared one */
+    cc_clear(3 * sizeof(uint32_t), &ctx->chacha20_ctx.state[13]);
+    cc_clear(sizeof(ctx->poly1305_ctx), &ctx->poly1305_ctx);
 
     return CCERR_OK;
 }
@@ -67,6 +77,9 @@ int ccchacha20poly1305_setnonce(const struct ccchacha20poly1305_info *info, ccch
     /* that is our poly1305 key */
     ccpoly1305_init(&ctx->poly1305_ctx, ctx->chacha20_ctx.buffer);
 
+    /* the text starts at block 1 */
+    ccchacha20_setcounter(&ctx->chacha20_ctx, 1);
+
     ctx->state = CCCHACHA20POLY1305_STATE_AAD;
 
     return 0;
@@ -82,10 +95,32 @@ int ccchacha20poly1305_aad(const struct ccchacha20poly1305_info *info, ccchacha2
     ccpoly1305_update(&ctx->poly1305_ctx, nbytes, aad);
     ctx->aad_nbytes += nbytes;
 
+    return 0;
+
 bail:
     return 1;
 }
 
+/* one pass over the text: cipher a chunk, MAC the ciphertext side of it while it is hot */
+static void ccchacha20poly1305_xor_mac(ccchacha20poly1305_ctx *ctx, size_t nbytes, const uint8_t *in, uint8_t *out, bool encrypt)
+{
+    size_t n;
+
+    while (nbytes) {
+        n = CC_MIN(nbytes, (size_t)CCCHACHA20POLY1305_CHUNK_NBYTES);
+        if (encrypt) {
+            ccchacha20_update(&ctx->chacha20_ctx, n, in, out);
+            ccpoly1305_update(&ctx->poly1305_ctx, n, out);
+        } else {
+            ccpoly1305_update(&ctx->poly1305_ctx, n, in);
+            ccchacha20_update(&ctx->chacha20_ctx, n, in, out);
+        }
+        in += n;
+        out += n;
+        nbytes -= n;
+    }
+}
+
 int ccchacha20poly1305_encrypt(const struct ccchacha20poly1305_info *info, ccchacha20poly1305_ctx *ctx, size_t nbytes, const void *ptext, void *ctext)
 {
     /*
@@ -107,8 +142,7 @@ int ccchacha20poly1305_encrypt(const struct ccchacha20poly1305_info *info, cccha
     /* Enforce this constraint. */
     cc_require(ctx->text_nbytes + nbytes <= CCCHACHA20POLY1305_TEXT_MAX_NBYTES, bail);
 
-    ccchacha20_update(&ctx->chacha20_ctx, nbytes, ptext, ctext);
-    ccpoly1305_update(&ctx->poly1305_ctx, nbytes, ctext);
+    ccchacha20poly1305_xor_mac(ctx, nbytes, ptext, ctext, true);
 
     ctx->text_nbytes += nbytes;
 
@@ -139,8 +173,7 @@ int ccchacha20poly1305_decrypt(const struct ccchacha20poly1305_info *info, cccha
     /* Enforce this constraint. */
     cc_require(ctx->text_nbytes + nbytes <= CCCHACHA20POLY1305_TEXT_MAX_NBYTES, bail);
 
-    ccpoly1305_update(&ctx->poly1305_ctx, nbytes, ctext);
-    ccchacha20_update(&ctx->chacha20_ctx, nbytes, ctext, ptext);
+    ccchacha20poly1305_xor_mac(ctx, nbytes, ctext, ptext, false);
 
     ctx->text_nbytes += nbytes;
 
@@ -166,7 +199,7 @@ int ccchacha20poly1305_finalize(const struct ccchacha20poly1305_info *info, ccch
         ctx->state = CCCHACHA20POLY1305_STATE_ENCRYPT;
     }
 
-    cc_require(ctx->state == CCCHACHA20POLY1305_STATE_ENCRYPT, bail);
+    cc_require(ctx->state == CCCHACHA20POLY1305_STATE_ENCRYPT || ctx->state == CCCHACHA20POLY1305_STATE_DECRYPT, bail);
 
     /* padding2 as per RFC 7539 */
     size_t padding = (16 - (ctx->text_nbytes & 0xf)) & 0xf;
@@ -206,27 +239,35 @@ int ccchacha20poly1305_verify(const struct ccchacha20poly1305_info *info, ccchac
 int ccchacha20poly1305_encrypt_oneshot(const struct ccchacha20poly1305_info *info, const uint8_t *key, const uint8_t *nonce, size_t aad_nbytes, const void *aad, size_t ptext_nbytes, const void *ptext, void *ctext, uint8_t *tag)
 {
     ccchacha20poly1305_ctx ctx;
+    int rv;
 
     ccchacha20poly1305_init(info, &ctx, key);
     ccchacha20poly1305_setnonce(info, &ctx, nonce);
     ccchacha20poly1305_aad(info, &ctx, aad_nbytes, aad);
-    ccchacha20poly1305_encrypt(info, &ctx, ptext_nbytes, ptext, ctext);
-    ccchacha20poly1305_finalize(info, &ctx, tag);
+    rv = ccchacha20poly1305_encrypt(info, &ctx, ptext_nbytes, ptext, ctext);
+    if (rv == 0) {
+        rv = ccchacha20poly1305_finalize(info, &ctx, tag);
+    }
 
-    return 0;
+    cc_clear(sizeof(ctx), &ctx);
+    return rv;
 }
 
 int ccchacha20poly1305_decrypt_oneshot(const struct ccchacha20poly1305_info *info, const uint8_t *key, const uint8_t *nonce, size_t aad_nbytes, const void *aad, size_t ctext_nbytes, const void *ctext, void *ptext, const uint8_t *tag)
 {
     ccchacha20poly1305_ctx ctx;
+    int rv;
 
     ccchacha20poly1305_init(info, &ctx, key);
     ccchacha20poly1305_setnonce(info, &ctx, nonce);
     ccchacha20poly1305_aad(info, &ctx, aad_nbytes, aad);
-    ccchacha20poly1305_decrypt(info, &ctx, ctext_nbytes, ctext, ptext);
+    rv = ccchacha20poly1305_decrypt(info, &ctx, ctext_nbytes, ctext, ptext);
+    if (rv == 0) {
+        rv = ccchacha20poly1305_verify(info, &ctx, tag);
+    }
 
-    return ccchacha20poly1305_verify(info, &ctx, tag);
-    ;
+    cc_clear(sizeof(ctx), &ctx);
+    return rv;
 }
 
 int ccchacha20poly1305_incnonce(const struct ccchacha20poly1305_info *info, ccchacha20poly1305_ctx *ctx, uint8_t *nonce)
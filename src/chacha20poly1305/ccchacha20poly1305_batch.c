@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_runtime_config.h>
+#include <corecrypto/ccchacha20poly1305.h>
+#include <corecrypto/ccchacha20poly1305_priv.h>
+#include "ccchacha20_internal.h"
+
+/*
+ * Packets are set up a group at a time. The wide kernels only pay off on
+ * runs of whole 4-block groups, so per packet the Poly1305 key block and
+ * what is left after those runs (at most 4 blocks) are generated for the
+ * whole group in one lane pass, one (counter, nonce) per lane.
+ */
+#define CCCHACHA20POLY1305_BATCH_NPACKETS 8
+#define CCCHACHA20POLY1305_BATCH_TAIL_NBLOCKS 4
+#define CCCHACHA20POLY1305_BATCH_NJOBS (CCCHACHA20POLY1305_BATCH_NPACKETS * (1 + CCCHACHA20POLY1305_BATCH_TAIL_NBLOCKS))
+
+/* one keystream block per (counter, nonce) in words, all under the key in key_ctx */
+static void ccchacha20poly1305_batch_keystream(const ccchacha20_ctx *key_ctx, size_t njobs, const uint32_t (*words)[4], uint8_t *out)
+{
+    ccchacha20_ctx ctx;
+    uint32_t *buf = (uint32_t *)ctx.buffer;
+    size_t i, k;
+
+#if CCCHACHA20_INTEL
+    if (CC_HAS_AVX2()) {
+        for (; njobs > 0; njobs -= k) {
+            k = CC_MIN(njobs, (size_t)8);
+            ccchacha20_intel_avx2_lanes(key_ctx->state, k, words, out);
+            words += k;
+            out += k * CCCHACHA20_BLOCK_NBYTES;
+        }
+        return;
+    }
+#endif
+
+    ctx = *key_ctx;
+    for (i = 0; i < njobs; i++) {
+        for (k = 0; k < 4; k++) {
+            ctx.state[12 + k] = words[i][k];
+        }
+        _ccchacha20_block(&ctx);
+        for (k = 0; k < 16; k++) {
+            CC_WRITE_LE32(out + 4 * k, buf[k]);
+        }
+        out += CCCHACHA20_BLOCK_NBYTES;
+    }
+    cc_clear(sizeof(ctx), &ctx);
+}
+
+/* bytes of text left to the wide kernels, the rest comes out of the lane pass */
+static size_t ccchacha20poly1305_batch_bulk_nbytes(size_t text_nbytes)
+{
+    size_t nblocks = text_nbytes / CCCHACHA20_BLOCK_NBYTES;
+
+    return (nblocks & ~(size_t)(CCCHACHA20POLY1305_BATCH_TAIL_NBLOCKS - 1)) * CCCHACHA20_BLOCK_NBYTES;
+}
+
+static int ccchacha20poly1305_batch(const struct ccchacha20poly1305_info *info, const uint8_t *key, size_t npackets,
+                                    const struct ccchacha20poly1305_packet *packets, int *results, bool encrypt)
+{
+    ccchacha20_ctx key_ctx;
+    ccchacha20poly1305_ctx ctx;
+    uint32_t words[CCCHACHA20POLY1305_BATCH_NJOBS][4];
+    uint8_t ks[CCCHACHA20POLY1305_BATCH_NJOBS * CCCHACHA20_BLOCK_NBYTES];
+    size_t first[CCCHACHA20POLY1305_BATCH_NPACKETS];
+    size_t i, j, k, n, njobs, bulk, tail;
+    const uint8_t *in;
+    uint8_t *out;
+    int rv = 0, prv;
+
+    /* the key schedule, once */
+    cc_clear(sizeof(key_ctx), &key_ctx);
+    ccchacha20_init(&key_ctx, key);
+
+    for (i = 0; i < npackets; i += n) {
+        n = CC_MIN(npackets - i, (size_t)CCCHACHA20POLY1305_BATCH_NPACKETS);
+
+        /* block 0 and the tail blocks of every packet in the group */
+        njobs = 0;
+        for (j = 0; j < n; j++) {
+            const struct ccchacha20poly1305_packet *p = &packets[i + j];
+            size_t ctr = 1 + ccchacha20poly1305_batch_bulk_nbytes(p->text_nbytes) / CCCHACHA20_BLOCK_NBYTES;
+            size_t nblocks = cc_ceiling(p->text_nbytes, CCCHACHA20_BLOCK_NBYTES);
+
+            first[j] = njobs;
+            for (k = 0; k < 1 + nblocks + 1 - ctr; k++, njobs++) {
+                words[njobs][0] = k == 0 ? 0 : (uint32_t)(ctr + k - 1);
+                words[njobs][1] = CC_READ_LE32(p->nonce);
+                words[njobs][2] = CC_READ_LE32(p->nonce + 4);
+                words[njobs][3] = CC_READ_LE32(p->nonce + 8);
+            }
+        }
+        ccchacha20poly1305_batch_keystream(&key_ctx, njobs, (const uint32_t(*)[4])words, ks);
+
+        for (j = 0; j < n; j++) {
+            const struct ccchacha20poly1305_packet *p = &packets[i + j];
+            const uint8_t *pks = ks + first[j] * CCCHACHA20_BLOCK_NBYTES;
+
+            if (p->text_nbytes > CCCHACHA20POLY1305_TEXT_MAX_NBYTES) {
+                prv = 1;
+                goto next;
+            }
+
+            /* what ccchacha20poly1305_setnonce() leaves behind, minus its block */
+            ctx.chacha20_ctx = key_ctx;
+            ctx.chacha20_ctx.state[13] = words[first[j]][1];
+            ctx.chacha20_ctx.state[14] = words[first[j]][2];
+            ctx.chacha20_ctx.state[15] = words[first[j]][3];
+            ccchacha20_setcounter(&ctx.chacha20_ctx, 1);
+            ccpoly1305_init(&ctx.poly1305_ctx, pks);
+            ctx.aad_nbytes = 0;
+            ctx.text_nbytes = 0;
+            ctx.state = CCCHACHA20POLY1305_STATE_AAD;
+
+            ccchacha20poly1305_aad(info, &ctx, p->aad_nbytes, p->aad);
+
+            bulk = ccchacha20poly1305_batch_bulk_nbytes(p->text_nbytes);
+            tail = p->text_nbytes - bulk;
+            in = (const uint8_t *)p->in + bulk;
+            out = (uint8_t *)p->out + bulk;
+            pks += CCCHACHA20_BLOCK_NBYTES;
+
+            if (encrypt) {
+                prv = ccchacha20poly1305_encrypt(info, &ctx, bulk, p->in, p->out);
+                for (k = 0; k < tail; k++) {
+                    out[k] = in[k] ^ pks[k];
+                }
+                ccpoly1305_update(&ctx.poly1305_ctx, tail, out);
+                ctx.text_nbytes += tail;
+                if (prv == 0) {
+                    prv = ccchacha20poly1305_finalize(info, &ctx, p->tag);
+                }
+            } else {
+                prv = ccchacha20poly1305_decrypt(info, &ctx, bulk, p->in, p->out);
+                ccpoly1305_update(&ctx.poly1305_ctx, tail, in);
+                for (k = 0; k < tail; k++) {
+                    out[k] = in[k] ^ pks[k];
+                }
+                ctx.text_nbytes += tail;
+                if (prv == 0) {
+                    prv = ccchacha20poly1305_verify(info, &ctx, p->tag);
+                }
+            }
+
+        next:
+            if (results) {
+                results[i + j] = prv;
+            }
+            if (rv == 0) {
+                rv = prv;
+            }
+        }
+    }
+
+    cc_clear(sizeof(ks), ks);
+    cc_clear(sizeof(ctx), &ctx);
+    cc_clear(sizeof(key_ctx), &key_ctx);
+
+    return rv;
+}
+
+int ccchacha20poly1305_encrypt_batch(const struct ccchacha20poly1305_info *info, const uint8_t *key, size_t npackets, const struct ccchacha20poly1305_packet *packets)
+{
+    return ccchacha20poly1305_batch(info, key, npackets, packets, NULL, true);
+}
+
+int ccchacha20poly1305_decrypt_batch(const struct ccchacha20poly1305_info *info, const uint8_t *key, size_t npackets, const struct ccchacha20poly1305_packet *packets, int *results)
+{
+    return ccchacha20poly1305_batch(info, key, npackets, packets, results, false);
+}
@@ -16,20 +16,81 @@
  * @LICENSE_HEADER_END@
  */
 
+#include "ccchacha20_internal.h"
 #include <corecrypto/cc_priv.h>
-#include <corecrypto/ccchacha20poly1305.h>
-#include <corecrypto/ccchacha20poly1305_priv.h>
+#include <corecrypto/cc_runtime_config.h>
+#include <corecrypto/ccn.h>
 
 /* based on https://github.com/floodyberry/poly1305-donna */
 
+/*
+ * r and the accumulator stay in ctx in the radix the scalar blocks run in:
+ * five 26-bit limbs, or three 44-bit limbs (ctx->l44) where the compiler has a
+ * 128-bit type, so an update converts nothing. Only the AVX2 path, which works
+ * in 26-bit lanes, converts on entry and exit; it runs on 8 or more blocks at a
+ * time, which pays for that and for the powers of r it builds on the stack.
+ */
+#if CCN_UNIT_SIZE == 8 && CCN_UINT128_SUPPORT_FOR_64BIT_ARCH
+#define CCPOLY1305_64 1
+#else
+#define CCPOLY1305_64 0
+#endif
+
+#if CCCHACHA20_INTEL
+/* out = a * b mod 2^130 - 5, partially reduced; used to build the powers of r */
+static void ccpoly1305_mul26(const uint32_t *a, const uint32_t *b, uint32_t *out)
+{
+    uint64_t d0, d1, d2, d3, d4;
+    uint32_t s1 = b[1] * 5, s2 = b[2] * 5, s3 = b[3] * 5, s4 = b[4] * 5, c;
+
+    d0 = ((uint64_t)a[0] * b[0]) + ((uint64_t)a[1] * s4) + ((uint64_t)a[2] * s3) + ((uint64_t)a[3] * s2) + ((uint64_t)a[4] * s1);
+    d1 = ((uint64_t)a[0] * b[1]) + ((uint64_t)a[1] * b[0]) + ((uint64_t)a[2] * s4) + ((uint64_t)a[3] * s3) + ((uint64_t)a[4] * s2);
+    d2 = ((uint64_t)a[0] * b[2]) + ((uint64_t)a[1] * b[1]) + ((uint64_t)a[2] * b[0]) + ((uint64_t)a[3] * s4) + ((uint64_t)a[4] * s3);
+    d3 = ((uint64_t)a[0] * b[3]) + ((uint64_t)a[1] * b[2]) + ((uint64_t)a[2] * b[1]) + ((uint64_t)a[3] * b[0]) + ((uint64_t)a[4] * s4);
+    d4 = ((uint64_t)a[0] * b[4]) + ((uint64_t)a[1] * b[3]) + ((uint64_t)a[2] * b[2]) + ((uint64_t)a[3] * b[1]) + ((uint64_t)a[4] * b[0]);
+
+    c = (uint32_t)(d0 >> 26);
+    out[0] = (uint32_t)d0 & 0x3ffffff;
+    d1 += c;
+    c = (uint32_t)(d1 >> 26);
+    out[1] = (uint32_t)d1 & 0x3ffffff;
+    d2 += c;
+    c = (uint32_t)(d2 >> 26);
+    out[2] = (uint32_t)d2 & 0x3ffffff;
+    d3 += c;
+    c = (uint32_t)(d3 >> 26);
+    out[3] = (uint32_t)d3 & 0x3ffffff;
+    d4 += c;
+    c = (uint32_t)(d4 >> 26);
+    out[4] = (uint32_t)d4 & 0x3ffffff;
+    out[0] += c * 5;
+    c = out[0] >> 26;
+    out[0] &= 0x3ffffff;
+    out[1] += c;
+}
+#endif
+
 int ccpoly1305_init(ccpoly1305_ctx *ctx, const uint8_t *key)
 {
+#if CCPOLY1305_64
+    uint64_t t0, t1;
+
+    CC_LOAD64_LE(t0, key);
+    CC_LOAD64_LE(t1, key + 8);
+
+    /* r &= 0xffffffc0ffffffc0ffffffc0fffffff, split into 44, 44 and 42 bits */
+    ctx->l44.r[0] = t0 & 0xffc0fffffff;
+    ctx->l44.r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffff;
+    ctx->l44.r[2] = (t1 >> 24) & 0x00ffffffc0f;
+
+    ctx->l44.h[0] = ctx->l44.h[1] = ctx->l44.h[2] = 0;
+#else
     uint32_t k[5];
 
     CC_LOAD32_LE(k[0], key);
-    CC_LOAD32_LE(k[1], key + 4);
-    CC_LOAD32_LE(k[2], key + 7);
-    CC_LOAD32_LE(k[3], key + 10);
+    CC_LOAD32_LE(k[1], key + 3);
+    CC_LOAD32_LE(k[2], key + 6);
+    CC_LOAD32_LE(k[3], key + 9);
     CC_LOAD32_LE(k[4], key + 12);
 
     k[1] >>= 2;
@@ -56,12 +117,17 @@ int ccpoly1305_init(ccpoly1305_ctx *ctx, const uint8_t *key)
     ctx->s3 = ctx->r3 * 5;
     ctx->s4 = ctx->r4 * 5;
 
+    ctx->h0 = ctx->h1 = ctx->h2 = ctx->h3 = ctx->h4 = 0;
+#endif
+
     cc_memcpy(ctx->key, key + 16, 16);
+    ctx->buf_used = 0;
 
     return CCERR_OK;
 }
 
-static void _ccpoly1305_update(ccpoly1305_ctx *ctx, size_t nbytes, const void *in, bool final)
+#if !CCPOLY1305_64
+static void ccpoly1305_blocks(ccpoly1305_ctx *ctx, size_t nbytes, const uint8_t *in, bool final)
 {
     uint32_t h0, h1, h2, h3, h4, r0, r1, r2, r3, r4, s1, s2, s3, s4, c;
     uint64_t d0, d1, d2, d3, d4;
@@ -127,58 +193,245 @@ static void _ccpoly1305_update(ccpoly1305_ctx *ctx, size_t nbytes, const void *i
     ctx->h3 = h3;
     ctx->h4 = h4;
 }
+#endif
+
+#if CCPOLY1305_64
+static void ccpoly1305_blocks(ccpoly1305_ctx *ctx, size_t nbytes, const uint8_t *in, bool final)
+{
+    const uint64_t m44 = 0xfffffffffff, m42 = 0x3ffffffffff;
+    const uint64_t hibit = final ? 0 : ((uint64_t)1 << 40);
+    const uint64_t r0 = ctx->l44.r[0], r1 = ctx->l44.r[1], r2 = ctx->l44.r[2];
+    const uint64_t s1 = r1 * (5 << 2), s2 = r2 * (5 << 2);
+    uint64_t h0 = ctx->l44.h[0], h1 = ctx->l44.h[1], h2 = ctx->l44.h[2], t0, t1, c;
+    cc_dunit d0, d1, d2;
+
+    while (nbytes >= 16) {
+        CC_LOAD64_LE(t0, in);
+        CC_LOAD64_LE(t1, in + 8);
+
+        h0 += t0 & m44;
+        h1 += ((t0 >> 44) | (t1 << 20)) & m44;
+        h2 += ((t1 >> 24) & m42) | hibit;
+
+        /* h *= r */
+        d0 = (cc_dunit)h0 * r0 + (cc_dunit)h1 * s2 + (cc_dunit)h2 * s1;
+        d1 = (cc_dunit)h0 * r1 + (cc_dunit)h1 * r0 + (cc_dunit)h2 * s2;
+        d2 = (cc_dunit)h0 * r2 + (cc_dunit)h1 * r1 + (cc_dunit)h2 * r0;
+
+        /* (partial) h %= p */
+        c = (uint64_t)(d0 >> 44);
+        h0 = (uint64_t)d0 & m44;
+        d1 += c;
+        c = (uint64_t)(d1 >> 44);
+        h1 = (uint64_t)d1 & m44;
+        d2 += c;
+        c = (uint64_t)(d2 >> 42);
+        h2 = (uint64_t)d2 & m42;
+        h0 += c * 5;
+        c = h0 >> 44;
+        h0 &= m44;
+        h1 += c;
+
+        in += 16;
+        nbytes -= 16;
+    }
+
+    ctx->l44.h[0] = h0;
+    ctx->l44.h[1] = h1;
+    ctx->l44.h[2] = h2;
+}
+#endif
+
+#if CCCHACHA20_INTEL
+/* r, its powers and h in 26-bit limbs for the AVX2 blocks, and h back again */
+static void ccpoly1305_avx2_update(ccpoly1305_ctx *ctx, size_t nblocks, const uint8_t *in)
+{
+    uint32_t r[4][5], h[5];
+
+#if CCPOLY1305_64
+    const uint64_t m44 = 0xfffffffffff;
+    const uint64_t *l = ctx->l44.r;
+    uint64_t h0 = ctx->l44.h[0], h1 = ctx->l44.h[1], h2 = ctx->l44.h[2], c;
+
+    r[0][0] = (uint32_t)l[0] & 0x3ffffff;
+    r[0][1] = (uint32_t)((l[0] >> 26) | (l[1] << 18)) & 0x3ffffff;
+    r[0][2] = (uint32_t)(l[1] >> 8) & 0x3ffffff;
+    r[0][3] = (uint32_t)((l[1] >> 34) | (l[2] << 10)) & 0x3ffffff;
+    r[0][4] = (uint32_t)(l[2] >> 16);
+
+    c = h1 >> 44;
+    h1 &= m44;
+    h2 += c;
+    h[0] = (uint32_t)h0 & 0x3ffffff;
+    h[1] = (uint32_t)((h0 >> 26) | (h1 << 18)) & 0x3ffffff;
+    h[2] = (uint32_t)(h1 >> 8) & 0x3ffffff;
+    h[3] = (uint32_t)((h1 >> 34) | (h2 << 10)) & 0x3ffffff;
+    h[4] = (uint32_t)(h2 >> 16);
+#else
+    r[0][0] = ctx->r0;
+    r[0][1] = ctx->r1;
+    r[0][2] = ctx->r2;
+    r[0][3] = ctx->r3;
+    r[0][4] = ctx->r4;
+
+    h[0] = ctx->h0;
+    h[1] = ctx->h1;
+    h[2] = ctx->h2;
+    h[3] = ctx->h3;
+    h[4] = ctx->h4;
+#endif
+
+    ccpoly1305_mul26(r[0], r[0], r[1]);
+    ccpoly1305_mul26(r[1], r[0], r[2]);
+    ccpoly1305_mul26(r[2], r[0], r[3]);
+
+    ccpoly1305_intel_avx2_blocks(h, (const uint32_t (*)[5])r, nblocks, in);
+
+#if CCPOLY1305_64
+    h0 = (uint64_t)h[0] + ((uint64_t)h[1] << 26);
+    ctx->l44.h[0] = h0 & m44;
+    h1 = (h0 >> 44) + ((uint64_t)h[2] << 8) + ((uint64_t)h[3] << 34);
+    ctx->l44.h[1] = h1 & m44;
+    ctx->l44.h[2] = (h1 >> 44) + ((uint64_t)h[4] << 16);
+#else
+    ctx->h0 = h[0];
+    ctx->h1 = h[1];
+    ctx->h2 = h[2];
+    ctx->h3 = h[3];
+    ctx->h4 = h[4];
+#endif
+
+    cc_clear(sizeof(r), r);
+}
+#endif
+
+static void _ccpoly1305_update(ccpoly1305_ctx *ctx, size_t nbytes, const uint8_t *in, bool final)
+{
+#if CCCHACHA20_INTEL
+    /* worth it from a few 4-block steps on; the lane combine at the end costs about one */
+    if (nbytes >= 8 * 16 && CC_HAS_AVX2()) {
+        size_t n = nbytes & ~(size_t)63;
+        ccpoly1305_avx2_update(ctx, n / 16, in);
+        in += n;
+        nbytes -= n;
+    }
+#endif
+    ccpoly1305_blocks(ctx, nbytes, in, final);
+}
 
 int ccpoly1305_update(ccpoly1305_ctx *ctx, size_t nbytes, const void *in)
 {
     const uint8_t *p = in;
+    size_t n;
 
     if (ctx->buf_used) {
-        /* copy the newest bytes into the buffer & run update */
-        size_t bytes = 16 - ctx->buf_used;
-
-        for (size_t i = bytes; i < 16; i++) {
-            ctx->buf[i] = p[i];
+        /* top up the buffered partial block first */
+        n = CC_MIN(nbytes, 16 - ctx->buf_used);
+        cc_memcpy(ctx->buf + ctx->buf_used, p, n);
+        ctx->buf_used += n;
+        nbytes -= n;
+        p += n;
+
+        if (ctx->buf_used < 16) {
+            return CCERR_OK;
         }
-
         _ccpoly1305_update(ctx, 16, ctx->buf, false);
-
-        nbytes -= bytes;
-        p += bytes;
+        ctx->buf_used = 0;
     }
 
     if (nbytes >= 16) {
-        size_t bytes = cc_ceiling(nbytes, 16) * 16;
-        _ccpoly1305_update(ctx, bytes, in, false);
-        nbytes -= bytes;
-        p += bytes;
+        n = nbytes & ~(size_t)15;
+        _ccpoly1305_update(ctx, n, p, false);
+        nbytes -= n;
+        p += n;
     }
 
     /* copy it into the buffer */
     if (nbytes) {
-        for (size_t i = 0; i < nbytes; i++) {
-            ctx->buf[i] = p[i];
-        }
-
+        cc_memcpy(ctx->buf, p, nbytes);
         ctx->buf_used = nbytes;
     }
 
     return CCERR_OK;
 };
 
-int ccpoly1305_final(ccpoly1305_ctx *ctx, void *tag)
+#if CCPOLY1305_64
+static void ccpoly1305_tag(ccpoly1305_ctx *ctx, uint8_t *tag)
 {
-    uint32_t h0, h1, h2, h3, h4, g0, g1, g2, g3, g4, c, mask;
-    uint64_t f;
+    const uint64_t m44 = 0xfffffffffff, m42 = 0x3ffffffffff;
+    uint64_t h0, h1, h2, g0, g1, g2, t0, t1, c, mask;
 
-    if (ctx->buf_used) {
-        size_t i = ctx->buf_used;
-        ctx->buf[i++] = 1;
-        for (; i < 16; i++) {
-            ctx->buf[i] = 0;
-        }
+    h0 = ctx->l44.h[0];
+    h1 = ctx->l44.h[1];
+    h2 = ctx->l44.h[2];
 
-        _ccpoly1305_update(ctx, 16, ctx->buf, true);
-    }
+    /* fully carry h */
+    c = h1 >> 44;
+    h1 &= m44;
+    h2 += c;
+    c = h2 >> 42;
+    h2 &= m42;
+    h0 += c * 5;
+    c = h0 >> 44;
+    h0 &= m44;
+    h1 += c;
+    c = h1 >> 44;
+    h1 &= m44;
+    h2 += c;
+    c = h2 >> 42;
+    h2 &= m42;
+    h0 += c * 5;
+    c = h0 >> 44;
+    h0 &= m44;
+    h1 += c;
+
+    /* compute h + -p */
+    g0 = h0 + 5;
+    c = g0 >> 44;
+    g0 &= m44;
+    g1 = h1 + c;
+    c = g1 >> 44;
+    g1 &= m44;
+    g2 = h2 + c - ((uint64_t)1 << 42);
+
+    /* select h if h < p, or h + -p if h >= p */
+    mask = (g2 >> 63) - 1;
+    g0 &= mask;
+    g1 &= mask;
+    g2 &= mask;
+    mask = ~mask;
+    h0 = (h0 & mask) | g0;
+    h1 = (h1 & mask) | g1;
+    h2 = (h2 & mask) | g2;
+
+    /* mac = (h + pad) % (2^128) */
+    CC_LOAD64_LE(t0, ctx->key);
+    CC_LOAD64_LE(t1, ctx->key + 8);
+
+    h0 += t0 & m44;
+    c = h0 >> 44;
+    h0 &= m44;
+    h1 += (((t0 >> 44) | (t1 << 20)) & m44) + c;
+    c = h1 >> 44;
+    h1 &= m44;
+    h2 += (t1 >> 24) + c;
+    h2 &= m42;
+
+    h0 = h0 | (h1 << 44);
+    h1 = (h1 >> 20) | (h2 << 24);
+
+    CC_STORE64_LE(h0, tag);
+    CC_STORE64_LE(h1, tag + 8);
+
+    ctx->l44.h[0] = 0;
+    ctx->l44.h[1] = 0;
+    ctx->l44.h[2] = 0;
+}
+#else
+static void ccpoly1305_tag(ccpoly1305_ctx *ctx, uint8_t *tag)
+{
+    uint32_t h0, h1, h2, h3, h4, g0, g1, g2, g3, g4, c, mask;
+    uint64_t f;
 
     h0 = ctx->h0;
     h1 = ctx->h1;
@@ -238,13 +491,13 @@ int ccpoly1305_final(ccpoly1305_ctx *ctx, void *tag)
     h3 = ((h3 >> 18) | (h4 << 8)) & 0xffffffff;
 
     /* mac = (h + pad) % (2^128) */
-    f = (uint64_t)h0 + ctx->key[0];
+    f = (uint64_t)h0 + CC_READ_LE32(ctx->key);
     h0 = (uint32_t)f;
-    f = (uint64_t)h1 + ctx->key[1] + (f >> 32);
+    f = (uint64_t)h1 + CC_READ_LE32(ctx->key + 4) + (f >> 32);
     h1 = (uint32_t)f;
-    f = (uint64_t)h2 + ctx->key[2] + (f >> 32);
+    f = (uint64_t)h2 + CC_READ_LE32(ctx->key + 8) + (f >> 32);
     h2 = (uint32_t)f;
-    f = (uint64_t)h3 + ctx->key[3] + (f >> 32);
+    f = (uint64_t)h3 + CC_READ_LE32(ctx->key + 12) + (f >> 32);
     h3 = (uint32_t)f;
 
     CC_WRITE_LE32(tag, h0);
@@ -257,6 +510,23 @@ int ccpoly1305_final(ccpoly1305_ctx *ctx, void *tag)
     ctx->h2 = 0;
     ctx->h3 = 0;
     ctx->h4 = 0;
+}
+#endif
+
+int ccpoly1305_final(ccpoly1305_ctx *ctx, void *tag)
+{
+    if (ctx->buf_used) {
+        size_t i = ctx->buf_used;
+        ctx->buf[i++] = 1;
+        for (; i < 16; i++) {
+            ctx->buf[i] = 0;
+        }
+
+        _ccpoly1305_update(ctx, 16, ctx->buf, true);
+        ctx->buf_used = 0;
+    }
+
+    ccpoly1305_tag(ctx, tag);
 
     return CCERR_OK;
 }
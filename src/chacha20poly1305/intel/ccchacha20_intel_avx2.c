@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "../ccchacha20_internal.h"
+#include <corecrypto/cc_priv.h>
+
+#if CCCHACHA20_INTEL
+
+#include <immintrin.h>
+
+/* eight blocks at a time, word i of block j in lane j of x[i] */
+
+#define ROTL16(v) _mm256_shuffle_epi8(v, rot16)
+#define ROTL8(v)  _mm256_shuffle_epi8(v, rot8)
+#define ROTL(v, n) _mm256_or_si256(_mm256_slli_epi32(v, n), _mm256_srli_epi32(v, 32 - (n)))
+
+#define QR(a, b, c, d)                                               \
+    a = _mm256_add_epi32(a, b); d = ROTL16(_mm256_xor_si256(d, a));    \
+    c = _mm256_add_epi32(c, d); b = ROTL(_mm256_xor_si256(b, c), 12);  \
+    a = _mm256_add_epi32(a, b); d = ROTL8(_mm256_xor_si256(d, a));     \
+    c = _mm256_add_epi32(c, d); b = ROTL(_mm256_xor_si256(b, c), 7);
+
+/* per 128-bit half: afterwards x0..x3 hold words w..w+3 of blocks 0..3 (low) and 4..7 (high) */
+#define TRANSPOSE(x0, x1, x2, x3)                 \
+    t0 = _mm256_unpacklo_epi32(x0, x1);           \
+    t1 = _mm256_unpacklo_epi32(x2, x3);           \
+    t2 = _mm256_unpackhi_epi32(x0, x1);           \
+    t3 = _mm256_unpackhi_epi32(x2, x3);           \
+    x0 = _mm256_unpacklo_epi64(t0, t1);           \
+    x1 = _mm256_unpackhi_epi64(t0, t1);           \
+    x2 = _mm256_unpacklo_epi64(t2, t3);           \
+    x3 = _mm256_unpackhi_epi64(t2, t3);
+
+#define XOR_STORE(v, off)                                                                    \
+    _mm256_storeu_si256((__m256i *)(out + (off)),                                            \
+                        _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i *)(in + (off)))));
+
+__attribute__((target("avx2")))
+void ccchacha20_intel_avx2_xor(const uint32_t *state, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    const __m256i rot16 = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                          13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    const __m256i rot8 = _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+                                         14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+    __m256i s[16], x[16], t0, t1, t2, t3;
+    uint32_t ctr = state[12];
+    int i, r, b;
+
+    for (i = 0; i < 16; i++) {
+        s[i] = _mm256_set1_epi32((int)state[i]);
+    }
+
+    for (; nblocks >= 8; nblocks -= 8) {
+        s[12] = _mm256_add_epi32(_mm256_set1_epi32((int)ctr), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        for (i = 0; i < 16; i++) {
+            x[i] = s[i];
+        }
+
+        for (r = 0; r < 10; r++) {
+            QR(x[0], x[4], x[8], x[12]);
+            QR(x[1], x[5], x[9], x[13]);
+            QR(x[2], x[6], x[10], x[14]);
+            QR(x[3], x[7], x[11], x[15]);
+            QR(x[0], x[5], x[10], x[15]);
+            QR(x[1], x[6], x[11], x[12]);
+            QR(x[2], x[7], x[8], x[13]);
+            QR(x[3], x[4], x[9], x[14]);
+        }
+
+        for (i = 0; i < 16; i++) {
+            x[i] = _mm256_add_epi32(x[i], s[i]);
+        }
+
+        for (i = 0; i < 16; i += 4) {
+            TRANSPOSE(x[i], x[i + 1], x[i + 2], x[i + 3]);
+        }
+
+        /* pair word groups (0,1) and (2,3) into whole 32-byte halves of a block */
+        for (b = 0; b < 4; b++) {
+            XOR_STORE(_mm256_permute2x128_si256(x[b], x[b + 4], 0x20), 64 * b);
+            XOR_STORE(_mm256_permute2x128_si256(x[b + 8], x[b + 12], 0x20), 64 * b + 32);
+            XOR_STORE(_mm256_permute2x128_si256(x[b], x[b + 4], 0x31), 64 * b + 256);
+            XOR_STORE(_mm256_permute2x128_si256(x[b + 8], x[b + 12], 0x31), 64 * b + 288);
+        }
+
+        ctr += 8;
+        in += 512;
+        out += 512;
+    }
+}
+
+__attribute__((target("avx2")))
+void ccchacha20_intel_avx2_lanes(const uint32_t *state, size_t nlanes, const uint32_t (*words)[4], uint8_t *out)
+{
+    const __m256i rot16 = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                          13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    const __m256i rot8 = _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+                                         14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+    __m256i s[16], x[16], t0, t1, t2, t3;
+    uint32_t w[4][8] = { { 0 } };
+    uint8_t ks[8 * 64];
+    size_t j;
+    int i, r, b;
+
+    /* words 12..15 differ per lane, unused lanes just run on zeros */
+    for (j = 0; j < nlanes; j++) {
+        for (i = 0; i < 4; i++) {
+            w[i][j] = words[j][i];
+        }
+    }
+
+    for (i = 0; i < 12; i++) {
+        s[i] = _mm256_set1_epi32((int)state[i]);
+    }
+    for (i = 0; i < 4; i++) {
+        s[12 + i] = _mm256_loadu_si256((const __m256i *)w[i]);
+    }
+    for (i = 0; i < 16; i++) {
+        x[i] = s[i];
+    }
+
+    for (r = 0; r < 10; r++) {
+        QR(x[0], x[4], x[8], x[12]);
+        QR(x[1], x[5], x[9], x[13]);
+        QR(x[2], x[6], x[10], x[14]);
+        QR(x[3], x[7], x[11], x[15]);
+        QR(x[0], x[5], x[10], x[15]);
+        QR(x[1], x[6], x[11], x[12]);
+        QR(x[2], x[7], x[8], x[13]);
+        QR(x[3], x[4], x[9], x[14]);
+    }
+
+    for (i = 0; i < 16; i++) {
+        x[i] = _mm256_add_epi32(x[i], s[i]);
+    }
+
+    for (i = 0; i < 16; i += 4) {
+        TRANSPOSE(x[i], x[i + 1], x[i + 2], x[i + 3]);
+    }
+
+    for (b = 0; b < 4; b++) {
+        _mm256_storeu_si256((__m256i *)(ks + 64 * b), _mm256_permute2x128_si256(x[b], x[b + 4], 0x20));
+        _mm256_storeu_si256((__m256i *)(ks + 64 * b + 32), _mm256_permute2x128_si256(x[b + 8], x[b + 12], 0x20));
+        _mm256_storeu_si256((__m256i *)(ks + 64 * b + 256), _mm256_permute2x128_si256(x[b], x[b + 4], 0x31));
+        _mm256_storeu_si256((__m256i *)(ks + 64 * b + 288), _mm256_permute2x128_si256(x[b + 8], x[b + 12], 0x31));
+    }
+    _mm256_zeroupper();
+
+    cc_memcpy(out, ks, nlanes * 64);
+    cc_clear(sizeof(ks), ks);
+    cc_clear(sizeof(w), w);
+}
+
+#endif /* CCCHACHA20_INTEL */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "../ccchacha20_internal.h"
+
+#if CCCHACHA20_INTEL
+
+#include <immintrin.h>
+
+/* sixteen blocks at a time, word i of block j in lane j of x[i] */
+
+#define QR(a, b, c, d)                                                            \
+    a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 16);   \
+    c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 12);   \
+    a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 8);    \
+    c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 7);
+
+/* per 128-bit quarter: afterwards x0..x3 hold words w..w+3 of blocks 0..3, 4..7, 8..11 and 12..15 */
+#define TRANSPOSE(x0, x1, x2, x3)                 \
+    t0 = _mm512_unpacklo_epi32(x0, x1);           \
+    t1 = _mm512_unpacklo_epi32(x2, x3);           \
+    t2 = _mm512_unpackhi_epi32(x0, x1);           \
+    t3 = _mm512_unpackhi_epi32(x2, x3);           \
+    x0 = _mm512_unpacklo_epi64(t0, t1);           \
+    x1 = _mm512_unpackhi_epi64(t0, t1);           \
+    x2 = _mm512_unpacklo_epi64(t2, t3);           \
+    x3 = _mm512_unpackhi_epi64(t2, t3);
+
+#define XOR_STORE(v, off)                                                                    \
+    _mm512_storeu_si512((__m512i *)(out + (off)),                                            \
+                        _mm512_xor_si512(v, _mm512_loadu_si512((const __m512i *)(in + (off)))));
+
+__attribute__((target("avx512f")))
+void ccchacha20_intel_avx512_xor(const uint32_t *state, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    __m512i s[16], x[16], t0, t1, t2, t3, u0, u1, u2, u3;
+    uint32_t ctr = state[12];
+    int i, r, b;
+
+    for (i = 0; i < 16; i++) {
+        s[i] = _mm512_set1_epi32((int)state[i]);
+    }
+
+    for (; nblocks >= 16; nblocks -= 16) {
+        s[12] = _mm512_add_epi32(_mm512_set1_epi32((int)ctr),
+                                 _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+        for (i = 0; i < 16; i++) {
+            x[i] = s[i];
+        }
+
+        for (r = 0; r < 10; r++) {
+            QR(x[0], x[4], x[8], x[12]);
+            QR(x[1], x[5], x[9], x[13]);
+            QR(x[2], x[6], x[10], x[14]);
+            QR(x[3], x[7], x[11], x[15]);
+            QR(x[0], x[5], x[10], x[15]);
+            QR(x[1], x[6], x[11], x[12]);
+            QR(x[2], x[7], x[8], x[13]);
+            QR(x[3], x[4], x[9], x[14]);
+        }
+
+        for (i = 0; i < 16; i++) {
+            x[i] = _mm512_add_epi32(x[i], s[i]);
+        }
+
+        for (i = 0; i < 16; i += 4) {
+            TRANSPOSE(x[i], x[i + 1], x[i + 2], x[i + 3]);
+        }
+
+        /* gather quarter q of the four word groups into block 4q + b */
+        for (b = 0; b < 4; b++) {
+            u0 = _mm512_shuffle_i32x4(x[b], x[b + 4], 0x44);
+            u1 = _mm512_shuffle_i32x4(x[b + 8], x[b + 12], 0x44);
+            u2 = _mm512_shuffle_i32x4(x[b], x[b + 4], 0xee);
+            u3 = _mm512_shuffle_i32x4(x[b + 8], x[b + 12], 0xee);
+            XOR_STORE(_mm512_shuffle_i32x4(u0, u1, 0x88), 64 * b);
+            XOR_STORE(_mm512_shuffle_i32x4(u0, u1, 0xdd), 64 * b + 256);
+            XOR_STORE(_mm512_shuffle_i32x4(u2, u3, 0x88), 64 * b + 512);
+            XOR_STORE(_mm512_shuffle_i32x4(u2, u3, 0xdd), 64 * b + 768);
+        }
+
+        ctr += 16;
+        in += 1024;
+        out += 1024;
+    }
+}
+
+#endif /* CCCHACHA20_INTEL */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "../ccchacha20_internal.h"
+
+#if CCCHACHA20_INTEL
+
+#include <immintrin.h>
+
+/* four blocks at a time, word i of block j in lane j of x[i] */
+
+#define ROTL16(v) _mm_shuffle_epi8(v, rot16)
+#define ROTL8(v)  _mm_shuffle_epi8(v, rot8)
+#define ROTL(v, n) _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - (n)))
+
+#define QR(a, b, c, d)                                      \
+    a = _mm_add_epi32(a, b); d = ROTL16(_mm_xor_si128(d, a)); \
+    c = _mm_add_epi32(c, d); b = ROTL(_mm_xor_si128(b, c), 12); \
+    a = _mm_add_epi32(a, b); d = ROTL8(_mm_xor_si128(d, a));  \
+    c = _mm_add_epi32(c, d); b = ROTL(_mm_xor_si128(b, c), 7);
+
+/* words w..w+3 of the four blocks, transposed so each vector is 16 bytes of one block */
+#define TRANSPOSE(x0, x1, x2, x3)                 \
+    t0 = _mm_unpacklo_epi32(x0, x1);              \
+    t1 = _mm_unpacklo_epi32(x2, x3);              \
+    t2 = _mm_unpackhi_epi32(x0, x1);              \
+    t3 = _mm_unpackhi_epi32(x2, x3);              \
+    x0 = _mm_unpacklo_epi64(t0, t1);              \
+    x1 = _mm_unpackhi_epi64(t0, t1);              \
+    x2 = _mm_unpacklo_epi64(t2, t3);              \
+    x3 = _mm_unpackhi_epi64(t2, t3);
+
+#define XOR_STORE(v, off)                                                              \
+    _mm_storeu_si128((__m128i *)(out + (off)),                                         \
+                     _mm_xor_si128(v, _mm_loadu_si128((const __m128i *)(in + (off)))));
+
+__attribute__((target("ssse3")))
+void ccchacha20_intel_ssse3_xor(const uint32_t *state, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    const __m128i rot16 = _mm_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+    const __m128i rot8 = _mm_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+    __m128i s[16], x[16], t0, t1, t2, t3;
+    uint32_t ctr = state[12];
+    int i, r;
+
+    for (i = 0; i < 16; i++) {
+        s[i] = _mm_set1_epi32((int)state[i]);
+    }
+
+    for (; nblocks >= 4; nblocks -= 4) {
+        s[12] = _mm_add_epi32(_mm_set1_epi32((int)ctr), _mm_set_epi32(3, 2, 1, 0));
+        for (i = 0; i < 16; i++) {
+            x[i] = s[i];
+        }
+
+        for (r = 0; r < 10; r++) {
+            QR(x[0], x[4], x[8], x[12]);
+            QR(x[1], x[5], x[9], x[13]);
+            QR(x[2], x[6], x[10], x[14]);
+            QR(x[3], x[7], x[11], x[15]);
+            QR(x[0], x[5], x[10], x[15]);
+            QR(x[1], x[6], x[11], x[12]);
+            QR(x[2], x[7], x[8], x[13]);
+            QR(x[3], x[4], x[9], x[14]);
+        }
+
+        for (i = 0; i < 16; i++) {
+            x[i] = _mm_add_epi32(x[i], s[i]);
+        }
+
+        for (i = 0; i < 16; i += 4) {
+            TRANSPOSE(x[i], x[i + 1], x[i + 2], x[i + 3]);
+            XOR_STORE(x[i], 4 * i);
+            XOR_STORE(x[i + 1], 4 * i + 64);
+            XOR_STORE(x[i + 2], 4 * i + 128);
+            XOR_STORE(x[i + 3], 4 * i + 192);
+        }
+
+        ctr += 4;
+        in += 256;
+        out += 256;
+    }
+}
+
+#endif /* CCCHACHA20_INTEL */
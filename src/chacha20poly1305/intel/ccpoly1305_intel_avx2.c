@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include "../ccchacha20_internal.h"
+
+#if CCCHACHA20_INTEL
+
+#include <immintrin.h>
+
+/*
+ * Four interleaved accumulators, one per 64-bit lane, limb i of lane j in
+ * lane j of h[i]. Lane j takes blocks j, j + 4, j + 8, ... and is multiplied
+ * by r^4 between steps; the last step multiplies lane j by r^(4 - j) so the
+ * lanes sum to the serial result.
+ */
+
+/* d = h * r mod 2^130 - 5, s = 5 * r, then a partial reduction back into h */
+#define MUL(h, r, s)                                                                                   \
+    d[0] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[0]),           \
+                                                              _mm256_mul_epu32(h[1], s[4])),          \
+                                             _mm256_add_epi64(_mm256_mul_epu32(h[2], s[3]),           \
+                                                              _mm256_mul_epu32(h[3], s[2]))),         \
+                            _mm256_mul_epu32(h[4], s[1]));                                             \
+    d[1] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[1]),           \
+                                                              _mm256_mul_epu32(h[1], r[0])),          \
+                                             _mm256_add_epi64(_mm256_mul_epu32(h[2], s[4]),           \
+                                                              _mm256_mul_epu32(h[3], s[3]))),         \
+                            _mm256_mul_epu32(h[4], s[2]));                                             \
+    d[2] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[2]),           \
+                                                              _mm256_mul_epu32(h[1], r[1])),          \
+                                             _mm256_add_epi64(_mm256_mul_epu32(h[2], r[0]),           \
+                                                              _mm256_mul_epu32(h[3], s[4]))),         \
+                            _mm256_mul_epu32(h[4], s[3]));                                             \
+    d[3] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[3]),           \
+                                                              _mm256_mul_epu32(h[1], r[2])),          \
+                                             _mm256_add_epi64(_mm256_mul_epu32(h[2], r[1]),           \
+                                                              _mm256_mul_epu32(h[3], r[0]))),         \
+                            _mm256_mul_epu32(h[4], s[4]));                                             \
+    d[4] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[4]),           \
+                                                              _mm256_mul_epu32(h[1], r[3])),          \
+                                             _mm256_add_epi64(_mm256_mul_epu32(h[2], r[2]),           \
+                                                              _mm256_mul_epu32(h[3], r[1]))),         \
+                            _mm256_mul_epu32(h[4], r[0]));                                             \
+    c = _mm256_srli_epi64(d[0], 26); h[0] = _mm256_and_si256(d[0], m26); d[1] = _mm256_add_epi64(d[1], c); \
+    c = _mm256_srli_epi64(d[1], 26); h[1] = _mm256_and_si256(d[1], m26); d[2] = _mm256_add_epi64(d[2], c); \
+    c = _mm256_srli_epi64(d[2], 26); h[2] = _mm256_and_si256(d[2], m26); d[3] = _mm256_add_epi64(d[3], c); \
+    c = _mm256_srli_epi64(d[3], 26); h[3] = _mm256_and_si256(d[3], m26); d[4] = _mm256_add_epi64(d[4], c); \
+    c = _mm256_srli_epi64(d[4], 26); h[4] = _mm256_and_si256(d[4], m26);                               \
+    h[0] = _mm256_add_epi64(h[0], _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));                       \
+    c = _mm256_srli_epi64(h[0], 26); h[0] = _mm256_and_si256(h[0], m26); h[1] = _mm256_add_epi64(h[1], c);
+
+__attribute__((target("avx2")))
+void ccpoly1305_intel_avx2_blocks(uint32_t acc[5], const uint32_t r[4][5], size_t nblocks, const uint8_t *in)
+{
+    const __m256i m26 = _mm256_set1_epi64x(0x3ffffff);
+    const __m256i hibit = _mm256_set1_epi64x(1 << 24);
+    __m256i h[5], r4[5], s4[5], rl[5], sl[5], d[5], c, a, b, lo, hi;
+    uint64_t t[4], g[5];
+    uint32_t cs;
+    int i;
+
+    for (i = 0; i < 5; i++) {
+        h[i] = _mm256_set_epi64x(0, 0, 0, acc[i]);
+        r4[i] = _mm256_set1_epi64x(r[3][i]);
+        s4[i] = _mm256_set1_epi64x(r[3][i] * 5);
+        rl[i] = _mm256_set_epi64x(r[0][i], r[1][i], r[2][i], r[3][i]);
+        sl[i] = _mm256_set_epi64x(r[0][i] * 5, r[1][i] * 5, r[2][i] * 5, r[3][i] * 5);
+    }
+
+    for (;;) {
+        /* low and high 64 bits of blocks 0..3, one block per lane */
+        a = _mm256_loadu_si256((const __m256i *)in);
+        b = _mm256_loadu_si256((const __m256i *)(in + 32));
+        lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8);
+        hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xd8);
+
+        h[0] = _mm256_add_epi64(h[0], _mm256_and_si256(lo, m26));
+        h[1] = _mm256_add_epi64(h[1], _mm256_and_si256(_mm256_srli_epi64(lo, 26), m26));
+        h[2] = _mm256_add_epi64(h[2], _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), m26));
+        h[3] = _mm256_add_epi64(h[3], _mm256_and_si256(_mm256_srli_epi64(hi, 14), m26));
+        h[4] = _mm256_add_epi64(h[4], _mm256_or_si256(_mm256_srli_epi64(hi, 40), hibit));
+
+        in += 64;
+        nblocks -= 4;
+        if (nblocks == 0) {
+            break;
+        }
+
+        MUL(h, r4, s4);
+    }
+
+    /* lane j times r^(4 - j), then fold the lanes together */
+    MUL(h, rl, sl);
+
+    for (i = 0; i < 5; i++) {
+        _mm256_storeu_si256((__m256i *)t, h[i]);
+        g[i] = t[0] + t[1] + t[2] + t[3];
+    }
+    _mm256_zeroupper();
+
+    cs = (uint32_t)(g[0] >> 26); g[0] &= 0x3ffffff; g[1] += cs;
+    cs = (uint32_t)(g[1] >> 26); g[1] &= 0x3ffffff; g[2] += cs;
+    cs = (uint32_t)(g[2] >> 26); g[2] &= 0x3ffffff; g[3] += cs;
+    cs = (uint32_t)(g[3] >> 26); g[3] &= 0x3ffffff; g[4] += cs;
+    cs = (uint32_t)(g[4] >> 26); g[4] &= 0x3ffffff; g[0] += cs * 5;
+    cs = (uint32_t)(g[0] >> 26); g[0] &= 0x3ffffff; g[1] += cs;
+
+    for (i = 0; i < 5; i++) {
+        acc[i] = (uint32_t)g[i];
+    }
+}
+
+#endif /* CCCHACHA20_INTEL */
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cccmac_priv.h>
+
+int cccmac_final_generate(cccmac_ctx_t ctx, size_t mac_nbytes, void *mac)
+{
+    const struct ccmode_cbc *cbc = cccmac_cbc(ctx);
+    uint8_t *block = cccmac_block(ctx);
+    size_t n = cccmac_block_nbytes(ctx);
+    uint8_t T[CMAC_BLOCKSIZE];
+    int rv;
+
+    if (mac_nbytes == 0 || mac_nbytes > CMAC_BLOCKSIZE) {
+        return CCERR_PARAMETER;
+    }
+
+    /* a complete last block is masked with K1, a padded (or empty) one with K2 */
+    if (n == CMAC_BLOCKSIZE) {
+        cc_xor(CMAC_BLOCKSIZE, block, block, cccmac_k1(ctx));
+    } else {
+        block[n] = 0x80;
+        cc_clear(CMAC_BLOCKSIZE - n - 1, block + n + 1);
+        cc_xor(CMAC_BLOCKSIZE, block, block, cccmac_k2(ctx));
+    }
+
+    rv = cccbc_update(cbc, cccmac_mode_sym_ctx(cbc, ctx), cccmac_mode_iv(cbc, ctx), 1, block, T);
+    if (rv == CCERR_OK) {
+        cc_memcpy(mac, T, mac_nbytes);
+    }
+
+    cc_clear(sizeof(T), T);
+    cc_clear(cccmac_ctx_size(cbc), ctx);
+    return rv;
+}
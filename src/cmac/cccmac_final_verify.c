@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cccmac_priv.h>
+
+int cccmac_final_verify(cccmac_ctx_t ctx, size_t expected_mac_nbytes, const void *expected_mac)
+{
+    uint8_t mac[CMAC_BLOCKSIZE];
+    int rv;
+
+    if (expected_mac_nbytes == 0 || expected_mac_nbytes > CMAC_BLOCKSIZE) {
+        return CCERR_PARAMETER;
+    }
+
+    rv = cccmac_final_generate(ctx, CMAC_BLOCKSIZE, mac);
+    if (rv == CCERR_OK && cc_cmp_safe(expected_mac_nbytes, mac, expected_mac)) {
+        rv = CCERR_INTEGRITY;
+    }
+
+    cc_clear(sizeof(mac), mac);
+    return rv;
+}
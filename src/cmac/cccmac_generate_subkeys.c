@@ -20,7 +20,8 @@
 #include <corecrypto/cccmac_priv.h>
 #include <corecrypto/ccmode.h>
 
-const uint8_t constant_zero[CMAC_BLOCKSIZE] = { 0 };
+/* R_128 from SP800-38B, folded into the last byte when the shifted-out bit is set */
+static const uint8_t constant_rb[CMAC_BLOCKSIZE] = { [CMAC_BLOCKSIZE - 1] = 0x87 };
 
 /* recycled from older versions of CommonCrypto. */
 void cc_leftshift_onebit(uint8_t *input, uint8_t *output)
@@ -36,31 +37,37 @@ void cc_leftshift_onebit(uint8_t *input, uint8_t *output)
     return;
 }
 
-int cccmac_generate_subkeys(const struct ccmode_cbc *cbc, size_t key_nbytes, const void *key, uint8_t *key1, uint8_t *key2)
+void cccmac_derive_subkeys(const uint8_t *L, uint8_t *key1, uint8_t *key2)
 {
-    const uint8_t iv[CMAC_BLOCKSIZE] = { 0 };
-    uint8_t buf[CMAC_BLOCKSIZE] = { 0 };
-    uint8_t tmp[CMAC_BLOCKSIZE] = { 0 };
+    uint8_t tmp[CMAC_BLOCKSIZE];
 
-    int ret = cccbc_one_shot(cbc, key_nbytes, key, iv, 1, buf, buf);
-    if (ret) { return ret; }
-
-    if ((buf[0] & 0x80) == 0) {
-        cc_leftshift_onebit(buf, key1);
+    if ((L[0] & 0x80) == 0) {
+        cc_leftshift_onebit((uint8_t *)L, key1);
     } else {
-        cc_leftshift_onebit(buf, tmp);
-        cc_xor(CMAC_BLOCKSIZE, key1, tmp, constant_zero);
+        cc_leftshift_onebit((uint8_t *)L, tmp);
+        cc_xor(CMAC_BLOCKSIZE, key1, tmp, constant_rb);
     }
 
     if ((key1[0] & 0x80) == 0) {
         cc_leftshift_onebit(key1, key2);
     } else {
         cc_leftshift_onebit(key1, tmp);
-        cc_xor(CMAC_BLOCKSIZE, key2, tmp, constant_zero);
+        cc_xor(CMAC_BLOCKSIZE, key2, tmp, constant_rb);
     }
 
-    cc_clear(CMAC_BLOCKSIZE, buf);
     cc_clear(CMAC_BLOCKSIZE, tmp);
+}
+
+int cccmac_generate_subkeys(const struct ccmode_cbc *cbc, size_t key_nbytes, const void *key, uint8_t *key1, uint8_t *key2)
+{
+    const uint8_t iv[CMAC_BLOCKSIZE] = { 0 };
+    uint8_t buf[CMAC_BLOCKSIZE] = { 0 };
+
+    int ret = cccbc_one_shot(cbc, key_nbytes, key, iv, 1, buf, buf);
+    if (ret) { return ret; }
+
+    cccmac_derive_subkeys(buf, key1, key2);
+    cc_clear(CMAC_BLOCKSIZE, buf);
 
     return CCERR_OK;
 }
@@ -16,21 +16,36 @@
  * @LICENSE_HEADER_END@
  */
 
+
 #include <corecrypto/cc_priv.h>
 #include <corecrypto/cccmac_priv.h>
 
 int cccmac_init(const struct ccmode_cbc *cbc, cccmac_ctx_t ctx, size_t key_nbytes, const void *key)
 {
-    cccmac_cbc(ctx) = cbc;
+    uint8_t L[CMAC_BLOCKSIZE] = { 0 };
+    int rv;
 
-    /* Block size CANNOT be larger than CMAC_BLOCKSIZE. */
-    if (cbc->block_size > CMAC_BLOCKSIZE) {
+    /* Only 128-bit block ciphers, K1/K2 are derived with R_128. */
+    if (cbc->block_size != CMAC_BLOCKSIZE) {
         return CCERR_PARAMETER;
     }
 
-    cccmac_generate_subkeys(cbc, key_nbytes, key, cccmac_k1(ctx), cccmac_k2(ctx));
-    cbc->init(cccmac_cbc(ctx), cccmac_mode_sym_ctx(cccmac_cbc(ctx), ctx), key_nbytes, key);
+    cccmac_cbc(ctx) = cbc;
+    cccmac_block_nbytes(ctx) = 0;
+    cccmac_cumulated_nbytes(ctx) = 0;
+
+    if ((rv = cccbc_init(cbc, cccmac_mode_sym_ctx(cbc, ctx), key_nbytes, key))) {
+        return rv;
+    }
+
+    /* L = E_K(0) on the key we just scheduled, then the running IV starts at zero */
+    cccbc_set_iv(cbc, cccmac_mode_iv(cbc, ctx), NULL);
+    if ((rv = cccbc_update(cbc, cccmac_mode_sym_ctx(cbc, ctx), cccmac_mode_iv(cbc, ctx), 1, L, L))) {
+        return rv;
+    }
+    cccmac_derive_subkeys(L, cccmac_k1(ctx), cccmac_k2(ctx));
+    cccbc_set_iv(cbc, cccmac_mode_iv(cbc, ctx), NULL);
 
-    /* Anything else? */
+    cc_clear(sizeof(L), L);
     return CCERR_OK;
 }
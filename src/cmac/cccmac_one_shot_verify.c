@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cccmac_priv.h>
+
+int cccmac_one_shot_verify(const struct ccmode_cbc *cbc,
+                           size_t key_nbytes, const void *key,
+                           size_t data_nbytes, const void *data,
+                           size_t expected_mac_nbytes, const void *expected_mac)
+{
+    cccmac_mode_decl(cbc, ctx);
+    int rv;
+
+    rv = cccmac_init(cbc, ctx, key_nbytes, key);
+    if (rv == CCERR_OK) {
+        rv = cccmac_update(ctx, data_nbytes, data);
+    }
+    if (rv == CCERR_OK) {
+        rv = cccmac_final_verify(ctx, expected_mac_nbytes, expected_mac);
+    }
+
+    cccmac_mode_clear(cbc, ctx);
+    return rv;
+}
@@ -16,24 +16,51 @@
  * @LICENSE_HEADER_END@
  */
 
+
 #include <corecrypto/cc_priv.h>
 #include <corecrypto/cccmac.h>
 #include <corecrypto/cccmac_priv.h>
 
 int cccmac_update(cccmac_ctx_t ctx, size_t data_nbytes, const void *data)
 {
-    int flag = (data_nbytes % CMAC_BLOCKSIZE);
-    size_t nblocks = data_nbytes / CMAC_BLOCKSIZE;
-    if (flag) {
+    const struct ccmode_cbc *cbc = cccmac_cbc(ctx);
+    const uint8_t *p = data;
+    uint8_t out[CCCMAC_UPDATE_NBLOCKS * CMAC_BLOCKSIZE];
+    int rv = CCERR_OK;
+
+    if (data_nbytes == 0) {
+        return CCERR_OK;
     }
 
-    cc_memcpy(cccmac_block(ctx), data, CMAC_BLOCKSIZE);
+    cccmac_cumulated_nbytes(ctx) += data_nbytes;
+
+    /* The last block is always held back, final_generate masks it with K1 or K2. */
+    if (cccmac_block_nbytes(ctx)) {
+        size_t n = CC_MIN(data_nbytes, CMAC_BLOCKSIZE - cccmac_block_nbytes(ctx));
+        cc_memcpy(cccmac_block(ctx) + cccmac_block_nbytes(ctx), p, n);
+        cccmac_block_nbytes(ctx) += n;
+        p += n;
+        data_nbytes -= n;
+
+        if (data_nbytes == 0) {
+            return CCERR_OK;
+        }
+
+        rv = cccbc_update(cbc, cccmac_mode_sym_ctx(cbc, ctx), cccmac_mode_iv(cbc, ctx), 1, cccmac_block(ctx), out);
+        cccmac_block_nbytes(ctx) = 0;
+    }
 
-    while (nblocks--) {
-        cccmac_cbc(ctx)->cbc(cccmac_mode_sym_ctx(cccmac_cbc(ctx), ctx), cccmac_mode_iv(cccmac_cbc(ctx), ctx), 1, cccmac_block(ctx), cccmac_block(ctx));
+    /* every whole block but the last one goes straight from the input, a run per cbc call */
+    while (rv == CCERR_OK && data_nbytes > CMAC_BLOCKSIZE) {
+        size_t nblocks = CC_MIN((data_nbytes - 1) / CMAC_BLOCKSIZE, (size_t)CCCMAC_UPDATE_NBLOCKS);
+        rv = cccbc_update(cbc, cccmac_mode_sym_ctx(cbc, ctx), cccmac_mode_iv(cbc, ctx), nblocks, p, out);
+        p += nblocks * CMAC_BLOCKSIZE;
+        data_nbytes -= nblocks * CMAC_BLOCKSIZE;
     }
 
-    cc_try_abort("ZORMEISTER: incomplete CMAC function called. raising hell.\n");
+    cc_memcpy(cccmac_block(ctx), p, data_nbytes);
+    cccmac_block_nbytes(ctx) = data_nbytes;
 
-    return 0;
+    cc_clear(sizeof(out), out);
+    return rv;
 }
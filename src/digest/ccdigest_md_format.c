@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccdigest_priv.h>
+
+bool ccdigest_md_format(const struct ccdigest_info *di, struct ccdigest_md_format *fmt)
+{
+    if (di->output_size > di->state_size) {
+        return false;
+    }
+
+    if (di->block_size == 64 && di->final == ccdigest_final_64be) {
+        *fmt = (struct ccdigest_md_format){ 4, 8, false };
+    } else if (di->block_size == 64 && di->final == ccdigest_final_64le) {
+        *fmt = (struct ccdigest_md_format){ 4, 8, true };
+    } else if (di->block_size == 128 && di->final == ccsha512_final) {
+        *fmt = (struct ccdigest_md_format){ 8, 16, false };
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ccdigest_md_pad_block(const struct ccdigest_info *di, const struct ccdigest_md_format *fmt,
+                           size_t nbytes, uint8_t *block)
+{
+    uint64_t nbits = (di->block_size + nbytes) * 8;
+    uint8_t *len = block + di->block_size - fmt->length_nbytes;
+
+    cc_clear(di->block_size - nbytes, block + nbytes);
+    block[nbytes] = 0x80;
+    if (fmt->le) {
+        CC_STORE64_LE(nbits, len);
+    } else {
+        CC_STORE64_BE(nbits, len + fmt->length_nbytes - 8);
+    }
+}
+
+void ccdigest_md_store(const struct ccdigest_md_format *fmt, size_t nbytes, const void *state, uint8_t *out)
+{
+    uint8_t word[8];
+    size_t i;
+
+    for (i = 0; i < nbytes; i += fmt->word_nbytes) {
+        if (fmt->word_nbytes == 8) {
+            CC_STORE64_BE(((const uint64_t *)state)[i / 8], word);
+        } else if (fmt->le) {
+            CC_STORE32_LE(((const uint32_t *)state)[i / 4], word);
+        } else {
+            CC_STORE32_BE(((const uint32_t *)state)[i / 4], word);
+        }
+        cc_memcpy(out + i, word, CC_MIN(fmt->word_nbytes, nbytes - i));
+    }
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_runtime_config.h>
+#include <corecrypto/ccdigest_priv.h>
+#include <corecrypto/ccsha1.h>
+#include <corecrypto/ccsha2.h>
+
+struct ccdigest_multi_lane {
+    ccdigest_ctx_t ctx;
+    const uint8_t *data;
+    size_t nblocks;
+};
+
+#if CCDIGEST_MULTI_SIMD
+
+const struct ccdigest_multi_compress *ccdigest_multi_kernels(const struct ccdigest_info *di)
+{
+    if (di->compress == ccsha1_ltc_di.compress) {
+        return ccsha1_multi_compress;
+    }
+    if (di->compress == ccsha256_ltc_di.compress) {
+        return ccsha256_multi_compress;
+    }
+#if CCSHA1_VNG_INTEL && defined(__x86_64__)
+    if (di->compress == ccsha1_vng_intel_AVX2_di.compress) {
+        return ccsha1_multi_compress;
+    }
+#endif
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+    /* not for SHA-NI, a single stream of it beats every lane count here */
+    if (di->compress == ccsha256_vng_intel_AVX2_di.compress ||
+        di->compress == ccsha256_vng_intel_SupplementalSSE3_di.compress) {
+        return ccsha256_multi_compress;
+    }
+    if (di->compress == ccsha512_vng_intel_AVX2_di.compress ||
+        di->compress == ccsha512_vng_intel_AVX512_di.compress) {
+        return ccsha512_multi_compress;
+    }
+#endif
+    if (di->compress == ccsha512_ltc_di.compress) {
+        return ccsha512_multi_compress;
+    }
+    return NULL;
+}
+
+static bool ccdigest_multi_usable(const struct ccdigest_multi_compress *k)
+{
+    switch (k->cpu) {
+#if CCDIGEST_MULTI_X86
+    case CCDIGEST_MULTI_CPU_AVX2:
+        return CC_HAS_AVX2();
+    case CCDIGEST_MULTI_CPU_AVX512:
+        return CC_HAS_AVX512_AND_IN_KERNEL();
+#endif
+    case CCDIGEST_MULTI_CPU_ANY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+#else
+
+const struct ccdigest_multi_compress *ccdigest_multi_kernels(CC_UNUSED const struct ccdigest_info *di)
+{
+    return NULL;
+}
+
+static bool ccdigest_multi_usable(CC_UNUSED const struct ccdigest_multi_compress *k)
+{
+    return false;
+}
+
+#endif /* CCDIGEST_MULTI_SIMD */
+
+const struct ccdigest_multi_compress *ccdigest_multi_select(const struct ccdigest_multi_compress *kernels, size_t nactive)
+{
+    const struct ccdigest_multi_compress *k = NULL, *kp;
+
+    if (kernels == NULL) {
+        return NULL;
+    }
+
+    /* the widest kernel the lanes can fill, otherwise the narrowest one padded out */
+    for (kp = kernels; kp->nlanes; kp++) {
+        if (ccdigest_multi_usable(kp)) {
+            k = kp;
+            if (kp->nlanes <= nactive) {
+                break;
+            }
+        }
+    }
+    return k;
+}
+
+/* compress the whole blocks of up to CCDIGEST_MULTI_MAX_LANES messages, as many lanes wide as the CPU allows */
+static void ccdigest_multi_blocks(const struct ccdigest_info *di, const struct ccdigest_multi_compress *kernels,
+                                  size_t nlanes, struct ccdigest_multi_lane *lanes)
+{
+    uint64_t pad[CCDIGEST_MULTI_MAX_LANES * 8] = { 0 };
+    ccdigest_state_t states[CCDIGEST_MULTI_MAX_LANES];
+    const uint8_t *data[CCDIGEST_MULTI_MAX_LANES];
+    size_t active[CCDIGEST_MULTI_MAX_LANES];
+
+    for (;;) {
+        const struct ccdigest_multi_compress *k;
+        size_t nactive = 0, nblocks = SIZE_MAX, i;
+
+        for (i = 0; i < nlanes; i++) {
+            if (lanes[i].nblocks) {
+                active[nactive++] = i;
+            }
+        }
+
+        if (nactive == 0) {
+            return;
+        }
+
+        /* a single lane left is a ragged tail, give it to the scalar compress */
+        if (nactive == 1) {
+            struct ccdigest_multi_lane *lane = &lanes[active[0]];
+            di->compress(ccdigest_state(di, lane->ctx), lane->nblocks, lane->data);
+            ccdigest_nbits(di, lane->ctx) += lane->nblocks * di->block_size * 8;
+            lane->data += lane->nblocks * di->block_size;
+            lane->nblocks = 0;
+            return;
+        }
+
+        k = ccdigest_multi_select(kernels, nactive);
+        if (nactive > k->nlanes) {
+            nactive = k->nlanes;
+        }
+
+        for (i = 0; i < nactive; i++) {
+            struct ccdigest_multi_lane *lane = &lanes[active[i]];
+            states[i] = ccdigest_state(di, lane->ctx);
+            data[i] = lane->data;
+            if (lane->nblocks < nblocks) {
+                nblocks = lane->nblocks;
+            }
+        }
+        for (; i < k->nlanes; i++) {
+            states[i] = (ccdigest_state_t)&pad[8 * i];
+            data[i] = data[0];
+        }
+
+        k->compress(states, nblocks, data);
+
+        for (i = 0; i < nactive; i++) {
+            struct ccdigest_multi_lane *lane = &lanes[active[i]];
+            lane->data += nblocks * di->block_size;
+            lane->nblocks -= nblocks;
+            ccdigest_nbits(di, lane->ctx) += nblocks * di->block_size * 8;
+        }
+    }
+}
+
+void ccdigest_multi_update(const struct ccdigest_info *di, size_t njobs, const struct ccdigest_multi_job *jobs)
+{
+    const struct ccdigest_multi_compress *kernels = ccdigest_multi_kernels(di);
+    struct ccdigest_multi_lane lanes[CCDIGEST_MULTI_MAX_LANES];
+    size_t tails[CCDIGEST_MULTI_MAX_LANES];
+
+    if (kernels == NULL) {
+        for (size_t i = 0; i < njobs; i++) {
+            ccdigest_update(di, jobs[i].ctx, jobs[i].len, jobs[i].data);
+        }
+        return;
+    }
+
+    while (njobs) {
+        size_t n = CC_MIN(njobs, (size_t)CCDIGEST_MULTI_MAX_LANES), i;
+
+        for (i = 0; i < n; i++) {
+            const uint8_t *p = jobs[i].data;
+            size_t len = jobs[i].len;
+
+            /* top up a partially filled block first */
+            if (ccdigest_num(di, jobs[i].ctx)) {
+                size_t head = CC_MIN(len, di->block_size - ccdigest_num(di, jobs[i].ctx));
+                ccdigest_update(di, jobs[i].ctx, head, p);
+                p += head;
+                len -= head;
+            }
+
+            lanes[i].ctx = jobs[i].ctx;
+            lanes[i].data = p;
+            lanes[i].nblocks = len / di->block_size;
+            tails[i] = len % di->block_size;
+        }
+
+        ccdigest_multi_blocks(di, kernels, n, lanes);
+
+        for (i = 0; i < n; i++) {
+            ccdigest_update(di, jobs[i].ctx, tails[i], lanes[i].data);
+        }
+
+        jobs += n;
+        njobs -= n;
+    }
+}
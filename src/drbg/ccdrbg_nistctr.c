@@ -16,55 +16,406 @@
  * @LICENSE_HEADER_END@
  */
 
+#include <stdbool.h>
+
+#include <corecrypto/cc_macros.h>
 #include <corecrypto/cc_priv.h>
 #include <corecrypto/ccaes.h>
 #include <corecrypto/ccdrbg.h>
 #include <corecrypto/ccdrbg_impl.h>
+#include <corecrypto/ccmode.h>
+
+// This CTR DRBG is described in:
+
+// NIST SP 800-90A Rev. 1
+// Recommendation for Random Number Generation Using Deterministic Random Bit Generators
+// June 2015
+
+// See in particular:
+// - 10.2.1 CTR_DRBG
+// - 10.3.2 Derivation Function Using a Block Cipher Algorithm
 
 #define CCDRBG_CTR_MAX_KEYLEN   CCAES_KEY_SIZE_256
 #define CCDRBG_CTR_BLOCK_LENGTH CCAES_BLOCK_SIZE
+#define CCDRBG_CTR_MAX_SEEDLEN  (CCDRBG_CTR_MAX_KEYLEN + CCDRBG_CTR_BLOCK_LENGTH)
+
+/*
+ * NIST CTR based DRBGs can use the following ciphers:
+ * - 3 Key TDEA
+ * - AES with key sizes of 128, 192 or 256.
+ *
+ * Only AES is supported here. Every block encryption is done with the
+ * ctr_info mode: the keystream of a counter is the encryption of it, so
+ * generate turns the whole request into a single ctr call and gets the
+ * backend's parallel (AES-NI 8 blocks at a time) path.
+ */
 
 struct ccdrbg_nistctr_state {
     uint8_t V[CCDRBG_CTR_BLOCK_LENGTH];
     uint8_t Key[CCDRBG_CTR_MAX_KEYLEN];
     uint64_t reseed_counter;
     const struct ccdrbg_nistctr_custom *custom;
+    size_t buffered_nbytes; // unread keystream at the end of the buffer
 };
 
-/*
- * NIST CTR based DRBGs can use the following ciphers:
- * - 3 Key TDEA
- * - AES with key sizes of 128, 192 or 256.
- */
+// The state is followed by the ctr context, keyed with Key, then by the optional keystream buffer
+#define NISTCTR_STATE_SIZE cc_pad_align(sizeof(struct ccdrbg_nistctr_state))
+#define NISTCTR_CTR_CTX(drbg_ctx) ((ccctr_ctx *)((uint8_t *)(drbg_ctx) + NISTCTR_STATE_SIZE))
+#define NISTCTR_BUFFER(drbg_ctx) \
+    ((uint8_t *)(drbg_ctx) + NISTCTR_STATE_SIZE + cc_pad_align((drbg_ctx)->custom->ctr_info->size))
+
+struct nistctr_input {
+    size_t nbytes;
+    const void *bytes;
+};
+
+static size_t
+seedlen(const struct ccdrbg_nistctr_custom *custom)
+{
+    return custom->keylen + CCDRBG_CTR_BLOCK_LENGTH;
+}
 
-/* SP800-90A, 9.4, Removing a DRBG Instantiation */
+static size_t
+buffer_size(const struct ccdrbg_nistctr_custom *custom)
+{
+    return custom->strictFIPS ? 0 : CC_MIN(custom->buffer_nbytes, (size_t)CCDRBG_NISTCTR_MAX_BUFFER_SIZE);
+}
+
+static size_t
+context_size(const struct ccdrbg_nistctr_custom *custom)
+{
+    return NISTCTR_STATE_SIZE + cc_pad_align(custom->ctr_info->size) + buffer_size(custom);
+}
+
+// See NIST SP 800-90A, Rev. 1, 9.4
 static void
 done(struct ccdrbg_state *ctx)
 {
-    cc_clear(sizeof(struct ccdrbg_nistctr_state), ctx);
+    struct ccdrbg_nistctr_state *drbg_ctx = (struct ccdrbg_nistctr_state *)ctx;
+
+    cc_clear(context_size(drbg_ctx->custom), ctx);
 }
 
-/*
-int (*init)(const struct ccdrbg_info *info, struct ccdrbg_state *drbg,
-            size_t entropyLength, const void* entropy,
-            size_t nonceLength, const void* nonce,
-            size_t psLength, const void* ps);
- */
+// V + n, the counter is the whole block
+static void
+ctr_add(uint8_t *V, uint64_t n)
+{
+    for (size_t i = CCDRBG_CTR_BLOCK_LENGTH; i-- > 0 && n; n >>= 8) {
+        n += V[i];
+        V[i] = (uint8_t)n;
+    }
+}
 
-static int init(const struct ccdrbg_info *info, struct ccdrbg_state *drbg,
-                size_t entropy_len, const void *entropy,
-                size_t nonce_len, const void *nonce,
-                size_t ps_len, const void *ps)
+// Encryptions of the counter blocks from ctr on, nbytes of them
+static void
+keystream(struct ccdrbg_nistctr_state *drbg_ctx, const uint8_t *ctr, size_t nbytes, void *out)
 {
+    const struct ccmode_ctr *ctr_info = drbg_ctx->custom->ctr_info;
+
+    ctr_info->setctr(ctr_info, NISTCTR_CTR_CTX(drbg_ctx), ctr);
+    cc_memset(out, 0, nbytes);
+    ccctr_update(ctr_info, NISTCTR_CTR_CTX(drbg_ctx), nbytes, out, out);
+}
+
+static void
+rekey(struct ccdrbg_nistctr_state *drbg_ctx, const uint8_t *key)
+{
+    const struct ccdrbg_nistctr_custom *custom = drbg_ctx->custom;
+
+    ccctr_init(custom->ctr_info, NISTCTR_CTR_CTX(drbg_ctx), custom->keylen, key, drbg_ctx->V);
+}
+
+// See NIST SP 800-90A, Rev. 1, 10.2.1.2
+static void
+update(struct ccdrbg_nistctr_state *drbg_ctx, const uint8_t *provided_data)
+{
+    size_t keylen = drbg_ctx->custom->keylen;
+    size_t len = seedlen(drbg_ctx->custom);
+    uint8_t temp[CCDRBG_CTR_MAX_SEEDLEN + CCDRBG_CTR_BLOCK_LENGTH];
+    uint8_t ctr[CCDRBG_CTR_BLOCK_LENGTH];
+    size_t nblocks = (len + CCDRBG_CTR_BLOCK_LENGTH - 1) / CCDRBG_CTR_BLOCK_LENGTH;
+
+    cc_memcpy(ctr, drbg_ctx->V, sizeof(ctr));
+    ctr_add(ctr, 1);
+    keystream(drbg_ctx, ctr, nblocks * CCDRBG_CTR_BLOCK_LENGTH, temp);
+
+    cc_xor(len, temp, temp, provided_data);
+    cc_memcpy(drbg_ctx->Key, temp, keylen);
+    cc_memcpy(drbg_ctx->V, temp + keylen, CCDRBG_CTR_BLOCK_LENGTH);
+    rekey(drbg_ctx, drbg_ctx->Key);
+
+    cc_clear(sizeof(temp), temp);
+}
+
+// Run the S || 0x80 || 0* blocks of BCC, 10.3.3, through chain
+static void
+bcc_feed(struct ccdrbg_nistctr_state *drbg_ctx, uint8_t *chain, uint8_t *block, size_t *block_nbytes,
+         size_t nbytes, const uint8_t *bytes)
+{
+    while (nbytes) {
+        size_t n = CC_MIN(nbytes, CCDRBG_CTR_BLOCK_LENGTH - *block_nbytes);
+
+        cc_memcpy(block + *block_nbytes, bytes, n);
+        *block_nbytes += n;
+        bytes += n;
+        nbytes -= n;
+
+        if (*block_nbytes == CCDRBG_CTR_BLOCK_LENGTH) {
+            cc_xor(CCDRBG_CTR_BLOCK_LENGTH, block, block, chain);
+            keystream(drbg_ctx, block, CCDRBG_CTR_BLOCK_LENGTH, chain);
+            *block_nbytes = 0;
+        }
+    }
+}
+
+// See NIST SP 800-90A, Rev. 1, 10.3.2, the result is seedlen bytes
+static void
+df(struct ccdrbg_nistctr_state *drbg_ctx, size_t ninputs, const struct nistctr_input *inputs, uint8_t *out)
+{
+    static const uint8_t df_key[CCDRBG_CTR_MAX_KEYLEN] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    };
+    static const uint8_t pad[CCDRBG_CTR_BLOCK_LENGTH] = { 0x80 };
+    size_t keylen = drbg_ctx->custom->keylen;
+    size_t len = seedlen(drbg_ctx->custom);
+    uint8_t temp[CCDRBG_CTR_MAX_SEEDLEN + CCDRBG_CTR_BLOCK_LENGTH];
+    uint8_t iv[CCDRBG_CTR_BLOCK_LENGTH] = { 0 };
+    uint8_t block[CCDRBG_CTR_BLOCK_LENGTH];
+    uint8_t header[8];
+    size_t i, input_nbytes = 0;
+
+    for (i = 0; i < ninputs; i++) {
+        input_nbytes += inputs[i].nbytes;
+    }
+    CC_STORE32_BE((uint32_t)input_nbytes, header);
+    CC_STORE32_BE((uint32_t)len, header + 4);
+
+    rekey(drbg_ctx, df_key);
+    for (size_t t = 0; t < len; t += CCDRBG_CTR_BLOCK_LENGTH) {
+        size_t block_nbytes = 0;
+        uint8_t *chain = temp + t;
+
+        CC_STORE32_BE((uint32_t)(t / CCDRBG_CTR_BLOCK_LENGTH), iv);
+        cc_clear(CCDRBG_CTR_BLOCK_LENGTH, chain);
+
+        bcc_feed(drbg_ctx, chain, block, &block_nbytes, sizeof(iv), iv);
+        bcc_feed(drbg_ctx, chain, block, &block_nbytes, sizeof(header), header);
+        for (i = 0; i < ninputs; i++) {
+            bcc_feed(drbg_ctx, chain, block, &block_nbytes, inputs[i].nbytes, inputs[i].bytes);
+        }
+        bcc_feed(drbg_ctx, chain, block, &block_nbytes, CCDRBG_CTR_BLOCK_LENGTH - block_nbytes, pad);
+    }
+
+    // X = E(K, X) chained over the new key
+    rekey(drbg_ctx, temp);
+    for (size_t t = 0; t < len; t += CCDRBG_CTR_BLOCK_LENGTH) {
+        keystream(drbg_ctx, t ? temp + t - CCDRBG_CTR_BLOCK_LENGTH : temp + keylen, CCDRBG_CTR_BLOCK_LENGTH, temp + t);
+    }
+    cc_memcpy(out, temp, len);
+
+    rekey(drbg_ctx, drbg_ctx->Key);
+
+    cc_clear(sizeof(temp), temp);
+    cc_clear(sizeof(block), block);
+}
+
+// The provided_data of seedlen bytes: inputs through the derivation function, or xored together
+static void
+seed_material(struct ccdrbg_nistctr_state *drbg_ctx, size_t ninputs, const struct nistctr_input *inputs, uint8_t *out)
+{
+    size_t len = seedlen(drbg_ctx->custom);
+
+    if (drbg_ctx->custom->use_df) {
+        df(drbg_ctx, ninputs, inputs, out);
+        return;
+    }
+
+    cc_clear(len, out);
+    for (size_t i = 0; i < ninputs; i++) {
+        cc_xor(inputs[i].nbytes, out, out, inputs[i].bytes);
+    }
+}
+
+static bool
+entropy_isvalid(size_t entropy_nbytes, const struct ccdrbg_nistctr_custom *custom)
+{
+    if (custom->use_df) {
+        return (entropy_nbytes <= CCDRBG_MAX_ENTROPY_SIZE) && (entropy_nbytes >= custom->keylen);
+    }
+    return entropy_nbytes == seedlen(custom);
+}
+
+static bool
+add_isvalid(size_t add_nbytes, const struct ccdrbg_nistctr_custom *custom)
+{
+    if (custom->use_df) {
+        return add_nbytes <= CCDRBG_MAX_ADDITIONALINPUT_SIZE;
+    }
+    return add_nbytes <= seedlen(custom);
+}
+
+// See NIST SP 800-90A, Rev. 1, 9.1 and 10.2.1.3
+static int
+init(const struct ccdrbg_info *info,
+     struct ccdrbg_state *ctx,
+     size_t entropy_nbytes,
+     const void *entropy,
+     size_t nonce_nbytes,
+     const void *nonce,
+     size_t ps_nbytes,
+     const void *ps)
+{
+    struct ccdrbg_nistctr_state *drbg_ctx = (struct ccdrbg_nistctr_state *)ctx;
+    const struct ccdrbg_nistctr_custom *custom = info->custom;
+    uint8_t seed[CCDRBG_CTR_MAX_SEEDLEN];
+
+    int status = CCDRBG_STATUS_PARAM_ERROR;
+    cc_require(custom->keylen == CCAES_KEY_SIZE_128 || custom->keylen == CCAES_KEY_SIZE_192 ||
+               custom->keylen == CCAES_KEY_SIZE_256, out);
+    cc_require(custom->ctr_info->ecb_block_size == CCDRBG_CTR_BLOCK_LENGTH, out);
+    cc_require(entropy_isvalid(entropy_nbytes, custom), out);
+    cc_require(custom->use_df ? ps_nbytes <= CCDRBG_MAX_PSINPUT_SIZE : ps_nbytes <= seedlen(custom), out);
+
+    status = CCDRBG_STATUS_OK;
+
+    drbg_ctx->custom = custom;
+    drbg_ctx->buffered_nbytes = 0;
+    cc_clear(sizeof(drbg_ctx->Key), drbg_ctx->Key);
+    cc_clear(sizeof(drbg_ctx->V), drbg_ctx->V);
+    rekey(drbg_ctx, drbg_ctx->Key);
+
+    // the nonce only goes in through the derivation function
+    struct nistctr_input inputs[3] = {
+        { entropy_nbytes, entropy },
+        { custom->use_df ? nonce_nbytes : 0, nonce },
+        { ps_nbytes, ps },
+    };
+    seed_material(drbg_ctx, 3, inputs, seed);
+    update(drbg_ctx, seed);
+
+    drbg_ctx->reseed_counter = 1;
+
+    cc_clear(sizeof(seed), seed);
+
+out:
+    return status;
+}
+
+// See NIST SP 800-90A, Rev. 1, 9.2 and 10.2.1.4
+static int
+reseed(struct ccdrbg_state *ctx, size_t entropy_nbytes, const void *entropy, size_t add_nbytes, const void *add)
+{
+    struct ccdrbg_nistctr_state *drbg_ctx = (struct ccdrbg_nistctr_state *)ctx;
+    const struct ccdrbg_nistctr_custom *custom = drbg_ctx->custom;
+    uint8_t seed[CCDRBG_CTR_MAX_SEEDLEN];
+
+    int status = CCDRBG_STATUS_PARAM_ERROR;
+    cc_require(entropy_isvalid(entropy_nbytes, custom), out);
+    cc_require(add_isvalid(add_nbytes, custom), out);
+
+    status = CCDRBG_STATUS_OK;
+
+    // keystream drawn before the reseed must not come out after it
+    cc_clear(buffer_size(custom), NISTCTR_BUFFER(drbg_ctx));
+    drbg_ctx->buffered_nbytes = 0;
+
+    struct nistctr_input inputs[2] = {
+        { entropy_nbytes, entropy },
+        { add_nbytes, add },
+    };
+    seed_material(drbg_ctx, 2, inputs, seed);
+    update(drbg_ctx, seed);
+
+    drbg_ctx->reseed_counter = 1;
+
+    cc_clear(sizeof(seed), seed);
+
+out:
+    return status;
+}
+
+// See NIST SP 800-90A, Rev. 1, 9.3 and 10.2.1.5
+static int
+generate_blocks(struct ccdrbg_nistctr_state *drbg_ctx, size_t out_nbytes, void *out, size_t add_nbytes, const void *add)
+{
+    const struct ccdrbg_nistctr_custom *custom = drbg_ctx->custom;
+    uint8_t add_input[CCDRBG_CTR_MAX_SEEDLEN] = { 0 };
+    uint8_t ctr[CCDRBG_CTR_BLOCK_LENGTH];
+
+    int status = CCDRBG_STATUS_PARAM_ERROR;
+    cc_require(out_nbytes <= CCDRBG_MAX_REQUEST_SIZE, out);
+    cc_require(add_isvalid(add_nbytes, custom), out);
+
+    status = CCDRBG_STATUS_NEED_RESEED;
+    cc_require(drbg_ctx->reseed_counter <= CCDRBG_RESEED_INTERVAL || !custom->strictFIPS, out);
+
+    status = CCDRBG_STATUS_OK;
+
+    if (add_nbytes > 0) {
+        struct nistctr_input input = { add_nbytes, add };
+        seed_material(drbg_ctx, 1, &input, add_input);
+        update(drbg_ctx, add_input);
+    }
+
+    // the whole request is one run of counter blocks from V + 1
+    cc_memcpy(ctr, drbg_ctx->V, sizeof(ctr));
+    ctr_add(ctr, 1);
+    keystream(drbg_ctx, ctr, out_nbytes, out);
+    ctr_add(drbg_ctx->V, (out_nbytes + CCDRBG_CTR_BLOCK_LENGTH - 1) / CCDRBG_CTR_BLOCK_LENGTH);
+
+    update(drbg_ctx, add_input);
+
+    drbg_ctx->reseed_counter += 1;
+
+    cc_clear(sizeof(add_input), add_input);
+
+out:
+    return status;
+}
+
+static int
+generate(struct ccdrbg_state *ctx, size_t out_nbytes, void *out, size_t add_nbytes, const void *add)
+{
+    struct ccdrbg_nistctr_state *drbg_ctx = (struct ccdrbg_nistctr_state *)ctx;
+    size_t buf_nbytes = buffer_size(drbg_ctx->custom);
+    uint8_t *buf = NISTCTR_BUFFER(drbg_ctx);
+    uint8_t *out_bytes = out;
+
+    if (add_nbytes > 0 || out_nbytes >= buf_nbytes) {
+        return generate_blocks(drbg_ctx, out_nbytes, out, add_nbytes, add);
+    }
+
+    // small requests are cut from one larger generate, each byte handed out once
+    while (out_nbytes > 0) {
+        if (drbg_ctx->buffered_nbytes == 0) {
+            int status = generate_blocks(drbg_ctx, buf_nbytes, buf, 0, NULL);
+            if (status) {
+                return status;
+            }
+            drbg_ctx->buffered_nbytes = buf_nbytes;
+        }
+
+        size_t n = CC_MIN(out_nbytes, drbg_ctx->buffered_nbytes);
+        uint8_t *p = buf + buf_nbytes - drbg_ctx->buffered_nbytes;
+
+        cc_memcpy(out_bytes, p, n);
+        cc_clear(n, p);
+        drbg_ctx->buffered_nbytes -= n;
+
+        out_bytes += n;
+        out_nbytes -= n;
+    }
 
-    /* */
     return CCDRBG_STATUS_OK;
 }
 
 void ccdrbg_factory_nistctr(struct ccdrbg_info *info, const struct ccdrbg_nistctr_custom *custom)
 {
-    cc_abort("incomplete NIST CTR based DRBG - aborting in the event that it is ever called\n");
-    info->size = sizeof(struct ccdrbg_nistctr_state) + sizeof(struct ccdrbg_nistctr_custom);
-
+    info->size = context_size(custom);
+    info->init = init;
+    info->generate = generate;
+    info->reseed = reseed;
     info->done = done;
+    info->custom = custom;
 }
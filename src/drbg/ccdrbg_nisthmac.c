@@ -36,6 +36,7 @@
 
 #include <corecrypto/cc_macros.h>
 #include <corecrypto/cc_priv.h>
+#include <corecrypto/ccdigest_priv.h>
 #include <corecrypto/ccdrbg.h>
 #include <corecrypto/cchmac.h>
 #include <corecrypto/ccsha2.h>
@@ -52,6 +53,8 @@
 // - B.2 HMAC_DRBGExample
 
 #define NISTHMAC_MAX_OUTPUT_SIZE (CCSHA512_OUTPUT_SIZE)
+#define NISTHMAC_MAX_STATE_SIZE (CCSHA512_STATE_SIZE)
+#define NISTHMAC_MAX_BLOCK_SIZE (CCSHA512_BLOCK_SIZE)
 
 #define MIN_REQ_ENTROPY(di) ((di)->output_size / 2)
 
@@ -60,8 +63,12 @@ struct ccdrbg_nisthmac_state {
     uint8_t key[NISTHMAC_MAX_OUTPUT_SIZE];
     uint8_t V[NISTHMAC_MAX_OUTPUT_SIZE];
     uint64_t reseed_counter;
+    // Key prepared once per update(), every HMAC until the next update() starts from it
+    cc_unit hmac_key[ccn_nof_size(cchmac_key_size(NISTHMAC_MAX_STATE_SIZE))];
 };
 
+#define NISTHMAC_KEY(drbg_ctx) ((cchmac_key_t)(drbg_ctx)->hmac_key)
+
 #define DRBG_NISTHMAC_DEBUG 0
 
 #if DRBG_NISTHMAC_DEBUG
@@ -97,7 +104,7 @@ update(struct ccdrbg_state *ctx, unsigned ndata, ...)
     cchmac_di_decl(info, hmac_ctx);
 
     for (uint8_t b = 0; b < 2; b += 1) {
-        cchmac_init(info, hmac_ctx, outlen, drbg_ctx->key);
+        cchmac_init_with_key(info, hmac_ctx, NISTHMAC_KEY(drbg_ctx));
 
         cchmac_update(info, hmac_ctx, outlen, drbg_ctx->V);
 
@@ -118,7 +125,9 @@ update(struct ccdrbg_state *ctx, unsigned ndata, ...)
 
         cchmac_final(info, hmac_ctx, drbg_ctx->key);
 
-        cchmac(info, outlen, drbg_ctx->key, outlen, drbg_ctx->V, drbg_ctx->V);
+        cchmac_key_init(info, NISTHMAC_KEY(drbg_ctx), outlen, drbg_ctx->key);
+
+        cchmac_with_key(info, NISTHMAC_KEY(drbg_ctx), outlen, drbg_ctx->V, drbg_ctx->V);
 
         if (data_nbytes == 0) {
             break;
@@ -152,6 +161,7 @@ init(const struct ccdrbg_info *info,
 
     int status = CCDRBG_STATUS_PARAM_ERROR;
     cc_require(outlen <= NISTHMAC_MAX_OUTPUT_SIZE, out);
+    cc_require(digest_info->state_size <= NISTHMAC_MAX_STATE_SIZE, out);
     cc_require(entropy_isvalid(entropy_nbytes, digest_info), out);
     cc_require(ps_nbytes <= CCDRBG_MAX_PSINPUT_SIZE, out);
 
@@ -159,6 +169,7 @@ init(const struct ccdrbg_info *info,
 
     cc_memset(drbg_ctx->key, 0, outlen);
     cc_memset(drbg_ctx->V, 1, outlen);
+    cchmac_key_init(digest_info, NISTHMAC_KEY(drbg_ctx), outlen, drbg_ctx->key);
 
     update(ctx, 3, entropy_nbytes, entropy, nonce_nbytes, nonce, ps_nbytes, ps);
 
@@ -195,55 +206,129 @@ out:
     return status;
 }
 
-// See NIST SP 800-90A, Rev. 1, 9.3 and 10.1.2.5
+// See FIPS 140-2, 4.9.2 Conditional Tests
 static int
-generate(struct ccdrbg_state *ctx, size_t out_nbytes, void *out, size_t add_nbytes, const void *add)
+check_V(struct ccdrbg_state *ctx, const uint8_t *Vnext)
+{
+    struct ccdrbg_nisthmac_state *drbg_ctx = (struct ccdrbg_nisthmac_state *)ctx;
+    size_t outlen = drbg_ctx->custom->di->output_size;
+
+    if (cc_cmp_safe(outlen, drbg_ctx->V, Vnext) == 0) {
+        done(ctx);
+        cc_try_abort(NULL);
+        return CCDRBG_STATUS_ABORT;
+    }
+
+    cc_memcpy(drbg_ctx->V, Vnext, outlen);
+    return CCDRBG_STATUS_OK;
+}
+
+// V = HMAC(Key, V) for every outlen bytes of output, with the generic HMAC
+static int
+generate_hmac(struct ccdrbg_state *ctx, size_t out_nbytes, uint8_t *out)
 {
     struct ccdrbg_nisthmac_state *drbg_ctx = (struct ccdrbg_nisthmac_state *)ctx;
     const struct ccdigest_info *info = drbg_ctx->custom->di;
     size_t outlen = info->output_size;
+    uint8_t Vnext[NISTHMAC_MAX_OUTPUT_SIZE];
+    int status = CCDRBG_STATUS_OK;
 
-    int status = CCDRBG_STATUS_PARAM_ERROR;
-    cc_require(out_nbytes <= CCDRBG_MAX_REQUEST_SIZE, out);
-    cc_require(add_isvalid(add_nbytes), out);
+    while (out_nbytes > 0) {
+        cchmac_with_key(info, NISTHMAC_KEY(drbg_ctx), outlen, drbg_ctx->V, Vnext);
 
-    status = CCDRBG_STATUS_NEED_RESEED;
-    cc_require(drbg_ctx->reseed_counter <= CCDRBG_RESEED_INTERVAL || !drbg_ctx->custom->strictFIPS, out);
+        status = check_V(ctx, Vnext);
+        if (status) {
+            break;
+        }
 
-    status = CCDRBG_STATUS_OK;
+        size_t n = CC_MIN(out_nbytes, outlen);
+        cc_memcpy(out, drbg_ctx->V, n);
 
-    if (add_nbytes > 0) {
-        update(ctx, 1, add_nbytes, add);
+        out += n;
+        out_nbytes -= n;
     }
 
-    uint8_t *out_bytes = out;
-    uint8_t Vprev[NISTHMAC_MAX_OUTPUT_SIZE];
+    cc_clear(sizeof(Vnext), Vnext);
+    return status;
+}
+
+// Same, but both HMAC messages are a single block after the key pads: V, then the
+// inner digest. Their padding is written once, V and the digest go straight into
+// the blocks, and each V costs exactly two compressions off the key midstates.
+static int
+generate_blocks(struct ccdrbg_state *ctx, const struct ccdigest_md_format *fmt, size_t out_nbytes, uint8_t *out)
+{
+    struct ccdrbg_nisthmac_state *drbg_ctx = (struct ccdrbg_nisthmac_state *)ctx;
+    const struct ccdigest_info *info = drbg_ctx->custom->di;
+    cchmac_key_t hk = NISTHMAC_KEY(drbg_ctx);
+    size_t outlen = info->output_size;
+    uint64_t s[NISTHMAC_MAX_STATE_SIZE / 8];
+    uint8_t inner[NISTHMAC_MAX_BLOCK_SIZE];
+    uint8_t outer[NISTHMAC_MAX_BLOCK_SIZE];
+    int status = CCDRBG_STATUS_OK;
+
+    ccdigest_md_pad_block(info, fmt, outlen, inner);
+    ccdigest_md_pad_block(info, fmt, outlen, outer);
+    cc_memcpy(inner, drbg_ctx->V, outlen);
 
     while (out_nbytes > 0) {
-        cc_memcpy(Vprev, drbg_ctx->V, outlen);
-        cchmac(info, outlen, drbg_ctx->key, outlen, drbg_ctx->V, drbg_ctx->V);
-
-        // See FIPS 140-2, 4.9.2 Conditional Tests
-        if (cc_cmp_safe(outlen, Vprev, drbg_ctx->V) == 0) {
-            done(ctx);
-            status = CCDRBG_STATUS_ABORT;
-            cc_try_abort(NULL);
-            goto out;
+        ccdigest_copy_state(info, s, cchmac_key_istate(info, hk));
+        info->compress((ccdigest_state_t)s, 1, inner);
+        ccdigest_md_store(fmt, outlen, s, outer);
+
+        ccdigest_copy_state(info, s, cchmac_key_ostate(info, hk));
+        info->compress((ccdigest_state_t)s, 1, outer);
+        ccdigest_md_store(fmt, outlen, s, inner);
+
+        status = check_V(ctx, inner);
+        if (status) {
+            break;
         }
 
         size_t n = CC_MIN(out_nbytes, outlen);
-        cc_memcpy(out_bytes, drbg_ctx->V, n);
+        cc_memcpy(out, drbg_ctx->V, n);
 
-        out_bytes += n;
+        out += n;
         out_nbytes -= n;
     }
 
+    cc_clear(sizeof(s), s);
+    cc_clear(sizeof(inner), inner);
+    cc_clear(sizeof(outer), outer);
+    return status;
+}
+
+// See NIST SP 800-90A, Rev. 1, 9.3 and 10.1.2.5
+static int
+generate(struct ccdrbg_state *ctx, size_t out_nbytes, void *out, size_t add_nbytes, const void *add)
+{
+    struct ccdrbg_nisthmac_state *drbg_ctx = (struct ccdrbg_nisthmac_state *)ctx;
+    const struct ccdigest_info *info = drbg_ctx->custom->di;
+    struct ccdigest_md_format fmt;
+
+    int status = CCDRBG_STATUS_PARAM_ERROR;
+    cc_require(out_nbytes <= CCDRBG_MAX_REQUEST_SIZE, out);
+    cc_require(add_isvalid(add_nbytes), out);
+
+    status = CCDRBG_STATUS_NEED_RESEED;
+    cc_require(drbg_ctx->reseed_counter <= CCDRBG_RESEED_INTERVAL || !drbg_ctx->custom->strictFIPS, out);
+
+    if (add_nbytes > 0) {
+        update(ctx, 1, add_nbytes, add);
+    }
+
+    if (ccdigest_md_format(info, &fmt)) {
+        status = generate_blocks(ctx, &fmt, out_nbytes, out);
+    } else {
+        status = generate_hmac(ctx, out_nbytes, out);
+    }
+    cc_require(status == CCDRBG_STATUS_OK, out);
+
     update(ctx, 1, add_nbytes, add);
 
     drbg_ctx->reseed_counter += 1;
 
 out:
-    cc_clear(outlen, Vprev);
     return status;
 }
 
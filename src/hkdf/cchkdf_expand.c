@@ -31,53 +31,40 @@ int cchkdf_expand(struct ccdigest_info *di, size_t prk_len, const void *prk,
                   size_t derived_len, void *derived_key)
 {
     uint8_t T[di->output_size];
+    uint8_t *out = derived_key;
     size_t n = cc_ceiling(derived_len, di->output_size);
     size_t Tlength = 0;
-    size_t finalBytes = derived_len - (n * di->output_size);
-    size_t finalBytesOffset = derived_len - finalBytes;
     cchmac_di_decl(di, hmac);
-    cchmac_di_decl(di, hmac_initial);
+    cchmac_key_decl(di, hmac_key);
 
     if (n > 255) {
         return CCERR_PARAMETER;
-    } else if (prk_len < di->output_size) {
-
     }
 
-    // i'm actually glad that HMAC ops can be split up into different function calls
-    cchmac_init(di, hmac_initial, prk_len, prk);
+    // the PRK is the HMAC key of every block, so its pads are only compressed once
+    cchmac_key_init(di, hmac_key, prk_len, prk);
 
     for (size_t i = 1; i <= n; i++) {
         uint8_t ctr = (uint8_t)i;
+        size_t nbytes = CC_MIN(derived_len, di->output_size);
 
-        cc_memcpy(hmac, hmac_initial, cchmac_di_size(di));
+        cchmac_init_with_key(di, hmac, hmac_key);
 
-        // update using the contents of T first.
+        // T(i) = HMAC(PRK, T(i-1) | info | i)
         cchmac_update(di, hmac, Tlength, T);
-
-        // then; update using the info string
         cchmac_update(di, hmac, info_len, info);
-
-        // and then do the 'counter' field.
         cchmac_update(di, hmac, 1, &ctr);
-
-        // generate the MAC
         cchmac_final(di, hmac, T);
 
-        // that is a piece of our key; copy to derived_key and 'push' the pointer forward
-        if (i == n) {
-            cc_memcpy(derived_key, T, finalBytes);
-        } else {
-            cc_memcpy(derived_key, T, di->output_size);
-        }
+        cc_memcpy(out, T, nbytes);
+        out += nbytes;
+        derived_len -= nbytes;
 
         Tlength = di->output_size;
-
-        derived_key += di->output_size;
     }
 
-    cc_clear(cchmac_di_size(di), hmac);
-    cc_clear(cchmac_di_size(di), hmac_initial);
+    cchmac_di_clear(di, hmac);
+    cchmac_key_clear(di, hmac_key);
     cc_clear(di->output_size, T);
 
     return CCERR_OK;
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccdigest_priv.h>
+#include <corecrypto/cchmac.h>
+
+void cchmac_key_init(const struct ccdigest_info *di, cchmac_key_t hk,
+                     size_t key_len, const void *key)
+{
+    cchmac_di_decl(di, hc);
+
+    cchmac_init(di, hc, key_len, key);
+    ccdigest_copy_state(di, cchmac_key_istate(di, hk), cchmac_istate(di, hc));
+    ccdigest_copy_state(di, cchmac_key_ostate(di, hk), cchmac_ostate(di, hc));
+
+    cchmac_di_clear(di, hc);
+}
+
+void cchmac_init_with_key(const struct ccdigest_info *di, cchmac_ctx_t hc,
+                          const cchmac_key_t hk)
+{
+    ccdigest_copy_state(di, cchmac_istate(di, hc), cchmac_key_istate(di, hk));
+    ccdigest_copy_state(di, cchmac_ostate(di, hc), cchmac_key_ostate(di, hk));
+    cchmac_num(di, hc) = 0;
+    cchmac_nbits(di, hc) = di->block_size * 8;
+}
+
+void cchmac_with_key(const struct ccdigest_info *di, const cchmac_key_t hk,
+                     size_t data_len, const void *data, unsigned char *mac)
+{
+    cchmac_di_decl(di, hc);
+
+    cchmac_init_with_key(di, hc, hk);
+    cchmac_update(di, hc, data_len, data);
+    cchmac_final(di, hc, mac);
+
+    cchmac_di_clear(di, hc);
+}
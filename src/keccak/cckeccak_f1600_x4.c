@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "cckeccak_internal.h"
+#include <corecrypto/cc_runtime_config.h>
+
+#if CCKECCAK_X4_SIMD
+
+/* one vector element per state; without AVX2 the compiler splits each op in two SSE2/NEON ones */
+#define CCKECCAK_F1600_X4(fn, attr)                                                 \
+    attr static void fn(struct cckeccak_state_x4 *states)                           \
+    {                                                                               \
+        typedef uint64_t vec __attribute__((vector_size(32), may_alias));           \
+        vec *lanes = (vec *)states->state;                                          \
+        CCKECCAK_DECLARE(vec);                                                      \
+                                                                                    \
+        CCKECCAK_LOAD(A, lanes);                                                    \
+        CCKECCAK_PERMUTE(cckeccak_round_constants);                                 \
+        CCKECCAK_STORE(A, lanes);                                                   \
+    }
+
+CCKECCAK_F1600_X4(cckeccak_f1600_x4_vec, )
+
+#if CCKECCAK_X4_AVX2
+CCKECCAK_F1600_X4(cckeccak_f1600_x4_avx2, __attribute__((target("avx2"))))
+#endif
+
+#endif /* CCKECCAK_X4_SIMD */
+
+void cckeccak_f1600_x4(struct cckeccak_state_x4 *states)
+{
+#if CCKECCAK_X4_AVX2
+    if (CC_HAS_AVX2()) {
+        cckeccak_f1600_x4_avx2(states);
+        return;
+    }
+#endif
+#if CCKECCAK_X4_SIMD
+    cckeccak_f1600_x4_vec(states);
+#else
+    struct cckeccak_state s;
+    size_t i, j;
+
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 25; i++) {
+            s.state[i] = states->state[i][j];
+        }
+        cckeccak_f1600_c(&s);
+        for (i = 0; i < 25; i++) {
+            states->state[i][j] = s.state[i];
+        }
+    }
+    cc_clear(sizeof(s), &s);
+#endif
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#ifndef _CORECRYPTO_CCKECCAK_INTERNAL_H_
+#define _CORECRYPTO_CCKECCAK_INTERNAL_H_
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cckeccak.h>
+
+/*
+ * Keccak-f[1600] round, fully unrolled over the 25 lanes and shared between
+ * the scalar permutation and the 4-way vector one. T only needs ~, ^, &, |,
+ * << and >>, so it works for uint64_t and GCC/clang vector types alike.
+ *
+ * Lanes are named by row (b, g, k, m, s = y 0..4) and column (a, e, i, o, u =
+ * x 0..4). Lanes 1, 2, 8, 12, 17 and 20 are kept complemented while the
+ * rounds run ("lane complementing"), which turns most of the ANDNs in chi into
+ * plain ANDs/ORs; CCKECCAK_LOAD and CCKECCAK_STORE apply the mask.
+ */
+
+#define CCKECCAK_NROUNDS 24
+
+/* the 4-way permutation uses GCC/clang vector extensions, AVX2 only where cc_runtime_config.h can probe for it */
+#if defined(__GNUC__) || defined(__clang__)
+#define CCKECCAK_X4_SIMD 1
+#else
+#define CCKECCAK_X4_SIMD 0
+#endif
+
+#if CCKECCAK_X4_SIMD && defined(__x86_64__) && (CCSHA1_VNG_INTEL || CCSHA2_VNG_INTEL || CCAES_INTEL_ASM)
+#define CCKECCAK_X4_AVX2 1
+#else
+#define CCKECCAK_X4_AVX2 0
+#endif
+
+extern const uint64_t cckeccak_round_constants[CCKECCAK_NROUNDS];
+
+#define CCKECCAK_ROL(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+#define CCKECCAK_DECLARE(T)     \
+    T Aba, Abe, Abi, Abo, Abu;  \
+    T Aga, Age, Agi, Ago, Agu;  \
+    T Aka, Ake, Aki, Ako, Aku;  \
+    T Ama, Ame, Ami, Amo, Amu;  \
+    T Asa, Ase, Asi, Aso, Asu;  \
+    T Eba, Ebe, Ebi, Ebo, Ebu;  \
+    T Ega, Ege, Egi, Ego, Egu;  \
+    T Eka, Eke, Eki, Eko, Eku;  \
+    T Ema, Eme, Emi, Emo, Emu;  \
+    T Esa, Ese, Esi, Eso, Esu;  \
+    T Ba, Be, Bi, Bo, Bu;       \
+    T Ca, Ce, Ci, Co, Cu;       \
+    T Da, De, Di, Do, Du
+
+#define CCKECCAK_LOAD(A, L)  \
+    A##ba = (L)[0];          \
+    A##be = ~(L)[1];         \
+    A##bi = ~(L)[2];         \
+    A##bo = (L)[3];          \
+    A##bu = (L)[4];          \
+    A##ga = (L)[5];          \
+    A##ge = (L)[6];          \
+    A##gi = (L)[7];          \
+    A##go = ~(L)[8];         \
+    A##gu = (L)[9];          \
+    A##ka = (L)[10];         \
+    A##ke = (L)[11];         \
+    A##ki = ~(L)[12];        \
+    A##ko = (L)[13];         \
+    A##ku = (L)[14];         \
+    A##ma = (L)[15];         \
+    A##me = (L)[16];         \
+    A##mi = ~(L)[17];        \
+    A##mo = (L)[18];         \
+    A##mu = (L)[19];         \
+    A##sa = ~(L)[20];        \
+    A##se = (L)[21];         \
+    A##si = (L)[22];         \
+    A##so = (L)[23];         \
+    A##su = (L)[24]
+
+#define CCKECCAK_STORE(A, L)  \
+    (L)[0] = A##ba;           \
+    (L)[1] = ~A##be;          \
+    (L)[2] = ~A##bi;          \
+    (L)[3] = A##bo;           \
+    (L)[4] = A##bu;           \
+    (L)[5] = A##ga;           \
+    (L)[6] = A##ge;           \
+    (L)[7] = A##gi;           \
+    (L)[8] = ~A##go;          \
+    (L)[9] = A##gu;           \
+    (L)[10] = A##ka;          \
+    (L)[11] = A##ke;          \
+    (L)[12] = ~A##ki;         \
+    (L)[13] = A##ko;          \
+    (L)[14] = A##ku;          \
+    (L)[15] = A##ma;          \
+    (L)[16] = A##me;          \
+    (L)[17] = ~A##mi;         \
+    (L)[18] = A##mo;          \
+    (L)[19] = A##mu;          \
+    (L)[20] = ~A##sa;         \
+    (L)[21] = A##se;          \
+    (L)[22] = A##si;          \
+    (L)[23] = A##so;          \
+    (L)[24] = A##su
+
+#define CCKECCAK_ROUND(A, E, rc)                 \
+    Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa;  \
+    Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se;  \
+    Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si;  \
+    Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so;  \
+    Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su;  \
+    Da = Cu ^ CCKECCAK_ROL(Ce, 1);               \
+    De = Ca ^ CCKECCAK_ROL(Ci, 1);               \
+    Di = Ce ^ CCKECCAK_ROL(Co, 1);               \
+    Do = Ci ^ CCKECCAK_ROL(Cu, 1);               \
+    Du = Co ^ CCKECCAK_ROL(Ca, 1);               \
+    Ba = A##ba ^ Da;                             \
+    Be = CCKECCAK_ROL(A##ge ^ De, 44);           \
+    Bi = CCKECCAK_ROL(A##ki ^ Di, 43);           \
+    Bo = CCKECCAK_ROL(A##mo ^ Do, 21);           \
+    Bu = CCKECCAK_ROL(A##su ^ Du, 14);           \
+    E##ba = Ba ^ (Be | Bi);                      \
+    E##be = Be ^ (~Bi | Bo);                     \
+    E##bi = Bi ^ (Bo & Bu);                      \
+    E##bo = Bo ^ (Bu | Ba);                      \
+    E##bu = Bu ^ (Ba & Be);                      \
+    E##ba ^= (rc);                               \
+    Ba = CCKECCAK_ROL(A##bo ^ Do, 28);           \
+    Be = CCKECCAK_ROL(A##gu ^ Du, 20);           \
+    Bi = CCKECCAK_ROL(A##ka ^ Da, 3);            \
+    Bo = CCKECCAK_ROL(A##me ^ De, 45);           \
+    Bu = CCKECCAK_ROL(A##si ^ Di, 61);           \
+    E##ga = Ba ^ (Be | Bi);                      \
+    E##ge = Be ^ (Bi & Bo);                      \
+    E##gi = Bi ^ (Bo | ~Bu);                     \
+    E##go = Bo ^ (Bu | Ba);                      \
+    E##gu = Bu ^ (Ba & Be);                      \
+    Ba = CCKECCAK_ROL(A##be ^ De, 1);            \
+    Be = CCKECCAK_ROL(A##gi ^ Di, 6);            \
+    Bi = CCKECCAK_ROL(A##ko ^ Do, 25);           \
+    Bo = CCKECCAK_ROL(A##mu ^ Du, 8);            \
+    Bu = CCKECCAK_ROL(A##sa ^ Da, 18);           \
+    E##ka = Ba ^ (Be | Bi);                      \
+    E##ke = Be ^ (Bi & Bo);                      \
+    E##ki = Bi ^ (~Bo & Bu);                     \
+    E##ko = ~Bo ^ (Bu | Ba);                     \
+    E##ku = Bu ^ (Ba & Be);                      \
+    Ba = CCKECCAK_ROL(A##bu ^ Du, 27);           \
+    Be = CCKECCAK_ROL(A##ga ^ Da, 36);           \
+    Bi = CCKECCAK_ROL(A##ke ^ De, 10);           \
+    Bo = CCKECCAK_ROL(A##mi ^ Di, 15);           \
+    Bu = CCKECCAK_ROL(A##so ^ Do, 56);           \
+    E##ma = Ba ^ (Be & Bi);                      \
+    E##me = Be ^ (Bi | Bo);                      \
+    E##mi = Bi ^ (~Bo | Bu);                     \
+    E##mo = ~Bo ^ (Bu & Ba);                     \
+    E##mu = Bu ^ (Ba | Be);                      \
+    Ba = CCKECCAK_ROL(A##bi ^ Di, 62);           \
+    Be = CCKECCAK_ROL(A##go ^ Do, 55);           \
+    Bi = CCKECCAK_ROL(A##ku ^ Du, 39);           \
+    Bo = CCKECCAK_ROL(A##ma ^ Da, 41);           \
+    Bu = CCKECCAK_ROL(A##se ^ De, 2);            \
+    E##sa = Ba ^ (~Be & Bi);                     \
+    E##se = ~Be ^ (Bi | Bo);                     \
+    E##si = Bi ^ (Bo & Bu);                      \
+    E##so = Bo ^ (Bu | Ba);                      \
+    E##su = Bu ^ (Ba & Be)
+
+/* two rounds per step so the A and E sets swap back without copies */
+#define CCKECCAK_PERMUTE(rc)                                        \
+    do {                                                            \
+        int _round;                                                 \
+        for (_round = 0; _round < CCKECCAK_NROUNDS; _round += 2) {  \
+            CCKECCAK_ROUND(A, E, (rc)[_round]);                     \
+            CCKECCAK_ROUND(E, A, (rc)[_round + 1]);                 \
+        }                                                           \
+    } while (0)
+
+/* lanes are little-endian, so byte i of the rate is byte i % 8 of lane i / 8 */
+CC_INLINE void cckeccak_xor_bytes(struct cckeccak_state *s, size_t offset, size_t nbytes, const uint8_t *in)
+{
+    size_t i;
+
+    for (i = 0; i < nbytes; i++) {
+        s->state[(offset + i) / 8] ^= (uint64_t)in[i] << (8 * ((offset + i) % 8));
+    }
+}
+
+CC_INLINE void cckeccak_extract_bytes(const struct cckeccak_state *s, size_t offset, size_t nbytes, uint8_t *out)
+{
+    size_t i;
+
+    for (i = 0; i < nbytes; i++) {
+        out[i] = (uint8_t)(s->state[(offset + i) / 8] >> (8 * ((offset + i) % 8)));
+    }
+}
+
+#endif /* _CORECRYPTO_CCKECCAK_INTERNAL_H_ */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "cckeccak_internal.h"
+#include <corecrypto/cc_error.h>
+
+int cckeccak_init_state(cckeccak_state_t state)
+{
+    cc_clear(sizeof(*state), state);
+    return CCERR_OK;
+}
+
+cckeccak_permutation cckeccak_get_permutation(void)
+{
+    /* the unrolled C round is what every target gets for now */
+    return cckeccak_f1600_c;
+}
+
+void cckeccak_absorb_blocks(cckeccak_state_t state, size_t rate, size_t nblocks, const void *data, cckeccak_permutation permutation)
+{
+    const uint8_t *p = data;
+    uint64_t w;
+    size_t i;
+
+    while (nblocks--) {
+        for (i = 0; i < rate / 8; i++) {
+            CC_LOAD64_LE(w, p + 8 * i);
+            state->state[i] ^= w;
+        }
+        permutation(state);
+        p += rate;
+    }
+}
+
+void cckeccak_absorb_and_pad(cckeccak_state_t state, size_t rate, size_t nbytes, const void *data, uint8_t padding)
+{
+    uint8_t last = 0x80;
+
+    cckeccak_xor_bytes(state, 0, nbytes, data);
+    cckeccak_xor_bytes(state, nbytes, 1, &padding);
+    cckeccak_xor_bytes(state, rate - 1, 1, &last);
+}
+
+void cckeccak_squeeze(cckeccak_state_t state, size_t rate, size_t nbytes, void *out, cckeccak_permutation permutation)
+{
+    uint8_t *p = out;
+    size_t i, n;
+
+    while (nbytes > 0) {
+        permutation(state);
+        n = CC_MIN(nbytes, rate);
+        for (i = 0; i + 8 <= n; i += 8) {
+            CC_STORE64_LE(state->state[i / 8], p + i);
+        }
+        cckeccak_extract_bytes(state, i, n - i, p + i);
+        p += n;
+        nbytes -= n;
+    }
+}
@@ -1,8 +0,0 @@
-//
-//  pdckeccak.c
-//  corecrypto
-//
-//  Created by Zormeister on 21/1/2025.
-//
-
-#include "pdckeccak.h"
@@ -1,5 +1,8 @@
-#include "yarrow/yarrow.h"
 #include <corecrypto/cckprng.h>
+
+#if CCKPRNG_YARROW
+
+#include "yarrow/yarrow.h"
 #include <corecrypto/ccrng.h>
 #include <stddef.h>
 #if !KERNEL
@@ -53,6 +56,13 @@ void cckprng_generate(struct cckprng_ctx *ctx, unsigned gen_idx, size_t nbytes,
     }
 }
 
+void cckprng_done(struct cckprng_ctx *ctx)
+{
+    prngDestroy(ctx->prng);
+    ctx->prng = NULL;
+    ctx->bytes_generated = ctx->bytes_since_entropy = 0;
+}
+
 // MARK: -
 
 /*
@@ -80,3 +90,5 @@ struct ccrng_state *ccrng(int *error) {
 }
 
 */
+
+#endif /* CCKPRNG_YARROW */
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cckprng.h>
+
+#if !CCKPRNG_YARROW
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccaes.h>
+#include <corecrypto/cchmac.h>
+#include <corecrypto/ccmode.h>
+#include <corecrypto/ccsha2.h>
+
+#include "cckprng_internal.h"
+
+/*
+ * Fortuna-style PRNG. Entropy read from the external buffer is hashed into
+ * one of CCKPRNG_NPOOLS SHA-256 pools in turn. Once pool 0 has seen
+ * CCKPRNG_RESEED_NSAMPLES samples, the scheduler folds pool i into the master
+ * seed on every 2^i-th reseed. Each output generator runs AES-256 in counter
+ * mode under its own key, which is replaced by fresh keystream after every
+ * request. A reseed derives a new key per generator from the seed and parks
+ * it in the idle slot; the generator swaps it in on its next request.
+ */
+
+static void cckprng_derive_key(const struct cckprng_ctx *ctx, unsigned gen_idx, uint8_t *key)
+{
+    uint8_t idx[4];
+
+    CC_STORE32_LE(gen_idx, idx);
+    cchmac(ccsha256_di(), sizeof(ctx->seed), ctx->seed, sizeof(idx), idx, key);
+}
+
+/* shared lock held */
+static void cckprng_rekey(struct cckprng_ctx *ctx)
+{
+    uint8_t key[CCKPRNG_KEY_NBYTES];
+
+    for (unsigned i = 0; i < ctx->max_ngens; i++) {
+        struct cckprng_gen_ctx *gen = &ctx->gens[i];
+
+        if (!gen->init) {
+            continue;
+        }
+
+        cckprng_derive_key(ctx, i, key);
+
+        cckprng_lock(&gen->lock.mutex);
+        cc_memcpy(gen->keys[gen->key_idle_idx].data, key, sizeof(key));
+        atomic_store(&gen->swap, 1);
+        ctx->diag.gens[i].nrekeys += 1;
+        cckprng_unlock(&gen->lock.mutex);
+    }
+
+    cc_clear(sizeof(key), key);
+}
+
+/* shared lock held */
+static void cckprng_addentropy(struct cckprng_ctx *ctx)
+{
+    const struct ccdigest_info *di = ccsha256_di();
+    struct cckprng_entropybuf *ebuf = &ctx->entropybuf;
+    uint32_t nsamples = *ebuf->nsamples;
+    uint32_t delta = nsamples - ebuf->nsamples_last;
+
+    if (delta == 0) {
+        return;
+    }
+    ebuf->nsamples_last = nsamples;
+
+    unsigned pool_idx = ctx->sched.pool_idx;
+    struct cckprng_pool_ctx *pool = &ctx->pools[pool_idx];
+    struct cckprng_pool_diag *pdiag = &ctx->diag.pools[pool_idx];
+
+    ccdigest_di_decl(di, dc);
+    ccdigest_init(di, dc);
+    ccdigest_update(di, dc, sizeof(pool->data), pool->data);
+    ccdigest_update(di, dc, ebuf->nbytes, ebuf->buf);
+    ccdigest_final(di, dc, pool->data);
+    ccdigest_di_clear(di, dc);
+
+    pdiag->nsamples += delta;
+    pdiag->nsamples_max = CC_MAX(pdiag->nsamples_max, pdiag->nsamples);
+    ctx->diag.addentropy_nsamples_max = CC_MAX(ctx->diag.addentropy_nsamples_max, (uint64_t)delta);
+
+    ctx->sched.pool_idx = (pool_idx + 1) % CCKPRNG_NPOOLS;
+}
+
+/* shared lock held */
+static void cckprng_schedreseed(struct cckprng_ctx *ctx)
+{
+    const struct ccdigest_info *di = ccsha256_di();
+    uint64_t sched = ++ctx->sched.reseed_sched;
+    uint64_t nsamples = 0;
+
+    ccdigest_di_decl(di, dc);
+    ccdigest_init(di, dc);
+    ccdigest_update(di, dc, sizeof(ctx->seed), ctx->seed);
+
+    for (unsigned i = 0; i < CCKPRNG_NPOOLS; i++) {
+        if (sched & (((uint64_t)1 << i) - 1)) {
+            break;
+        }
+
+        struct cckprng_pool_diag *pdiag = &ctx->diag.pools[i];
+
+        ccdigest_update(di, dc, sizeof(ctx->pools[i].data), ctx->pools[i].data);
+        cc_clear(sizeof(ctx->pools[i].data), ctx->pools[i].data);
+
+        nsamples += pdiag->nsamples;
+        pdiag->nsamples = 0;
+        pdiag->ndrains += 1;
+    }
+
+    ccdigest_final(di, dc, ctx->seed);
+    ccdigest_di_clear(di, dc);
+
+    ctx->sched.reseed_last = sched;
+    ctx->diag.schedreseed_nreseeds += 1;
+    ctx->diag.schedreseed_nsamples_max = CC_MAX(ctx->diag.schedreseed_nsamples_max, nsamples);
+
+    cckprng_rekey(ctx);
+}
+
+void cckprng_init(struct cckprng_ctx *ctx,
+                  unsigned max_ngens,
+                  size_t entropybuf_nbytes,
+                  const void *entropybuf,
+                  const uint32_t *entropybuf_nsamples,
+                  size_t seed_nbytes,
+                  const void *seed,
+                  size_t nonce_nbytes,
+                  const void *nonce)
+{
+    const struct ccdigest_info *di = ccsha256_di();
+
+    cc_clear(sizeof(*ctx), ctx);
+
+    ccdigest_di_decl(di, dc);
+    ccdigest_init(di, dc);
+    ccdigest_update(di, dc, seed_nbytes, seed);
+    ccdigest_update(di, dc, nonce_nbytes, nonce);
+    ccdigest_final(di, dc, ctx->seed);
+    ccdigest_di_clear(di, dc);
+
+    cckprng_lock_init(&ctx->lock.mutex);
+
+    ctx->max_ngens = max_ngens;
+    ctx->gens = calloc(max_ngens, sizeof(*ctx->gens));
+    ctx->diag.ngens = max_ngens;
+    ctx->diag.gens = calloc(max_ngens, sizeof(*ctx->diag.gens));
+    if (max_ngens && (ctx->gens == NULL || ctx->diag.gens == NULL)) {
+        cc_abort("cckprng: cannot allocate generators");
+    }
+
+    for (unsigned i = 0; i < max_ngens; i++) {
+        cckprng_lock_init(&ctx->gens[i].lock.mutex);
+    }
+
+    // the first refresh consumes whatever the buffer already holds
+    ctx->entropybuf.buf = entropybuf;
+    ctx->entropybuf.nbytes = entropybuf_nbytes;
+    ctx->entropybuf.nsamples = entropybuf_nsamples;
+    ctx->entropybuf.nsamples_last = 0;
+}
+
+void cckprng_initgen(struct cckprng_ctx *ctx, unsigned gen_idx)
+{
+    if (gen_idx >= ctx->max_ngens) {
+        cc_abort("cckprng: generator index out of range");
+    }
+
+    struct cckprng_gen_ctx *gen = &ctx->gens[gen_idx];
+
+    cckprng_lock(&ctx->lock.mutex);
+
+    if (gen->init) {
+        cc_abort("cckprng: generator initialized twice");
+    }
+
+    cckprng_derive_key(ctx, gen_idx, gen->keys[0].data);
+    gen->key_live_idx = 0;
+    gen->key_idle_idx = 1;
+    atomic_store(&gen->swap, 0);
+    cc_clear(sizeof(gen->ctr), gen->ctr);
+    gen->init = true;
+
+    cckprng_unlock(&ctx->lock.mutex);
+}
+
+void cckprng_reseed(struct cckprng_ctx *ctx, size_t nbytes, const void *seed)
+{
+    const struct ccdigest_info *di = ccsha256_di();
+    uint8_t len[8];
+
+    CC_STORE64_LE((uint64_t)nbytes, len);
+
+    cckprng_lock(&ctx->lock.mutex);
+
+    ccdigest_di_decl(di, dc);
+    ccdigest_init(di, dc);
+    ccdigest_update(di, dc, sizeof(ctx->seed), ctx->seed);
+    ccdigest_update(di, dc, sizeof(len), len);
+    ccdigest_update(di, dc, nbytes, seed);
+    ccdigest_final(di, dc, ctx->seed);
+    ccdigest_di_clear(di, dc);
+
+    ctx->diag.userreseed_nreseeds += 1;
+    cckprng_rekey(ctx);
+
+    cckprng_unlock(&ctx->lock.mutex);
+}
+
+void cckprng_refresh(struct cckprng_ctx *ctx)
+{
+    if (!cckprng_trylock(&ctx->lock.mutex)) {
+        return;
+    }
+
+    cckprng_addentropy(ctx);
+
+    if (ctx->diag.pools[0].nsamples >= CCKPRNG_RESEED_NSAMPLES) {
+        cckprng_schedreseed(ctx);
+    }
+
+    cckprng_unlock(&ctx->lock.mutex);
+}
+
+/* big-endian add of nblocks to the 128-bit counter */
+static void cckprng_ctr_add(uint8_t *ctr, size_t nblocks)
+{
+    uint64_t carry = nblocks;
+
+    for (int i = 15; i >= 0 && carry; i--) {
+        carry += ctr[i];
+        ctr[i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+}
+
+void cckprng_generate(struct cckprng_ctx *ctx, unsigned gen_idx, size_t nbytes, void *out)
+{
+    const struct ccmode_ctr *mode = ccaes_ctr_crypt_mode();
+    uint8_t ks[CCKPRNG_GENERATE_MAX_NBYTES + CCKPRNG_KEY_NBYTES];
+
+    if (gen_idx >= ctx->max_ngens || !ctx->gens[gen_idx].init) {
+        cc_abort("cckprng: generator not initialized");
+    }
+    if (nbytes > CCKPRNG_GENERATE_MAX_NBYTES) {
+        cc_abort("cckprng: request too large");
+    }
+
+    struct cckprng_gen_ctx *gen = &ctx->gens[gen_idx];
+    struct cckprng_gen_diag *gdiag = &ctx->diag.gens[gen_idx];
+
+    // whole blocks of output, then one key's worth for the next request
+    size_t out_nblocks = (nbytes + 15) / 16;
+    size_t ks_nbytes = out_nblocks * 16 + CCKPRNG_KEY_NBYTES;
+
+    cckprng_lock(&gen->lock.mutex);
+
+    if (atomic_exchange(&gen->swap, 0)) {
+        unsigned idx = gen->key_live_idx;
+        gen->key_live_idx = gen->key_idle_idx;
+        gen->key_idle_idx = idx;
+        cc_clear(sizeof(gen->keys[idx].data), gen->keys[idx].data);
+        gdiag->out_nbytes_key = 0;
+    }
+
+    uint8_t *key = gen->keys[gen->key_live_idx].data;
+
+    ccctr_ctx_decl(mode->size, ctr);
+    cc_memset(ks, 0, ks_nbytes);
+    ccctr_init(mode, ctr, CCKPRNG_KEY_NBYTES, key, gen->ctr);
+    ccctr_update(mode, ctr, ks_nbytes, ks, ks);
+    ccctr_ctx_clear(mode->size, ctr);
+    cckprng_ctr_add(gen->ctr, ks_nbytes / 16);
+
+    cc_memcpy(out, ks, nbytes);
+    cc_memcpy(key, ks + out_nblocks * 16, CCKPRNG_KEY_NBYTES);
+
+    gdiag->out_nreqs += 1;
+    gdiag->out_nbytes += nbytes;
+    gdiag->out_nbytes_req_max = CC_MAX(gdiag->out_nbytes_req_max, (uint64_t)nbytes);
+    gdiag->out_nbytes_key += nbytes;
+    gdiag->out_nbytes_key_max = CC_MAX(gdiag->out_nbytes_key_max, gdiag->out_nbytes_key);
+
+    cckprng_unlock(&gen->lock.mutex);
+
+    cc_clear(ks_nbytes, ks);
+}
+
+void cckprng_done(struct cckprng_ctx *ctx)
+{
+    for (unsigned i = 0; i < ctx->max_ngens; i++) {
+        cckprng_lock_destroy(&ctx->gens[i].lock.mutex);
+    }
+    cckprng_lock_destroy(&ctx->lock.mutex);
+
+    if (ctx->gens) {
+        cc_clear(ctx->max_ngens * sizeof(*ctx->gens), ctx->gens);
+        free(ctx->gens);
+    }
+    if (ctx->diag.gens) {
+        cc_clear(ctx->diag.ngens * sizeof(*ctx->diag.gens), ctx->diag.gens);
+        free(ctx->diag.gens);
+    }
+
+    cc_clear(sizeof(*ctx), ctx);
+}
+
+#endif /* !CCKPRNG_YARROW */
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#ifndef _CORECRYPTO_CCKPRNG_INTERNAL_H_
+#define _CORECRYPTO_CCKPRNG_INTERNAL_H_
+
+#include <corecrypto/cckprng.h>
+
+#if CC_KERNEL
+#error "the kernel build registers the Yarrow cckprng"
+#endif
+
+/* samples pool 0 must hold before the scheduler will reseed */
+#define CCKPRNG_RESEED_NSAMPLES 64
+
+#if defined(__APPLE__)
+
+CC_INLINE void cckprng_lock_init(cckprng_lock_mutex *mutex)
+{
+    *mutex = OS_UNFAIR_LOCK_INIT;
+}
+
+CC_INLINE void cckprng_lock(cckprng_lock_mutex *mutex)
+{
+    os_unfair_lock_lock(mutex);
+}
+
+CC_INLINE bool cckprng_trylock(cckprng_lock_mutex *mutex)
+{
+    return os_unfair_lock_trylock(mutex);
+}
+
+CC_INLINE void cckprng_unlock(cckprng_lock_mutex *mutex)
+{
+    os_unfair_lock_unlock(mutex);
+}
+
+CC_INLINE void cckprng_lock_destroy(CC_UNUSED cckprng_lock_mutex *mutex)
+{
+}
+
+#else
+
+CC_INLINE void cckprng_lock_init(cckprng_lock_mutex *mutex)
+{
+    pthread_mutex_init(mutex, NULL);
+}
+
+CC_INLINE void cckprng_lock(cckprng_lock_mutex *mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+CC_INLINE bool cckprng_trylock(cckprng_lock_mutex *mutex)
+{
+    return pthread_mutex_trylock(mutex) == 0;
+}
+
+CC_INLINE void cckprng_unlock(cckprng_lock_mutex *mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+CC_INLINE void cckprng_lock_destroy(cckprng_lock_mutex *mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+#endif
+
+#endif /* _CORECRYPTO_CCKPRNG_INTERNAL_H_ */
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_error.h>
+#include "ccmerkle_internal.h"
+
+int ccmerkle_build(struct ccmerkle_tree *tree)
+{
+    for (size_t level = 1; level < tree->nlevels; level++) {
+        ccmerkle_hash_level(tree, level, 0, ccmerkle_level_nnodes(tree->nleaves, level - 1));
+    }
+    return CCERR_OK;
+}
+
+int ccmerkle_update_leaf(struct ccmerkle_tree *tree, size_t leaf,
+                         size_t nbytes, const void *data)
+{
+    int rc = ccmerkle_hash_leaves(tree, leaf, nbytes, data);
+
+    if (rc) {
+        return rc;
+    }
+
+    /* one parent per level, so O(log(nleaves)) node hashes */
+    for (size_t level = 1; level < tree->nlevels; level++, leaf /= 2) {
+        ccmerkle_hash_level(tree, level, leaf, 1);
+    }
+    return CCERR_OK;
+}
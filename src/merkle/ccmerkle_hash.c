@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include "ccmerkle_internal.h"
+
+void ccmerkle_hash_batch(const struct ccdigest_info *di, uint8_t prefix, size_t n,
+                         const uint8_t *const *data, const size_t *nbytes, uint8_t *const *out)
+{
+    uint64_t ctxs[CCDIGEST_MULTI_MAX_LANES][ccdigest_ctx_size(CCMERKLE_MAX_STATE_NBYTES, CCMERKLE_MAX_BLOCK_NBYTES) / 8 + 1];
+    struct ccdigest_multi_job jobs[CCDIGEST_MULTI_MAX_LANES];
+
+    while (n) {
+        size_t nlanes = CC_MIN(n, (size_t)CCDIGEST_MULTI_MAX_LANES), i;
+
+        for (i = 0; i < nlanes; i++) {
+            ccdigest_ctx_t ctx = (ccdigest_ctx_t)ctxs[i];
+            ccdigest_init(di, ctx);
+            ccdigest_update(di, ctx, 1, &prefix);
+            jobs[i] = (struct ccdigest_multi_job){ ctx, nbytes[i], data[i] };
+        }
+
+        ccdigest_multi_update(di, nlanes, jobs);
+
+        for (i = 0; i < nlanes; i++) {
+            ccdigest_final(di, (ccdigest_ctx_t)ctxs[i], out[i]);
+        }
+
+        data += nlanes;
+        nbytes += nlanes;
+        out += nlanes;
+        n -= nlanes;
+    }
+    cc_clear(sizeof(ctxs), ctxs);
+}
+
+void ccmerkle_hash_leaf(const struct ccdigest_info *di, size_t nbytes,
+                        const void *data, void *digest)
+{
+    const uint8_t *in = data;
+    uint8_t *out = digest;
+
+    ccmerkle_hash_batch(di, CCMERKLE_LEAF_PREFIX, 1, &in, &nbytes, &out);
+}
+
+void ccmerkle_hash_level(const struct ccmerkle_tree *tree, size_t level, size_t first, size_t n)
+{
+    const struct ccdigest_info *di = tree->di;
+    const uint8_t *data[CCDIGEST_MULTI_MAX_LANES];
+    size_t nbytes[CCDIGEST_MULTI_MAX_LANES];
+    uint8_t *out[CCDIGEST_MULTI_MAX_LANES];
+    size_t nchildren = ccmerkle_level_nnodes(tree->nleaves, level - 1);
+    const uint8_t *children = ccmerkle_level(tree, level - 1);
+    uint8_t *parents = ccmerkle_level(tree, level);
+    size_t i = first & ~(size_t)1, end = CC_MIN(first + n, nchildren), nlanes = 0;
+
+    for (; i < end; i += 2) {
+        /* an only child moves up as it is */
+        if (i + 1 == nchildren) {
+            cc_memcpy(parents + (i / 2) * di->output_size, children + i * di->output_size, di->output_size);
+            break;
+        }
+
+        /* the two children are next to each other, so they are one message */
+        data[nlanes] = children + i * di->output_size;
+        nbytes[nlanes] = 2 * di->output_size;
+        out[nlanes] = parents + (i / 2) * di->output_size;
+        if (++nlanes == CCDIGEST_MULTI_MAX_LANES) {
+            ccmerkle_hash_batch(di, CCMERKLE_NODE_PREFIX, nlanes, data, nbytes, out);
+            nlanes = 0;
+        }
+    }
+    ccmerkle_hash_batch(di, CCMERKLE_NODE_PREFIX, nlanes, data, nbytes, out);
+}
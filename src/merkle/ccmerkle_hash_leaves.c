@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_error.h>
+#include "ccmerkle_internal.h"
+
+int ccmerkle_hash_leaves(struct ccmerkle_tree *tree, size_t first,
+                         size_t nbytes, const void *data)
+{
+    const struct ccdigest_info *di = tree->di;
+    const uint8_t *in[CCDIGEST_MULTI_MAX_LANES];
+    size_t lens[CCDIGEST_MULTI_MAX_LANES];
+    uint8_t *out[CCDIGEST_MULTI_MAX_LANES];
+    const uint8_t *p = data;
+    size_t n, i;
+
+    if (first >= tree->nleaves) {
+        return CCERR_PARAMETER;
+    }
+
+    /* only the last leaf of the tree may be short (or empty) */
+    n = ccmerkle_nleaves(tree->leaf_nbytes, nbytes);
+    if (n > tree->nleaves - first ||
+        (first + n < tree->nleaves && nbytes != n * tree->leaf_nbytes)) {
+        return CCERR_PARAMETER;
+    }
+
+    for (i = 0; i < n; i += CCDIGEST_MULTI_MAX_LANES) {
+        size_t nlanes = CC_MIN(n - i, (size_t)CCDIGEST_MULTI_MAX_LANES), j;
+
+        for (j = 0; j < nlanes; j++) {
+            lens[j] = CC_MIN(nbytes, tree->leaf_nbytes);
+            in[j] = p;
+            out[j] = ccmerkle_level(tree, 0) + (first + i + j) * di->output_size;
+            p += lens[j];
+            nbytes -= lens[j];
+        }
+        ccmerkle_hash_batch(di, CCMERKLE_LEAF_PREFIX, nlanes, in, lens, out);
+    }
+    return CCERR_OK;
+}
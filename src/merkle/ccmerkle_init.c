@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_error.h>
+#include "ccmerkle_internal.h"
+
+size_t ccmerkle_nodes_nbytes(const struct ccdigest_info *di, size_t nleaves)
+{
+    size_t nnodes = 0;
+
+    for (;;) {
+        if (nnodes > SIZE_MAX - nleaves) {
+            return 0;
+        }
+        nnodes += nleaves;
+        if (nleaves <= 1) {
+            break;
+        }
+        nleaves = (nleaves + 1) / 2;
+    }
+
+    if (nnodes > SIZE_MAX / di->output_size) {
+        return 0;
+    }
+    return nnodes * di->output_size;
+}
+
+int ccmerkle_init(struct ccmerkle_tree *tree, const struct ccdigest_info *di,
+                  size_t leaf_nbytes, size_t nleaves, void *nodes)
+{
+    size_t n;
+
+    if (di->state_size > CCMERKLE_MAX_STATE_NBYTES || di->block_size > CCMERKLE_MAX_BLOCK_NBYTES ||
+        leaf_nbytes == 0 || nleaves == 0) {
+        return CCERR_PARAMETER;
+    }
+    if (ccmerkle_nodes_nbytes(di, nleaves) == 0) {
+        return CCERR_OVERFLOW;
+    }
+
+    tree->di = di;
+    tree->leaf_nbytes = leaf_nbytes;
+    tree->nleaves = nleaves;
+    tree->nlevels = 1;
+    for (n = nleaves; n > 1; n = (n + 1) / 2) {
+        tree->nlevels++;
+    }
+    tree->nodes = nodes;
+    return CCERR_OK;
+}
+
+const uint8_t *ccmerkle_node(const struct ccmerkle_tree *tree, size_t level, size_t index)
+{
+    if (level >= tree->nlevels || index >= ccmerkle_level_nnodes(tree->nleaves, level)) {
+        return NULL;
+    }
+    return ccmerkle_level(tree, level) + index * tree->di->output_size;
+}
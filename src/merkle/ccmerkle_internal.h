@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#ifndef _CORECRYPTO_CCMERKLE_INTERNAL_H_
+#define _CORECRYPTO_CCMERKLE_INTERNAL_H_
+
+#include <corecrypto/ccdigest_priv.h>
+#include <corecrypto/ccmerkle.h>
+
+#define CCMERKLE_LEAF_PREFIX 0x00
+#define CCMERKLE_NODE_PREFIX 0x01
+
+#define CCMERKLE_MAX_STATE_NBYTES 64
+#define CCMERKLE_MAX_BLOCK_NBYTES 128
+
+/* H(prefix || data[i]) into out[i] for n messages, compressed side by side where di allows */
+void ccmerkle_hash_batch(const struct ccdigest_info *di, uint8_t prefix, size_t n,
+                         const uint8_t *const *data, const size_t *nbytes, uint8_t *const *out);
+
+/* number of nodes on level of a tree of nleaves leaves */
+CC_INLINE size_t ccmerkle_level_nnodes(size_t nleaves, size_t level)
+{
+    while (level--) {
+        nleaves = (nleaves + 1) / 2;
+    }
+    return nleaves;
+}
+
+/* first node digest of level */
+CC_INLINE uint8_t *ccmerkle_level(const struct ccmerkle_tree *tree, size_t level)
+{
+    size_t n = tree->nleaves, offset = 0;
+
+    while (level--) {
+        offset += n;
+        n = (n + 1) / 2;
+    }
+    return tree->nodes + offset * tree->di->output_size;
+}
+
+/* rehash the nodes of level that cover nodes [first, first + n) of the level below */
+void ccmerkle_hash_level(const struct ccmerkle_tree *tree, size_t level, size_t first, size_t n);
+
+#endif /* _CORECRYPTO_CCMERKLE_INTERNAL_H_ */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_error.h>
+#include "ccmerkle_internal.h"
+
+int ccmerkle_proof(const struct ccmerkle_tree *tree, size_t leaf,
+                   size_t *proof_nbytes, void *proof)
+{
+    size_t outsize = tree->di->output_size, nbytes = 0;
+    uint8_t *p = proof;
+
+    if (leaf >= tree->nleaves) {
+        return CCERR_PARAMETER;
+    }
+
+    for (size_t level = 0; level + 1 < tree->nlevels; level++, leaf /= 2) {
+        const uint8_t *sibling = ccmerkle_node(tree, level, leaf ^ 1);
+
+        /* an only child has no sibling to record */
+        if (sibling == NULL) {
+            continue;
+        }
+        if (*proof_nbytes - nbytes < outsize) {
+            return CCERR_PARAMETER;
+        }
+        cc_memcpy(p + nbytes, sibling, outsize);
+        nbytes += outsize;
+    }
+
+    *proof_nbytes = nbytes;
+    return CCERR_OK;
+}
+
+int ccmerkle_verify_proof(const struct ccdigest_info *di, size_t nleaves, size_t leaf,
+                          const void *leaf_digest, size_t proof_nbytes, const void *proof,
+                          const void *root)
+{
+    uint8_t node[2 * CCMERKLE_MAX_STATE_NBYTES];
+    const uint8_t *p = proof;
+    size_t outsize = di->output_size, n = nleaves, nbytes = 2 * outsize;
+    const uint8_t *in = node;
+    uint8_t *out = node;
+    int rc = CCERR_INTEGRITY;
+
+    if (leaf >= nleaves || outsize > CCMERKLE_MAX_STATE_NBYTES || di->block_size > CCMERKLE_MAX_BLOCK_NBYTES) {
+        return CCERR_PARAMETER;
+    }
+
+    cc_memcpy(node, leaf_digest, outsize);
+    for (; n > 1; n = (n + 1) / 2, leaf /= 2) {
+        if ((leaf ^ 1) >= n) {
+            continue;
+        }
+        if (proof_nbytes < outsize) {
+            goto out;
+        }
+        if (leaf & 1) {
+            cc_memcpy(node + outsize, node, outsize);
+            cc_memcpy(node, p, outsize);
+        } else {
+            cc_memcpy(node + outsize, p, outsize);
+        }
+        ccmerkle_hash_batch(di, CCMERKLE_NODE_PREFIX, 1, &in, &nbytes, &out);
+        p += outsize;
+        proof_nbytes -= outsize;
+    }
+
+    if (proof_nbytes == 0 && cc_cmp_safe(outsize, node, root) == 0) {
+        rc = CCERR_OK;
+    }
+out:
+    cc_clear(sizeof(node), node);
+    return rc;
+}
@@ -19,20 +19,38 @@
 #include <corecrypto/cc_priv.h>
 #include <corecrypto/ccmode_internal.h>
 
+/*
+ * CBC decryption has no chain between blocks: P_i = D(C_i) ^ C_{i-1}. Whole batches go through the ECB backend in
+ * one call, then a single XOR sweep against the ciphertext shifted by one block. Everything is read from in before
+ * out is written, so in == out works.
+ */
 int ccmode_cbc_decrypt(const cccbc_ctx *ctx, cccbc_iv *iv, size_t nblocks, const void *in, void *out)
 {
     const struct _ccmode_cbc_key *fctx = (const struct _ccmode_cbc_key *)ctx;
-    void *cur_iv = iv->b;
+    size_t block_size = ccecb_block_size(fctx->ecb);
+    size_t batch_nblocks = CCMODE_CBC_DECRYPT_BATCH_NBYTES / block_size;
+    uint8_t tmp[CCMODE_CBC_DECRYPT_BATCH_NBYTES];
+    const uint8_t *c = in;
+    uint8_t *p = out;
+
+    while (nblocks) {
+        size_t n = CC_MIN(nblocks, batch_nblocks);
+        size_t nbytes = n * block_size;
 
-    /* iterate. */
-    while (nblocks--) {
-        ccecb_update(fctx->ecb, CCMODE_CBC_KEY_ECB_CTX(fctx), 1, in, out);
-        cc_xor(ccecb_block_size(fctx->ecb), out, in, cur_iv);
+        ccecb_update(fctx->ecb, CCMODE_CBC_KEY_ECB_CTX(fctx), n, c, tmp);
+        ccmode_xor(block_size, tmp, tmp, iv->b);
+        ccmode_xor(nbytes - block_size, tmp + block_size, tmp + block_size, c);
 
-        cur_iv = out;
-        in += ccecb_block_size(fctx->ecb);
-        out += ccecb_block_size(fctx->ecb);
+        /* the last ciphertext block chains into the next call */
+        cc_memcpy(iv->b, c + nbytes - block_size, block_size);
+        cc_memcpy(p, tmp, nbytes);
+
+        c += nbytes;
+        p += nbytes;
+        nblocks -= n;
     }
 
+    cc_clear(sizeof(tmp), tmp);
+
     return CCERR_OK;
 }
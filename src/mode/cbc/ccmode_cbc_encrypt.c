@@ -27,12 +27,17 @@ int ccmode_cbc_encrypt(const cccbc_ctx *ctx, cccbc_iv *iv, size_t nblocks, const
     /* iterate. */
     while (nblocks--) {
         cc_xor(ccecb_block_size(fctx->ecb), out, in, cur_iv);
-        ccecb_update(fctx->ecb, CCMODE_CBC_KEY_ECB_CTX(fctx), 1, in, out);
+        ccecb_update(fctx->ecb, CCMODE_CBC_KEY_ECB_CTX(fctx), 1, out, out);
 
         cur_iv = out;
         in += ccecb_block_size(fctx->ecb);
         out += ccecb_block_size(fctx->ecb);
     }
 
+    /* the last ciphertext block chains into the next call */
+    if (cur_iv != iv->b) {
+        cc_memcpy(iv->b, cur_iv, ccecb_block_size(fctx->ecb));
+    }
+
     return CCERR_OK;
 }
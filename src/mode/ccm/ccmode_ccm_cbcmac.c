@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+int ccmode_ccm_cbcmac(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in)
+{
+    struct _ccmode_ccm_nonce *n = _CCMODE_CCM_NONCE(nonce_ctx);
+
+    /* AAD has to come before any text */
+    if (n->mode != CCMODE_CCM_STATE_IV && n->mode != CCMODE_CCM_STATE_AAD) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    /* B_0 already committed to auth_len */
+    if (nbytes > n->aad_nbytes) {
+        return CCMODE_INVALID_INPUT;
+    }
+    n->aad_nbytes -= nbytes;
+
+    n->mode = CCMODE_CCM_STATE_AAD;
+    ccmode_ccm_macdata(ctx, nonce_ctx, 0, nbytes, in);
+
+    return CCERR_OK;
+}
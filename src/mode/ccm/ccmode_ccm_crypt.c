@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/* Plain CTR over the buffered keystream in buf, for the partial blocks on either side of a blocks_f run. */
+void ccmode_ccm_crypt(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out)
+{
+    struct _ccmode_ccm_key *key = _CCMODE_CCM_KEY(ctx);
+    struct _ccmode_ccm_nonce *n = _CCMODE_CCM_NONCE(nonce_ctx);
+    size_t L = CCMODE_CCM_L(n);
+    const uint8_t *p = in;
+    uint8_t *c = out;
+
+    while (nbytes) {
+        size_t take;
+
+        if (n->buflen == CCMODE_CCM_BLOCK_NBYTES) {
+            ccmode_ctr_inc(L, n->A_i + CCMODE_CCM_BLOCK_NBYTES - L);
+            key->ecb->ecb(CCMODE_CCM_KEY_ECB_CTX(key), 1, n->A_i, n->buf);
+            n->buflen = 0;
+        }
+
+        take = CC_MIN(nbytes, CCMODE_CCM_BLOCK_NBYTES - n->buflen);
+        ccmode_xor(take, c, p, n->buf + n->buflen);
+        n->buflen += (uint32_t)take;
+
+        p += take;
+        c += take;
+        nbytes -= take;
+    }
+}
+
+/* MAC over the plaintext: before it is overwritten when encrypting, after it is produced when decrypting. */
+static void ccmode_ccm_crypt_partial(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const uint8_t *in,
+                                     uint8_t *out, int encrypting)
+{
+    if (encrypting) {
+        ccmode_ccm_macdata(ctx, nonce_ctx, 0, nbytes, in);
+        ccmode_ccm_crypt(ctx, nonce_ctx, nbytes, in, out);
+    } else {
+        ccmode_ccm_crypt(ctx, nonce_ctx, nbytes, in, out);
+        ccmode_ccm_macdata(ctx, nonce_ctx, 0, nbytes, out);
+    }
+}
+
+int ccmode_ccm_crypt_with(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out,
+                          int encrypting, ccmode_ccm_blocks_f blocks_f)
+{
+    struct _ccmode_ccm_nonce *n = _CCMODE_CCM_NONCE(nonce_ctx);
+    const uint8_t *p = in;
+    uint8_t *c = out;
+    size_t nblocks;
+
+    if (n->mode != CCMODE_CCM_STATE_IV && n->mode != CCMODE_CCM_STATE_AAD && n->mode != CCMODE_CCM_STATE_TEXT) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    /* the text starts once all of the AAD is in, and stops at the data_len in B_0 */
+    if (n->mode != CCMODE_CCM_STATE_TEXT && n->aad_nbytes) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+    if (nbytes > n->text_nbytes) {
+        return CCMODE_INVALID_INPUT;
+    }
+    n->text_nbytes -= nbytes;
+
+    if (n->mode != CCMODE_CCM_STATE_TEXT) {
+        /* zero pad the end of the AAD */
+        ccmode_ccm_macdata(ctx, nonce_ctx, 1, 0, NULL);
+        n->mode = CCMODE_CCM_STATE_TEXT;
+    }
+
+    /* finish the block a previous call left open, the MAC and keystream positions move in lockstep */
+    if (n->b_i_len) {
+        size_t take = CC_MIN(nbytes, CCMODE_CCM_BLOCK_NBYTES - n->b_i_len);
+
+        ccmode_ccm_crypt_partial(ctx, nonce_ctx, take, p, c, encrypting);
+        p += take;
+        c += take;
+        nbytes -= take;
+    }
+
+    nblocks = nbytes / CCMODE_CCM_BLOCK_NBYTES;
+    if (nblocks) {
+        blocks_f(_CCMODE_CCM_KEY(ctx), n, nblocks, p, c);
+        p += nblocks * CCMODE_CCM_BLOCK_NBYTES;
+        c += nblocks * CCMODE_CCM_BLOCK_NBYTES;
+        nbytes -= nblocks * CCMODE_CCM_BLOCK_NBYTES;
+    }
+
+    if (nbytes) {
+        ccmode_ccm_crypt_partial(ctx, nonce_ctx, nbytes, p, c, encrypting);
+    }
+
+    return CCERR_OK;
+}
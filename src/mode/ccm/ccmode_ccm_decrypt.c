@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * Generic path: the MAC needs P_i, which needs E(A_i), so the pair is skewed by one block; the keystream for block
+ * i + 1 goes through the same two block ECB call as the MAC of block i.
+ */
+static void ccmode_ccm_decrypt_blocks(struct _ccmode_ccm_key *key, struct _ccmode_ccm_nonce *n, size_t nblocks,
+                                      const uint8_t *in, uint8_t *out)
+{
+    const ccecb_ctx *ecb_key = CCMODE_CCM_KEY_ECB_CTX(key);
+    size_t L = CCMODE_CCM_L(n);
+    uint8_t blk[2 * CCMODE_CCM_BLOCK_NBYTES];
+    uint8_t *mac = blk + CCMODE_CCM_BLOCK_NBYTES;
+
+    ccmode_ctr_inc(L, n->A_i + CCMODE_CCM_BLOCK_NBYTES - L);
+    key->ecb->ecb(ecb_key, 1, n->A_i, blk);
+
+    while (nblocks--) {
+        ccmode_xor(CCMODE_CCM_BLOCK_NBYTES, out, in, blk);
+        ccmode_xor(CCMODE_CCM_BLOCK_NBYTES, mac, n->B_i, out);
+
+        if (nblocks) {
+            ccmode_ctr_inc(L, n->A_i + CCMODE_CCM_BLOCK_NBYTES - L);
+            cc_memcpy(blk, n->A_i, CCMODE_CCM_BLOCK_NBYTES);
+            key->ecb->ecb(ecb_key, 2, blk, blk);
+        } else {
+            key->ecb->ecb(ecb_key, 1, mac, mac);
+        }
+        cc_memcpy(n->B_i, mac, CCMODE_CCM_BLOCK_NBYTES);
+
+        in += CCMODE_CCM_BLOCK_NBYTES;
+        out += CCMODE_CCM_BLOCK_NBYTES;
+    }
+
+    cc_clear(sizeof(blk), blk);
+}
+
+int ccmode_ccm_decrypt(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_ccm_crypt_with(ctx, nonce_ctx, nbytes, in, out, 0, ccmode_ccm_decrypt_blocks);
+}
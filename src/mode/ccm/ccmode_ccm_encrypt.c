@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * Generic path: P_i feeds the MAC and A_i the keystream, and the two blocks are independent, so they go through the
+ * cipher in a single two block ECB call and implementations that interleave blocks overlap them.
+ */
+static void ccmode_ccm_encrypt_blocks(struct _ccmode_ccm_key *key, struct _ccmode_ccm_nonce *n, size_t nblocks,
+                                      const uint8_t *in, uint8_t *out)
+{
+    size_t L = CCMODE_CCM_L(n);
+    uint8_t blk[2 * CCMODE_CCM_BLOCK_NBYTES];
+
+    while (nblocks--) {
+        ccmode_ctr_inc(L, n->A_i + CCMODE_CCM_BLOCK_NBYTES - L);
+        cc_memcpy(blk, n->A_i, CCMODE_CCM_BLOCK_NBYTES);
+        ccmode_xor(CCMODE_CCM_BLOCK_NBYTES, blk + CCMODE_CCM_BLOCK_NBYTES, n->B_i, in);
+
+        key->ecb->ecb(CCMODE_CCM_KEY_ECB_CTX(key), 2, blk, blk);
+
+        cc_memcpy(n->B_i, blk + CCMODE_CCM_BLOCK_NBYTES, CCMODE_CCM_BLOCK_NBYTES);
+        ccmode_xor(CCMODE_CCM_BLOCK_NBYTES, out, in, blk);
+
+        in += CCMODE_CCM_BLOCK_NBYTES;
+        out += CCMODE_CCM_BLOCK_NBYTES;
+    }
+
+    cc_clear(sizeof(blk), blk);
+}
+
+int ccmode_ccm_encrypt(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_ccm_crypt_with(ctx, nonce_ctx, nbytes, in, out, 1, ccmode_ccm_encrypt_blocks);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * Writes the mac_size byte tag, T = MSB_t(CBC-MAC) ^ MSB_t(E(K, A_0)), for both directions; a decryptor compares it
+ * against the received tag itself (with cc_cmp_safe).
+ */
+int ccmode_ccm_finalize(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, void *mac)
+{
+    struct _ccmode_ccm_nonce *n = _CCMODE_CCM_NONCE(nonce_ctx);
+
+    if (n->mode != CCMODE_CCM_STATE_IV && n->mode != CCMODE_CCM_STATE_AAD && n->mode != CCMODE_CCM_STATE_TEXT) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    /* the lengths in B_0 are only right if all of the AAD and text went through */
+    if (n->aad_nbytes || n->text_nbytes) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    /* zero pad whatever is left of the AAD or the text */
+    ccmode_ccm_macdata(ctx, nonce_ctx, 1, 0, NULL);
+
+    ccmode_xor(n->mac_size, mac, n->B_i, n->MAC);
+    n->mode = CCMODE_CCM_STATE_MAC;
+
+    return CCERR_OK;
+}
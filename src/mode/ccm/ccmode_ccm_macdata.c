@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * XORs nbytes into the CBC-MAC state, encrypting B_i every time a block fills up. new_block first closes out a
+ * partial block, which is the zero padding at the end of the AAD and of the text.
+ */
+void ccmode_ccm_macdata(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, unsigned new_block, size_t nbytes, const void *in)
+{
+    struct _ccmode_ccm_key *key = _CCMODE_CCM_KEY(ctx);
+    struct _ccmode_ccm_nonce *n = _CCMODE_CCM_NONCE(nonce_ctx);
+    const uint8_t *p = in;
+
+    if (new_block && n->b_i_len) {
+        key->ecb->ecb(CCMODE_CCM_KEY_ECB_CTX(key), 1, n->B_i, n->B_i);
+        n->b_i_len = 0;
+    }
+
+    while (nbytes) {
+        size_t take = CC_MIN(nbytes, CCMODE_CCM_BLOCK_NBYTES - n->b_i_len);
+
+        ccmode_xor(take, n->B_i + n->b_i_len, n->B_i + n->b_i_len, p);
+        n->b_i_len += (uint32_t)take;
+        if (n->b_i_len == CCMODE_CCM_BLOCK_NBYTES) {
+            key->ecb->ecb(CCMODE_CCM_KEY_ECB_CTX(key), 1, n->B_i, n->B_i);
+            n->b_i_len = 0;
+        }
+
+        p += take;
+        nbytes -= take;
+    }
+}
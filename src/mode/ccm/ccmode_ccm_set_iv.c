@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * Formats B_0 and A_0 (SP 800-38C, A.2) and starts the MAC.
+ *
+ * B_0 = flags || N || [data_len]_L, with flags = Adata << 6 | ((t - 2) / 2) << 3 | (L - 1). B_0 is encrypted right
+ * away into B_i, E(K, A_0) is kept in MAC for finalize, and A_i is left at A_0 so the first text block uses counter 1.
+ * A non-zero auth_len is encoded and fed to the MAC here, ahead of the AAD itself. Both lengths are also kept as
+ * the number of bytes the later calls still have to supply.
+ */
+int ccmode_ccm_set_iv(ccccm_ctx *ctx, ccccm_nonce *nonce_ctx, size_t nonce_len, const void *nonce, size_t mac_size,
+                      size_t auth_len, size_t data_len)
+{
+    struct _ccmode_ccm_key *key = _CCMODE_CCM_KEY(ctx);
+    struct _ccmode_ccm_nonce *n = _CCMODE_CCM_NONCE(nonce_ctx);
+    const struct ccmode_ecb *ecb = key->ecb;
+    uint8_t alen[10];
+    size_t alen_nbytes;
+    size_t L;
+
+    if (nonce_len < 7 || nonce_len > 13) {
+        return CCMODE_INVALID_INPUT;
+    }
+
+    if (mac_size < 4 || mac_size > CCMODE_CCM_BLOCK_NBYTES || (mac_size & 1)) {
+        return CCMODE_INVALID_INPUT;
+    }
+
+    /* data_len has to fit in the L byte length field (and so the counter never wraps) */
+    L = 15 - nonce_len;
+    if (L < sizeof(uint64_t) && (uint64_t)data_len >> (8 * L)) {
+        return CCMODE_INVALID_INPUT;
+    }
+
+    cc_clear(sizeof(*n), n);
+    n->nonce_size = nonce_len;
+    n->mac_size = mac_size;
+    n->aad_nbytes = auth_len;
+    n->text_nbytes = data_len;
+
+    /* A_0 = (L - 1) || N || 0 */
+    n->A_i[0] = (uint8_t)(L - 1);
+    cc_memcpy(n->A_i + 1, nonce, nonce_len);
+    ecb->ecb(CCMODE_CCM_KEY_ECB_CTX(key), 1, n->A_i, n->MAC);
+
+    /* B_0 */
+    n->B_i[0] = (uint8_t)((auth_len ? 0x40 : 0) | ((mac_size - 2) / 2) << 3 | (L - 1));
+    cc_memcpy(n->B_i + 1, nonce, nonce_len);
+    for (size_t i = 0; i < L; i++) {
+        n->B_i[CCMODE_CCM_BLOCK_NBYTES - 1 - i] = (uint8_t)((uint64_t)data_len >> (8 * i));
+    }
+    ecb->ecb(CCMODE_CCM_KEY_ECB_CTX(key), 1, n->B_i, n->B_i);
+
+    if (auth_len) {
+        /* 2, 6 or 10 byte length prefix for the AAD */
+        if ((uint64_t)auth_len < 0xff00) {
+            alen[0] = (uint8_t)(auth_len >> 8);
+            alen[1] = (uint8_t)auth_len;
+            alen_nbytes = 2;
+        } else if ((uint64_t)auth_len <= 0xffffffff) {
+            alen[0] = 0xff;
+            alen[1] = 0xfe;
+            CC_STORE32_BE((uint32_t)auth_len, alen + 2);
+            alen_nbytes = 6;
+        } else {
+            alen[0] = 0xff;
+            alen[1] = 0xff;
+            CC_STORE64_BE((uint64_t)auth_len, alen + 2);
+            alen_nbytes = 10;
+        }
+        ccmode_ccm_macdata(ctx, nonce_ctx, 0, alen_nbytes, alen);
+    }
+
+    n->buflen = CCMODE_CCM_BLOCK_NBYTES;
+    n->mode = CCMODE_CCM_STATE_IV;
+
+    return CCERR_OK;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccaes.h>
+#include <corecrypto/ccmode_internal.h>
+
+/* Construct a CCM mode from an ECB encrypt mode; both directions run the block cipher forwards. */
+static void ccmode_factory_ccm(struct ccmode_ccm *ccm, const struct ccmode_ecb *ecb_encrypt, int encrypting)
+{
+    ccm->size = ccn_sizeof_size(sizeof(struct _ccmode_ccm_key)) + ccn_sizeof_size(ecb_encrypt->block_size) +
+                ccn_sizeof_size(ecb_encrypt->size);
+    ccm->nonce_size = ccn_sizeof_size(sizeof(struct _ccmode_ccm_nonce));
+    ccm->block_size = 1;
+    ccm->init = ccmode_ccm_init;
+    ccm->set_iv = ccmode_ccm_set_iv;
+    ccm->cbcmac = ccmode_ccm_cbcmac;
+    ccm->ccm = encrypting ? ccmode_ccm_encrypt : ccmode_ccm_decrypt;
+    ccm->finalize = ccmode_ccm_finalize;
+    ccm->reset = ccmode_ccm_reset;
+    ccm->custom = ecb_encrypt;
+
+#if CCAES_INTEL_ASM && defined(__x86_64__)
+    /* same key layout, but the CBC-MAC and CTR blocks share one interleaved AES-NI round loop */
+    if (ecb_encrypt == &ccaes_intel_ecb_encrypt_aesni_mode) {
+        ccm->ccm = encrypting ? ccaes_vng_ccm_encrypt : ccaes_vng_ccm_decrypt;
+    }
+#endif
+}
+
+void ccmode_factory_ccm_decrypt(struct ccmode_ccm *ccm, const struct ccmode_ecb *ecb_encrypt)
+{
+    ccmode_factory_ccm(ccm, ecb_encrypt, 0);
+}
+
+void ccmode_factory_ccm_encrypt(struct ccmode_ccm *ccm, const struct ccmode_ecb *ecb_encrypt)
+{
+    ccmode_factory_ccm(ccm, ecb_encrypt, 1);
+}
@@ -16,28 +16,83 @@
  * @LICENSE_HEADER_END@
  */
 
- #include <corecrypto/cc_priv.h>
- #include <corecrypto/ccmode_internal.h>
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
 
-int ccmode_ctr_crypt(ccctr_ctx *ctx, size_t nbytes, const void *in, void *out)
+/* Generic bulk path: lay out a run of counter blocks, encrypt them with a single ECB call and XOR the lot. */
+static void ccmode_ctr_crypt_blocks(struct _ccmode_ctr_key *ckey, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    const struct ccmode_ecb *ecb = ckey->ecb;
+    size_t block_size = ecb->block_size;
+    uint8_t *ctr = (uint8_t *)CCMODE_CTR_KEY_COUNTER(ckey);
+    cc_unit ks[ccn_nof_size(CCMODE_CTR_MAX_PARALLEL_NBLOCKS * CCMODE_CTR_MAX_BLOCK_NBYTES)];
+    size_t max_nblocks = sizeof(ks) / block_size;
+
+    cc_assert(block_size <= CCMODE_CTR_MAX_BLOCK_NBYTES);
+
+    while (nblocks) {
+        size_t n = CC_MIN(nblocks, max_nblocks);
+        uint8_t *cur_ks = (uint8_t *)ks;
+
+        for (size_t i = 0; i < n; i++) {
+            cc_memcpy(cur_ks, ctr, block_size);
+            ccmode_ctr_inc(block_size, ctr);
+            cur_ks += block_size;
+        }
+
+        ecb->ecb(CCMODE_CTR_KEY_ECB_CTX(ckey), n, ks, ks);
+        ccmode_xor(n * block_size, out, in, ks);
+
+        in += n * block_size;
+        out += n * block_size;
+        nblocks -= n;
+    }
+
+    cc_clear(sizeof(ks), ks);
+}
+
+int ccmode_ctr_crypt_with(struct _ccmode_ctr_key *ckey, size_t nbytes, const void *in, void *out, ccmode_ctr_blocks_f blocks_f)
 {
-    struct _ccmode_ctr_key *ckey = (struct _ccmode_ctr_key *)ctx;
     size_t block_size = ckey->ecb->block_size;
+    uint8_t *pad = (uint8_t *)CCMODE_CTR_KEY_PAD(ckey);
     const uint8_t *cur_in = in;
     uint8_t *cur_out = out;
 
-    while (nbytes--) {
-        if (ckey->pad_len == block_size) {
-            for (size_t i = block_size - 1; i >= block_size; i--) {
-                CCMODE_CTR_KEY_COUNTER(ckey)[i] += 1;
-            }
+    /* use up the keystream left over from the previous call first. */
+    if (ckey->pad_len < block_size) {
+        size_t n = CC_MIN(nbytes, block_size - ckey->pad_len);
 
-            ckey->ecb->ecb(CCMODE_CTR_KEY_ECB_CTX(ckey), 1, CCMODE_CTR_KEY_COUNTER(ckey), CCMODE_CTR_KEY_PAD(ckey));
-            ckey->pad_len = 0;
-        }
+        ccmode_xor(n, cur_out, cur_in, pad + ckey->pad_len);
+        ckey->pad_len += n;
+        cur_in += n;
+        cur_out += n;
+        nbytes -= n;
+    }
+
+    if (nbytes >= block_size) {
+        size_t nblocks = nbytes / block_size;
 
-        *cur_out++ = *cur_in++ ^ CCMODE_CTR_KEY_PAD(ckey)[ckey->pad_len++];
+        blocks_f(ckey, nblocks, cur_in, cur_out);
+        cur_in += nblocks * block_size;
+        cur_out += nblocks * block_size;
+        nbytes -= nblocks * block_size;
+    }
+
+    /* partial tail, keep the rest of the keystream block around for the next call. */
+    if (nbytes) {
+        uint8_t *ctr = (uint8_t *)CCMODE_CTR_KEY_COUNTER(ckey);
+
+        ckey->ecb->ecb(CCMODE_CTR_KEY_ECB_CTX(ckey), 1, ctr, pad);
+        ccmode_ctr_inc(block_size, ctr);
+
+        ccmode_xor(nbytes, cur_out, cur_in, pad);
+        ckey->pad_len = nbytes;
     }
 
     return CCERR_OK;
 }
+
+int ccmode_ctr_crypt(ccctr_ctx *ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_ctr_crypt_with((struct _ccmode_ctr_key *)ctx, nbytes, in, out, ccmode_ctr_crypt_blocks);
+}
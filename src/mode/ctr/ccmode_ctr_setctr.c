@@ -23,5 +23,8 @@ int ccmode_ctr_setctr(const struct ccmode_ctr *mode, ccctr_ctx *ctx, const void
 {
     struct _ccmode_ctr_key *ckey = (struct _ccmode_ctr_key *)ctx;
     cc_memcpy(CCMODE_CTR_KEY_COUNTER(ckey), ctr, ckey->ecb->block_size); /* This gets a bit absurd for AES,  */
+
+    /* no keystream buffered for the new counter yet. */
+    ckey->pad_len = ckey->ecb->block_size;
     return CCERR_OK;
 }
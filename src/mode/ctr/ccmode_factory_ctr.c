@@ -17,6 +17,7 @@
  */
 
 #include <corecrypto/cc_priv.h>
+#include <corecrypto/ccaes.h>
 #include <corecrypto/ccmode_internal.h>
 
 void ccmode_factory_ctr_crypt(struct ccmode_ctr *ctr, const struct ccmode_ecb *ecb)
@@ -27,4 +28,12 @@ void ccmode_factory_ctr_crypt(struct ccmode_ctr *ctr, const struct ccmode_ecb *e
     ctr->init = ccmode_ctr_init;
     ctr->setctr = ccmode_ctr_setctr;
     ctr->ctr = ccmode_ctr_crypt;
+    ctr->custom = ecb;
+
+#if CCAES_INTEL_ASM && defined(__x86_64__)
+    /* same key layout, but the whole blocks go through the 8-way AES-NI loop instead of the ECB callback */
+    if (ecb == &ccaes_intel_ecb_encrypt_aesni_mode) {
+        ctr->ctr = ccaes_intel_ctr_crypt_aesni;
+    }
+#endif
 }
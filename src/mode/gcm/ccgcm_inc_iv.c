@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+int ccgcm_inc_iv(const struct ccmode_gcm *mode, ccgcm_ctx *ctx, void *iv)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+    uint8_t next_iv[CCGCM_IV_NBYTES];
+    uint64_t counter;
+
+    (void)mode;
+
+    if (!(key->flags & CCGCM_FLAGS_INIT_WITH_IV) || key->state != CCMODE_GCM_STATE_INIT) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    /* 4-byte salt || 8-byte big-endian counter; J0 still holds the previous IV */
+    cc_memcpy(next_iv, key->Y_0, CCGCM_IV_NBYTES);
+    CC_LOAD64_BE(counter, next_iv + 4);
+    counter++;
+    CC_STORE64_BE(counter, next_iv + 4);
+
+    ccmode_gcm_set_iv_internal(ctx, CCGCM_IV_NBYTES, next_iv);
+    cc_memcpy(iv, next_iv, CCGCM_IV_NBYTES);
+
+    return CCERR_OK;
+}
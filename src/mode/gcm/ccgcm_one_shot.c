@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+typedef int (*ccgcm_set_iv_f)(const struct ccmode_gcm *mode, ccgcm_ctx *ctx, size_t iv_nbytes, const void *iv);
+
+static int ccgcm_one_shot_with(const struct ccmode_gcm *mode, ccgcm_set_iv_f set_iv,
+                               size_t key_nbytes, const void *key,
+                               size_t iv_nbytes, const void *iv,
+                               size_t adata_nbytes, const void *adata,
+                               size_t nbytes, const void *in, void *out,
+                               size_t tag_nbytes, void *tag)
+{
+    ccgcm_ctx_decl(mode->size, ctx);
+    int rc;
+
+    rc = ccgcm_init(mode, ctx, key_nbytes, key);
+    if (rc != CCERR_OK) {
+        goto out;
+    }
+
+    rc = set_iv(mode, ctx, iv_nbytes, iv);
+    if (rc != CCERR_OK) {
+        goto out;
+    }
+
+    rc = ccgcm_aad(mode, ctx, adata_nbytes, adata);
+    if (rc != CCERR_OK) {
+        goto out;
+    }
+
+    rc = ccgcm_update(mode, ctx, nbytes, in, out);
+    if (rc != CCERR_OK) {
+        goto out;
+    }
+
+    rc = ccgcm_finalize(mode, ctx, tag_nbytes, tag);
+
+out:
+    ccgcm_ctx_clear(mode->size, ctx);
+    return rc;
+}
+
+int ccgcm_one_shot(const struct ccmode_gcm *mode,
+                   size_t key_nbytes, const void *key,
+                   size_t iv_nbytes, const void *iv,
+                   size_t adata_nbytes, const void *adata,
+                   size_t nbytes, const void *in, void *out,
+                   size_t tag_nbytes, void *tag)
+{
+    return ccgcm_one_shot_with(mode, ccgcm_set_iv, key_nbytes, key, iv_nbytes, iv, adata_nbytes, adata, nbytes, in, out, tag_nbytes, tag);
+}
+
+int ccgcm_one_shot_legacy(const struct ccmode_gcm *mode,
+                          size_t key_nbytes, const void *key,
+                          size_t iv_nbytes, const void *iv,
+                          size_t adata_nbytes, const void *adata,
+                          size_t nbytes, const void *in, void *out,
+                          size_t tag_nbytes, void *tag)
+{
+    return ccgcm_one_shot_with(mode, ccgcm_set_iv_legacy, key_nbytes, key, iv_nbytes, iv, adata_nbytes, adata, nbytes, in, out, tag_nbytes, tag);
+}
+
+int ccgcm_one_shot_batch(const struct ccmode_gcm *mode,
+                         size_t key_nbytes, const void *key,
+                         size_t tag_nbytes,
+                         size_t npackets, const struct ccgcm_packet *packets,
+                         int *results)
+{
+    ccgcm_ctx_decl(mode->size, ctx);
+    const struct ccgcm_packet *p;
+    int rc, prc = CCERR_OK;
+    size_t i;
+
+    /* key schedule and H table once, ccgcm_reset() keeps both */
+    rc = ccgcm_init(mode, ctx, key_nbytes, key);
+    if (rc != CCERR_OK) {
+        goto out;
+    }
+
+    for (i = 0; i < npackets; i++) {
+        p = &packets[i];
+
+        rc = ccgcm_set_iv(mode, ctx, p->iv_nbytes, p->iv);
+        if (rc == CCERR_OK) {
+            rc = ccgcm_aad(mode, ctx, p->adata_nbytes, p->adata);
+        }
+        if (rc == CCERR_OK) {
+            rc = ccgcm_update(mode, ctx, p->nbytes, p->in, p->out);
+        }
+        if (rc == CCERR_OK) {
+            rc = ccgcm_finalize(mode, ctx, tag_nbytes, p->tag);
+        }
+        ccgcm_reset(mode, ctx);
+
+        if (results) {
+            results[i] = rc;
+        }
+        if (prc == CCERR_OK) {
+            prc = rc;
+        }
+    }
+    rc = prc;
+
+out:
+    ccgcm_ctx_clear(mode->size, ctx);
+    return rc;
+}
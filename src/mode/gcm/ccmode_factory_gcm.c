@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_runtime_config.h>
+#include <corecrypto/ccaes.h>
+#include <corecrypto/ccmode_internal.h>
+
+/* Construct a GCM mode from an ECB encrypt mode; both directions run the block cipher forwards. */
+static void ccmode_factory_gcm(struct ccmode_gcm *gcm, const struct ccmode_ecb *ecb_encrypt, int encdec)
+{
+    gcm->size = CCMODE_GCM_KEY_SIZE(ecb_encrypt);
+    gcm->encdec = encdec;
+    gcm->block_size = 1;
+    gcm->init = ccmode_gcm_init;
+    gcm->set_iv = ccmode_gcm_set_iv;
+    gcm->gmac = ccmode_gcm_aad;
+    gcm->gcm = (encdec == CCMODE_GCM_ENCRYPTOR) ? ccmode_gcm_encrypt : ccmode_gcm_decrypt;
+    gcm->finalize = ccmode_gcm_finalize;
+    gcm->reset = ccmode_gcm_reset;
+    gcm->custom = ecb_encrypt;
+
+#if CCMODE_GCM_VNG_SPEEDUP
+    /* AES-NI keys can run the stitched CTR + GHASH loop, the context layout is unchanged */
+    if (ecb_encrypt == &ccaes_intel_ecb_encrypt_aesni_mode && CC_HAS_PCLMULQDQ()) {
+        gcm->gcm = (encdec == CCMODE_GCM_ENCRYPTOR) ? ccaes_vng_gcm_encrypt : ccaes_vng_gcm_decrypt;
+    }
+#endif
+}
+
+void ccmode_factory_gcm_decrypt(struct ccmode_gcm *gcm, const struct ccmode_ecb *ecb_encrypt)
+{
+    ccmode_factory_gcm(gcm, ecb_encrypt, CCMODE_GCM_DECRYPTOR);
+}
+
+void ccmode_factory_gcm_encrypt(struct ccmode_gcm *gcm, const struct ccmode_ecb *ecb_encrypt)
+{
+    ccmode_factory_gcm(gcm, ecb_encrypt, CCMODE_GCM_ENCRYPTOR);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+int ccmode_gcm_aad(ccgcm_ctx *ctx, size_t nbytes, const void *in)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+    const uint8_t *cur_in = in;
+    size_t used;
+
+    if (key->state == CCMODE_GCM_STATE_IV) {
+        key->state = CCMODE_GCM_STATE_AAD;
+    } else if (key->state != CCMODE_GCM_STATE_AAD) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    if (key->aad_nbytes + nbytes < key->aad_nbytes) {
+        return CCMODE_INVALID_INPUT;
+    }
+
+    /* a partial block is XORed straight into X and only multiplied once it fills up */
+    used = (size_t)(key->aad_nbytes % CCGCM_BLOCK_NBYTES);
+    key->aad_nbytes += nbytes;
+
+    if (used) {
+        size_t n = CC_MIN(nbytes, CCGCM_BLOCK_NBYTES - used);
+
+        ccmode_xor(n, key->X + used, key->X + used, cur_in);
+        cur_in += n;
+        nbytes -= n;
+
+        if (used + n < CCGCM_BLOCK_NBYTES) {
+            return CCERR_OK;
+        }
+
+        ccmode_gcm_mult_x(key);
+    }
+
+    key->ghash(key, nbytes / CCGCM_BLOCK_NBYTES, cur_in);
+    cur_in += nbytes & ~(size_t)(CCGCM_BLOCK_NBYTES - 1);
+
+    ccmode_xor(nbytes % CCGCM_BLOCK_NBYTES, key->X, key->X, cur_in);
+
+    return CCERR_OK;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/* XOR n bytes of keystream and fold the ciphertext side into X at offset used. in may alias out. */
+static void ccmode_gcm_crypt_partial(struct _ccmode_gcm_key *key, size_t used, size_t n, const uint8_t *in, uint8_t *out)
+{
+    if (key->encdec == CCMODE_GCM_DECRYPTOR) {
+        ccmode_xor(n, key->X + used, key->X + used, in);
+        ccmode_xor(n, out, in, key->buf + used);
+    } else {
+        ccmode_xor(n, out, in, key->buf + used);
+        ccmode_xor(n, key->X + used, key->X + used, out);
+    }
+}
+
+int ccmode_gcm_crypt_with(ccgcm_ctx *ctx, size_t nbytes, const void *in, void *out, ccmode_gcm_blocks_f blocks_f)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+    const uint8_t *cur_in = in;
+    uint8_t *cur_out = out;
+    size_t used;
+
+    if (key->state == CCMODE_GCM_STATE_IV || key->state == CCMODE_GCM_STATE_AAD) {
+        /* close off a partial AAD block before the text starts */
+        if (key->aad_nbytes % CCGCM_BLOCK_NBYTES) {
+            ccmode_gcm_mult_x(key);
+        }
+        key->state = CCMODE_GCM_STATE_TEXT;
+    } else if (key->state != CCMODE_GCM_STATE_TEXT) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    if (nbytes > CCGCM_TEXT_MAX_NBYTES - key->text_nbytes) {
+        return CCMODE_INVALID_INPUT;
+    }
+
+    used = (size_t)(key->text_nbytes % CCGCM_BLOCK_NBYTES);
+    key->text_nbytes += nbytes;
+
+    /* use up the keystream left in buf by the previous call */
+    if (used) {
+        size_t n = CC_MIN(nbytes, CCGCM_BLOCK_NBYTES - used);
+
+        ccmode_gcm_crypt_partial(key, used, n, cur_in, cur_out);
+        cur_in += n;
+        cur_out += n;
+        nbytes -= n;
+
+        if (used + n < CCGCM_BLOCK_NBYTES) {
+            return CCERR_OK;
+        }
+
+        ccmode_gcm_mult_x(key);
+    }
+
+    if (nbytes >= CCGCM_BLOCK_NBYTES) {
+        size_t nblocks = nbytes / CCGCM_BLOCK_NBYTES;
+
+        blocks_f(key, nblocks, cur_in, cur_out);
+        cur_in += nblocks * CCGCM_BLOCK_NBYTES;
+        cur_out += nblocks * CCGCM_BLOCK_NBYTES;
+        nbytes -= nblocks * CCGCM_BLOCK_NBYTES;
+    }
+
+    /* ragged tail, X is multiplied once the block is completed or in finalize */
+    if (nbytes) {
+        ccmode_gcm_keystream(key, 1, key->buf);
+        ccmode_gcm_crypt_partial(key, 0, nbytes, cur_in, cur_out);
+    }
+
+    return CCERR_OK;
+}
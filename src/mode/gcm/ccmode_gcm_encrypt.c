@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/* Generic path: a run of counter blocks through one ECB call, then GHASH over the ciphertext just written. */
+static void ccmode_gcm_encrypt_blocks(struct _ccmode_gcm_key *key, size_t nblocks, const uint8_t *in, uint8_t *out)
+{
+    uint8_t ks[CCMODE_GCM_MAX_PARALLEL_NBLOCKS * CCGCM_BLOCK_NBYTES];
+
+    while (nblocks) {
+        size_t n = CC_MIN(nblocks, CCMODE_GCM_MAX_PARALLEL_NBLOCKS);
+
+        ccmode_gcm_keystream(key, n, ks);
+        ccmode_xor(n * CCGCM_BLOCK_NBYTES, out, in, ks);
+        key->ghash(key, n, out);
+
+        in += n * CCGCM_BLOCK_NBYTES;
+        out += n * CCGCM_BLOCK_NBYTES;
+        nblocks -= n;
+    }
+
+    cc_clear(sizeof(ks), ks);
+}
+
+int ccmode_gcm_encrypt(ccgcm_ctx *ctx, size_t nbytes, const void *in, void *out)
+{
+    return ccmode_gcm_crypt_with(ctx, nbytes, in, out, ccmode_gcm_encrypt_blocks);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+int ccmode_gcm_finalize(ccgcm_ctx *ctx, size_t tag_size, void *tag)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+    unsigned char computed_tag[CCGCM_BLOCK_NBYTES];
+    int rc = CCERR_OK;
+
+    if (key->state != CCMODE_GCM_STATE_IV && key->state != CCMODE_GCM_STATE_AAD && key->state != CCMODE_GCM_STATE_TEXT) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    if (tag_size == 0 || tag_size > CCGCM_BLOCK_NBYTES) {
+        return CCMODE_INVALID_INPUT;
+    }
+
+    /* finish whichever partial block is still sitting in X */
+    if ((key->state == CCMODE_GCM_STATE_TEXT && (key->text_nbytes % CCGCM_BLOCK_NBYTES)) ||
+        (key->state == CCMODE_GCM_STATE_AAD && (key->aad_nbytes % CCGCM_BLOCK_NBYTES))) {
+        ccmode_gcm_mult_x(key);
+    }
+
+    /* [len(A)]_64 || [len(C)]_64, in bits */
+    CC_STORE64_BE(key->aad_nbytes * 8, key->buf);
+    CC_STORE64_BE(key->text_nbytes * 8, key->buf + 8);
+    key->ghash(key, 1, key->buf);
+
+    /* T = E(K, J0) ^ S */
+    key->ecb->ecb(CCMODE_GCM_KEY_ECB_CTX(key), 1, key->Y_0, computed_tag);
+    ccmode_xor(CCGCM_BLOCK_NBYTES, computed_tag, computed_tag, key->X);
+
+    if (key->encdec == CCMODE_GCM_DECRYPTOR) {
+        if (cc_cmp_safe(tag_size, computed_tag, tag)) {
+            rc = CCMODE_INTEGRITY_FAILURE;
+        }
+    }
+
+    /* decryptors get the computed tag back too, see ccgcm_finalize() */
+    cc_memcpy(tag, computed_tag, tag_size);
+
+    cc_clear(sizeof(computed_tag), computed_tag);
+    cc_clear(CCGCM_BLOCK_NBYTES, key->buf);
+    key->state = CCMODE_GCM_STATE_FINAL;
+
+    return rc;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * c = a * b in GF(2^128) with the GCM bit order, one bit at a time.
+ *
+ * This is the reference multiply from SP800-38D; it has no table and no secret-dependent branches, which makes it the
+ * slowest option around. The modes use the precomputed tables in ccmode_gcm_ghash.c instead.
+ */
+void ccmode_gcm_gf_mult(const unsigned char *a, const unsigned char *b, unsigned char *c)
+{
+    uint64_t Z0 = 0, Z1 = 0;
+    uint64_t V0, V1;
+
+    CC_LOAD64_BE(V0, b);
+    CC_LOAD64_BE(V1, b + 8);
+
+    for (size_t i = 0; i < 128; i++) {
+        uint64_t bit = (uint64_t)((a[i / 8] >> (7 - (i % 8))) & 1);
+        uint64_t lsb = V1 & 1;
+
+        Z0 ^= V0 & (0 - bit);
+        Z1 ^= V1 & (0 - bit);
+
+        V1 = (V1 >> 1) | (V0 << 63);
+        V0 = (V0 >> 1) ^ (0xe100000000000000ULL & (0 - lsb));
+    }
+
+    CC_STORE64_BE(Z0, c);
+    CC_STORE64_BE(Z1, c + 8);
+}
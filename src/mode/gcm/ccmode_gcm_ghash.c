@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * Portable GHASH using Shoup's 4-bit tables.
+ *
+ * The table holds i * H for every 4-bit i, split into the high and low 64 bits of the product, so a multiply by H is
+ * 32 lookups and shifts instead of 128 conditional XORs. Reducing the four bits that fall off the end of each shift is
+ * done with the small last4 table below.
+ */
+
+static const uint64_t ccmode_gcm_last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+#define HTABLE_HI(key) ((uint64_t *)CCMODE_GCM_KEY_HTABLE(key))
+#define HTABLE_LO(key) ((uint64_t *)CCMODE_GCM_KEY_HTABLE(key) + 16)
+
+void ccmode_gcm_gen_table(struct _ccmode_gcm_key *key)
+{
+    uint64_t *HH = HTABLE_HI(key);
+    uint64_t *HL = HTABLE_LO(key);
+    uint64_t vh, vl;
+
+    CC_LOAD64_BE(vh, key->H);
+    CC_LOAD64_BE(vl, key->H + 8);
+
+    /* index 8 (the top bit of the nibble) is H itself, 4, 2 and 1 are successive halvings of it */
+    HH[0] = 0;
+    HL[0] = 0;
+    HH[8] = vh;
+    HL[8] = vl;
+
+    for (size_t i = 4; i > 0; i >>= 1) {
+        uint64_t T = (vl & 1) * 0xe1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (T << 32);
+        HH[i] = vh;
+        HL[i] = vl;
+    }
+
+    /* everything else is a sum of the above */
+    for (size_t i = 2; i <= 8; i *= 2) {
+        vh = HH[i];
+        vl = HL[i];
+        for (size_t j = 1; j < i; j++) {
+            HH[i + j] = vh ^ HH[j];
+            HL[i + j] = vl ^ HL[j];
+        }
+    }
+}
+
+/* X = X * H */
+static void ccmode_gcm_mult_table(const struct _ccmode_gcm_key *key, unsigned char *X)
+{
+    const uint64_t *HH = HTABLE_HI(key);
+    const uint64_t *HL = HTABLE_LO(key);
+    uint64_t zh, zl;
+    uint8_t lo, hi, rem;
+
+    lo = X[15] & 0xf;
+    zh = HH[lo];
+    zl = HL[lo];
+
+    for (int i = 15; i >= 0; i--) {
+        lo = X[i] & 0xf;
+        hi = (X[i] >> 4) & 0xf;
+
+        if (i != 15) {
+            rem = (uint8_t)(zl & 0xf);
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (ccmode_gcm_last4[rem] << 48);
+            zh ^= HH[lo];
+            zl ^= HL[lo];
+        }
+
+        rem = (uint8_t)(zl & 0xf);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (ccmode_gcm_last4[rem] << 48);
+        zh ^= HH[hi];
+        zl ^= HL[hi];
+    }
+
+    CC_STORE64_BE(zh, X);
+    CC_STORE64_BE(zl, X + 8);
+}
+
+void ccmode_gcm_ghash_table(struct _ccmode_gcm_key *key, size_t nblocks, const unsigned char *in)
+{
+    while (nblocks--) {
+        ccmode_xor(CCGCM_BLOCK_NBYTES, key->X, key->X, in);
+        ccmode_gcm_mult_table(key, key->X);
+        in += CCGCM_BLOCK_NBYTES;
+    }
+}
+
+void ccmode_gcm_mult_h(ccgcm_ctx *ctx, unsigned char *I)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+    unsigned char X[CCGCM_BLOCK_NBYTES];
+
+    /* borrow the accumulator so any GHASH backend can do the multiply */
+    cc_memcpy(X, key->X, sizeof(X));
+    cc_memcpy(key->X, I, CCGCM_BLOCK_NBYTES);
+    ccmode_gcm_mult_x(key);
+    cc_memcpy(I, key->X, CCGCM_BLOCK_NBYTES);
+    cc_memcpy(key->X, X, sizeof(X));
+    cc_clear(sizeof(X), X);
+}
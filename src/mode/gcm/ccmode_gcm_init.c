@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cc_runtime_config.h>
+#include <corecrypto/ccmode_internal.h>
+
+int ccmode_gcm_init(const struct ccmode_gcm *gcm, ccgcm_ctx *ctx, size_t rawkey_len, const void *rawkey)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+    int rc;
+
+    cc_clear(sizeof(*key), key);
+
+    key->ecb = gcm->custom;
+    key->ecb_key = key->u;
+    key->encdec = gcm->encdec;
+
+    rc = key->ecb->init(key->ecb, CCMODE_GCM_KEY_ECB_CTX(key), rawkey_len, rawkey);
+    if (rc != CCERR_OK) {
+        return rc;
+    }
+
+    /* H = E(K, 0^128) */
+    key->ecb->ecb(CCMODE_GCM_KEY_ECB_CTX(key), 1, key->H, key->H);
+
+#if CCMODE_GCM_VNG_SPEEDUP
+    if (CC_HAS_PCLMULQDQ()) {
+        ccmode_gcm_gen_table_clmul(key);
+        key->ghash = ccmode_gcm_ghash_clmul;
+    } else
+#endif
+    {
+        ccmode_gcm_gen_table(key);
+        key->ghash = ccmode_gcm_ghash_table;
+    }
+
+    key->state = CCMODE_GCM_STATE_INIT;
+
+    return CCERR_OK;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+int ccmode_gcm_reset(ccgcm_ctx *ctx)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+
+    /* keep the key, H and its table, drop everything tied to the last message */
+    cc_clear(CCGCM_BLOCK_NBYTES, key->X);
+    cc_clear(CCGCM_BLOCK_NBYTES, key->Y);
+    cc_clear(CCGCM_BLOCK_NBYTES, key->buf);
+    key->buf_nbytes = 0;
+    key->aad_nbytes = 0;
+    key->text_nbytes = 0;
+
+    /*
+     * Y_0 is kept so ccgcm_inc_iv() can derive the next IV from it; a fresh IV (set_iv or inc_iv) is
+     * needed before the context can be used again either way.
+     */
+    key->state = CCMODE_GCM_STATE_INIT;
+
+    return CCERR_OK;
+}
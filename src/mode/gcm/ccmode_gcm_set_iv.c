@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+int ccmode_gcm_set_iv_internal(ccgcm_ctx *ctx, size_t iv_nbytes, const void *iv)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+
+    if (key->state != CCMODE_GCM_STATE_INIT && key->state != CCMODE_GCM_STATE_IV) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    if (iv_nbytes == CCGCM_IV_NBYTES) {
+        /* J0 = IV || 0^31 || 1 */
+        cc_memcpy(key->Y_0, iv, CCGCM_IV_NBYTES);
+        CC_STORE32_BE(1, key->Y_0 + CCGCM_IV_NBYTES);
+    } else {
+        /* J0 = GHASH(IV || 0^s || 0^64 || [len(IV)]_64), run through X which is still clear at this point */
+        unsigned char block[CCGCM_BLOCK_NBYTES];
+        size_t nblocks = iv_nbytes / CCGCM_BLOCK_NBYTES;
+        size_t rem = iv_nbytes % CCGCM_BLOCK_NBYTES;
+
+        cc_clear(CCGCM_BLOCK_NBYTES, key->X);
+        key->ghash(key, nblocks, iv);
+
+        if (rem) {
+            cc_clear(sizeof(block), block);
+            cc_memcpy(block, (const uint8_t *)iv + nblocks * CCGCM_BLOCK_NBYTES, rem);
+            key->ghash(key, 1, block);
+        }
+
+        cc_clear(sizeof(block), block);
+        CC_STORE64_BE((uint64_t)iv_nbytes * 8, block + 8);
+        key->ghash(key, 1, block);
+
+        cc_memcpy(key->Y_0, key->X, CCGCM_BLOCK_NBYTES);
+        cc_clear(CCGCM_BLOCK_NBYTES, key->X);
+    }
+
+    cc_memcpy(key->Y, key->Y_0, CCGCM_BLOCK_NBYTES);
+    key->aad_nbytes = 0;
+    key->text_nbytes = 0;
+    key->state = CCMODE_GCM_STATE_IV;
+
+    return CCERR_OK;
+}
+
+int ccmode_gcm_set_iv(ccgcm_ctx *ctx, size_t iv_nbytes, const void *iv)
+{
+    struct _ccmode_gcm_key *key = _CCMODE_GCM_KEY(ctx);
+
+    /* contexts set up with ccgcm_init_with_iv() manage their own IVs */
+    if (key->flags & CCGCM_FLAGS_INIT_WITH_IV) {
+        return CCMODE_INVALID_CALL_SEQUENCE;
+    }
+
+    if (iv_nbytes == 0) {
+        return CCMODE_INVALID_INPUT;
+    }
+
+    return ccmode_gcm_set_iv_internal(ctx, iv_nbytes, iv);
+}
@@ -22,7 +22,7 @@
 void ccmode_factory_xts_decrypt(struct ccmode_xts *xts, const struct ccmode_ecb *ecb, const struct ccmode_ecb *ecb_encrypt)
 {
     /* Fill in size parameters */
-    xts->size = ccn_sizeof_size(sizeof(struct _ccmode_xts_key)) + 2 * ccn_sizeof_size(ecb->size);
+    xts->size = ccn_sizeof_size(sizeof(struct _ccmode_xts_key)) + ccn_sizeof_size(ecb->size) + ccn_sizeof_size(ecb_encrypt->size);
     xts->block_size = ccecb_block_size(ecb);
     xts->tweak_size = ccn_sizeof_size(sizeof(struct _ccmode_xts_tweak)) + ccn_sizeof_size(ecb->block_size);
 
@@ -31,6 +31,7 @@ void ccmode_factory_xts_decrypt(struct ccmode_xts *xts, const struct ccmode_ecb
     xts->key_sched = ccmode_xts_key_sched;
     xts->set_tweak = ccmode_xts_set_tweak;
     xts->xts = ccmode_xts_crypt;
+    xts->xts_sectors = ccmode_xts_sectors;
 
     /* Populate the custom fields */
     xts->custom = ecb;
@@ -40,7 +41,7 @@ void ccmode_factory_xts_decrypt(struct ccmode_xts *xts, const struct ccmode_ecb
 void ccmode_factory_xts_encrypt(struct ccmode_xts *xts, const struct ccmode_ecb *ecb, const struct ccmode_ecb *ecb_encrypt)
 {
     /* Fill in size parameters */
-    xts->size = ccn_sizeof_size(sizeof(struct _ccmode_xts_key)) + 2 * ccn_sizeof_size(ecb->size);
+    xts->size = ccn_sizeof_size(sizeof(struct _ccmode_xts_key)) + ccn_sizeof_size(ecb->size) + ccn_sizeof_size(ecb_encrypt->size);
     xts->block_size = ccecb_block_size(ecb);
     xts->tweak_size = ccn_sizeof_size(sizeof(struct _ccmode_xts_tweak)) + ccn_sizeof_size(ecb->block_size);
 
@@ -49,6 +50,7 @@ void ccmode_factory_xts_encrypt(struct ccmode_xts *xts, const struct ccmode_ecb
     xts->key_sched = ccmode_xts_key_sched;
     xts->set_tweak = ccmode_xts_set_tweak;
     xts->xts = ccmode_xts_crypt;
+    xts->xts_sectors = ccmode_xts_sectors;
 
     /* Populate the custom fields */
     xts->custom = ecb;
@@ -38,47 +38,55 @@ void ccmode_xts_mult_alpha(uint8_t *I)
 
 /* the function that everyone's been waiting for. */
 
-/* ccmode_xts's declaration says we return the pointer to the tweak buffer */
+/*
+ * ccmode_xts's declaration says we return the pointer to the tweak buffer.
+ *
+ * The tweaks for a run of blocks are worked out up front, so the whole run goes through the ECB layer in one call
+ * and parallel ciphers (bitsliced, AES-NI) get to overlap the blocks.
+ */
 void *ccmode_xts_crypt(const ccxts_ctx *ctx, ccxts_tweak *tweak,
                        size_t nblocks, const void *in, void *out)
 {
     /* grab our actual key and tweak pointers */
     struct _ccmode_xts_key *key = (struct _ccmode_xts_key *)ctx;
     struct _ccmode_xts_tweak *twk = (struct _ccmode_xts_tweak *)tweak;
+    size_t block_size = ccecb_block_size(key->ecb);
+    uint8_t tweaks[CCMODE_XTS_MAX_PARALLEL_NBLOCKS * 16];
+    const uint8_t *p = in;
+    uint8_t *c = out;
 
     /*
      * set_tweak has already been called at this point, therefore we don't need
      * to worry about anything to do with tweak enc
      */
 
-    /* so, does XTS have a set block size? */
-    while (nblocks--) {
-        /* en/de crypt the block using the tweak */
-
-        /* check that the tweak counter hasn't overflowed. */
-        if (twk->blocks_processed >= CCMODE_XTS_TWEAK_MAX_BLOCKS_PROCESSED) {
-            /* We shouldn't en/de crypt any futher as per FIPS */
-            return NULL;
-        }
-
-        /* first, XOR the plaintext with the tweak */
-        cc_xor(ccecb_block_size(key->ecb), out, in, &twk->u);
+    /* check that the tweak counter won't overflow, we shouldn't en/de crypt any further as per FIPS */
+    if (nblocks > CCMODE_XTS_TWEAK_MAX_BLOCKS_PROCESSED - twk->blocks_processed) {
+        return NULL;
+    }
 
-        /* then, en/de crypt the block using ecb */
-        ccecb_update(key->ecb, CCMODE_XTS_KEY_ECB_CTX(key), 1, out, out);
+    while (nblocks) {
+        size_t n = CC_MIN(nblocks, CCMODE_XTS_MAX_PARALLEL_NBLOCKS);
 
-        /* then, XOR the block using the tweak */
-        cc_xor(ccecb_block_size(key->ecb), out, out, &twk->u);
+        /* T_j, T_j * alpha, ... */
+        for (size_t i = 0; i < n; i++) {
+            cc_memcpy(tweaks + i * block_size, twk->u, block_size);
+            ccmode_xts_mult_alpha((uint8_t *)twk->u);
+        }
 
-        /* then, multiply the tweak */
-        ccmode_xts_mult_alpha((uint8_t *)&twk->u);
+        /* XOR with the tweak, en/de crypt the run using ecb, XOR with the tweak again */
+        ccmode_xor(n * block_size, c, p, tweaks);
+        ccecb_update(key->ecb, CCMODE_XTS_KEY_ECB_CTX(key), n, c, c);
+        ccmode_xor(n * block_size, c, c, tweaks);
 
-        /* finally, increment the tweak counter and progress the pointers. */
-        twk->blocks_processed++;
+        twk->blocks_processed += n;
 
-        in += ccecb_block_size(key->ecb);
-        out += ccecb_block_size(key->ecb);
+        p += n * block_size;
+        c += n * block_size;
+        nblocks -= n;
     }
 
-    return &twk->u; /* Is this how it should work? */
+    cc_clear(sizeof(tweaks), tweaks);
+
+    return twk->u; /* Is this how it should work? */
 }
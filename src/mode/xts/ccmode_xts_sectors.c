@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+/*
+ * The sectors are contiguous and whole, so a run of blocks for the ECB call can cross from one sector into the next:
+ * each block just carries its own sector's tweak. Sectors shorter than CCMODE_XTS_MAX_PARALLEL_NBLOCKS blocks, or
+ * not a multiple of it, still fill every ECB call but the last.
+ */
+int ccmode_xts_sectors(const ccxts_ctx *ctx, uint64_t data_unit,
+                       size_t sector_nbytes, size_t nbytes,
+                       const void *in, void *out)
+{
+    struct _ccmode_xts_key *key = (struct _ccmode_xts_key *)ctx;
+    uint8_t tweaks[CCMODE_XTS_SECTORS_NTWEAKS * 16];
+    uint8_t run[CCMODE_XTS_MAX_PARALLEL_NBLOCKS * 16];
+    uint8_t T[16];
+    size_t sector_nblocks = sector_nbytes / 16;
+    size_t nsectors = nbytes / sector_nbytes;
+    size_t nblocks = nbytes / 16;
+    size_t ntweaks = 0, next_tweak = 0, left = 0;
+    const uint8_t *p = in;
+    uint8_t *c = out;
+
+    while (nblocks) {
+        size_t n = CC_MIN(nblocks, (size_t)CCMODE_XTS_MAX_PARALLEL_NBLOCKS);
+
+        for (size_t i = 0; i < n; i++) {
+            if (left == 0) {
+                /* one ECB call encrypts the tweaks of the next few sectors */
+                if (next_tweak == ntweaks) {
+                    ntweaks = CC_MIN(nsectors, (size_t)CCMODE_XTS_SECTORS_NTWEAKS);
+                    for (size_t j = 0; j < ntweaks; j++) {
+                        ccmode_xts_data_unit_iv(data_unit + j, tweaks + 16 * j);
+                    }
+                    ccecb_update(key->ecb_encrypt, CCMODE_XTS_KEY_ECB_ENCRYPT_CTX(key), ntweaks, tweaks, tweaks);
+                    data_unit += ntweaks;
+                    nsectors -= ntweaks;
+                    next_tweak = 0;
+                }
+                cc_memcpy(T, tweaks + 16 * next_tweak++, 16);
+                left = sector_nblocks;
+            }
+
+            cc_memcpy(run + 16 * i, T, 16);
+            ccmode_xts_mult_alpha(T);
+            left--;
+        }
+
+        ccmode_xor(n * 16, c, p, run);
+        ccecb_update(key->ecb, CCMODE_XTS_KEY_ECB_CTX(key), n, c, c);
+        ccmode_xor(n * 16, c, c, run);
+
+        p += n * 16;
+        c += n * 16;
+        nblocks -= n;
+    }
+
+    cc_clear(sizeof(tweaks), tweaks);
+    cc_clear(sizeof(run), run);
+    cc_clear(sizeof(T), T);
+
+    return CCERR_OK;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode_internal.h>
+
+int ccxts_update_sectors(const struct ccmode_xts *mode,
+                         ccxts_ctx *ctx,
+                         uint64_t data_unit,
+                         size_t sector_nbytes,
+                         size_t nbytes,
+                         const void *in,
+                         void *out)
+{
+    const uint8_t *p = in;
+    uint8_t *c = out;
+    uint8_t iv[16];
+    int rv = CCERR_OK;
+
+    if (ccxts_block_size(mode) != 16 || sector_nbytes == 0 || sector_nbytes % 16 ||
+        sector_nbytes / 16 > CCMODE_XTS_TWEAK_MAX_BLOCKS_PROCESSED || nbytes % sector_nbytes) {
+        return CCERR_PARAMETER;
+    }
+
+    if (mode->xts_sectors) {
+        return mode->xts_sectors(ctx, data_unit, sector_nbytes, nbytes, in, out);
+    }
+
+    /* modes without a batched path still save the caller the per-sector calls */
+    ccxts_tweak_decl(mode->tweak_size, tweak);
+    for (; nbytes; nbytes -= sector_nbytes) {
+        ccmode_xts_data_unit_iv(data_unit++, iv);
+        if ((rv = ccxts_set_tweak(mode, ctx, tweak, iv))) {
+            break;
+        }
+        if (ccxts_update(mode, ctx, tweak, sector_nbytes / 16, p, c) == NULL) {
+            rv = CCERR_PARAMETER;
+            break;
+        }
+        p += sector_nbytes;
+        c += sector_nbytes;
+    }
+    ccxts_tweak_clear(mode->tweak_size, tweak);
+
+    return rv;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cchmac.h>
+#include <corecrypto/ccnistkdf.h>
+
+//
+// NIST SP800-108r1, 4.1 KDF in Counter Mode
+//
+// K(i) = HMAC(K_IN, [i]_32 || Label || 0x00 || Context || [L]_32)
+//
+
+int ccnistkdf_ctr_hmac(struct ccdigest_info *digest,
+                       size_t key_len, const void *key,
+                       size_t label_len, const void *label,
+                       size_t context_len, const void *context,
+                       size_t derived_len, void *derived_key)
+{
+    uint8_t K[digest->output_size];
+    uint8_t ctr[4], L[4];
+    const uint8_t separator = 0;
+    uint8_t *out = derived_key;
+    size_t n = cc_ceiling(derived_len, digest->output_size);
+    cchmac_di_decl(digest, hmac);
+    cchmac_key_decl(digest, hmac_key);
+
+    if (derived_len == 0 || n > UINT32_MAX || derived_len > UINT32_MAX / 8) {
+        return CCERR_PARAMETER;
+    }
+
+    CC_STORE32_BE((uint32_t)(derived_len * 8), L);
+
+    // K_IN keys every block, its pads are only compressed once
+    cchmac_key_init(digest, hmac_key, key_len, key);
+
+    for (size_t i = 1; i <= n; i++) {
+        size_t nbytes = CC_MIN(derived_len, digest->output_size);
+
+        CC_STORE32_BE((uint32_t)i, ctr);
+
+        cchmac_init_with_key(digest, hmac, hmac_key);
+        cchmac_update(digest, hmac, sizeof(ctr), ctr);
+        cchmac_update(digest, hmac, label_len, label);
+        cchmac_update(digest, hmac, 1, &separator);
+        cchmac_update(digest, hmac, context_len, context);
+        cchmac_update(digest, hmac, sizeof(L), L);
+        cchmac_final(digest, hmac, K);
+
+        cc_memcpy(out, K, nbytes);
+        out += nbytes;
+        derived_len -= nbytes;
+    }
+
+    cchmac_di_clear(digest, hmac);
+    cchmac_key_clear(digest, hmac_key);
+    cc_clear(digest->output_size, K);
+
+    return CCERR_OK;
+}
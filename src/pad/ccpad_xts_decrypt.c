@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode.h>
+#include <corecrypto/ccmode_factory.h>
+#include <corecrypto/ccmode_internal.h>
+#include <corecrypto/ccpad.h>
+
+/* T in an opaque tweak: the generic modes keep a block count in front of it, the others store T alone */
+static uint8_t *ccpad_xts_tweak_block(const struct ccmode_xts *xts, ccxts_tweak *tweak)
+{
+    if (xts->set_tweak == ccmode_xts_set_tweak) {
+        return (uint8_t *)((struct _ccmode_xts_tweak *)tweak)->u;
+    }
+    return (uint8_t *)tweak;
+}
+
+/* undoes ccpad_xts_encrypt(), C_m-1 was made under the tweak after the one for C_m's position */
+size_t ccpad_xts_decrypt(const struct ccmode_xts *xts, ccxts_ctx *ctx, ccxts_tweak *tweak, size_t nbytes, const void *in, void *out)
+{
+    size_t block_size = ccxts_block_size(xts);
+    size_t nblocks = nbytes / block_size;
+    size_t tail = nbytes % block_size;
+    const uint8_t *ip = in;
+    uint8_t *op = out;
+    uint8_t cc[16], pp[16];
+    ccxts_tweak_decl(xts->tweak_size, next);
+
+    if (nbytes < block_size) {
+        return 0;
+    }
+
+    if (tail == 0) {
+        ccxts_update(xts, ctx, tweak, nblocks, in, out);
+        return nbytes;
+    }
+
+    if (nblocks > 1) {
+        ccxts_update(xts, ctx, tweak, nblocks - 1, ip, op);
+        ip += (nblocks - 1) * block_size;
+        op += (nblocks - 1) * block_size;
+    }
+
+    /* T_m = T_m-1 * alpha, in a copy of the tweak */
+    cc_memcpy(next, tweak, xts->tweak_size);
+    ccmode_xts_mult_alpha(ccpad_xts_tweak_block(xts, next));
+
+    /* PP = D(C_m-1) under T_m, its head is P_m and C_m || its tail is C_m-1's plaintext under T_m-1 */
+    ccxts_update(xts, ctx, next, 1, ip, pp);
+    cc_memcpy(cc, pp, block_size);
+    cc_memcpy(cc, ip + block_size, tail);
+    cc_memcpy(op + block_size, pp, tail);
+    ccxts_update(xts, ctx, tweak, 1, cc, op);
+
+    cc_clear(sizeof(cc), cc);
+    cc_clear(sizeof(pp), pp);
+    ccxts_tweak_clear(xts->tweak_size, next);
+
+    return nbytes;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccmode.h>
+#include <corecrypto/ccpad.h>
+
+/* IEEE 1619 ciphertext stealing: a partial last block borrows the tail of the one before it */
+void ccpad_xts_encrypt(const struct ccmode_xts *xts, ccxts_ctx *ctx, ccxts_tweak *tweak, size_t nbytes, const void *in, void *out)
+{
+    size_t block_size = ccxts_block_size(xts);
+    size_t nblocks = nbytes / block_size;
+    size_t tail = nbytes % block_size;
+    const uint8_t *ip = in;
+    uint8_t *op = out;
+    uint8_t cc[16], pp[16];
+
+    /* nothing to steal from */
+    if (nbytes < block_size) {
+        return;
+    }
+
+    if (tail == 0) {
+        ccxts_update(xts, ctx, tweak, nblocks, in, out);
+        return;
+    }
+
+    /* everything but the last whole block goes through in one run */
+    if (nblocks > 1) {
+        ccxts_update(xts, ctx, tweak, nblocks - 1, ip, op);
+        ip += (nblocks - 1) * block_size;
+        op += (nblocks - 1) * block_size;
+    }
+
+    /* CC = E(P_m-1), its head is C_m and P_m || its tail becomes C_m-1 */
+    ccxts_update(xts, ctx, tweak, 1, ip, cc);
+    cc_memcpy(pp, cc, block_size);
+    cc_memcpy(pp, ip + block_size, tail);
+    cc_memcpy(op + block_size, cc, tail);
+    ccxts_update(xts, ctx, tweak, 1, pp, op);
+
+    cc_clear(sizeof(cc), cc);
+    cc_clear(sizeof(pp), pp);
+}
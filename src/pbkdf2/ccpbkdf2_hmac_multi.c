@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccdigest_priv.h>
+#include <corecrypto/cchmac.h>
+#include <corecrypto/ccpbkdf2.h>
+
+/*
+ * Every U_i after the first is HMAC(P, U_{i-1}), and U_{i-1} is shorter than a
+ * block. With the key^ipad and key^opad midstates of a prepared cchmac_key,
+ * an iteration is then exactly two compressions of blocks whose padding never
+ * changes, so the padding is written once and only the hLen-byte digests are
+ * rewritten per iteration.
+ *
+ * Output blocks (of one or several passwords) are independent, so a pass
+ * iterates up to CCPBKDF2_MAX_LANES of them in lockstep through the
+ * multi-buffer compress kernels when di has them.
+ */
+
+#define CCPBKDF2_MAX_LANES        8
+#define CCPBKDF2_MAX_STATE_NBYTES 64
+#define CCPBKDF2_MAX_BLOCK_NBYTES 128
+
+struct ccpbkdf2_lane {
+    uint64_t istate[CCPBKDF2_MAX_STATE_NBYTES / 8];
+    uint64_t ostate[CCPBKDF2_MAX_STATE_NBYTES / 8];
+    uint64_t s[CCPBKDF2_MAX_STATE_NBYTES / 8];
+    uint8_t u[CCPBKDF2_MAX_BLOCK_NBYTES];   /* U_i, then the inner message padding */
+    uint8_t o[CCPBKDF2_MAX_BLOCK_NBYTES];   /* the inner digest, then the outer message padding */
+    uint8_t t[CCPBKDF2_MAX_STATE_NBYTES];   /* U_1 ^ ... ^ U_i */
+    uint8_t *dk;
+    size_t nbytes;
+};
+
+static bool ccpbkdf2_md_format(const struct ccdigest_info *di, struct ccdigest_md_format *fmt)
+{
+    return di->state_size <= CCPBKDF2_MAX_STATE_NBYTES && ccdigest_md_format(di, fmt);
+}
+
+static void ccpbkdf2_compress(const struct ccdigest_info *di, const struct ccdigest_multi_compress *k,
+                              size_t nlanes, ccdigest_state_t *states, const uint8_t **data)
+{
+    size_t i;
+
+    if (k) {
+        k->compress(states, 1, data);
+    } else {
+        for (i = 0; i < nlanes; i++) {
+            di->compress(states[i], 1, data[i]);
+        }
+    }
+}
+
+static void ccpbkdf2_iterate(const struct ccdigest_info *di, const struct ccdigest_md_format *fmt,
+                             const struct ccdigest_multi_compress *k, size_t nlanes,
+                             struct ccpbkdf2_lane *lanes, size_t iterations)
+{
+    uint64_t dummy[CCDIGEST_MULTI_MAX_LANES * CCPBKDF2_MAX_STATE_NBYTES / 8] = { 0 };
+    ccdigest_state_t states[CCDIGEST_MULTI_MAX_LANES];
+    const uint8_t *inner[CCDIGEST_MULTI_MAX_LANES], *outer[CCDIGEST_MULTI_MAX_LANES];
+    size_t hlen = di->output_size, i, j;
+
+    /* kernels run all their lanes, the unused ones hash a copy of lane 0 into scratch */
+    for (i = 0; i < (k ? k->nlanes : nlanes); i++) {
+        if (i < nlanes) {
+            states[i] = (ccdigest_state_t)lanes[i].s;
+            inner[i] = lanes[i].u;
+            outer[i] = lanes[i].o;
+        } else {
+            states[i] = (ccdigest_state_t)&dummy[i * CCPBKDF2_MAX_STATE_NBYTES / 8];
+            inner[i] = lanes[0].u;
+            outer[i] = lanes[0].o;
+        }
+    }
+
+    for (i = 0; i < nlanes; i++) {
+        ccdigest_md_pad_block(di, fmt, hlen, lanes[i].u);
+        ccdigest_md_pad_block(di, fmt, hlen, lanes[i].o);
+    }
+
+    while (--iterations) {
+        for (i = 0; i < nlanes; i++) {
+            cc_memcpy(lanes[i].s, lanes[i].istate, di->state_size);
+        }
+        ccpbkdf2_compress(di, k, nlanes, states, inner);
+
+        for (i = 0; i < nlanes; i++) {
+            ccdigest_md_store(fmt, hlen, lanes[i].s, lanes[i].o);
+            cc_memcpy(lanes[i].s, lanes[i].ostate, di->state_size);
+        }
+        ccpbkdf2_compress(di, k, nlanes, states, outer);
+
+        for (i = 0; i < nlanes; i++) {
+            ccdigest_md_store(fmt, hlen, lanes[i].s, lanes[i].u);
+            for (j = 0; j < hlen; j++) {
+                lanes[i].t[j] ^= lanes[i].u[j];
+            }
+        }
+    }
+
+    cc_clear(sizeof(dummy), dummy);
+}
+
+/* digests the fast path does not know about (or that are too big for it) get whole HMACs off the saved midstates */
+static void ccpbkdf2_iterate_hmac(const struct ccdigest_info *di, cchmac_key_t hk, cchmac_ctx_t work,
+                                  uint8_t *u, uint8_t *t, size_t iterations)
+{
+    size_t hlen = di->output_size, j;
+
+    while (--iterations) {
+        cchmac_init_with_key(di, work, hk);
+        cchmac_update(di, work, hlen, u);
+        cchmac_final(di, work, u);
+        for (j = 0; j < hlen; j++) {
+            t[j] ^= u[j];
+        }
+    }
+}
+
+int ccpbkdf2_hmac_multi(const struct ccdigest_info *di,
+                        size_t njobs, const struct ccpbkdf2_hmac_job *jobs,
+                        size_t iterations,
+                        size_t dk_nbytes)
+{
+    struct ccpbkdf2_lane lanes[CCPBKDF2_MAX_LANES];
+    const struct ccdigest_multi_compress *kernels = NULL, *k;
+    struct ccdigest_md_format fmt;
+    size_t hlen = di->output_size;
+    size_t nblocks = (dk_nbytes + hlen - 1) / hlen;
+    size_t nlanes, n, job = 0, block = 0, i;
+    uint8_t ctr[4];
+    bool fast = ccpbkdf2_md_format(di, &fmt);
+    cchmac_key_decl(di, hk);
+    cchmac_di_decl(di, work);
+
+    if (nblocks > UINT32_MAX) {
+        return CCERR_PARAMETER;
+    }
+    if (iterations == 0) {
+        iterations = 1;
+    }
+    if (fast) {
+        kernels = ccdigest_multi_kernels(di);
+    }
+
+    while (job < njobs && nblocks > 0) {
+        /* fill a pass with the next output blocks, in job order */
+        nlanes = 0;
+        while (nlanes < CCPBKDF2_MAX_LANES && job < njobs) {
+            struct ccpbkdf2_lane *lane = &lanes[nlanes];
+
+            /* the password's pads are compressed once for all of its output blocks */
+            if (block == 0) {
+                cchmac_key_init(di, hk, jobs[job].password_nbytes, jobs[job].password);
+            }
+
+            /* U_1 = PRF(P, S || INT(block + 1)) */
+            CC_STORE32_BE((uint32_t)(block + 1), ctr);
+            cchmac_init_with_key(di, work, hk);
+            cchmac_update(di, work, jobs[job].salt_nbytes, jobs[job].salt);
+            cchmac_update(di, work, sizeof(ctr), ctr);
+            cchmac_final(di, work, lane->u);
+            cc_memcpy(lane->t, lane->u, hlen);
+
+            lane->dk = (uint8_t *)jobs[job].dk + block * hlen;
+            lane->nbytes = CC_MIN(hlen, dk_nbytes - block * hlen);
+
+            if (fast) {
+                cc_memcpy(lane->istate, cchmac_key_istate(di, hk), di->state_size);
+                cc_memcpy(lane->ostate, cchmac_key_ostate(di, hk), di->state_size);
+                nlanes++;
+            } else {
+                ccpbkdf2_iterate_hmac(di, hk, work, lane->u, lane->t, iterations);
+                cc_memcpy(lane->dk, lane->t, lane->nbytes);
+            }
+
+            if (++block == nblocks) {
+                block = 0;
+                job++;
+            }
+        }
+
+        for (i = 0; i < nlanes; i += n) {
+            n = nlanes - i;
+            /* one lane is faster through the scalar compress */
+            k = n > 1 ? ccdigest_multi_select(kernels, n) : NULL;
+            if (k && k->nlanes < n) {
+                n = k->nlanes;
+            }
+            ccpbkdf2_iterate(di, &fmt, k, n, &lanes[i], iterations);
+        }
+
+        for (i = 0; i < nlanes; i++) {
+            cc_memcpy(lanes[i].dk, lanes[i].t, lanes[i].nbytes);
+        }
+    }
+
+    cc_clear(sizeof(lanes), lanes);
+    cchmac_key_clear(di, hk);
+    cchmac_di_clear(di, work);
+    return CCERR_OK;
+}
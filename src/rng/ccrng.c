@@ -16,8 +16,190 @@
  * @LICENSE_HEADER_END@
  */
 
+
+#include <corecrypto/cc_config.h>
+
+#if !CC_KERNEL
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <corecrypto/cc_priv.h>
 #include <corecrypto/ccaes.h>
-#include <corecrypto/ccmode_impl.h>
+#include <corecrypto/ccdrbg.h>
 #include <corecrypto/ccrng.h>
+#include <corecrypto/ccrng_system.h>
 
 /* CommonCrypto calls this RNG a DRBG. I assume this means the default RNG is actually the NIST CTR DRBG */
+
+/*
+ * Every thread gets its own AES-256 CTR_DRBG, instantiated from the system RNG
+ * the first time it asks for bytes, so the generate path takes no locks and
+ * shares no writable state. The only shared word is the fork generation, bumped
+ * in the child by a pthread_atfork() handler: a DRBG seeded under an older
+ * generation was copied from the parent and is instantiated again before use.
+ * A thread also reseeds from the system RNG every CCRNG_RESEED_NREQUESTS calls.
+ */
+
+#define CCRNG_ENTROPY_NBYTES   32
+#define CCRNG_NONCE_NBYTES     16
+#define CCRNG_BUFFER_NBYTES    1024
+#define CCRNG_RESEED_NREQUESTS ((uint64_t)1 << 20)
+
+struct ccrng_thread {
+    uint64_t generation;    // fork generation the DRBG was instantiated in
+    uint64_t nrequests;     // generate calls since the last (re)seed
+};
+
+#define CCRNG_THREAD_DRBG(t) ((struct ccdrbg_state *)((uint8_t *)(t) + cc_pad_align(sizeof(struct ccrng_thread))))
+
+static struct ccdrbg_nistctr_custom ccrng_drbg_custom;
+static struct ccdrbg_info ccrng_drbg_info;
+static struct ccrng_system_state ccrng_seed_rng;
+static pthread_once_t ccrng_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ccrng_thread_key;
+static int ccrng_init_status;
+static uint64_t ccrng_generation;
+
+static __thread struct ccrng_thread *ccrng_thread_state;
+
+static int ccrng_thread_generate(struct ccrng_state *rng, size_t outlen, void *out);
+
+static struct ccrng_state ccrng_thread_rng = { .generate = ccrng_thread_generate };
+
+static void ccrng_atfork_child(void)
+{
+    __atomic_add_fetch(&ccrng_generation, 1, __ATOMIC_RELAXED);
+}
+
+static void ccrng_thread_done(void *arg)
+{
+    struct ccrng_thread *t = arg;
+
+    ccdrbg_done(&ccrng_drbg_info, CCRNG_THREAD_DRBG(t));
+    cc_clear(sizeof(*t), t);
+    free(t);
+    ccrng_thread_state = NULL;
+}
+
+static void ccrng_init_once(void)
+{
+    ccrng_drbg_custom = (struct ccdrbg_nistctr_custom){
+        .ctr_info = ccaes_ctr_crypt_mode(),
+        .keylen = CCAES_KEY_SIZE_256,
+        .strictFIPS = 0,
+        .use_df = 1,
+        .buffer_nbytes = CCRNG_BUFFER_NBYTES,
+    };
+    ccdrbg_factory_nistctr(&ccrng_drbg_info, &ccrng_drbg_custom);
+
+    ccrng_init_status = ccrng_system_init(&ccrng_seed_rng);
+    if (ccrng_init_status) {
+        return;
+    }
+    if (pthread_key_create(&ccrng_thread_key, ccrng_thread_done)) {
+        ccrng_init_status = CCERR_INTERNAL;
+        return;
+    }
+    if (pthread_atfork(NULL, NULL, ccrng_atfork_child)) {
+        ccrng_init_status = CCERR_ATFORK;
+    }
+}
+
+// Instantiate (or reseed) the thread's DRBG with fresh system entropy
+static int ccrng_thread_seed(struct ccrng_thread *t, uint64_t generation, bool instantiate)
+{
+    uint8_t seed[CCRNG_ENTROPY_NBYTES + CCRNG_NONCE_NBYTES];
+    int rc;
+
+    rc = ccrng_generate(&ccrng_seed_rng, sizeof(seed), seed);
+    if (rc == CCERR_OK) {
+        if (instantiate) {
+            rc = ccdrbg_init(&ccrng_drbg_info, CCRNG_THREAD_DRBG(t), CCRNG_ENTROPY_NBYTES, seed,
+                             CCRNG_NONCE_NBYTES, seed + CCRNG_ENTROPY_NBYTES, 0, NULL);
+        } else {
+            rc = ccdrbg_reseed(&ccrng_drbg_info, CCRNG_THREAD_DRBG(t), sizeof(seed), seed, 0, NULL);
+        }
+    }
+    if (rc == CCERR_OK) {
+        t->generation = generation;
+        t->nrequests = 0;
+    }
+
+    cc_clear(sizeof(seed), seed);
+    return rc;
+}
+
+static int ccrng_thread_create(uint64_t generation, struct ccrng_thread **tp)
+{
+    struct ccrng_thread *t = malloc(cc_pad_align(sizeof(struct ccrng_thread)) + ccdrbg_context_size(&ccrng_drbg_info));
+    int rc;
+
+    if (t == NULL) {
+        return CCERR_MEMORY_ALLOC_FAIL;
+    }
+
+    rc = ccrng_thread_seed(t, generation, true);
+    if (rc) {
+        free(t);
+        return rc;
+    }
+
+    // the key only frees the DRBG when the thread exits
+    if (pthread_setspecific(ccrng_thread_key, t)) {
+        ccdrbg_done(&ccrng_drbg_info, CCRNG_THREAD_DRBG(t));
+        free(t);
+        return CCERR_INTERNAL;
+    }
+
+    *tp = t;
+    return CCERR_OK;
+}
+
+static int ccrng_thread_generate(CC_UNUSED struct ccrng_state *rng, size_t outlen, void *out)
+{
+    struct ccrng_thread *t = ccrng_thread_state;
+    uint64_t generation = __atomic_load_n(&ccrng_generation, __ATOMIC_RELAXED);
+    uint8_t *p = out;
+    int rc = CCERR_OK;
+
+    if (t == NULL) {
+        rc = ccrng_thread_create(generation, &t);
+        ccrng_thread_state = t;
+    } else if (t->generation != generation) {
+        rc = ccrng_thread_seed(t, generation, true);
+    } else if (t->nrequests >= CCRNG_RESEED_NREQUESTS) {
+        rc = ccrng_thread_seed(t, generation, false);
+    }
+    if (rc) {
+        return rc;
+    }
+
+    while (outlen) {
+        size_t n = CC_MIN(outlen, (size_t)CCDRBG_MAX_REQUEST_SIZE);
+
+        rc = ccdrbg_generate(&ccrng_drbg_info, CCRNG_THREAD_DRBG(t), n, p, 0, NULL);
+        if (rc) {
+            cc_clear((size_t)(p - (uint8_t *)out), out);
+            return rc;
+        }
+        p += n;
+        outlen -= n;
+    }
+
+    t->nrequests++;
+    return CCERR_OK;
+}
+
+struct ccrng_state *ccrng(int *error)
+{
+    pthread_once(&ccrng_once, ccrng_init_once);
+
+    if (error) {
+        *error = ccrng_init_status;
+    }
+    return ccrng_init_status ? NULL : &ccrng_thread_rng;
+}
+
+#endif /* !CC_KERNEL */
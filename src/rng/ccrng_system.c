@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if !CC_KERNEL
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#elif defined(__APPLE__)
+#include <sys/random.h>
+#endif
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccrng_system.h>
+
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+
+/*
+ * No file descriptor is kept: a long lived one gets closed or dup2()ed over
+ * by daemons that sweep their fds, and then reads from whatever took its
+ * number. getrandom() on Linux and getentropy() elsewhere need no fd at all.
+ * Where neither exists (or the kernel says ENOSYS), /dev/urandom is opened
+ * for each request.
+ */
+#if defined(__linux__) && defined(SYS_getrandom)
+#define CCRNG_SYSTEM_GETRANDOM 1
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+#define CCRNG_SYSTEM_GETENTROPY 1
+#endif
+
+// getentropy() refuses more than this per call
+#define CCRNG_SYSTEM_GETENTROPY_MAX 256
+
+static int ccrng_system_read_device(size_t outlen, uint8_t *out)
+{
+    int fd;
+
+    do {
+        fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+        return CCERR_FILEDESC;
+    }
+
+    while (outlen) {
+        ssize_t n = read(fd, out, outlen);
+
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            close(fd);
+            return CCERR_OUT_OF_ENTROPY;
+        }
+        out += n;
+        outlen -= (size_t)n;
+    }
+
+    close(fd);
+    return CCERR_OK;
+}
+
+static int ccrng_system_generate(CC_UNUSED struct ccrng_state *rng, size_t outlen, void *out)
+{
+    uint8_t *p = out;
+    size_t nbytes = outlen;
+    int status = CCERR_OK;
+
+#if CCRNG_SYSTEM_GETRANDOM
+    while (outlen) {
+        long n = syscall(SYS_getrandom, p, outlen, 0);
+
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        p += n;
+        outlen -= (size_t)n;
+    }
+#elif CCRNG_SYSTEM_GETENTROPY
+    while (outlen) {
+        size_t n = CC_MIN(outlen, (size_t)CCRNG_SYSTEM_GETENTROPY_MAX);
+
+        if (getentropy(p, n)) {
+            break;
+        }
+        p += n;
+        outlen -= n;
+    }
+#endif
+
+    if (outlen) {
+        status = ccrng_system_read_device(outlen, p);
+    }
+    if (status) {
+        cc_clear(nbytes, out);
+    }
+    return status;
+}
+
+int ccrng_system_init(struct ccrng_system_state *rng)
+{
+    rng->generate = ccrng_system_generate;
+    rng->fd = -1;
+    return CCERR_OK;
+}
+
+void ccrng_system_done(struct ccrng_system_state *rng)
+{
+    rng->fd = -1;
+}
+
+#endif /* !CC_KERNEL */
@@ -16,10 +16,26 @@
  * @LICENSE_HEADER_END@
  */
 
+#include <corecrypto/cc_runtime_config.h>
 #include <corecrypto/ccsha1.h>
 
-/* prefer the LTC implementation? I don't even know what would trigger the other one to be used. */
 const struct ccdigest_info *ccsha1_di(void)
 {
+#if CCSHA1_VNG_INTEL && defined(__x86_64__)
+    /* the cpu doesn't change under us, so probe once; racing callers all store the same answer */
+    static const struct ccdigest_info *di = NULL;
+
+    if (di == NULL) {
+        if (CC_HAS_SHA()) {
+            di = &ccsha1_vng_intel_shani_di;
+        } else if (CC_HAS_AVX2()) {
+            di = &ccsha1_vng_intel_AVX2_di;
+        } else {
+            di = &ccsha1_ltc_di;
+        }
+    }
+    return di;
+#else
     return &ccsha1_ltc_di;
+#endif
 }
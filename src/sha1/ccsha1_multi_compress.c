@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "ccsha1_internal.h"
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccdigest_priv.h>
+
+#if CCDIGEST_MULTI_SIMD
+
+#define ROL(x, n)    (((x) << (n)) | ((x) >> (32 - (n))))
+#define F0(x, y, z)  (z ^ (x & (y ^ z)))
+#define F1(x, y, z)  (x ^ y ^ z)
+#define F2(x, y, z)  ((x & y) | (z & (x | y)))
+
+/* 4 lanes: one SSE2 or NEON register per word */
+#define CCSHA1_MULTI_FN    ccsha1_multi_compress_x4
+#define CCSHA1_MULTI_LANES 4
+#define CCSHA1_MULTI_ATTR
+#include "ccsha1_multi_template.h"
+#undef CCSHA1_MULTI_FN
+#undef CCSHA1_MULTI_LANES
+#undef CCSHA1_MULTI_ATTR
+
+#if CCDIGEST_MULTI_X86
+#define CCSHA1_MULTI_FN    ccsha1_multi_compress_x8
+#define CCSHA1_MULTI_LANES 8
+#define CCSHA1_MULTI_ATTR  __attribute__((target("avx2")))
+#include "ccsha1_multi_template.h"
+#undef CCSHA1_MULTI_FN
+#undef CCSHA1_MULTI_LANES
+#undef CCSHA1_MULTI_ATTR
+
+#define CCSHA1_MULTI_FN    ccsha1_multi_compress_x16
+#define CCSHA1_MULTI_LANES 16
+#define CCSHA1_MULTI_ATTR  __attribute__((target("avx512f")))
+#include "ccsha1_multi_template.h"
+#undef CCSHA1_MULTI_FN
+#undef CCSHA1_MULTI_LANES
+#undef CCSHA1_MULTI_ATTR
+#endif
+
+const struct ccdigest_multi_compress ccsha1_multi_compress[] = {
+#if CCDIGEST_MULTI_X86
+    { 16, CCDIGEST_MULTI_CPU_AVX512, ccsha1_multi_compress_x16 },
+    { 8, CCDIGEST_MULTI_CPU_AVX2, ccsha1_multi_compress_x8 },
+#endif
+    { 4, CCDIGEST_MULTI_CPU_ANY, ccsha1_multi_compress_x4 },
+    { 0, CCDIGEST_MULTI_CPU_ANY, NULL },
+};
+
+#endif /* CCDIGEST_MULTI_SIMD */
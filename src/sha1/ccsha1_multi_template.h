@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+/*
+ * Body of one multi-buffer SHA-1 kernel, included once per lane count by
+ * ccsha1_multi_compress.c with CCSHA1_MULTI_FN, CCSHA1_MULTI_LANES and
+ * CCSHA1_MULTI_ATTR defined. Each vector element is one message.
+ */
+
+CCSHA1_MULTI_ATTR
+static void CCSHA1_MULTI_FN(ccdigest_state_t *states, size_t nblocks, const uint8_t *const *data)
+{
+    typedef uint32_t vec __attribute__((vector_size(4 * CCSHA1_MULTI_LANES)));
+    const uint8_t *p[CCSHA1_MULTI_LANES];
+    vec H[5], W[16], a, b, c, d, e, w, t;
+    size_t l;
+    int i;
+
+    for (l = 0; l < CCSHA1_MULTI_LANES; l++) {
+        p[l] = data[l];
+        for (i = 0; i < 5; i++) {
+            H[i][l] = ccdigest_u32(states[l])[i];
+        }
+    }
+
+    while (nblocks--) {
+        for (i = 0; i < 16; i++) {
+            for (l = 0; l < CCSHA1_MULTI_LANES; l++) {
+                uint32_t x;
+                CC_LOAD32_BE(x, p[l] + 4 * i);
+                W[i][l] = x;
+            }
+        }
+
+        a = H[0]; b = H[1]; c = H[2]; d = H[3]; e = H[4];
+
+        for (i = 0; i < 80; i++) {
+            if (i < 16) {
+                w = W[i];
+            } else {
+                w = W[i & 15] = ROL(W[(i - 3) & 15] ^ W[(i - 8) & 15] ^ W[(i - 14) & 15] ^ W[i & 15], 1);
+            }
+            if (i < 20) {
+                t = F0(b, c, d) + 0x5a827999;
+            } else if (i < 40) {
+                t = F1(b, c, d) + 0x6ed9eba1;
+            } else if (i < 60) {
+                t = F2(b, c, d) + 0x8f1bbcdc;
+            } else {
+                t = F1(b, c, d) + 0xca62c1d6;
+            }
+            t += ROL(a, 5) + e + w;
+            e = d; d = c; c = ROL(b, 30); b = a; a = t;
+        }
+
+        H[0] += a; H[1] += b; H[2] += c; H[3] += d; H[4] += e;
+
+        for (l = 0; l < CCSHA1_MULTI_LANES; l++) {
+            p[l] += CCSHA1_BLOCK_SIZE;
+        }
+    }
+
+    for (l = 0; l < CCSHA1_MULTI_LANES; l++) {
+        for (i = 0; i < 5; i++) {
+            ccdigest_u32(states[l])[i] = H[i][l];
+        }
+    }
+}
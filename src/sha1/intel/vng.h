@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#ifndef _CORECRYPTO_CCSHA1_INTEL_VNG_H_
+#define _CORECRYPTO_CCSHA1_INTEL_VNG_H_
+
+#include <corecrypto/ccsha1.h>
+
+/* vng_sha1_intel_shani_compress.c */
+extern void vng_sha1_intel_shani_compress(ccdigest_state_t state, size_t nblocks, const void *data);
+
+/* vng_sha1_intel_avx2_compress.c */
+extern void vng_sha1_intel_avx2_compress(ccdigest_state_t state, size_t nblocks, const void *data);
+
+#endif /* _CORECRYPTO_CCSHA1_INTEL_VNG_H_ */
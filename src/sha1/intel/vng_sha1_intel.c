@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if CCSHA1_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include "../ccsha1_internal.h"
+#include <corecrypto/ccdigest_priv.h>
+#include <corecrypto/ccsha1.h>
+
+const struct ccdigest_info ccsha1_vng_intel_shani_di = {
+    .block_size = CCSHA1_BLOCK_SIZE,
+    .output_size = CCSHA1_OUTPUT_SIZE,
+    .state_size = CCSHA1_STATE_SIZE,
+
+    .final = ccdigest_final_64be,
+    .compress = vng_sha1_intel_shani_compress,
+
+    .initial_state = ccsha1_initial_state,
+
+    .oid = CC_DIGEST_OID_SHA1,
+    .oid_size = ccoid_sha1_len,
+};
+
+const struct ccdigest_info ccsha1_vng_intel_AVX2_di = {
+    .block_size = CCSHA1_BLOCK_SIZE,
+    .output_size = CCSHA1_OUTPUT_SIZE,
+    .state_size = CCSHA1_STATE_SIZE,
+
+    .final = ccdigest_final_64be,
+    .compress = vng_sha1_intel_avx2_compress,
+
+    .initial_state = ccsha1_initial_state,
+
+    .oid = CC_DIGEST_OID_SHA1,
+    .oid_size = ccoid_sha1_len,
+};
+
+#endif /* CCSHA1_VNG_INTEL && defined(__x86_64__) */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if CCSHA1_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include <corecrypto/cc_priv.h>
+#include <immintrin.h>
+
+#define F0(x, y, z) (z ^ (x & (y ^ z)))
+#define F1(x, y, z) (x ^ y ^ z)
+#define F2(x, y, z) ((x & y) | (z & (x | y)))
+
+/* plain C so the compiler can schedule it, CC_ROLc is volatile asm */
+#define ROL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/* the 80 rounds over a precomputed W+K */
+static void vng_sha1_intel_rounds(uint32_t *state, const uint32_t *wk)
+{
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+#define RND(F, a, b, c, d, e, i)                   \
+    e += ROL(a, 5) + F(b, c, d) + wk[i];           \
+    b = ROL(b, 30);
+
+#define RND5(F, i)                  \
+    RND(F, a, b, c, d, e, i + 0);   \
+    RND(F, e, a, b, c, d, i + 1);   \
+    RND(F, d, e, a, b, c, i + 2);   \
+    RND(F, c, d, e, a, b, i + 3);   \
+    RND(F, b, c, d, e, a, i + 4);
+
+    RND5(F0, 0);  RND5(F0, 5);  RND5(F0, 10); RND5(F0, 15);
+    RND5(F1, 20); RND5(F1, 25); RND5(F1, 30); RND5(F1, 35);
+    RND5(F2, 40); RND5(F2, 45); RND5(F2, 50); RND5(F2, 55);
+    RND5(F1, 60); RND5(F1, 65); RND5(F1, 70); RND5(F1, 75);
+#undef RND5
+#undef RND
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+}
+
+/* the round constant of W[4 * i .. 4 * i + 3] */
+static const uint32_t vng_sha1_intel_K[4] = { 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6 };
+
+#define ROL32(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+/*
+ * W[t..t+3] from W[t-16..t-1]. W[t+3] needs W[t] of the same step, so the
+ * missing term is left out of lane 3 and folded in afterwards: with
+ * r = W[t-3..t-1] ^ ... and W[t] = rol(r0, 1), W[t+3] = rol(r3, 1) ^ rol(r0, 2).
+ * The byte shifts and alignr stay within their 128-bit lane.
+ */
+__attribute__((target("avx2")))
+static inline __m256i vng_sha1_avx2_schedule(__m256i x0, __m256i x1, __m256i x2, __m256i x3)
+{
+    __m256i r;
+
+    r = _mm256_xor_si256(x0, _mm256_alignr_epi8(x1, x0, 8));
+    r = _mm256_xor_si256(r, x2);
+    r = _mm256_xor_si256(r, _mm256_srli_si256(x3, 4));
+    return _mm256_xor_si256(ROL32(r, 1), ROL32(_mm256_slli_si256(r, 12), 2));
+}
+
+/* two blocks' message schedules at once, one per 128-bit lane, then their rounds back to back */
+__attribute__((target("avx2")))
+void vng_sha1_intel_avx2_compress(ccdigest_state_t state, size_t nblocks, const void *data)
+{
+    const __m256i bswap = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const uint8_t *p = data;
+    uint32_t wk[2][80] CC_ALIGNED(16);
+    __m256i X[4];
+    int i;
+
+    for (; nblocks >= 2; nblocks -= 2) {
+        for (i = 0; i < 20; i++) {
+            if (i < 4) {
+                X[i] = _mm256_loadu2_m128i((const __m128i *)(p + CCSHA1_BLOCK_SIZE + 16 * i),
+                                           (const __m128i *)(p + 16 * i));
+                X[i] = _mm256_shuffle_epi8(X[i], bswap);
+            } else {
+                X[i & 3] = vng_sha1_avx2_schedule(X[i & 3], X[(i + 1) & 3], X[(i + 2) & 3], X[(i + 3) & 3]);
+            }
+            _mm256_storeu2_m128i((__m128i *)&wk[1][4 * i], (__m128i *)&wk[0][4 * i],
+                                 _mm256_add_epi32(X[i & 3], _mm256_set1_epi32((int)vng_sha1_intel_K[i / 5])));
+        }
+
+        /* the rounds are plain scalar code, don't make them pay for dirty upper halves */
+        _mm256_zeroupper();
+        vng_sha1_intel_rounds(ccdigest_u32(state), wk[0]);
+        vng_sha1_intel_rounds(ccdigest_u32(state), wk[1]);
+        p += 2 * CCSHA1_BLOCK_SIZE;
+    }
+
+    if (nblocks) {
+        ccsha1_ltc_di.compress(state, nblocks, p);
+    }
+
+    cc_clear(sizeof(wk), wk);
+}
+
+#endif /* CCSHA1_VNG_INTEL && defined(__x86_64__) */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if CCSHA1_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include <immintrin.h>
+
+/*
+ * Intel SHA-NI extensions:
+ *
+ * sha1rnds4 does four rounds on ABCD with E + W[t..t+3] packed in the other
+ * operand, sha1nexte derives the next E from the ABCD of four rounds back and
+ * adds it to the next four words. sha1msg1, a xor and sha1msg2 build
+ * W[t..t+3] from W[t-16..t-1] across three steps, so group g starts the words
+ * of group g + 3 and finishes those of group g + 1.
+ */
+#define SHA1_GROUP(g, f, Ecur, Enext)                                              \
+    do {                                                                           \
+        if ((g) == 0) {                                                            \
+            Ecur = _mm_add_epi32(Ecur, M[0]);                                      \
+        } else {                                                                   \
+            Ecur = _mm_sha1nexte_epu32(Ecur, M[(g) & 3]);                          \
+        }                                                                          \
+        Enext = abcd;                                                              \
+        if ((g) >= 3 && (g) <= 18) {                                               \
+            M[((g) + 1) & 3] = _mm_sha1msg2_epu32(M[((g) + 1) & 3], M[(g) & 3]);   \
+        }                                                                          \
+        abcd = _mm_sha1rnds4_epu32(abcd, Ecur, f);                                 \
+        if ((g) >= 1 && (g) <= 16) {                                               \
+            M[((g) - 1) & 3] = _mm_sha1msg1_epu32(M[((g) - 1) & 3], M[(g) & 3]);   \
+        }                                                                          \
+        if ((g) >= 2 && (g) <= 17) {                                               \
+            M[((g) - 2) & 3] = _mm_xor_si128(M[((g) - 2) & 3], M[(g) & 3]);        \
+        }                                                                          \
+    } while (0)
+
+__attribute__((target("sha,sse4.1")))
+void vng_sha1_intel_shani_compress(ccdigest_state_t state, size_t nblocks, const void *data)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    const uint8_t *p = data;
+    uint32_t *s = ccdigest_u32(state);
+    __m128i abcd, abcd_save, e0, e0_save, e1, M[4];
+    int i;
+
+    /* A is kept in the top lane, E in the top lane of its own register */
+    abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)s), 0x1B);
+    e0 = _mm_set_epi32((int)s[4], 0, 0, 0);
+
+    while (nblocks--) {
+        abcd_save = abcd;
+        e0_save = e0;
+
+        for (i = 0; i < 4; i++) {
+            M[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 16 * i)), bswap);
+        }
+
+        SHA1_GROUP(0, 0, e0, e1);
+        SHA1_GROUP(1, 0, e1, e0);
+        SHA1_GROUP(2, 0, e0, e1);
+        SHA1_GROUP(3, 0, e1, e0);
+        SHA1_GROUP(4, 0, e0, e1);
+        SHA1_GROUP(5, 1, e1, e0);
+        SHA1_GROUP(6, 1, e0, e1);
+        SHA1_GROUP(7, 1, e1, e0);
+        SHA1_GROUP(8, 1, e0, e1);
+        SHA1_GROUP(9, 1, e1, e0);
+        SHA1_GROUP(10, 2, e0, e1);
+        SHA1_GROUP(11, 2, e1, e0);
+        SHA1_GROUP(12, 2, e0, e1);
+        SHA1_GROUP(13, 2, e1, e0);
+        SHA1_GROUP(14, 2, e0, e1);
+        SHA1_GROUP(15, 3, e1, e0);
+        SHA1_GROUP(16, 3, e0, e1);
+        SHA1_GROUP(17, 3, e1, e0);
+        SHA1_GROUP(18, 3, e0, e1);
+        SHA1_GROUP(19, 3, e1, e0);
+
+        e0 = _mm_sha1nexte_epu32(e0, e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+        p += CCSHA1_BLOCK_SIZE;
+    }
+
+    _mm_storeu_si128((__m128i *)s, _mm_shuffle_epi32(abcd, 0x1B));
+    s[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+#endif /* CCSHA1_VNG_INTEL && defined(__x86_64__) */
@@ -16,10 +16,29 @@
  * @LICENSE_HEADER_END@
  */
 
+#include <corecrypto/cc_runtime_config.h>
 #include <corecrypto/ccdigest_priv.h>
 #include <corecrypto/ccsha2.h>
 
 const struct ccdigest_info *ccsha256_di(void)
 {
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+    /* the cpu doesn't change under us, so probe once; racing callers all store the same answer */
+    static const struct ccdigest_info *di = NULL;
+
+    if (di == NULL) {
+        if (CC_HAS_SHA()) {
+            di = &ccsha256_vng_intel_shani_di;
+        } else if (CC_HAS_AVX2()) {
+            di = &ccsha256_vng_intel_AVX2_di;
+        } else if (CC_HAS_SupplementalSSE3()) {
+            di = &ccsha256_vng_intel_SupplementalSSE3_di;
+        } else {
+            di = &ccsha256_ltc_di;
+        }
+    }
+    return di;
+#else
     return &ccsha256_ltc_di;
+#endif
 }
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "ccsha2_ltc_internal.h"
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccdigest_priv.h>
+
+#if CCDIGEST_MULTI_SIMD
+
+#define ROR(x, n)    (((x) >> (n)) | ((x) << (32 - (n))))
+#define Ch(x, y, z)  (z ^ (x & (y ^ z)))
+#define Maj(x, y, z) (((x | y) & z) | (x & y))
+#define Sigma0(x)    (ROR(x, 2) ^ ROR(x, 13) ^ ROR(x, 22))
+#define Sigma1(x)    (ROR(x, 6) ^ ROR(x, 11) ^ ROR(x, 25))
+#define Gamma0(x)    (ROR(x, 7) ^ ROR(x, 18) ^ ((x) >> 3))
+#define Gamma1(x)    (ROR(x, 17) ^ ROR(x, 19) ^ ((x) >> 10))
+
+/* 4 lanes: one SSE2 or NEON register per word */
+#define CCSHA256_MULTI_FN    ccsha256_multi_compress_x4
+#define CCSHA256_MULTI_LANES 4
+#define CCSHA256_MULTI_ATTR
+#include "ccsha256_multi_template.h"
+#undef CCSHA256_MULTI_FN
+#undef CCSHA256_MULTI_LANES
+#undef CCSHA256_MULTI_ATTR
+
+#if CCDIGEST_MULTI_X86
+#define CCSHA256_MULTI_FN    ccsha256_multi_compress_x8
+#define CCSHA256_MULTI_LANES 8
+#define CCSHA256_MULTI_ATTR  __attribute__((target("avx2")))
+#include "ccsha256_multi_template.h"
+#undef CCSHA256_MULTI_FN
+#undef CCSHA256_MULTI_LANES
+#undef CCSHA256_MULTI_ATTR
+
+#define CCSHA256_MULTI_FN    ccsha256_multi_compress_x16
+#define CCSHA256_MULTI_LANES 16
+#define CCSHA256_MULTI_ATTR  __attribute__((target("avx512f")))
+#include "ccsha256_multi_template.h"
+#undef CCSHA256_MULTI_FN
+#undef CCSHA256_MULTI_LANES
+#undef CCSHA256_MULTI_ATTR
+#endif
+
+const struct ccdigest_multi_compress ccsha256_multi_compress[] = {
+#if CCDIGEST_MULTI_X86
+    { 16, CCDIGEST_MULTI_CPU_AVX512, ccsha256_multi_compress_x16 },
+    { 8, CCDIGEST_MULTI_CPU_AVX2, ccsha256_multi_compress_x8 },
+#endif
+    { 4, CCDIGEST_MULTI_CPU_ANY, ccsha256_multi_compress_x4 },
+    { 0, CCDIGEST_MULTI_CPU_ANY, NULL },
+};
+
+#endif /* CCDIGEST_MULTI_SIMD */
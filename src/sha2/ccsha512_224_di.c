@@ -16,10 +16,27 @@
  * @LICENSE_HEADER_END@
  */
 
+#include <corecrypto/cc_runtime_config.h>
 #include <corecrypto/ccdigest_priv.h>
 #include <corecrypto/ccsha2.h>
 
 const struct ccdigest_info *ccsha512_224_di(void)
 {
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+    /* probed once, as in ccsha256_di() */
+    static const struct ccdigest_info *di = NULL;
+
+    if (di == NULL) {
+        if (CC_HAS_AVX512_AND_IN_KERNEL()) {
+            di = &ccsha512_224_vng_intel_AVX512_di;
+        } else if (CC_HAS_AVX2()) {
+            di = &ccsha512_224_vng_intel_AVX2_di;
+        } else {
+            di = &ccsha512_224_ltc_di;
+        }
+    }
+    return di;
+#else
     return &ccsha512_224_ltc_di;
+#endif
 }
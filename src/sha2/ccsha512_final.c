@@ -31,14 +31,14 @@ void ccsha512_final(const struct ccdigest_info *di, ccdigest_ctx_t ctx,
     /* If we don't have at least 16 bytes (for the length) left we need to add
      a second block. */
     if (ccdigest_num(di, ctx) > di->block_size - 16) {
-        while (ccdigest_num(di, ctx) < 64) {
+        while (ccdigest_num(di, ctx) < di->block_size) {
             ccdigest_data(di, ctx)[ccdigest_num(di, ctx)++] = 0;
         }
         di->compress(ccdigest_state(di, ctx), 1, ccdigest_data(di, ctx));
         ccdigest_num(di, ctx) = 0;
     }
 
-    /* pad upto block_size minus 16 with 0s */
+    /* pad upto block_size minus 8 with 0s, the high half of the 128-bit length is always zero here */
     while (ccdigest_num(di, ctx) < di->block_size - 8) {
         ccdigest_data(di, ctx)[ccdigest_num(di, ctx)++] = 0;
     }
@@ -46,8 +46,13 @@ void ccsha512_final(const struct ccdigest_info *di, ccdigest_ctx_t ctx,
     CC_STORE64_BE(ccdigest_nbits(di, ctx), ccdigest_data(di, ctx) + di->block_size - 8);
     di->compress(ccdigest_state(di, ctx), 1, ccdigest_data(di, ctx));
 
-    /* copy output */
+    /* copy output, SHA-512/224 ends halfway through a word */
     for (unsigned int i = 0; i < di->output_size / 8; i++) {
-        CC_STORE64_BE(ccdigest_state_u64(di, ctx)[i], dgst + (4 * i));
+        CC_STORE64_BE(ccdigest_state_u64(di, ctx)[i], dgst + (8 * i));
+    }
+    if (di->output_size % 8) {
+        unsigned char last[8];
+        CC_STORE64_BE(ccdigest_state_u64(di, ctx)[di->output_size / 8], last);
+        CC_MEMCPY(dgst + (di->output_size & ~(size_t)7), last, di->output_size % 8);
     }
 }
@@ -48,58 +48,60 @@ void ccsha512_ltc_compress(ccdigest_state_t state, size_t nblocks, const void *d
     uint64_t S[8], W[80], t0, t1;
     int i;
 
-    /* copy state into S */
-    for (i = 0; i < 8; i++) {
-        S[i] = ccdigest_u64(state)[i];
-    }
+    while (nblocks--) {
+        /* copy state into S */
+        for (i = 0; i < 8; i++) {
+            S[i] = ccdigest_u64(state)[i];
+        }
 
-    /* copy the state into 1024-bits into W[0..15] */
-    for (i = 0; i < 16; i++) {
-        CC_LOAD64_BE(W[i], data + (8 * i));
-    }
+        /* copy the state into 1024-bits into W[0..15] */
+        for (i = 0; i < 16; i++) {
+            CC_LOAD64_BE(W[i], data + (8 * i));
+        }
 
-    /* fill W[16..79] */
-    for (i = 16; i < 80; i++) {
-        W[i] = Gamma1(W[i - 2]) + W[i - 7] + Gamma0(W[i - 15]) + W[i - 16];
-    }
+        /* fill W[16..79] */
+        for (i = 16; i < 80; i++) {
+            W[i] = Gamma1(W[i - 2]) + W[i - 7] + Gamma0(W[i - 15]) + W[i - 16];
+        }
 
-    /* Compress */
+        /* Compress */
 #if CC_SMALL_CODE
-    for (i = 0; i < 80; i++) {
-        t0 = S[7] + Sigma1(S[4]) + Ch(S[4], S[5], S[6]) + K[i] + W[i];
-        t1 = Sigma0(S[0]) + Maj(S[0], S[1], S[2]);
-        S[7] = S[6];
-        S[6] = S[5];
-        S[5] = S[4];
-        S[4] = S[3] + t0;
-        S[3] = S[2];
-        S[2] = S[1];
-        S[1] = S[0];
-        S[0] = t0 + t1;
-    }
+        for (i = 0; i < 80; i++) {
+            t0 = S[7] + Sigma1(S[4]) + Ch(S[4], S[5], S[6]) + K[i] + W[i];
+            t1 = Sigma0(S[0]) + Maj(S[0], S[1], S[2]);
+            S[7] = S[6];
+            S[6] = S[5];
+            S[5] = S[4];
+            S[4] = S[3] + t0;
+            S[3] = S[2];
+            S[2] = S[1];
+            S[1] = S[0];
+            S[0] = t0 + t1;
+        }
 #else
 #define RND(a, b, c, d, e, f, g, h, i)              \
-    t0 = h + Sigma1(e) + Ch(e, f, g) + K[i] + W[i]; \
-    t1 = Sigma0(a) + Maj(a, b, c);                  \
-    d += t0;                                        \
-    h = t0 + t1;
+        t0 = h + Sigma1(e) + Ch(e, f, g) + K[i] + W[i]; \
+        t1 = Sigma0(a) + Maj(a, b, c);                  \
+        d += t0;                                        \
+        h = t0 + t1;
 
-    for (i = 0; i < 80; i += 8) {
-        RND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], i + 0);
-        RND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], i + 1);
-        RND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], i + 2);
-        RND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], i + 3);
-        RND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], i + 4);
-        RND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], i + 5);
-        RND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], i + 6);
-        RND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], i + 7);
-    }
+        for (i = 0; i < 80; i += 8) {
+            RND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], i + 0);
+            RND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], i + 1);
+            RND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], i + 2);
+            RND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], i + 3);
+            RND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], i + 4);
+            RND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], i + 5);
+            RND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], i + 6);
+            RND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], i + 7);
+        }
 #endif
 
-    /* feedback */
-    for (i = 0; i < 8; i++) {
-        ccdigest_u64(state)[i] += S[i];
-    }
+        /* feedback */
+        for (i = 0; i < 8; i++) {
+            ccdigest_u64(state)[i] += S[i];
+        }
 
-    data += CCSHA512_BLOCK_SIZE;
+        data += CCSHA512_BLOCK_SIZE;
+    }
 }
@@ -28,7 +28,7 @@ const struct ccdigest_info ccsha512_ltc_di = {
     .final = ccsha512_final,
     .compress = ccsha512_ltc_compress,
 
-    .initial_state = ccsha256_initial_state,
+    .initial_state = ccsha512_initial_state,
 
     .oid = ccoid_sha512,
     .oid_size = ccoid_sha512_len,
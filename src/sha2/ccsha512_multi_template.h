@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+/*
+ * Body of one multi-buffer SHA-512 kernel, included once per lane count by
+ * ccsha512_multi_compress.c with CCSHA512_MULTI_FN, CCSHA512_MULTI_LANES and
+ * CCSHA512_MULTI_ATTR defined. Each vector element is one message.
+ */
+
+CCSHA512_MULTI_ATTR
+static void CCSHA512_MULTI_FN(ccdigest_state_t *states, size_t nblocks, const uint8_t *const *data)
+{
+    typedef uint64_t vec __attribute__((vector_size(8 * CCSHA512_MULTI_LANES)));
+    const uint8_t *p[CCSHA512_MULTI_LANES];
+    vec H[8], W[16], a, b, c, d, e, f, g, h, w, t0, t1;
+    size_t l;
+    int i;
+
+    for (l = 0; l < CCSHA512_MULTI_LANES; l++) {
+        p[l] = data[l];
+        for (i = 0; i < 8; i++) {
+            H[i][l] = ccdigest_u64(states[l])[i];
+        }
+    }
+
+    while (nblocks--) {
+        for (i = 0; i < 16; i++) {
+            for (l = 0; l < CCSHA512_MULTI_LANES; l++) {
+                uint64_t x;
+                CC_LOAD64_BE(x, p[l] + 8 * i);
+                W[i][l] = x;
+            }
+        }
+
+        a = H[0]; b = H[1]; c = H[2]; d = H[3];
+        e = H[4]; f = H[5]; g = H[6]; h = H[7];
+
+        for (i = 0; i < 80; i++) {
+            if (i < 16) {
+                w = W[i];
+            } else {
+                w = W[i & 15] += Gamma1(W[(i - 2) & 15]) + W[(i - 7) & 15] + Gamma0(W[(i - 15) & 15]);
+            }
+            t0 = h + Sigma1(e) + Ch(e, f, g) + ccsha512_K[i] + w;
+            t1 = Sigma0(a) + Maj(a, b, c);
+            h = g; g = f; f = e; e = d + t0;
+            d = c; c = b; b = a; a = t0 + t1;
+        }
+
+        H[0] += a; H[1] += b; H[2] += c; H[3] += d;
+        H[4] += e; H[5] += f; H[6] += g; H[7] += h;
+
+        for (l = 0; l < CCSHA512_MULTI_LANES; l++) {
+            p[l] += CCSHA512_BLOCK_SIZE;
+        }
+    }
+
+    for (l = 0; l < CCSHA512_MULTI_LANES; l++) {
+        for (i = 0; i < 8; i++) {
+            ccdigest_u64(states[l])[i] = H[i][l];
+        }
+    }
+}
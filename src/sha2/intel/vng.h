@@ -21,7 +21,21 @@
 
 #include <corecrypto/ccsha2.h>
 
-/* vng_sha256_intel_shani_compress.S */
+/* vng_sha256_intel_shani_compress.c */
 extern void vng_sha256_intel_shani_compress(ccdigest_state_t state, size_t nblocks, const void *data);
 
+/* vng_sha256_intel_avx2_compress.c */
+extern void vng_sha256_intel_avx2_compress(ccdigest_state_t state, size_t nblocks, const void *data);
+
+/* vng_sha256_intel_ssse3_compress.c */
+extern void vng_sha256_intel_ssse3_compress(ccdigest_state_t state, size_t nblocks, const void *data);
+extern void vng_sha256_intel_rounds(uint32_t *state, const uint32_t *wk);
+
+/* vng_sha512_intel_avx2_compress.c */
+extern void vng_sha512_intel_avx2_compress(ccdigest_state_t state, size_t nblocks, const void *data);
+extern void vng_sha512_intel_rounds(uint64_t *state, const uint64_t *wk);
+
+/* vng_sha512_intel_avx512_compress.c */
+extern void vng_sha512_intel_avx512_compress(ccdigest_state_t state, size_t nblocks, const void *data);
+
 #endif /* _CORECRYPTO_CCSHA2_INTEL_VNG_H_ */
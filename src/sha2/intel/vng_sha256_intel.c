@@ -16,6 +16,10 @@
  * @LICENSE_HEADER_END@
  */
 
+#include <corecrypto/cc_config.h>
+
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+
 #include "vng.h"
 #include "../ccsha2_ltc_internal.h"
 #include <corecrypto/ccdigest_priv.h>
@@ -48,3 +52,61 @@ const struct ccdigest_info ccsha256_vng_intel_shani_di = {
     .oid = ccoid_sha256,
     .oid_size = ccoid_sha256_len,
 };
+
+const struct ccdigest_info ccsha224_vng_intel_AVX2_di = {
+    .block_size = CCSHA256_BLOCK_SIZE,
+    .output_size = CCSHA224_OUTPUT_SIZE,
+    .state_size = CCSHA256_STATE_SIZE,
+
+    .final = ccdigest_final_64be,
+    .compress = vng_sha256_intel_avx2_compress,
+
+    .initial_state = ccsha224_initial_state,
+
+    .oid = ccoid_sha224,
+    .oid_size = ccoid_sha224_len,
+};
+
+const struct ccdigest_info ccsha256_vng_intel_AVX2_di = {
+    .block_size = CCSHA256_BLOCK_SIZE,
+    .output_size = CCSHA256_OUTPUT_SIZE,
+    .state_size = CCSHA256_STATE_SIZE,
+
+    .final = ccdigest_final_64be,
+    .compress = vng_sha256_intel_avx2_compress,
+
+    .initial_state = ccsha256_initial_state,
+
+    .oid = ccoid_sha256,
+    .oid_size = ccoid_sha256_len,
+};
+
+const struct ccdigest_info ccsha224_vng_intel_SupplementalSSE3_di = {
+    .block_size = CCSHA256_BLOCK_SIZE,
+    .output_size = CCSHA224_OUTPUT_SIZE,
+    .state_size = CCSHA256_STATE_SIZE,
+
+    .final = ccdigest_final_64be,
+    .compress = vng_sha256_intel_ssse3_compress,
+
+    .initial_state = ccsha224_initial_state,
+
+    .oid = ccoid_sha224,
+    .oid_size = ccoid_sha224_len,
+};
+
+const struct ccdigest_info ccsha256_vng_intel_SupplementalSSE3_di = {
+    .block_size = CCSHA256_BLOCK_SIZE,
+    .output_size = CCSHA256_OUTPUT_SIZE,
+    .state_size = CCSHA256_STATE_SIZE,
+
+    .final = ccdigest_final_64be,
+    .compress = vng_sha256_intel_ssse3_compress,
+
+    .initial_state = ccsha256_initial_state,
+
+    .oid = ccoid_sha256,
+    .oid_size = ccoid_sha256_len,
+};
+
+#endif /* CCSHA2_VNG_INTEL && defined(__x86_64__) */
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include "../ccsha2_ltc_internal.h"
+#include <corecrypto/cc_priv.h>
+#include <immintrin.h>
+
+#define ROR32(x, n)  _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define Gamma0(x)    _mm256_xor_si256(_mm256_xor_si256(ROR32(x, 7), ROR32(x, 18)), _mm256_srli_epi32(x, 3))
+#define Gamma1(x)    _mm256_xor_si256(_mm256_xor_si256(ROR32(x, 17), ROR32(x, 19)), _mm256_srli_epi32(x, 10))
+
+/* same step as the SSSE3 schedule; every instruction here stays within its 128-bit lane */
+__attribute__((target("avx2")))
+static inline __m256i vng_sha256_avx2_schedule(__m256i x0, __m256i x1, __m256i x2, __m256i x3)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i w;
+
+    w = _mm256_add_epi32(x0, Gamma0(_mm256_alignr_epi8(x1, x0, 4)));
+    w = _mm256_add_epi32(w, _mm256_alignr_epi8(x3, x2, 4));
+    w = _mm256_add_epi32(w, _mm256_unpackhi_epi64(Gamma1(x3), zero));
+    return _mm256_add_epi32(w, _mm256_unpacklo_epi64(zero, Gamma1(w)));
+}
+
+/* two blocks' message schedules at once, one per 128-bit lane, then their rounds back to back */
+__attribute__((target("avx2")))
+void vng_sha256_intel_avx2_compress(ccdigest_state_t state, size_t nblocks, const void *data)
+{
+    const __m256i bswap = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const uint8_t *p = data;
+    uint32_t wk[2][64] CC_ALIGNED(16);
+    __m256i X[4], k;
+    int i;
+
+    for (; nblocks >= 2; nblocks -= 2) {
+        for (i = 0; i < 16; i++) {
+            if (i < 4) {
+                X[i] = _mm256_loadu2_m128i((const __m128i *)(p + CCSHA256_BLOCK_SIZE + 16 * i),
+                                           (const __m128i *)(p + 16 * i));
+                X[i] = _mm256_shuffle_epi8(X[i], bswap);
+            } else {
+                X[i & 3] = vng_sha256_avx2_schedule(X[i & 3], X[(i + 1) & 3], X[(i + 2) & 3], X[(i + 3) & 3]);
+            }
+            k = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)&ccsha256_K[4 * i]));
+            _mm256_storeu2_m128i((__m128i *)&wk[1][4 * i], (__m128i *)&wk[0][4 * i], _mm256_add_epi32(X[i & 3], k));
+        }
+
+        /* the rounds are plain scalar code, don't make them pay for dirty upper halves */
+        _mm256_zeroupper();
+        vng_sha256_intel_rounds(ccdigest_u32(state), wk[0]);
+        vng_sha256_intel_rounds(ccdigest_u32(state), wk[1]);
+        p += 2 * CCSHA256_BLOCK_SIZE;
+    }
+
+    if (nblocks) {
+        vng_sha256_intel_ssse3_compress(state, nblocks, p);
+    }
+
+    cc_clear(sizeof(wk), wk);
+}
+
+#endif /* CCSHA2_VNG_INTEL && defined(__x86_64__) */
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+/* As far as I'm aware, no i386 CPU ever shipped with SHA-NI */
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include "../ccsha2_ltc_internal.h"
+#include <immintrin.h>
+
+/*
+ * Intel SHA-NI extensions:
+ *
+ * sha256rnds2 does two rounds, taking the state as ABEF and CDGH halves and
+ * W+K for the two rounds in the low quadword of xmm0. sha256msg1/sha256msg2
+ * do the sigma0 and sigma1 halves of the message schedule four words at a time.
+ */
+__attribute__((target("sha,sse4.1")))
+void vng_sha256_intel_shani_compress(ccdigest_state_t state, size_t nblocks, const void *data)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const uint8_t *p = data;
+    uint32_t *s = ccdigest_u32(state);
+    __m128i state0, state1, abef, cdgh, msg, tmp, X[4];
+    int i;
+
+    /* DCBA/HGFE -> ABEF/CDGH */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&s[0]), 0xB1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&s[4]), 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (nblocks--) {
+        abef = state0;
+        cdgh = state1;
+
+        for (i = 0; i < 16; i++) {
+            if (i < 4) {
+                X[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 16 * i)), bswap);
+            }
+
+            msg = _mm_add_epi32(X[i & 3], _mm_loadu_si128((const __m128i *)&ccsha256_K[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+            /* finish the words four rounds ahead */
+            if (i >= 3 && i < 15) {
+                tmp = _mm_alignr_epi8(X[i & 3], X[(i - 1) & 3], 4);
+                X[(i + 1) & 3] = _mm_add_epi32(X[(i + 1) & 3], tmp);
+                X[(i + 1) & 3] = _mm_sha256msg2_epu32(X[(i + 1) & 3], X[i & 3]);
+            }
+
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+            /* and start the ones twelve rounds ahead */
+            if (i >= 1 && i < 13) {
+                X[(i - 1) & 3] = _mm_sha256msg1_epu32(X[(i - 1) & 3], X[i & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+        p += CCSHA256_BLOCK_SIZE;
+    }
+
+    /* ABEF/CDGH -> DCBA/HGFE */
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128((__m128i *)&s[0], _mm_blend_epi16(tmp, state1, 0xF0));
+    _mm_storeu_si128((__m128i *)&s[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+#endif /* CCSHA2_VNG_INTEL && defined(__x86_64__) */
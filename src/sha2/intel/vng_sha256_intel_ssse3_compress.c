@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include "../ccsha2_ltc_internal.h"
+#include <corecrypto/cc_priv.h>
+#include <immintrin.h>
+
+#define Ch(x, y, z)  (z ^ (x & (y ^ z)))
+#define Maj(x, y, z) (((x | y) & z) | (x & y))
+#define S(x, n)      CC_RORc((x), (n))
+#define Sigma0(x)    (S(x, 2) ^ S(x, 13) ^ S(x, 22))
+#define Sigma1(x)    (S(x, 6) ^ S(x, 11) ^ S(x, 25))
+
+/* the 64 rounds over a precomputed W+K, shared with the AVX2 compress */
+void vng_sha256_intel_rounds(uint32_t *state, const uint32_t *wk)
+{
+    uint32_t S[8], t0, t1;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        S[i] = state[i];
+    }
+
+#define RND(a, b, c, d, e, f, g, h, i)                \
+    t0 = h + Sigma1(e) + Ch(e, f, g) + wk[i];         \
+    t1 = Sigma0(a) + Maj(a, b, c);                    \
+    d += t0;                                          \
+    h = t0 + t1;
+
+    for (i = 0; i < 64; i += 8) {
+        RND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], i + 0);
+        RND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], i + 1);
+        RND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], i + 2);
+        RND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], i + 3);
+        RND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], i + 4);
+        RND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], i + 5);
+        RND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], i + 6);
+        RND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], i + 7);
+    }
+#undef RND
+
+    for (i = 0; i < 8; i++) {
+        state[i] += S[i];
+    }
+}
+
+#define ROR32(x, n)  _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - (n)))
+#define Gamma0(x)    _mm_xor_si128(_mm_xor_si128(ROR32(x, 7), ROR32(x, 18)), _mm_srli_epi32(x, 3))
+#define Gamma1(x)    _mm_xor_si128(_mm_xor_si128(ROR32(x, 17), ROR32(x, 19)), _mm_srli_epi32(x, 10))
+
+/* W[t..t+3] from W[t-16..t-1]; the sigma1 half needs W[t] and W[t+1] before W[t+2] and W[t+3] */
+__attribute__((target("ssse3")))
+static inline __m128i vng_sha256_ssse3_schedule(__m128i x0, __m128i x1, __m128i x2, __m128i x3)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i w;
+
+    w = _mm_add_epi32(x0, Gamma0(_mm_alignr_epi8(x1, x0, 4)));
+    w = _mm_add_epi32(w, _mm_alignr_epi8(x3, x2, 4));
+    w = _mm_add_epi32(w, _mm_unpackhi_epi64(Gamma1(x3), zero));
+    return _mm_add_epi32(w, _mm_unpacklo_epi64(zero, Gamma1(w)));
+}
+
+/* the message schedule four words at a time, with the rounds left scalar */
+__attribute__((target("ssse3")))
+void vng_sha256_intel_ssse3_compress(ccdigest_state_t state, size_t nblocks, const void *data)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const uint8_t *p = data;
+    uint32_t wk[64] CC_ALIGNED(16);
+    __m128i X[4];
+    int i;
+
+    while (nblocks--) {
+        for (i = 0; i < 16; i++) {
+            if (i < 4) {
+                X[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 16 * i)), bswap);
+            } else {
+                X[i & 3] = vng_sha256_ssse3_schedule(X[i & 3], X[(i + 1) & 3], X[(i + 2) & 3], X[(i + 3) & 3]);
+            }
+            _mm_store_si128((__m128i *)&wk[4 * i],
+                            _mm_add_epi32(X[i & 3], _mm_loadu_si128((const __m128i *)&ccsha256_K[4 * i])));
+        }
+
+        vng_sha256_intel_rounds(ccdigest_u32(state), wk);
+        p += CCSHA256_BLOCK_SIZE;
+    }
+
+    cc_clear(sizeof(wk), wk);
+}
+
+#endif /* CCSHA2_VNG_INTEL && defined(__x86_64__) */
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include "../ccsha2_ltc_internal.h"
+#include <corecrypto/ccdigest_priv.h>
+#include <corecrypto/ccsha2.h>
+
+const struct ccdigest_info ccsha384_vng_intel_AVX2_di = {
+    .output_size = CCSHA384_OUTPUT_SIZE,
+    .state_size = CCSHA512_STATE_SIZE,
+    .block_size = CCSHA512_BLOCK_SIZE,
+
+    .oid_size = ccoid_sha384_len,
+    .oid = ccoid_sha384,
+
+    .initial_state = ccsha384_initial_state,
+
+    .compress = vng_sha512_intel_avx2_compress,
+    .final = ccsha512_final,
+};
+
+const struct ccdigest_info ccsha512_vng_intel_AVX2_di = {
+    .output_size = CCSHA512_OUTPUT_SIZE,
+    .state_size = CCSHA512_STATE_SIZE,
+    .block_size = CCSHA512_BLOCK_SIZE,
+
+    .oid_size = ccoid_sha512_len,
+    .oid = ccoid_sha512,
+
+    .initial_state = ccsha512_initial_state,
+
+    .compress = vng_sha512_intel_avx2_compress,
+    .final = ccsha512_final,
+};
+
+const struct ccdigest_info ccsha512_224_vng_intel_AVX2_di = {
+    .output_size = CCSHA512_224_OUTPUT_SIZE,
+    .state_size = CCSHA512_STATE_SIZE,
+    .block_size = CCSHA512_BLOCK_SIZE,
+
+    .oid_size = ccoid_sha512_224_len,
+    .oid = ccoid_sha512_224,
+
+    .initial_state = ccsha512_224_initial_state,
+
+    .compress = vng_sha512_intel_avx2_compress,
+    .final = ccsha512_final,
+};
+
+const struct ccdigest_info ccsha512_256_vng_intel_AVX2_di = {
+    .output_size = CCSHA512_256_OUTPUT_SIZE,
+    .state_size = CCSHA512_STATE_SIZE,
+    .block_size = CCSHA512_BLOCK_SIZE,
+
+    .oid_size = ccoid_sha512_256_len,
+    .oid = ccoid_sha512_256,
+
+    .initial_state = ccsha512_256_initial_state,
+
+    .compress = vng_sha512_intel_avx2_compress,
+    .final = ccsha512_final,
+};
+
+const struct ccdigest_info ccsha384_vng_intel_AVX512_di = {
+    .output_size = CCSHA384_OUTPUT_SIZE,
+    .state_size = CCSHA512_STATE_SIZE,
+    .block_size = CCSHA512_BLOCK_SIZE,
+
+    .oid_size = ccoid_sha384_len,
+    .oid = ccoid_sha384,
+
+    .initial_state = ccsha384_initial_state,
+
+    .compress = vng_sha512_intel_avx512_compress,
+    .final = ccsha512_final,
+};
+
+const struct ccdigest_info ccsha512_vng_intel_AVX512_di = {
+    .output_size = CCSHA512_OUTPUT_SIZE,
+    .state_size = CCSHA512_STATE_SIZE,
+    .block_size = CCSHA512_BLOCK_SIZE,
+
+    .oid_size = ccoid_sha512_len,
+    .oid = ccoid_sha512,
+
+    .initial_state = ccsha512_initial_state,
+
+    .compress = vng_sha512_intel_avx512_compress,
+    .final = ccsha512_final,
+};
+
+const struct ccdigest_info ccsha512_224_vng_intel_AVX512_di = {
+    .output_size = CCSHA512_224_OUTPUT_SIZE,
+    .state_size = CCSHA512_STATE_SIZE,
+    .block_size = CCSHA512_BLOCK_SIZE,
+
+    .oid_size = ccoid_sha512_224_len,
+    .oid = ccoid_sha512_224,
+
+    .initial_state = ccsha512_224_initial_state,
+
+    .compress = vng_sha512_intel_avx512_compress,
+    .final = ccsha512_final,
+};
+
+const struct ccdigest_info ccsha512_256_vng_intel_AVX512_di = {
+    .output_size = CCSHA512_256_OUTPUT_SIZE,
+    .state_size = CCSHA512_STATE_SIZE,
+    .block_size = CCSHA512_BLOCK_SIZE,
+
+    .oid_size = ccoid_sha512_256_len,
+    .oid = ccoid_sha512_256,
+
+    .initial_state = ccsha512_256_initial_state,
+
+    .compress = vng_sha512_intel_avx512_compress,
+    .final = ccsha512_final,
+};
+
+#endif /* CCSHA2_VNG_INTEL && defined(__x86_64__) */
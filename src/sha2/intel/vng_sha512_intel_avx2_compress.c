@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include "../ccsha2_ltc_internal.h"
+#include <corecrypto/cc_priv.h>
+#include <immintrin.h>
+
+#define Ch(x, y, z)  (z ^ (x & (y ^ z)))
+#define Maj(x, y, z) (((x | y) & z) | (x & y))
+#define S(x, n)      CC_ROR64c(x, n)
+#define Sigma0(x)    (S(x, 28) ^ S(x, 34) ^ S(x, 39))
+#define Sigma1(x)    (S(x, 14) ^ S(x, 18) ^ S(x, 41))
+
+/* the 80 rounds over a precomputed W+K, shared with the AVX-512 compress */
+void vng_sha512_intel_rounds(uint64_t *state, const uint64_t *wk)
+{
+    uint64_t S[8], t0, t1;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        S[i] = state[i];
+    }
+
+#define RND(a, b, c, d, e, f, g, h, i)                \
+    t0 = h + Sigma1(e) + Ch(e, f, g) + wk[i];         \
+    t1 = Sigma0(a) + Maj(a, b, c);                    \
+    d += t0;                                          \
+    h = t0 + t1;
+
+    for (i = 0; i < 80; i += 8) {
+        RND(S[0], S[1], S[2], S[3], S[4], S[5], S[6], S[7], i + 0);
+        RND(S[7], S[0], S[1], S[2], S[3], S[4], S[5], S[6], i + 1);
+        RND(S[6], S[7], S[0], S[1], S[2], S[3], S[4], S[5], i + 2);
+        RND(S[5], S[6], S[7], S[0], S[1], S[2], S[3], S[4], i + 3);
+        RND(S[4], S[5], S[6], S[7], S[0], S[1], S[2], S[3], i + 4);
+        RND(S[3], S[4], S[5], S[6], S[7], S[0], S[1], S[2], i + 5);
+        RND(S[2], S[3], S[4], S[5], S[6], S[7], S[0], S[1], i + 6);
+        RND(S[1], S[2], S[3], S[4], S[5], S[6], S[7], S[0], i + 7);
+    }
+#undef RND
+
+    for (i = 0; i < 8; i++) {
+        state[i] += S[i];
+    }
+}
+
+#define ROR64(x, n)  _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - (n)))
+#define Gamma0(x)    _mm256_xor_si256(_mm256_xor_si256(ROR64(x, 1), ROR64(x, 8)), _mm256_srli_epi64(x, 7))
+#define Gamma1(x)    _mm256_xor_si256(_mm256_xor_si256(ROR64(x, 19), ROR64(x, 61)), _mm256_srli_epi64(x, 6))
+
+/*
+ * Two blocks' message schedules at once, one per 128-bit lane, two words per step.
+ * W[t] and W[t+1] only need W[t-2] and W[t-1] for sigma1, so unlike SHA-256 a step
+ * has no dependency inside itself.
+ */
+__attribute__((target("avx2")))
+void vng_sha512_intel_avx2_compress(ccdigest_state_t state, size_t nblocks, const void *data)
+{
+    const __m256i bswap = _mm256_set_epi64x(0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL,
+                                            0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
+    const uint8_t *p = data;
+    uint64_t wk[2][80] CC_ALIGNED(16);
+    __m256i X[8];
+    int i;
+
+#define WK(i, x)                                                                                   \
+    _mm256_storeu2_m128i((__m128i *)&wk[1][2 * (i)], (__m128i *)&wk[0][2 * (i)],                   \
+                         _mm256_add_epi64(x, _mm256_broadcastsi128_si256(                          \
+                                                 _mm_loadu_si128((const __m128i *)&ccsha512_K[2 * (i)]))))
+#define SCHEDULE(j)                                                                                \
+    X[j] = _mm256_add_epi64(X[j], Gamma0(_mm256_alignr_epi8(X[((j) + 1) & 7], X[j], 8)));          \
+    X[j] = _mm256_add_epi64(X[j], _mm256_alignr_epi8(X[((j) + 5) & 7], X[((j) + 4) & 7], 8));      \
+    X[j] = _mm256_add_epi64(X[j], Gamma1(X[((j) + 7) & 7]));                                       \
+    WK(i + (j), X[j]);
+
+    while (nblocks) {
+        /* an odd last block is scheduled twice but only run once */
+        const uint8_t *q = nblocks > 1 ? p + CCSHA512_BLOCK_SIZE : p;
+
+        for (i = 0; i < 8; i++) {
+            X[i] = _mm256_loadu2_m128i((const __m128i *)(q + 16 * i), (const __m128i *)(p + 16 * i));
+            X[i] = _mm256_shuffle_epi8(X[i], bswap);
+            WK(i, X[i]);
+        }
+
+        /* unrolled by the ring size so X stays in registers */
+        for (i = 8; i < 40; i += 8) {
+            SCHEDULE(0); SCHEDULE(1); SCHEDULE(2); SCHEDULE(3);
+            SCHEDULE(4); SCHEDULE(5); SCHEDULE(6); SCHEDULE(7);
+        }
+
+        /* the rounds are plain scalar code, don't make them pay for dirty upper halves */
+        _mm256_zeroupper();
+        vng_sha512_intel_rounds(ccdigest_u64(state), wk[0]);
+        if (nblocks > 1) {
+            vng_sha512_intel_rounds(ccdigest_u64(state), wk[1]);
+            nblocks--;
+        }
+        nblocks--;
+        p += 2 * CCSHA512_BLOCK_SIZE;
+    }
+
+    cc_clear(sizeof(wk), wk);
+#undef SCHEDULE
+#undef WK
+}
+
+#endif /* CCSHA2_VNG_INTEL && defined(__x86_64__) */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_config.h>
+
+#if CCSHA2_VNG_INTEL && defined(__x86_64__)
+
+#include "vng.h"
+#include "../ccsha2_ltc_internal.h"
+#include <corecrypto/cc_priv.h>
+#include <immintrin.h>
+
+#define Gamma0(x) _mm512_xor_si512(_mm512_xor_si512(_mm512_ror_epi64(x, 1), _mm512_ror_epi64(x, 8)), _mm512_srli_epi64(x, 7))
+#define Gamma1(x) _mm512_xor_si512(_mm512_xor_si512(_mm512_ror_epi64(x, 19), _mm512_ror_epi64(x, 61)), _mm512_srli_epi64(x, 6))
+
+/*
+ * The AVX2 schedule stretched to four blocks, one per 128-bit lane. Only AVX-512F is
+ * assumed: the per-lane alignr becomes a two-source permute and the byte swap is done
+ * in AVX2 halves.
+ */
+__attribute__((target("avx512f,avx2")))
+void vng_sha512_intel_avx512_compress(ccdigest_state_t state, size_t nblocks, const void *data)
+{
+    const __m256i bswap = _mm256_set_epi64x(0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL,
+                                            0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
+    /* {x0[1], x1[0]} in each lane */
+    const __m512i shift1 = _mm512_set_epi64(14, 7, 12, 5, 10, 3, 8, 1);
+    const uint8_t *p = data;
+    uint64_t wk[4][80] CC_ALIGNED(16);
+    __m512i X[8], w;
+    int i, j;
+
+#define WK(i, x)                                                                                   \
+    w = _mm512_add_epi64(x, _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)&ccsha512_K[2 * (i)]))); \
+    _mm_store_si128((__m128i *)&wk[0][2 * (i)], _mm512_extracti32x4_epi32(w, 0));                \
+    _mm_store_si128((__m128i *)&wk[1][2 * (i)], _mm512_extracti32x4_epi32(w, 1));                \
+    _mm_store_si128((__m128i *)&wk[2][2 * (i)], _mm512_extracti32x4_epi32(w, 2));                \
+    _mm_store_si128((__m128i *)&wk[3][2 * (i)], _mm512_extracti32x4_epi32(w, 3));
+#define SCHEDULE(j)                                                                                \
+    X[j] = _mm512_add_epi64(X[j], Gamma0(_mm512_permutex2var_epi64(X[j], shift1, X[((j) + 1) & 7]))); \
+    X[j] = _mm512_add_epi64(X[j], _mm512_permutex2var_epi64(X[((j) + 4) & 7], shift1, X[((j) + 5) & 7])); \
+    X[j] = _mm512_add_epi64(X[j], Gamma1(X[((j) + 7) & 7]));                                       \
+    WK(i + (j), X[j]);
+
+    while (nblocks) {
+        size_t n = nblocks < 4 ? nblocks : 4;
+        const uint8_t *q[4];
+
+        /* short groups schedule the last block again in the spare lanes */
+        for (j = 0; j < 4; j++) {
+            q[j] = p + CCSHA512_BLOCK_SIZE * ((size_t)j < n ? (size_t)j : n - 1);
+        }
+
+        for (i = 0; i < 8; i++) {
+            __m256i lo = _mm256_loadu2_m128i((const __m128i *)(q[1] + 16 * i), (const __m128i *)(q[0] + 16 * i));
+            __m256i hi = _mm256_loadu2_m128i((const __m128i *)(q[3] + 16 * i), (const __m128i *)(q[2] + 16 * i));
+            X[i] = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_shuffle_epi8(lo, bswap)),
+                                      _mm256_shuffle_epi8(hi, bswap), 1);
+            WK(i, X[i]);
+        }
+
+        for (i = 8; i < 40; i += 8) {
+            SCHEDULE(0); SCHEDULE(1); SCHEDULE(2); SCHEDULE(3);
+            SCHEDULE(4); SCHEDULE(5); SCHEDULE(6); SCHEDULE(7);
+        }
+
+        _mm256_zeroupper();
+        for (j = 0; (size_t)j < n; j++) {
+            vng_sha512_intel_rounds(ccdigest_u64(state), wk[j]);
+        }
+        nblocks -= n;
+        p += n * CCSHA512_BLOCK_SIZE;
+    }
+
+    cc_clear(sizeof(wk), wk);
+#undef SCHEDULE
+#undef WK
+}
+
+#endif /* CCSHA2_VNG_INTEL && defined(__x86_64__) */
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "ccsha3_internal.h"
+#include <corecrypto/ccdigest_priv.h>
+
+static void ccsha3_512_c_compress(ccdigest_state_t state, size_t nblocks, const void *data)
+{
+    cckeccak_absorb_blocks((cckeccak_state_t)state, CCSHA3_512_BLOCK_SIZE, nblocks, data, cckeccak_f1600_c);
+}
+
+const struct ccdigest_info ccsha3_512_c_di = {
+    .block_size = CCSHA3_512_BLOCK_SIZE,
+    .output_size = CCSHA3_512_OUTPUT_SIZE,
+    .state_size = CCSHA3_512_STATE_SIZE,
+
+    .final = ccsha3_final,
+    .compress = ccsha3_512_c_compress,
+
+    .initial_state = ccsha3_keccak_p1600_initial_state,
+
+    .oid = ccoid_sha3_512,
+    .oid_size = ccoid_sha3_512_len,
+};
+
+const struct ccdigest_info *ccsha3_512_di(void)
+{
+    return &ccsha3_512_c_di;
+}
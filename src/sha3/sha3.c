@@ -16,10 +16,23 @@
  * @LICENSE_HEADER_END@
  */
 
-#include <corecrypto/ccsha3.h>
+
+#include "ccsha3_internal.h"
+#include <corecrypto/ccdigest_priv.h>
 
 /*
  * ZORMEISTER:
  *
  * I started with researching SHA-3. How in the hell did I get here.
  */
+
+const uint64_t ccsha3_keccak_p1600_initial_state[25] = { 0 };
+
+/* the ccdigest buffer holds the unabsorbed tail, which is always shorter than the rate */
+void ccsha3_final(const struct ccdigest_info *di, ccdigest_ctx_t ctx, void *digest)
+{
+    cckeccak_state_t state = (cckeccak_state_t)ccdigest_state(di, ctx);
+
+    cckeccak_absorb_and_pad(state, di->block_size, ccdigest_num(di, ctx), ccdigest_data(di, ctx), CCKECCAK_SHA3_PADDING);
+    cckeccak_squeeze(state, di->block_size, di->output_size, digest, cckeccak_f1600_c);
+}
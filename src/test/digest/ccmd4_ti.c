@@ -20,7 +20,7 @@
 
 #if CORECRYPTO_TEST
 
-#include <corecrypto/ccmd2.h>
+#include <corecrypto/ccmd4.h>
 #include <corecrypto/ccdigest_test_internal.h>
 
 #include "vectors/md4.inc"
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cckeccak.h>
+#include <corecrypto/ccxof.h>
+
+void ccshake_init(const struct ccxof_info *xi, ccxof_state_t state);
+
+void ccshake_init(CC_UNUSED const struct ccxof_info *xi, ccxof_state_t state)
+{
+    cckeccak_init_state((cckeccak_state_t)state);
+}
+
+static void ccshake_c_absorb(const struct ccxof_info *xi, ccxof_state_t state, size_t nblocks, const uint8_t *in)
+{
+    cckeccak_absorb_blocks((cckeccak_state_t)state, xi->block_nbytes, nblocks, in, cckeccak_f1600_c);
+}
+
+static void ccshake_c_absorb_last(const struct ccxof_info *xi, ccxof_state_t state, size_t in_nbytes, const uint8_t *in)
+{
+    cckeccak_absorb_and_pad((cckeccak_state_t)state, xi->block_nbytes, in_nbytes, in, CCKECCAK_SHAKE_PADDING);
+}
+
+static void ccshake_c_squeeze(const struct ccxof_info *xi, ccxof_state_t state, size_t out_nbytes, uint8_t *out)
+{
+    cckeccak_squeeze((cckeccak_state_t)state, xi->block_nbytes, out_nbytes, out, cckeccak_f1600_c);
+}
+
+static const struct ccxof_info ccxof_shake128_c_xi = {
+    .state_nbytes = CCKECCAK_STATE_NBYTES,
+    .block_nbytes = CCSHAKE128_RATE,
+    .init = ccshake_init,
+    .absorb = ccshake_c_absorb,
+    .absorb_last = ccshake_c_absorb_last,
+    .squeeze = ccshake_c_squeeze,
+};
+
+static const struct ccxof_info ccxof_shake256_c_xi = {
+    .state_nbytes = CCKECCAK_STATE_NBYTES,
+    .block_nbytes = CCSHAKE256_RATE,
+    .init = ccshake_init,
+    .absorb = ccshake_c_absorb,
+    .absorb_last = ccshake_c_absorb_last,
+    .squeeze = ccshake_c_squeeze,
+};
+
+const struct ccxof_info *ccshake128_xi(void)
+{
+    return &ccxof_shake128_c_xi;
+}
+
+const struct ccxof_info *ccshake256_xi(void)
+{
+    return &ccxof_shake256_c_xi;
+}
+
+static void ccshake(const struct ccxof_info *xi, size_t in_nbytes, const void *in, size_t out_nbytes, void *out)
+{
+    struct ccxof_ctx ctx;
+
+    ccxof_init(xi, &ctx);
+    ccxof_absorb(xi, &ctx, in_nbytes, in);
+    ccxof_squeeze(xi, &ctx, out_nbytes, out);
+    cc_clear(sizeof(ctx), &ctx);
+}
+
+void ccshake128(size_t in_nbytes, const void *in, size_t out_nbytes, void *out)
+{
+    ccshake(ccshake128_xi(), in_nbytes, in, out_nbytes, out);
+}
+
+void ccshake256(size_t in_nbytes, const void *in, size_t out_nbytes, void *out)
+{
+    ccshake(ccshake256_xi(), in_nbytes, in, out_nbytes, out);
+}
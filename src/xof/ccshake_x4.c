@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/cckeccak.h>
+#include <corecrypto/ccxof.h>
+
+/* lane i of message l lives at states->state[i][l], so one permutation call advances all four sponges */
+static void ccshake_x4(size_t rate, size_t in_nbytes, const void *const in[4], size_t out_nbytes, void *const out[4])
+{
+    struct cckeccak_state_x4 states;
+    const uint8_t *p[4];
+    uint8_t *q[4];
+    uint64_t w;
+    size_t i, l, n;
+
+    cc_clear(sizeof(states), &states);
+    for (l = 0; l < 4; l++) {
+        p[l] = in[l];
+        q[l] = out[l];
+    }
+
+    for (; in_nbytes >= rate; in_nbytes -= rate) {
+        for (l = 0; l < 4; l++) {
+            for (i = 0; i < rate / 8; i++) {
+                CC_LOAD64_LE(w, p[l] + 8 * i);
+                states.state[i][l] ^= w;
+            }
+            p[l] += rate;
+        }
+        cckeccak_f1600_x4(&states);
+    }
+
+    for (l = 0; l < 4; l++) {
+        for (i = 0; i < in_nbytes; i++) {
+            states.state[i / 8][l] ^= (uint64_t)p[l][i] << (8 * (i % 8));
+        }
+        states.state[in_nbytes / 8][l] ^= (uint64_t)CCKECCAK_SHAKE_PADDING << (8 * (in_nbytes % 8));
+        states.state[(rate - 1) / 8][l] ^= (uint64_t)0x80 << 56;
+    }
+
+    while (out_nbytes > 0) {
+        cckeccak_f1600_x4(&states);
+        n = CC_MIN(out_nbytes, rate);
+        for (l = 0; l < 4; l++) {
+            for (i = 0; i < n; i++) {
+                q[l][i] = (uint8_t)(states.state[i / 8][l] >> (8 * (i % 8)));
+            }
+            q[l] += n;
+        }
+        out_nbytes -= n;
+    }
+
+    cc_clear(sizeof(states), &states);
+}
+
+void ccshake128_x4(size_t in_nbytes, const void *const in[4], size_t out_nbytes, void *const out[4])
+{
+    ccshake_x4(CCSHAKE128_RATE, in_nbytes, in, out_nbytes, out);
+}
+
+void ccshake256_x4(size_t in_nbytes, const void *const in[4], size_t out_nbytes, void *const out[4])
+{
+    ccshake_x4(CCSHAKE256_RATE, in_nbytes, in, out_nbytes, out);
+}
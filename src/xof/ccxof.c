@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include <corecrypto/cc_priv.h>
+#include <corecrypto/ccxof.h>
+
+void ccxof_init(const struct ccxof_info *xi, ccxof_ctx_t ctx)
+{
+    xi->init(xi, &ctx->state);
+    ctx->nbytes = 0;
+    ctx->squeezing = false;
+}
+
+int ccxof_absorb(const struct ccxof_info *xi, ccxof_ctx_t ctx, size_t in_nbytes, const void *in)
+{
+    const uint8_t *p = in;
+    size_t n, nblocks;
+
+    if (ctx->squeezing) {
+        return CCERR_CALL_SEQUENCE;
+    }
+
+    /* top up a partial block first */
+    if (ctx->nbytes > 0) {
+        n = CC_MIN(in_nbytes, xi->block_nbytes - ctx->nbytes);
+        cc_memcpy(ctx->buffer + ctx->nbytes, p, n);
+        ctx->nbytes += n;
+        p += n;
+        in_nbytes -= n;
+
+        if (ctx->nbytes < xi->block_nbytes) {
+            return CCERR_OK;
+        }
+        xi->absorb(xi, &ctx->state, 1, ctx->buffer);
+        ctx->nbytes = 0;
+    }
+
+    nblocks = in_nbytes / xi->block_nbytes;
+    if (nblocks > 0) {
+        xi->absorb(xi, &ctx->state, nblocks, p);
+        p += nblocks * xi->block_nbytes;
+        in_nbytes -= nblocks * xi->block_nbytes;
+    }
+
+    cc_memcpy(ctx->buffer, p, in_nbytes);
+    ctx->nbytes = in_nbytes;
+    return CCERR_OK;
+}
+
+void ccxof_squeeze(const struct ccxof_info *xi, ccxof_ctx_t ctx, size_t out_nbytes, void *out)
+{
+    uint8_t *p = out;
+    size_t n;
+
+    if (!ctx->squeezing) {
+        xi->absorb_last(xi, &ctx->state, ctx->nbytes, ctx->buffer);
+        cc_clear(sizeof(ctx->buffer), ctx->buffer);
+        ctx->nbytes = 0;
+        ctx->squeezing = true;
+    }
+
+    /* unread output from the last block, which sits at the end of the buffer */
+    n = CC_MIN(out_nbytes, ctx->nbytes);
+    cc_memcpy(p, ctx->buffer + xi->block_nbytes - ctx->nbytes, n);
+    ctx->nbytes -= n;
+    p += n;
+    out_nbytes -= n;
+
+    n = out_nbytes - out_nbytes % xi->block_nbytes;
+    if (n > 0) {
+        xi->squeeze(xi, &ctx->state, n, p);
+        p += n;
+        out_nbytes -= n;
+    }
+
+    if (out_nbytes > 0) {
+        xi->squeeze(xi, &ctx->state, xi->block_nbytes, ctx->buffer);
+        cc_memcpy(p, ctx->buffer, out_nbytes);
+        ctx->nbytes = xi->block_nbytes - out_nbytes;
+    }
+}
@@ -1,8 +0,0 @@
-//
-//  pdcxof.c
-//  corecrypto
-//
-//  Created by Zormeister on 22/1/2025.
-//
-
-#include "pdcxof.h"
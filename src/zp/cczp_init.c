@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "../ccn/ccn_internal.h"
+#include "cczp_internal.h"
+#include <corecrypto/cc_priv.h>
+
+/* -p^-1 mod 2^w by Newton iteration, each step doubles the correct bits */
+static cc_unit cczp_mont_inv(cc_unit p0)
+{
+    cc_unit inv = p0; /* p0 * p0 == 1 mod 8 for odd p0 */
+
+    for (unsigned bits = 3; bits < CCN_UNIT_BITS; bits *= 2) {
+        inv *= 2 - p0 * inv;
+    }
+
+    return (cc_unit)0 - inv;
+}
+
+int cczp_init(cczp_t zp)
+{
+    cc_size n = cczp_n(zp);
+    const cc_unit *p = cczp_prime(zp);
+
+    if (n == 0 || (p[0] & 1) == 0 || ccn_is_one(n, p)) {
+        return CCERR_PARAMETER;
+    }
+
+    cc_unit *r2 = CCZP_RECIP(zp);
+    cc_unit t[n];
+
+    /* R^2 mod p by doubling 1 mod p 2 * ccn_bitsof_n(n) times, in constant time */
+    ccn_seti(n, r2, 1);
+    for (size_t i = 0; i < 2 * ccn_bitsof_n(n); i++) {
+        cc_unit carry = ccn_add(n, r2, r2, r2);
+        cc_unit borrow = ccn_sub(n, t, r2, p);
+        ccn_mux(n, carry | (borrow ^ 1), r2, t, r2);
+    }
+    ccn_clear(n, t);
+
+    r2[n] = cczp_mont_inv(p[0]);
+
+    zp->bitlen = ccn_bitlen(n, p);
+    zp->mulmod_prime = cczp_mul_mont;
+
+    return CCERR_OK;
+}
+
+void cczp_init_with_recip(cczp_t zp, const cc_unit *recip)
+{
+    cc_size n = cczp_n(zp);
+
+    ccn_set(n + 1, CCZP_RECIP(zp), recip);
+    zp->bitlen = ccn_bitlen(n, cczp_prime(zp));
+    zp->mulmod_prime = cczp_mul_mont;
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#ifndef _CORECRYPTO_CCZP_INTERNAL_H_
+#define _CORECRYPTO_CCZP_INTERNAL_H_
+
+#include <corecrypto/cczp.h>
+
+/*
+ * cczp_init() keeps p in the Montgomery domain: the n + 1 recip units hold
+ * R^2 mod p (n units, R = 2^ccn_bitsof_n(n)) followed by m' = -p^-1 mod 2^w.
+ */
+#define cczp_mont_r2(zp) cczp_recip(zp)
+#define cczp_mont_m0(zp) (cczp_recip(zp)[cczp_n(zp)])
+
+/* units of workspace the Montgomery routines take from ws->start */
+#define CCZP_MONT_WS_N(n) (2 * (n) + 2)
+
+/* x * y * R^-1 mod p -> r, x * y must be below R * p, r may alias x or y */
+void cczp_mul_mont(cc_ws_t ws, cczp_const_t zp, cc_unit *r, const cc_unit *x, const cc_unit *y);
+
+/* x^2 * R^-1 mod p -> r, x must be below p, r may alias x */
+void cczp_sqr_mont(cc_ws_t ws, cczp_const_t zp, cc_unit *r, const cc_unit *x);
+
+/* x * R mod p -> r */
+#define cczp_to_mont(ws, zp, r, x) cczp_mul_mont(ws, zp, r, x, cczp_mont_r2(zp))
+
+#endif /* _CORECRYPTO_CCZP_INTERNAL_H_ */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2025 The PureDarwin Project, All rights reserved.
+ *
+ * @LICENSE_HEADER_BEGIN@
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * @LICENSE_HEADER_END@
+ */
+
+
+#include "../ccn/ccn_internal.h"
+#include "cczp_internal.h"
+#include <corecrypto/cc_priv.h>
+
+/* t[0..n) + t[n] * R -> r, subtracting p once if that is at least p */
+static void cczp_mont_final(cczp_const_t zp, cc_unit *r, cc_unit *t)
+{
+    cc_size n = cczp_n(zp);
+    cc_unit borrow = ccn_sub(n, r, t, cczp_prime(zp));
+
+    ccn_mux(n, t[n] | (borrow ^ 1), r, r, t);
+}
+
+/* coarsely integrated operand scanning: interleave one row of x * y[i]
+   with one reduction step, so t never grows past n + 2 units */
+void cczp_mul_mont(cc_ws_t ws, cczp_const_t zp, cc_unit *r, const cc_unit *x, const cc_unit *y)
+{
+    cc_size n = cczp_n(zp);
+    const cc_unit *p = cczp_prime(zp);
+    cc_unit m0 = cczp_mont_m0(zp);
+    cc_unit *t = ws->start;
+
+    ccn_zero(n + 2, t);
+
+    for (cc_size i = 0; i < n; i++) {
+        cc_unit c = ccn_addmul1(n, t, x, y[i]);
+        t[n] += c;
+        t[n + 1] = t[n] < c;
+
+        /* t + m * p is divisible by 2^w, shift it down one unit as we go */
+        cc_unit m = t[0] * m0;
+        cc_unit lo;
+        c = ccn_mul_add2(m, p[0], t[0], 0, &lo);
+        for (cc_size j = 1; j < n; j++) {
+            c = ccn_mul_add2(m, p[j], t[j], c, &t[j - 1]);
+        }
+        t[n - 1] = t[n] + c;
+        t[n] = t[n + 1] + (t[n - 1] < c);
+        t[n + 1] = 0;
+    }
+
+    cczp_mont_final(zp, r, t);
+    ccn_clear(n + 2, t);
+}
+
+/* Montgomery reduction of the 2n unit t_2n in place */
+static void cczp_redc(cczp_const_t zp, cc_unit *r, cc_unit *t_2n)
+{
+    cc_size n = cczp_n(zp);
+    const cc_unit *p = cczp_prime(zp);
+    cc_unit m0 = cczp_mont_m0(zp);
+    cc_unit top = 0;
+
+    for (cc_size i = 0; i < n; i++) {
+        cc_unit c = ccn_addmul1(n, t_2n + i, p, t_2n[i] * m0);
+        cc_unit u = t_2n[i + n] + c;
+        cc_unit carry = u < c;
+        u += top;
+        carry += u < top;
+        t_2n[i + n] = u;
+        top = carry;
+    }
+
+    /* the reduced value sits in the upper half, its carry just above */
+    t_2n[2 * n] = top;
+    cczp_mont_final(zp, r, t_2n + n);
+}
+
+void cczp_sqr_mont(cc_ws_t ws, cczp_const_t zp, cc_unit *r, const cc_unit *x)
+{
+#if CCN_DEDICATED_SQR
+    cc_size n = cczp_n(zp);
+    cc_unit *t = ws->start;
+
+    ccn_sqr(n, t, x);
+    cczp_redc(zp, r, t);
+    ccn_clear(2 * n + 1, t);
+#else
+    cczp_mul_mont(ws, zp, r, x, x);
+#endif
+}
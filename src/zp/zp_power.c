@@ -16,9 +16,96 @@
  * @LICENSE_HEADER_END@
  */
 
-#include <corecrypto/cczp.h>
+#include "../ccn/ccn_internal.h"
+#include "cczp_internal.h"
+#include <corecrypto/cc_memory.h>
+#include <corecrypto/cc_priv.h>
 
+/* window width for the fixed-window ladder, a table of 2^w powers of m */
+#define CCZP_POWER_WINDOW(n) (ccn_bitsof_n(n) > 768 ? 5 : 4)
+
+/* bits [bit, bit + w) of e, the window may straddle two units */
+static cc_unit cczp_power_window(cc_size n, const cc_unit *e, size_t bit, unsigned w)
+{
+    size_t idx = bit / CCN_UNIT_BITS;
+    size_t off = bit % CCN_UNIT_BITS;
+    cc_unit v = e[idx] >> off;
+
+    if (off + w > CCN_UNIT_BITS && idx + 1 < n) {
+        v |= e[idx + 1] << (CCN_UNIT_BITS - off);
+    }
+
+    return v & (((cc_unit)1 << w) - 1);
+}
+
+/* table[k] -> r for k == idx, touching every entry */
+static void cczp_power_lookup(cc_size n, cc_unit *r, const cc_unit *table, size_t nentries, cc_unit idx)
+{
+    ccn_zero(n, r);
+
+    for (size_t k = 0; k < nentries; k++) {
+        cc_unit ne, mask;
+        CC_HEAVISIDE_STEP(ne, (cc_unit)k ^ idx);
+        mask = (cc_unit)ne - 1;
+
+        for (cc_size i = 0; i < n; i++) {
+            r[i] |= table[k * n + i] & mask;
+        }
+    }
+}
+
+/*
+ * Fixed-window exponentiation in the Montgomery domain. Every window of e,
+ * zero or not, costs w squarings, one table scan and one multiplication, so
+ * the sequence of operations only depends on cczp_n(zp).
+ */
 int cczp_power(cczp_const_t zp, cc_unit *r, const cc_unit *m, const cc_unit *e)
 {
+    cc_size n = cczp_n(zp);
+    unsigned w = CCZP_POWER_WINDOW(n);
+    size_t nentries = (size_t)1 << w;
+    size_t nbits = ccn_bitsof_n(n);
+    size_t ws_n = (nentries + 2) * n + CCZP_MONT_WS_N(n);
+
+    CC_WORKSPACE_DECL_N(ws, ws_n);
+    if (ws->start == NULL) {
+        return CCERR_MEMORY_ALLOC_FAIL;
+    }
+
+    cc_unit *table = ws->start;
+    cc_unit *acc = table + nentries * n;
+    cc_unit *sel = acc + n;
+    cc_ws scratch = { sel + n, ws->end };
+
+    /* table[k] = m^k * R mod p, table[0] is 1 in the Montgomery domain */
+    ccn_seti(n, acc, 1);
+    cczp_to_mont(&scratch, zp, table, acc);
+    cczp_to_mont(&scratch, zp, table + n, m);
+    for (size_t k = 2; k < nentries; k++) {
+        cczp_mul_mont(&scratch, zp, table + k * n, table + (k - 1) * n, table + n);
+    }
+
+    size_t nwindows = (nbits + w - 1) / w;
+    size_t bit = (nwindows - 1) * w;
+
+    cczp_power_lookup(n, acc, table, nentries, cczp_power_window(n, e, bit, w));
+
+    while (bit) {
+        bit -= w;
+
+        for (unsigned i = 0; i < w; i++) {
+            cczp_sqr_mont(&scratch, zp, acc, acc);
+        }
+
+        cczp_power_lookup(n, sel, table, nentries, cczp_power_window(n, e, bit, w));
+        cczp_mul_mont(&scratch, zp, acc, acc, sel);
+    }
+
+    /* leave the Montgomery domain */
+    ccn_seti(n, sel, 1);
+    cczp_mul_mont(&scratch, zp, r, acc, sel);
+
+    CC_WORKSPACE_FREE_N(ws, ws_n);
+
     return CCERR_OK;
 }
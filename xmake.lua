@@ -30,8 +30,8 @@ target("libcorecrypto_static")
 
     remove_files(
         "src/kext/*.c",
-        "src/kprng/*.c",
-        "src/kprng/**.c"
+        "src/kprng/cckprng.c",
+        "src/kprng/yarrow/*.c"
     )
 
     add_cflags("-Wincompatible-pointer-types", "-Wno-int-conversion")
@@ -64,12 +64,12 @@ target("libcorecrypto")
         )
     end
 
-    -- The yarrow PRNG won't compile for Linux, and I doubt it'll compile on Windows without modifications.
+    -- The yarrow PRNG (the kernel's cckprng) won't compile for Linux, and I doubt it'll compile on Windows without modifications.
     -- Also I don't think we want Darwin Kernel Extension code compiled on a non-Darwin (or non-Userspace) platform.
     remove_files(
         "src/kext/*.c",
-        "src/kprng/*.c",
-        "src/kprng/**.c"
+        "src/kprng/cckprng.c",
+        "src/kprng/yarrow/*.c"
     )
 
     add_cflags("-Wincompatible-pointer-types", "-Wno-int-conversion")
@@ -98,8 +98,8 @@ target("libcorecrypto_noasm")
 
     remove_files(
         "src/kext/*.c",
-        "src/kprng/*.c",
-        "src/kprng/**.c"
+        "src/kprng/cckprng.c",
+        "src/kprng/yarrow/*.c"
     )
 
     add_cflags("-Wincompatible-pointer-types", "-Wno-int-conversion")